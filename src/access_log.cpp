@@ -0,0 +1,138 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "access_log.hpp"
+
+#include <chrono>
+#include <iterator>
+
+#include <spdlog/fmt/fmt.h>
+
+#include "logging.hpp"
+#include "status.hpp"
+#include "timer.hpp"
+
+namespace ovms {
+
+thread_local AccessLogRecord* AccessLogRecord::currentRecord = nullptr;
+
+const char* toString(ExecutionContext::Interface interface) {
+    switch (interface) {
+    case ExecutionContext::Interface::GRPC:
+        return "gRPC";
+    case ExecutionContext::Interface::REST:
+        return "REST";
+    case ExecutionContext::Interface::CAPI:
+        return "C-API";
+    }
+    return "unknown";
+}
+
+const char* toString(ExecutionContext::Method method) {
+    switch (method) {
+    case ExecutionContext::Method::Predict:
+        return "Predict";
+    case ExecutionContext::Method::GetModelMetadata:
+        return "GetModelMetadata";
+    case ExecutionContext::Method::GetModelStatus:
+        return "GetModelStatus";
+    case ExecutionContext::Method::ConfigReload:
+        return "ConfigReload";
+    case ExecutionContext::Method::ConfigStatus:
+        return "ConfigStatus";
+    case ExecutionContext::Method::ModelInfer:
+        return "ModelInfer";
+    case ExecutionContext::Method::ModelReady:
+        return "ModelReady";
+    case ExecutionContext::Method::ModelMetadata:
+        return "ModelMetadata";
+    }
+    return "unknown";
+}
+
+static void appendJsonEscaped(std::string& buffer, const std::string& value) {
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            buffer.push_back('\\');
+            buffer.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            fmt::format_to(std::back_inserter(buffer), "\\u{:04x}", static_cast<int>(c));
+        } else {
+            buffer.push_back(c);
+        }
+    }
+}
+
+bool AccessLogRecord::isEnabled() {
+    return access_logger != nullptr;
+}
+
+AccessLogRecord::AccessLogRecord(ExecutionContext executionContext, const std::string& servableName, model_version_t servableVersion, const Status& status) :
+    executionContext(executionContext),
+    servableVersion(servableVersion),
+    status(status) {
+    if (!isEnabled() || currentRecord != nullptr) {
+        return;
+    }
+    this->active = true;
+    this->servableName = servableName;
+    this->startTicks = TickClock::now();
+    currentRecord = this;
+}
+
+AccessLogRecord::~AccessLogRecord() {
+    if (!this->active) {
+        return;
+    }
+    currentRecord = nullptr;
+    auto logger = access_logger;
+    if (logger) {
+        logger->info(this->format());
+    }
+}
+
+AccessLogRecord* AccessLogRecord::current(const std::string& servableName) {
+    AccessLogRecord* record = currentRecord;
+    if (record == nullptr || record->servableName != servableName) {
+        return nullptr;
+    }
+    return record;
+}
+
+void AccessLogRecord::addStage(const char* name, double microseconds) {
+    if (this->stagesCount >= MAX_STAGES) {
+        return;
+    }
+    this->stages[this->stagesCount++] = {name, microseconds};
+}
+
+std::string AccessLogRecord::format() const {
+    double totalMicroseconds = std::chrono::duration<double, std::micro>(TickClock::toDuration(TickClock::now() - this->startTicks)).count();
+    std::string buffer;
+    buffer.reserve(256);
+    fmt::format_to(std::back_inserter(buffer), "\"interface\":\"{}\",\"method\":\"{}\",\"servable\":\"",
+        toString(this->executionContext.interface), toString(this->executionContext.method));
+    appendJsonEscaped(buffer, this->servableName);
+    fmt::format_to(std::back_inserter(buffer), "\",\"version\":{},\"status_code\":{},\"status\":\"",
+        this->servableVersion, static_cast<int>(this->status.getCode()));
+    appendJsonEscaped(buffer, this->status.string());
+    fmt::format_to(std::back_inserter(buffer), "\",\"total_us\":{:.1f}", totalMicroseconds);
+    for (size_t i = 0; i < this->stagesCount; ++i) {
+        fmt::format_to(std::back_inserter(buffer), ",\"{}_us\":{:.1f}", this->stages[i].name, this->stages[i].microseconds);
+    }
+    return buffer;
+}
+
+}  // namespace ovms
@@ -0,0 +1,85 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "execution_context.hpp"
+#include "modelversion.hpp"
+
+namespace ovms {
+
+class Status;
+
+/**
+ * @brief Collects a single access log entry for an inference request and writes it when going out of scope.
+ *
+ * The record is bound to the calling thread for its lifetime so that ModelInstance::infer can attach
+ * per-stage timings without passing it through every call. Nested records on the same thread
+ * (e.g. REST KServe handler calling ModelInferImpl) are inactive - only the outermost one is written.
+ * When access log is disabled constructing a record costs a single flag check.
+ */
+class AccessLogRecord {
+public:
+    static const size_t MAX_STAGES = 8;
+
+private:
+    struct Stage {
+        const char* name;
+        double microseconds;
+    };
+
+    static thread_local AccessLogRecord* currentRecord;
+
+    bool active = false;
+    ExecutionContext executionContext;
+    std::string servableName;
+    model_version_t servableVersion;
+    const Status& status;
+    uint64_t startTicks = 0;
+    std::array<Stage, MAX_STAGES> stages;
+    size_t stagesCount = 0;
+
+public:
+    /**
+     * @param status reference to the status variable returned by the request handler, read when the record is written
+     */
+    AccessLogRecord(ExecutionContext executionContext, const std::string& servableName, model_version_t servableVersion, const Status& status);
+    ~AccessLogRecord();
+
+    AccessLogRecord(const AccessLogRecord&) = delete;
+    AccessLogRecord& operator=(const AccessLogRecord&) = delete;
+
+    static bool isEnabled();
+
+    /**
+     * @brief Returns record active on the calling thread if it was created for servable with given name, nullptr otherwise.
+     * Models executed as pipeline nodes do not match pipeline name, so their stages are not attributed to the pipeline.
+     */
+    static AccessLogRecord* current(const std::string& servableName);
+
+    void setServableVersion(model_version_t version) { this->servableVersion = version; }
+    void addStage(const char* name, double microseconds);
+
+    std::string format() const;
+};
+
+const char* toString(ExecutionContext::Interface interface);
+const char* toString(ExecutionContext::Method method);
+
+}  // namespace ovms
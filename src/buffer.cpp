@@ -45,5 +45,17 @@ const std::optional<uint32_t>& Buffer::getDeviceId() const {
     return bufferDeviceId;
 }
 
+bool Buffer::isOwned() const {
+    return ownedCopy != nullptr;
+}
+
+bool Buffer::refill(const void* src, size_t byteSize) {
+    if (!isOwned() || (this->byteSize != byteSize)) {
+        return false;
+    }
+    std::memcpy(ownedCopy.get(), src, byteSize);
+    return true;
+}
+
 Buffer::~Buffer() = default;
 }  // namespace ovms
@@ -34,6 +34,9 @@ public:
     OVMS_BufferType getBufferType() const;
     const std::optional<uint32_t>& getDeviceId() const;
     size_t getByteSize() const;
+    bool isOwned() const;
+    // Overwrites owned copy with new data of the same size, returns false otherwise
+    bool refill(const void* src, size_t byteSize);
 };
 
 }  // namespace ovms
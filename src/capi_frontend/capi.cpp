@@ -17,7 +17,10 @@
 #include <memory>
 #include <string>
 
+#include "../access_log.hpp"
 #include "../buffer.hpp"
+#include "../execution_context.hpp"
+#include "../inferencecompletionexecutor.hpp"
 #include "../inferenceparameter.hpp"
 #include "../inferencerequest.hpp"
 #include "../inferenceresponse.hpp"
@@ -27,6 +30,7 @@
 #include "../modelinstanceunloadguard.hpp"
 #include "../modelmanager.hpp"
 #include "../ovms.h"  // NOLINT
+#include "../pipeline.hpp"
 #include "../profiler.hpp"
 #include "../servablemanagermodule.hpp"
 #include "../server.hpp"
@@ -454,6 +458,72 @@ OVMS_Status* OVMS_InferenceRequestInputRemoveData(OVMS_InferenceRequest* req, co
     return nullptr;
 }
 
+OVMS_Status* OVMS_InferenceRequestAddOutput(OVMS_InferenceRequest* req, const char* outputName, OVMS_DataType datatype, const uint64_t* shape, uint32_t dimCount) {
+    if (req == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_REQUEST));
+    }
+    if (outputName == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_STRING));
+    }
+    if (shape == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_TABLE));
+    }
+    InferenceRequest* request = reinterpret_cast<InferenceRequest*>(req);
+    auto status = request->addOutput(outputName, datatype, shape, dimCount);
+    if (!status.ok()) {
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+    return nullptr;
+}
+
+OVMS_Status* OVMS_InferenceRequestOutputSetData(OVMS_InferenceRequest* req, const char* outputName, void* data, size_t bufferSize, OVMS_BufferType bufferType, uint32_t deviceId) {
+    if (req == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_REQUEST));
+    }
+    if (outputName == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_STRING));
+    }
+    if (data == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_DATA));
+    }
+    InferenceRequest* request = reinterpret_cast<InferenceRequest*>(req);
+    auto status = request->setOutputBuffer(outputName, data, bufferSize, bufferType, deviceId);
+    if (!status.ok()) {
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+    return nullptr;
+}
+
+OVMS_Status* OVMS_InferenceRequestOutputRemoveData(OVMS_InferenceRequest* req, const char* outputName) {
+    if (req == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_REQUEST));
+    }
+    if (outputName == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_STRING));
+    }
+    InferenceRequest* request = reinterpret_cast<InferenceRequest*>(req);
+    auto status = request->removeOutputBuffer(outputName);
+    if (!status.ok()) {
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+    return nullptr;
+}
+
+OVMS_Status* OVMS_InferenceRequestRemoveOutput(OVMS_InferenceRequest* req, const char* outputName) {
+    if (req == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_REQUEST));
+    }
+    if (outputName == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_STRING));
+    }
+    InferenceRequest* request = reinterpret_cast<InferenceRequest*>(req);
+    auto status = request->removeOutput(outputName);
+    if (!status.ok()) {
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+    return nullptr;
+}
+
 OVMS_Status* OVMS_InferenceResponseGetOutput(OVMS_InferenceResponse* res, uint32_t id, const char** name, OVMS_DataType* datatype, const uint64_t** shape, uint32_t* dimCount, const void** data, size_t* bytesize, OVMS_BufferType* bufferType, uint32_t* deviceId) {
     if (res == nullptr) {
         return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_RESPONSE));
@@ -556,8 +626,11 @@ OVMS_Status* OVMS_InferenceResponseGetParameter(OVMS_InferenceResponse* res, uin
 void OVMS_InferenceResponseDelete(OVMS_InferenceResponse* res) {
     if (res == nullptr)
         return;
-    InferenceResponse* response = reinterpret_cast<InferenceResponse*>(res);
-    delete response;
+    std::unique_ptr<InferenceResponse> response(reinterpret_cast<InferenceResponse*>(res));
+    auto pool = response->getPool();
+    if (pool) {
+        pool->giveBack(std::move(response));
+    }
 }
 
 namespace {
@@ -566,9 +639,7 @@ enum : unsigned int {
     TIMER_END
 };
 
-static Status getModelInstance(ovms::Server& server, const InferenceRequest* request, std::shared_ptr<ovms::ModelInstance>& modelInstance,
-    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
-    OVMS_PROFILE_FUNCTION();
+static Status getModelManager(ovms::Server& server, ModelManager** modelManager) {
     if (!server.isLive()) {
         return ovms::Status(ovms::StatusCode::SERVER_NOT_READY_FOR_INFERENCE, "not live");
     }
@@ -579,11 +650,51 @@ static Status getModelInstance(ovms::Server& server, const InferenceRequest* req
     if (!servableModule) {
         return ovms::Status(ovms::StatusCode::INTERNAL_ERROR, "missing servable manager");
     }
-    auto& modelManager = dynamic_cast<const ServableManagerModule*>(servableModule)->getServableManager();
+    *modelManager = &dynamic_cast<const ServableManagerModule*>(servableModule)->getServableManager();
+    return StatusCode::OK;
+}
+
+static Status getModelInstance(const ModelManager& modelManager, const InferenceRequest* request, std::shared_ptr<ovms::ModelInstance>& modelInstance,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
+    if (request->getPreparedModel()) {
+        return modelManager.getModelInstance(request->getPreparedModel(), request->getServableVersion(), modelInstance, modelInstanceUnloadGuardPtr);
+    }
     return modelManager.getModelInstance(request->getServableName(), request->getServableVersion(), modelInstance, modelInstanceUnloadGuardPtr);
 }
+
+static std::unique_ptr<InferenceResponse> createResponse(const InferenceRequest& request) {
+    if (request.getResponsePool()) {
+        return request.getResponsePool()->acquire();
+    }
+    return std::make_unique<InferenceResponse>(request.getServableName(), request.getServableVersion());
+}
 }  // namespace
+
+OVMS_Status* OVMS_InferenceRequestPrepare(OVMS_Server* serverPtr, OVMS_InferenceRequest* request) {
+    if (serverPtr == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_SERVER));
+    }
+    if (request == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_REQUEST));
+    }
+    auto req = reinterpret_cast<ovms::InferenceRequest*>(request);
+    ovms::Server& server = *reinterpret_cast<ovms::Server*>(serverPtr);
+    ModelManager* modelManager{nullptr};
+    auto status = getModelManager(server, &modelManager);
+    if (!status.ok()) {
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+    auto model = modelManager->findModelByName(req->getServableName());
+    if ((model == nullptr) && !modelManager->pipelineDefinitionExists(req->getServableName())) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::MODEL_NAME_MISSING));
+    }
+    // pipelines are created per inference, only responses are reused
+    req->prepare(std::move(model));
+    return nullptr;
+}
+
 OVMS_Status* OVMS_Inference(OVMS_Server* serverPtr, OVMS_InferenceRequest* request, OVMS_InferenceResponse** response) {
+    OVMS_PROFILE_REQUEST("C-API Inference");
     OVMS_PROFILE_FUNCTION();
     using std::chrono::microseconds;
     Timer<TIMER_END> timer;
@@ -599,42 +710,47 @@ OVMS_Status* OVMS_Inference(OVMS_Server* serverPtr, OVMS_InferenceRequest* reque
     }
     auto req = reinterpret_cast<ovms::InferenceRequest*>(request);
     ovms::Server& server = *reinterpret_cast<ovms::Server*>(serverPtr);
-    std::unique_ptr<ovms::InferenceResponse> res(new ovms::InferenceResponse(req->getServableName(), req->getServableVersion()));
+    std::unique_ptr<ovms::InferenceResponse> res = createResponse(*req);
 
     SPDLOG_DEBUG("Processing C-API request for model: {}; version: {}",
         req->getServableName(),
         req->getServableVersion());
 
     std::shared_ptr<ovms::ModelInstance> modelInstance;
-    //   std::unique_ptr<ovms::Pipeline> pipelinePtr;
+    std::unique_ptr<ovms::Pipeline> pipelinePtr;
 
+    ModelManager* modelManager{nullptr};
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
-    auto status = getModelInstance(server, req, modelInstance, modelInstanceUnloadGuard);
+    Status status;
+    AccessLogRecord accessLog(ExecutionContext{ExecutionContext::Interface::CAPI, ExecutionContext::Method::ModelInfer},
+        req->getServableName(), req->getServableVersion(), status);
+    status = getModelManager(server, &modelManager);
+    if (status.ok()) {
+        status = getModelInstance(*modelManager, req, modelInstance, modelInstanceUnloadGuard);
+    }
 
     if (status == StatusCode::MODEL_NAME_MISSING) {
         SPDLOG_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", req->getServableName());
-        // status = getPipeline(req, response, pipelinePtr);
-        status = Status(StatusCode::NOT_IMPLEMENTED, "Inference with DAG not supported with C-API in preview");
+        if (req->getOutputsSize() > 0) {
+            status = Status(StatusCode::NOT_IMPLEMENTED, "Output buffers are not supported with DAG in C-API");
+        } else {
+            status = modelManager->createPipeline(pipelinePtr, req->getServableName(), req, res.get());
+        }
     }
     if (!status.ok()) {
-        if (modelInstance) {
-            //    INCREMENT_IF_ENABLED(modelInstance->getMetricReporter().reqFailGrpcPredict);
-        }
         SPDLOG_INFO("Getting modelInstance or pipeline failed. {}", status.string());
         return reinterpret_cast<OVMS_Status*>(new Status(status));
     }
 
-    // ExecutionContext executionContext{
-    //   ExecutionContext::Interface::CAPI,
-    //  ExecutionContext::Method::Inference};
+    ExecutionContext executionContext{
+        ExecutionContext::Interface::CAPI,
+        ExecutionContext::Method::ModelInfer};
 
-    // if (pipelinePtr) {
-    //       status = pipelinePtr->execute(executionContext);
-    // INCREMENT_IF_ENABLED(pipelinePtr->getMetricReporter().getInferRequestMetric(executionContext, status.ok()));
-    //   } else {
-    status = modelInstance->infer(req, res.get(), modelInstanceUnloadGuard);
-    //   INCREMENT_IF_ENABLED(modelInstance->getMetricReporter().getInferRequestMetric(executionContext, status.ok()));
-    //}
+    if (pipelinePtr) {
+        status = pipelinePtr->execute(executionContext);
+    } else {
+        status = modelInstance->infer(req, res.get(), modelInstanceUnloadGuard);
+    }
 
     if (!status.ok()) {
         return reinterpret_cast<OVMS_Status*>(new Status(status));
@@ -642,15 +758,66 @@ OVMS_Status* OVMS_Inference(OVMS_Server* serverPtr, OVMS_InferenceRequest* reque
 
     timer.stop(TOTAL);
     double reqTotal = timer.elapsed<microseconds>(TOTAL);
-    // if (pipelinePtr) {
-    //  OBSERVE_IF_ENABLED(pipelinePtr->getMetricReporter().reqTimeGrpc, reqTotal);
-    //  } else {
-    //   OBSERVE_IF_ENABLED(modelInstance->getMetricReporter().reqTimeGrpc, reqTotal);
-    // }
     SPDLOG_DEBUG("Total C-API req processing time: {} ms", reqTotal / 1000);
     *response = reinterpret_cast<OVMS_InferenceResponse*>(res.release());
     return nullptr;
-    // return grpc::Status::OK;
+}
+
+OVMS_Status* OVMS_InferenceAsync(OVMS_Server* serverPtr, OVMS_InferenceRequest* request, OVMS_InferenceCallback callback, void* userdata) {
+    OVMS_PROFILE_REQUEST("C-API Async Inference");
+    OVMS_PROFILE_FUNCTION();
+    auto timer = std::make_shared<Timer<TIMER_END>>();
+    timer->start(TOTAL);
+    if (serverPtr == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_SERVER));
+    }
+    if (request == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_REQUEST));
+    }
+    if (callback == nullptr) {
+        return reinterpret_cast<OVMS_Status*>(new Status(StatusCode::NONEXISTENT_CALLBACK));
+    }
+    auto req = reinterpret_cast<ovms::InferenceRequest*>(request);
+    ovms::Server& server = *reinterpret_cast<ovms::Server*>(serverPtr);
+    std::unique_ptr<ovms::InferenceResponse> res = createResponse(*req);
+
+    SPDLOG_DEBUG("Processing asynchronous C-API request for model: {}; version: {}",
+        req->getServableName(),
+        req->getServableVersion());
+
+    ModelManager* modelManager{nullptr};
+    auto status = getModelManager(server, &modelManager);
+    std::shared_ptr<ovms::ModelInstance> modelInstance;
+    std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
+    if (status.ok()) {
+        status = getModelInstance(*modelManager, req, modelInstance, modelInstanceUnloadGuard);
+    }
+    if (status == StatusCode::MODEL_NAME_MISSING) {
+        SPDLOG_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", req->getServableName());
+        if (modelManager->pipelineDefinitionExists(req->getServableName())) {
+            status = Status(StatusCode::NOT_IMPLEMENTED, "Asynchronous inference with DAG not supported with C-API");
+        }
+    }
+    if (!status.ok()) {
+        SPDLOG_INFO("Getting modelInstance or pipeline failed. {}", status.string());
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+
+    // model instance is captured to outlive inference, unload guard is held by the instance until completion
+    status = modelInstance->inferAsync(req, std::move(res), modelInstanceUnloadGuard, modelManager->getInferenceCompletionExecutor(),
+        [modelInstance, timer, callback, userdata](const Status& inferenceStatus, std::unique_ptr<InferenceResponse> response) {
+            if (!inferenceStatus.ok()) {
+                callback(nullptr, reinterpret_cast<OVMS_Status*>(new Status(inferenceStatus)), userdata);
+                return;
+            }
+            timer->stop(TOTAL);
+            SPDLOG_DEBUG("Total asynchronous C-API req processing time: {} ms", timer->elapsed<std::chrono::microseconds>(TOTAL) / 1000);
+            callback(reinterpret_cast<OVMS_InferenceResponse*>(response.release()), nullptr, userdata);
+        });
+    if (!status.ok()) {
+        return reinterpret_cast<OVMS_Status*>(new Status(status));
+    }
+    return nullptr;
 }
 
 #ifdef __cplusplus
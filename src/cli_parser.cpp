@@ -59,12 +59,47 @@ void CLIParser::parse(int argc, char** argv) {
                 "Number of worker threads in REST server - has no effect if rest_port is not set. Default value depends on number of CPUs. ",
                 cxxopts::value<uint32_t>(),
                 "REST_WORKERS")
+            ("rest_compression_threshold",
+                "Minimal size in bytes of REST inference response compressed with gzip or deflate when client sends Accept-Encoding header. Default 1024.",
+                cxxopts::value<uint32_t>()->default_value("1024"),
+                "REST_COMPRESSION_THRESHOLD")
+            ("rest_event_loops",
+                "Number of REST server event loop threads accepting connections on rest_port. Default 1. Increase for many concurrent connections.",
+                cxxopts::value<uint32_t>()->default_value("1"),
+                "REST_EVENT_LOOPS")
+            ("rest_max_body_size",
+                "Maximal size in bytes of REST request body. Larger requests are rejected with 413 status. Default 1073741824.",
+                cxxopts::value<uint64_t>()->default_value("1073741824"),
+                "REST_MAX_BODY_SIZE")
+            ("rest_max_concurrent_requests",
+                "Maximal number of REST requests queued and processed by REST workers at once. Over the limit requests are rejected with 503 status. Default 0 - no limit.",
+                cxxopts::value<uint32_t>()->default_value("0"),
+                "REST_MAX_CONCURRENT_REQUESTS")
+            ("shared_memory_enable",
+                "Flag enabling KServe system shared memory API. Clients can then make the server map any POSIX shared memory object on the host, read inputs from it and write outputs into it. Enable only when all clients reaching the server are trusted. Default false.",
+                cxxopts::value<bool>()->default_value("false"),
+                "SHARED_MEMORY_ENABLE")
             ("log_level",
                 "serving log level - one of TRACE, DEBUG, INFO, WARNING, ERROR",
                 cxxopts::value<std::string>()->default_value("INFO"), "LOG_LEVEL")
             ("log_path",
                 "Optional path to the log file",
                 cxxopts::value<std::string>(), "LOG_PATH")
+            ("async_logging",
+                "Flag enabling asynchronous logging. Log messages are passed through a bounded queue to a background thread writing them to stdout and log file.",
+                cxxopts::value<bool>()->default_value("false"),
+                "ASYNC_LOGGING")
+            ("async_logging_queue_size",
+                "Number of log messages which can be queued for the background thread in asynchronous logging mode. Default 8192.",
+                cxxopts::value<uint32_t>()->default_value("8192"),
+                "ASYNC_LOGGING_QUEUE_SIZE")
+            ("async_logging_overflow_policy",
+                "Behavior when asynchronous logging queue is full - one of block, overrun_oldest. Default block.",
+                cxxopts::value<std::string>()->default_value("block"),
+                "ASYNC_LOGGING_OVERFLOW_POLICY")
+            ("access_log_path",
+                "Optional path to the access log file. When set, one JSON line per inference request is written with servable name, version, interface, stage timings and status. Does not require DEBUG log level.",
+                cxxopts::value<std::string>(), "ACCESS_LOG_PATH")
 #ifdef MTR_ENABLED
             ("trace_path",
                 "Path to the trace file",
@@ -89,6 +124,10 @@ void CLIParser::parse(int argc, char** argv) {
                 "Overrides model cache directory. By default cache files are saved into /opt/cache if the directory is present. When enabled, first model load will produce cache files.",
                 cxxopts::value<std::string>(),
                 "CACHE_DIR")
+            ("models_memory_budget_mb",
+                "Estimated memory limit for loaded models in megabytes. When exceeded, least recently used models are unloaded and loaded back on the next request. Default 0 - no limit.",
+                cxxopts::value<uint64_t>()->default_value("0"),
+                "MODELS_MEMORY_BUDGET_MB")
             ("cpu_extension",
                 "A path to shared library containing custom CPU layer implementation. Default: empty.",
                 cxxopts::value<std::string>()->default_value(""),
@@ -208,6 +247,12 @@ void CLIParser::prepare(ServerSettingsImpl* serverSettings, ModelsSettingsImpl*
     if (result->count("rest_workers"))
         serverSettings->restWorkers = result->operator[]("rest_workers").as<uint32_t>();
 
+    serverSettings->restCompressionThreshold = result->operator[]("rest_compression_threshold").as<uint32_t>();
+    serverSettings->restEventLoops = result->operator[]("rest_event_loops").as<uint32_t>();
+    serverSettings->restMaxBodySize = result->operator[]("rest_max_body_size").as<uint64_t>();
+    serverSettings->restMaxConcurrentRequests = result->operator[]("rest_max_concurrent_requests").as<uint32_t>();
+    serverSettings->sharedMemoryEnabled = result->operator[]("shared_memory_enable").as<bool>();
+
     if (result->count("batch_size"))
         modelsSettings->batchSize = result->operator[]("batch_size").as<std::string>();
 
@@ -245,6 +290,11 @@ void CLIParser::prepare(ServerSettingsImpl* serverSettings, ModelsSettingsImpl*
         serverSettings->logLevel = result->operator[]("log_level").as<std::string>();
     if (result->count("log_path"))
         serverSettings->logPath = result->operator[]("log_path").as<std::string>();
+    serverSettings->asyncLogging = result->operator[]("async_logging").as<bool>();
+    serverSettings->asyncLoggingQueueSize = result->operator[]("async_logging_queue_size").as<uint32_t>();
+    serverSettings->asyncLoggingOverflowPolicy = result->operator[]("async_logging_overflow_policy").as<std::string>();
+    if (result->count("access_log_path"))
+        serverSettings->accessLogPath = result->operator[]("access_log_path").as<std::string>();
 
 #ifdef MTR_ENABLED
     if (result->count("trace_path"))
@@ -258,6 +308,8 @@ void CLIParser::prepare(ServerSettingsImpl* serverSettings, ModelsSettingsImpl*
     serverSettings->sequenceCleanerPollWaitMinutes = result->operator[]("sequence_cleaner_poll_wait_minutes").as<uint32_t>();
     serverSettings->resourcesCleanerPollWaitSeconds = result->operator[]("custom_node_resources_cleaner_interval_seconds").as<uint32_t>();
 
+    serverSettings->modelsMemoryBudgetMb = result->operator[]("models_memory_budget_mb").as<uint64_t>();
+
     if (result != nullptr && result->count("cache_dir")) {
         serverSettings->cacheDir = result->operator[]("cache_dir").as<std::string>();
     }
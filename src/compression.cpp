@@ -0,0 +1,201 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "compression.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <map>
+
+#include <zlib.h>
+
+#include "logging.hpp"
+#include "status.hpp"
+#include "stringutils.hpp"
+
+namespace ovms {
+
+const std::string GZIP_ENCODING = "gzip";
+const std::string DEFLATE_ENCODING = "deflate";
+
+// zlib window bits 15 with 16 added selects gzip header and trailer instead of zlib ones
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+constexpr int ZLIB_WINDOW_BITS = 15;
+// negative window bits select raw deflate stream without zlib header
+constexpr int RAW_DEFLATE_WINDOW_BITS = -15;
+constexpr int GZIP_MEM_LEVEL = 8;
+constexpr size_t DECOMPRESSION_CHUNK_SIZE = 64 * 1024;
+
+// maps lower case content coding names to their quality
+static std::map<std::string, double> parseAcceptEncoding(const std::string& acceptEncoding) {
+    std::map<std::string, double> codings;
+    for (auto& coding : tokenize(acceptEncoding, ',')) {
+        auto parameters = tokenize(coding, ';');
+        if (parameters.empty()) {
+            continue;
+        }
+        std::string name = parameters[0];
+        trim(name);
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        double quality = 1.0;
+        for (size_t i = 1; i < parameters.size(); i++) {
+            std::string parameter = parameters[i];
+            erase_spaces(parameter);
+            if (parameter.rfind("q=", 0) != 0) {
+                continue;
+            }
+            quality = std::strtod(parameter.c_str() + 2, nullptr);
+        }
+        codings[name] = quality;
+    }
+    return codings;
+}
+
+static double getQuality(const std::map<std::string, double>& codings, const std::string& name) {
+    auto it = codings.find(name);
+    if (it == codings.end()) {
+        it = codings.find("*");
+    }
+    return it == codings.end() ? 0.0 : it->second;
+}
+
+bool isGzipAccepted(const std::string& acceptEncoding) {
+    return getQuality(parseAcceptEncoding(acceptEncoding), GZIP_ENCODING) > 0.0;
+}
+
+std::string selectContentEncoding(const std::string& acceptEncoding) {
+    auto codings = parseAcceptEncoding(acceptEncoding);
+    double gzipQuality = getQuality(codings, GZIP_ENCODING);
+    double deflateQuality = getQuality(codings, DEFLATE_ENCODING);
+    if (gzipQuality <= 0.0 && deflateQuality <= 0.0) {
+        return "";
+    }
+    return deflateQuality > gzipQuality ? DEFLATE_ENCODING : GZIP_ENCODING;
+}
+
+static Status zlibCompress(const std::string& input, int windowBits, const std::string& encoding, std::string& output) {
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, windowBits, GZIP_MEM_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        SPDLOG_ERROR("Failed to initialize {} compression", encoding);
+        return StatusCode::REST_COMPRESSION_ERROR;
+    }
+    output.resize(deflateBound(&stream, input.size()));
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = input.size();
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = output.size();
+    int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        SPDLOG_ERROR("Failed to compress {} bytes with {}, error: {}", input.size(), encoding, result);
+        output.clear();
+        return StatusCode::REST_COMPRESSION_ERROR;
+    }
+    output.resize(stream.total_out);
+    return StatusCode::OK;
+}
+
+Status gzipCompress(const std::string& input, std::string& output) {
+    return zlibCompress(input, GZIP_WINDOW_BITS, GZIP_ENCODING, output);
+}
+
+Status deflateCompress(const std::string& input, std::string& output) {
+    return zlibCompress(input, ZLIB_WINDOW_BITS, DEFLATE_ENCODING, output);
+}
+
+Status compress(const std::string& input, const std::string& encoding, std::string& output) {
+    if (encoding == GZIP_ENCODING) {
+        return gzipCompress(input, output);
+    }
+    if (encoding == DEFLATE_ENCODING) {
+        return deflateCompress(input, output);
+    }
+    SPDLOG_ERROR("Unsupported response content coding: {}", encoding);
+    return StatusCode::REST_COMPRESSION_ERROR;
+}
+
+static bool hasZlibHeader(const std::string& input) {
+    if (input.size() < 2) {
+        return false;
+    }
+    unsigned char cmf = input[0];
+    unsigned char flg = input[1];
+    return (cmf & 0x0f) == Z_DEFLATED && ((cmf << 8) | flg) % 31 == 0;
+}
+
+static std::string normalizeEncoding(const std::string& encoding) {
+    std::string name = encoding;
+    trim(name);
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return name;
+}
+
+bool isGzipEncoding(const std::string& contentEncoding) {
+    auto name = normalizeEncoding(contentEncoding);
+    return name == GZIP_ENCODING || name == "x-gzip";
+}
+
+bool isGzipCompressed(const std::string& data) {
+    return data.size() >= 2 && static_cast<unsigned char>(data[0]) == 0x1f && static_cast<unsigned char>(data[1]) == 0x8b;
+}
+
+Status decompress(const std::string& input, const std::string& encoding, size_t maxSize, std::string& output) {
+    const std::string name = normalizeEncoding(encoding);
+    if (name.empty() || name == "identity") {
+        output = input;
+        return StatusCode::OK;
+    }
+    int windowBits = 0;
+    if (isGzipEncoding(name)) {
+        windowBits = GZIP_WINDOW_BITS;
+    } else if (name == DEFLATE_ENCODING) {
+        // some clients send raw deflate stream instead of zlib format required by RFC 9110
+        windowBits = hasZlibHeader(input) ? ZLIB_WINDOW_BITS : RAW_DEFLATE_WINDOW_BITS;
+    } else {
+        SPDLOG_DEBUG("Unsupported request content coding: {}", encoding);
+        return StatusCode::REST_UNSUPPORTED_CONTENT_ENCODING;
+    }
+    z_stream stream{};
+    if (inflateInit2(&stream, windowBits) != Z_OK) {
+        SPDLOG_ERROR("Failed to initialize {} decompression", name);
+        return StatusCode::REST_DECOMPRESSION_ERROR;
+    }
+    output.clear();
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = input.size();
+    int result = Z_OK;
+    while (result == Z_OK) {
+        size_t written = output.size();
+        if (written >= maxSize) {
+            break;
+        }
+        output.resize(std::min(maxSize, written + std::max(DECOMPRESSION_CHUNK_SIZE, input.size() * 4)));
+        stream.next_out = reinterpret_cast<Bytef*>(output.data() + written);
+        stream.avail_out = output.size() - written;
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.resize(output.size() - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        SPDLOG_DEBUG("Failed to decompress {} bytes of {} request body, error: {}, decompressed: {} bytes, limit: {} bytes",
+            input.size(), name, result, output.size(), maxSize);
+        output.clear();
+        return StatusCode::REST_DECOMPRESSION_ERROR;
+    }
+    return StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,87 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace ovms {
+class Status;
+
+extern const std::string GZIP_ENCODING;
+extern const std::string DEFLATE_ENCODING;
+
+/**
+ * @brief Checks if value of Accept-Encoding header allows gzip content coding
+ *
+ * @param acceptEncoding header value, eg. "gzip, deflate;q=0.5"
+ * @return true if gzip (or *) is listed with non zero quality
+ */
+bool isGzipAccepted(const std::string& acceptEncoding);
+
+/**
+ * @brief Selects supported content coding with the highest quality in Accept-Encoding header, gzip wins ties
+ *
+ * @param acceptEncoding header value, eg. "gzip;q=0.5, deflate"
+ * @return GZIP_ENCODING, DEFLATE_ENCODING or empty string if none of them is accepted
+ */
+std::string selectContentEncoding(const std::string& acceptEncoding);
+
+/**
+ * @brief Compresses input with gzip format (RFC 1952)
+ *
+ * @param input data to compress
+ * @param output compressed data, previous content is replaced
+ * @return Status
+ */
+Status gzipCompress(const std::string& input, std::string& output);
+
+/**
+ * @brief Compresses input with HTTP deflate content coding, zlib format (RFC 1950)
+ *
+ * @param input data to compress
+ * @param output compressed data, previous content is replaced
+ * @return Status
+ */
+Status deflateCompress(const std::string& input, std::string& output);
+
+/**
+ * @brief Compresses input with content coding returned by selectContentEncoding
+ */
+Status compress(const std::string& input, const std::string& encoding, std::string& output);
+
+/**
+ * @brief Checks if Content-Encoding header value names gzip content coding
+ */
+bool isGzipEncoding(const std::string& contentEncoding);
+
+/**
+ * @brief Checks if data starts with gzip magic bytes
+ */
+bool isGzipCompressed(const std::string& data);
+
+/**
+ * @brief Decompresses body sent with Content-Encoding header
+ *
+ * @param input compressed data
+ * @param encoding header value, gzip, deflate or identity
+ * @param maxSize limit of decompressed data size protecting against decompression bombs
+ * @param output decompressed data, previous content is replaced
+ * @return REST_UNSUPPORTED_CONTENT_ENCODING, REST_DECOMPRESSION_ERROR or OK
+ */
+Status decompress(const std::string& input, const std::string& encoding, size_t maxSize, std::string& output);
+
+}  // namespace ovms
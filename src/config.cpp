@@ -103,6 +103,17 @@ bool Config::validate() {
         return false;
     }
 
+    // check rest_event_loops value
+    if (((restEventLoops() > AVAILABLE_CORES) || (restEventLoops() < 1))) {
+        std::cerr << "rest_event_loops count should be from 1 to CPU core count : " << AVAILABLE_CORES << std::endl;
+        return false;
+    }
+
+    if (restMaxBodySize() == 0) {
+        std::cerr << "rest_max_body_size must be greater than 0" << std::endl;
+        return false;
+    }
+
     if (this->serverSettings.restWorkers.has_value() && restPort() == 0) {
         std::cerr << "rest_workers is set but rest_port is not set. rest_port is required to start rest servers" << std::endl;
         return false;
@@ -164,6 +175,14 @@ bool Config::validate() {
         std::cerr << "log_level should be one of: TRACE, DEBUG, INFO, WARNING, ERROR" << std::endl;
         return false;
     }
+    if (this->serverSettings.asyncLoggingQueueSize == 0) {
+        std::cerr << "async_logging_queue_size must be greater than 0" << std::endl;
+        return false;
+    }
+    if (this->serverSettings.asyncLoggingOverflowPolicy != "block" && this->serverSettings.asyncLoggingOverflowPolicy != "overrun_oldest") {
+        std::cerr << "async_logging_overflow_policy should be one of: block, overrun_oldest" << std::endl;
+        return false;
+    }
     // check stateful flags:
     if ((this->modelsSettings.lowLatencyTransformation.has_value() || this->modelsSettings.maxSequenceNumber.has_value() || this->modelsSettings.idleSequenceCleanup.has_value()) && !stateful()) {
         std::cerr << "Setting low_latency_transformation, max_sequence_number and idle_sequence_cleanup require setting stateful flag for the model." << std::endl;
@@ -180,6 +199,11 @@ uint32_t Config::restPort() const { return this->serverSettings.restPort; }
 const std::string Config::restBindAddress() const { return this->serverSettings.restBindAddress; }
 uint32_t Config::grpcWorkers() const { return this->serverSettings.grpcWorkers; }
 uint32_t Config::restWorkers() const { return this->serverSettings.restWorkers.value_or(DEFAULT_REST_WORKERS); }
+uint32_t Config::restCompressionThreshold() const { return this->serverSettings.restCompressionThreshold; }
+uint32_t Config::restEventLoops() const { return this->serverSettings.restEventLoops; }
+uint64_t Config::restMaxBodySize() const { return this->serverSettings.restMaxBodySize; }
+uint32_t Config::restMaxConcurrentRequests() const { return this->serverSettings.restMaxConcurrentRequests; }
+bool Config::sharedMemoryEnabled() const { return this->serverSettings.sharedMemoryEnabled; }
 const std::string& Config::modelName() const { return this->modelsSettings.modelName; }
 const std::string& Config::modelPath() const { return this->modelsSettings.modelPath; }
 const std::string& Config::batchSize() const {
@@ -203,6 +227,10 @@ uint32_t Config::maxSequenceNumber() const { return this->modelsSettings.maxSequ
 bool Config::lowLatencyTransformation() const { return this->modelsSettings.lowLatencyTransformation.value_or(false); }
 const std::string& Config::logLevel() const { return this->serverSettings.logLevel; }
 const std::string& Config::logPath() const { return this->serverSettings.logPath; }
+bool Config::asyncLogging() const { return this->serverSettings.asyncLogging; }
+uint32_t Config::asyncLoggingQueueSize() const { return this->serverSettings.asyncLoggingQueueSize; }
+const std::string& Config::asyncLoggingOverflowPolicy() const { return this->serverSettings.asyncLoggingOverflowPolicy; }
+const std::string& Config::accessLogPath() const { return this->serverSettings.accessLogPath; }
 #ifdef MTR_ENABLED
 const std::string& Config::tracePath() const { return this->serverSettings.tracePath; }
 #endif
@@ -211,5 +239,6 @@ uint32_t Config::filesystemPollWaitSeconds() const { return this->serverSettings
 uint32_t Config::sequenceCleanerPollWaitMinutes() const { return this->serverSettings.sequenceCleanerPollWaitMinutes; }
 uint32_t Config::resourcesCleanerPollWaitSeconds() const { return this->serverSettings.resourcesCleanerPollWaitSeconds; }
 const std::string Config::cacheDir() const { return this->serverSettings.cacheDir; }
+uint64_t Config::modelsMemoryBudgetMb() const { return this->serverSettings.modelsMemoryBudgetMb; }
 
 }  // namespace ovms
@@ -136,6 +136,41 @@ public:
          */
     uint32_t restWorkers() const;
 
+    /**
+     * @brief Gets the minimal size of REST inference response compressed on client request
+     *
+     * @return uint32_t
+     */
+    uint32_t restCompressionThreshold() const;
+
+    /**
+     * @brief Gets the number of REST server event loops accepting connections on the REST port
+     *
+     * @return uint32_t
+     */
+    uint32_t restEventLoops() const;
+
+    /**
+     * @brief Gets the maximal size of REST request body
+     *
+     * @return uint64_t
+     */
+    uint64_t restMaxBodySize() const;
+
+    /**
+     * @brief Gets the maximal number of REST requests queued and processed at once, 0 for no limit
+     *
+     * @return uint32_t
+     */
+    uint32_t restMaxConcurrentRequests() const;
+
+    /**
+     * @brief Get KServe system shared memory API enabled flag
+     *
+     * @return bool
+     */
+    bool sharedMemoryEnabled() const;
+
     /**
          * @brief Get the model name
          * 
@@ -255,6 +290,41 @@ public:
         */
     const std::string& logPath() const;
 
+    /**
+     * @brief Get the flag enabling asynchronous logging
+     *
+     * @return bool
+     */
+    bool asyncLogging() const;
+
+    /**
+     * @brief Get the asynchronous logging queue size
+     *
+     * @return uint32_t
+     */
+    uint32_t asyncLoggingQueueSize() const;
+
+    /**
+     * @brief Get the asynchronous logging overflow policy
+     *
+     * @return const std::string&
+     */
+    const std::string& asyncLoggingOverflowPolicy() const;
+
+    /**
+     * @brief Get the access log path
+     *
+     * @return const std::string&
+     */
+    const std::string& accessLogPath() const;
+
+    /**
+     * @brief Get the memory budget for loaded models in megabytes, 0 if not limited
+     *
+     * @return uint64_t
+     */
+    uint64_t modelsMemoryBudgetMb() const;
+
 #ifdef MTR_ENABLED
     /**
         * @brief Get the log path
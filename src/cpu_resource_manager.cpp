@@ -0,0 +1,289 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "cpu_resource_manager.hpp"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "logging.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+bool parseCpuList(const std::string& cpuList, std::vector<int>& cpus) {
+    std::stringstream stream(cpuList);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), [](unsigned char c) { return std::isspace(c); }), range.end());
+        if (range.empty()) {
+            continue;
+        }
+        try {
+            size_t processed = 0;
+            auto dash = range.find('-');
+            int first = std::stoi(range.substr(0, dash), &processed);
+            if (processed != (dash == std::string::npos ? range.size() : dash) || first < 0) {
+                return false;
+            }
+            int last = first;
+            if (dash != std::string::npos) {
+                last = std::stoi(range.substr(dash + 1), &processed);
+                if (processed != range.size() - dash - 1 || last < first) {
+                    return false;
+                }
+            }
+            for (int cpu = first; cpu <= last; ++cpu) {
+                cpus.emplace_back(cpu);
+            }
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string formatCpuList(const std::vector<int>& cpus) {
+    std::string result;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t j = i;
+        while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+            ++j;
+        }
+        if (!result.empty()) {
+            result += ",";
+        }
+        result += std::to_string(cpus[i]);
+        if (j > i) {
+            result += "-" + std::to_string(cpus[j]);
+        }
+        i = j + 1;
+    }
+    return result;
+}
+
+CpuTopology CpuTopology::detect() {
+    CpuTopology topology;
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &mask)) {
+                topology.cpus.emplace_back(cpu);
+            }
+        }
+    }
+    if (topology.cpus.empty()) {
+        for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); ++cpu) {
+            topology.cpus.emplace_back(cpu);
+        }
+    }
+    const std::string nodesPath = "/sys/devices/system/node";
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(nodesPath, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.rfind("node", 0) != 0) {
+            continue;
+        }
+        int node = 0;
+        try {
+            node = std::stoi(name.substr(4));
+        } catch (const std::exception&) {
+            continue;
+        }
+        std::ifstream file(entry.path() / "cpulist");
+        std::string cpuList;
+        std::vector<int> nodeCpus;
+        if (!std::getline(file, cpuList) || !parseCpuList(cpuList, nodeCpus)) {
+            continue;
+        }
+        for (int cpu : nodeCpus) {
+            topology.numaNodeOfCpu[cpu] = node;
+        }
+    }
+    for (int cpu : topology.cpus) {
+        topology.numaNodeOfCpu.emplace(cpu, 0);
+    }
+    return topology;
+}
+
+CpuResourceManager::CpuResourceManager(CpuTopology topology) :
+    topology(std::move(topology)) {}
+
+bool CpuResourceManager::allocate(size_t cores, CpuAssignment& assignment) const {
+    std::map<int, std::vector<int>> freeCpusOfNode;
+    size_t freeCpusCount = 0;
+    for (int cpu : this->topology.cpus) {
+        if (this->reservedCpus.count(cpu) == 0) {
+            auto it = this->topology.numaNodeOfCpu.find(cpu);
+            freeCpusOfNode[it == this->topology.numaNodeOfCpu.end() ? 0 : it->second].emplace_back(cpu);
+            ++freeCpusCount;
+        }
+    }
+    if (cores > freeCpusCount) {
+        return false;
+    }
+    // prefer the single NUMA node which fits the reservation most tightly to keep larger nodes for larger models
+    const std::vector<int>* bestFit = nullptr;
+    int bestFitNode = 0;
+    for (const auto& [node, cpus] : freeCpusOfNode) {
+        if (cpus.size() >= cores && (bestFit == nullptr || cpus.size() < bestFit->size())) {
+            bestFit = &cpus;
+            bestFitNode = node;
+        }
+    }
+    if (bestFit != nullptr) {
+        assignment.cpus.assign(bestFit->begin(), bestFit->begin() + cores);
+        assignment.numaNodes.insert(bestFitNode);
+        return true;
+    }
+    // otherwise span the smallest number of nodes
+    std::vector<std::pair<int, const std::vector<int>*>> nodes;
+    for (const auto& [node, cpus] : freeCpusOfNode) {
+        nodes.emplace_back(node, &cpus);
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const auto& a, const auto& b) { return a.second->size() > b.second->size(); });
+    for (const auto& [node, cpus] : nodes) {
+        size_t taken = std::min(cores - assignment.cpus.size(), cpus->size());
+        assignment.cpus.insert(assignment.cpus.end(), cpus->begin(), cpus->begin() + taken);
+        assignment.numaNodes.insert(node);
+        if (assignment.cpus.size() == cores) {
+            break;
+        }
+    }
+    std::sort(assignment.cpus.begin(), assignment.cpus.end());
+    return true;
+}
+
+Status CpuResourceManager::reserve(const std::string& modelName, size_t cores) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    auto it = this->reservations.find(modelName);
+    CpuAssignment previous;
+    if (it != this->reservations.end()) {
+        if (it->second.cpus.size() == cores) {
+            return StatusCode::OK;
+        }
+        previous = std::move(it->second);
+        this->reservations.erase(it);
+        for (int cpu : previous.cpus) {
+            this->reservedCpus.erase(cpu);
+        }
+    }
+    if (cores == 0) {
+        if (!previous.cpus.empty()) {
+            SPDLOG_LOGGER_INFO(modelmanager_logger, "Model: {} released reserved CPU cores: {}", modelName, formatCpuList(previous.cpus));
+        }
+        return StatusCode::OK;
+    }
+    CpuAssignment assignment;
+    assignment.dedicated = true;
+    if (!allocate(cores, assignment)) {
+        Status status = StatusCode::CPU_CORES_NOT_AVAILABLE;
+        SPDLOG_LOGGER_ERROR(modelmanager_logger, "{}; model: {}; requested cores: {}; free cores: {}",
+            status.string(), modelName, cores, this->topology.cpus.size() - this->reservedCpus.size());
+        if (!previous.cpus.empty()) {
+            this->reservedCpus.insert(previous.cpus.begin(), previous.cpus.end());
+            this->reservations.emplace(modelName, std::move(previous));
+        }
+        return status;
+    }
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Model: {} reserved CPU cores: {}; NUMA nodes: {}",
+        modelName, formatCpuList(assignment.cpus), formatCpuList(std::vector<int>(assignment.numaNodes.begin(), assignment.numaNodes.end())));
+    this->reservedCpus.insert(assignment.cpus.begin(), assignment.cpus.end());
+    this->reservations.emplace(modelName, std::move(assignment));
+    return StatusCode::OK;
+}
+
+void CpuResourceManager::release(const std::string& modelName) {
+    reserve(modelName, 0);
+}
+
+std::vector<int> CpuResourceManager::sharedCpus() const {
+    std::vector<int> cpus;
+    for (int cpu : this->topology.cpus) {
+        if (this->reservedCpus.count(cpu) == 0) {
+            cpus.emplace_back(cpu);
+        }
+    }
+    if (cpus.empty()) {
+        cpus = this->topology.cpus;
+    }
+    return cpus;
+}
+
+CpuAssignment CpuResourceManager::getAssignment(const std::string& modelName) const {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    auto it = this->reservations.find(modelName);
+    if (it != this->reservations.end()) {
+        return it->second;
+    }
+    CpuAssignment shared;
+    shared.cpus = sharedCpus();
+    for (int cpu : shared.cpus) {
+        auto nodeIt = this->topology.numaNodeOfCpu.find(cpu);
+        shared.numaNodes.insert(nodeIt == this->topology.numaNodeOfCpu.end() ? 0 : nodeIt->second);
+    }
+    return shared;
+}
+
+bool CpuResourceManager::hasReservations() const {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    return !this->reservations.empty();
+}
+
+std::vector<int> CpuResourceManager::getSharedCpus() const {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (this->reservations.empty()) {
+        return {};
+    }
+    return sharedCpus();
+}
+
+void CpuResourceManager::applyToPluginConfig(const std::string& modelName, plugin_config_t& pluginConfig) const {
+    if (!hasReservations()) {
+        return;
+    }
+    const CpuAssignment assignment = getAssignment(modelName);
+    const size_t cores = assignment.cpus.size();
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Model: {} uses {} CPU cores: {}",
+        modelName, assignment.dedicated ? "reserved" : "shared", formatCpuList(assignment.cpus));
+    if (pluginConfig.count("INFERENCE_NUM_THREADS") == 0) {
+        pluginConfig["INFERENCE_NUM_THREADS"] = std::to_string(cores);
+    }
+    // CPU plugin pins threads of every compiled model starting from the first core,
+    // so pinning would stack co-hosted models on the same cores
+    if (pluginConfig.count("AFFINITY") == 0) {
+        pluginConfig["AFFINITY"] = "NONE";
+    }
+    if (!assignment.dedicated || pluginConfig.count("NUM_STREAMS") == 1) {
+        return;
+    }
+    auto hint = pluginConfig.find("PERFORMANCE_HINT");
+    if (hint != pluginConfig.end() && hint->second.as<std::string>() == "LATENCY") {
+        return;
+    }
+    size_t streams = std::max(assignment.numaNodes.size(), cores / THREADS_PER_THROUGHPUT_STREAM);
+    streams = std::max<size_t>(1, std::min(streams, cores));
+    pluginConfig["NUM_STREAMS"] = std::to_string(streams);
+}
+
+}  // namespace ovms
@@ -0,0 +1,114 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "modelconfig.hpp"
+
+namespace ovms {
+
+class Status;
+
+/**
+ * @brief Logical CPUs available to the server process and NUMA nodes they belong to
+ */
+struct CpuTopology {
+    std::vector<int> cpus;
+    std::map<int, int> numaNodeOfCpu;
+
+    /**
+     * @brief Reads CPUs from the process affinity mask and NUMA nodes from sysfs
+     */
+    static CpuTopology detect();
+};
+
+/**
+ * @brief Parses Linux cpulist format, e.g. "0-3,8,10-11"
+ *
+ * @return false if the list is malformed
+ */
+bool parseCpuList(const std::string& cpuList, std::vector<int>& cpus);
+
+std::string formatCpuList(const std::vector<int>& cpus);
+
+struct CpuAssignment {
+    std::vector<int> cpus;
+    std::set<int> numaNodes;
+    bool dedicated = false;
+};
+
+/**
+ * @brief Partitions CPU cores between models running on CPU device
+ *
+ * Models with cpu_cores set in config get disjoint core sets, packed into a single NUMA node whenever it has enough free cores.
+ * Remaining cores are shared by the other CPU models. Assignments are translated into thread, stream and affinity
+ * plugin properties when models are compiled, so that co-hosted models do not create more threads than there are cores.
+ * All versions of a model use the cores reserved for the model.
+ */
+class CpuResourceManager {
+    static constexpr size_t THREADS_PER_THROUGHPUT_STREAM = 4;
+
+    const CpuTopology topology;
+
+    mutable std::mutex mtx;
+    std::map<std::string, CpuAssignment> reservations;
+    std::set<int> reservedCpus;
+
+    bool allocate(size_t cores, CpuAssignment& assignment) const;
+    std::vector<int> sharedCpus() const;
+
+public:
+    explicit CpuResourceManager(CpuTopology topology);
+
+    size_t getCpusCount() const { return this->topology.cpus.size(); }
+
+    /**
+     * @brief Reserves cores for a model, keeps existing reservation if its size did not change
+     *
+     * @param cores 0 releases the reservation and makes the model use shared cores
+     */
+    Status reserve(const std::string& modelName, size_t cores);
+
+    void release(const std::string& modelName);
+
+    /**
+     * @brief Reserved cores of a model or cores shared by models without reservation
+     */
+    CpuAssignment getAssignment(const std::string& modelName) const;
+
+    bool hasReservations() const;
+
+    /**
+     * @brief Cores shared by models without reservation, empty if there are no reservations and such models use plugin defaults
+     */
+    std::vector<int> getSharedCpus() const;
+
+    /**
+     * @brief Translates model CPU assignment into plugin config, keys set explicitly by user are not overridden
+     *
+     * Plugin config is left unchanged when there are no reservations, so that models on a server without
+     * partitioning compile with plugin defaults.
+     */
+    void applyToPluginConfig(const std::string& modelName, plugin_config_t& pluginConfig) const;
+};
+
+}  // namespace ovms
@@ -16,9 +16,12 @@
 #pragma once
 
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
 
 #include "node_library.hpp"
+#include "tensorinfo.hpp"
 
 namespace ovms {
 
@@ -26,6 +29,11 @@ struct CNLIMWrapper {
     void* ptr;
     deinitialize_fn deinitialize = nullptr;
 
+    // Results of getInputsInfo/getOutputsInfo calls, keyed by the library callback.
+    // Valid for the lifetime of this wrapper since it is created per library initialization with fixed parameters.
+    std::mutex metadataCacheMtx;
+    std::map<metadata_fn, tensor_map_t> metadataCache;
+
     CNLIMWrapper(void* CNLIM, deinitialize_fn deinitialize) :
         ptr(CNLIM),
         deinitialize(deinitialize) {}
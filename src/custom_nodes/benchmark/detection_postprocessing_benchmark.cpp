@@ -0,0 +1,152 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+// Compares post-processing of detection custom nodes in detection_postprocessing.hpp
+// with the std::multimap based implementation from east_ocr/nms.hpp on synthetic crowded scenes.
+//
+// Usage: detection_postprocessing_benchmark [score_map_size] [iterations] [overlap_threshold]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../common/detection_postprocessing.hpp"
+#include "../east_ocr/nms.hpp"
+
+using ovms::custom_nodes_common::DetectionBoxes;
+using ovms::custom_nodes_common::nms;
+using ovms::custom_nodes_common::select_scores_above_threshold;
+
+static constexpr float CONFIDENCE_THRESHOLD = 0.5f;
+
+struct Scene {
+    std::vector<float> scores;
+    std::vector<cv::Rect> rects;
+};
+
+// Score map with clusters of confident pixels, each confident pixel proposes a box near its cluster center
+static Scene generateScene(int size, std::mt19937& generator) {
+    static constexpr int CLUSTER_RADIUS = 6;
+    Scene scene;
+    scene.scores.resize(size * size);
+    scene.rects.resize(size * size);
+    std::uniform_real_distribution<float> background(0.0f, 0.4f);
+    std::uniform_real_distribution<float> foreground(0.5f, 1.0f);
+    std::uniform_int_distribution<int> center(0, size - 1);
+    std::normal_distribution<float> jitter(0.0f, 2.0f);
+    for (auto& score : scene.scores) {
+        score = background(generator);
+    }
+    const int clustersCount = size / 4 + 1;
+    for (int i = 0; i < clustersCount; i++) {
+        const int clusterX = center(generator);
+        const int clusterY = center(generator);
+        for (int y = std::max(0, clusterY - CLUSTER_RADIUS); y < std::min(size, clusterY + CLUSTER_RADIUS); y++) {
+            for (int x = std::max(0, clusterX - CLUSTER_RADIUS); x < std::min(size, clusterX + CLUSTER_RADIUS); x++) {
+                scene.scores[y * size + x] = foreground(generator);
+                scene.rects[y * size + x] = cv::Rect(
+                    static_cast<int>(clusterX * 4 + jitter(generator)),
+                    static_cast<int>(clusterY * 4 + jitter(generator)),
+                    40 + static_cast<int>(jitter(generator)),
+                    16 + static_cast<int>(jitter(generator)));
+            }
+        }
+    }
+    return scene;
+}
+
+static size_t runLegacy(const Scene& scene, float overlapThreshold) {
+    std::vector<cv::Rect> rects;
+    std::vector<float> scores;
+    std::vector<int> metadata;
+    for (size_t i = 0; i < scene.scores.size(); i++) {
+        if (scene.scores[i] < CONFIDENCE_THRESHOLD) {
+            continue;
+        }
+        rects.emplace_back(scene.rects[i]);
+        scores.emplace_back(scene.scores[i]);
+        metadata.emplace_back(i);
+    }
+    std::vector<cv::Rect> filteredRects;
+    std::vector<float> filteredScores;
+    std::vector<int> filteredMetadata;
+    nms2(rects, scores, metadata, filteredRects, filteredScores, filteredMetadata, overlapThreshold);
+    return filteredRects.size();
+}
+
+static size_t runVectorized(const Scene& scene, float overlapThreshold) {
+    std::vector<uint32_t> candidates;
+    select_scores_above_threshold(scene.scores.data(), scene.scores.size(), CONFIDENCE_THRESHOLD, candidates);
+    DetectionBoxes boxes;
+    std::vector<float> scores;
+    boxes.reserve(candidates.size());
+    scores.reserve(candidates.size());
+    for (uint32_t candidate : candidates) {
+        const cv::Rect& rect = scene.rects[candidate];
+        boxes.add(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+        scores.emplace_back(scene.scores[candidate]);
+    }
+    std::vector<uint32_t> allBoxes(candidates.size());
+    std::iota(allBoxes.begin(), allBoxes.end(), 0);
+    std::vector<uint32_t> keep;
+    nms(boxes, scores.data(), allBoxes, overlapThreshold, allBoxes.size(), keep);
+    return keep.size();
+}
+
+template <typename F>
+static double measureMs(F&& function, int iterations, size_t& result) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        result = function();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+int main(int argc, char** argv) {
+    const int size = argc > 1 ? std::atoi(argv[1]) : 128;
+    const int iterations = argc > 2 ? std::atoi(argv[2]) : 20;
+    const float overlapThreshold = argc > 3 ? std::atof(argv[3]) : 0.3f;
+    if (size <= 0 || iterations <= 0) {
+        std::cout << "Usage: " << argv[0] << " [score_map_size] [iterations] [overlap_threshold]" << std::endl;
+        return 1;
+    }
+    std::mt19937 generator(42);
+    Scene scene = generateScene(size, generator);
+    size_t candidates = 0;
+    for (float score : scene.scores) {
+        candidates += score >= CONFIDENCE_THRESHOLD;
+    }
+
+    size_t legacyKept = 0;
+    size_t vectorizedKept = 0;
+    double legacyMs = measureMs([&]() { return runLegacy(scene, overlapThreshold); }, iterations, legacyKept);
+    double vectorizedMs = measureMs([&]() { return runVectorized(scene, overlapThreshold); }, iterations, vectorizedKept);
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Score map: " << size << "x" << size << "; candidate boxes: " << candidates << "; iterations: " << iterations << std::endl;
+    std::cout << "multimap nms2: " << legacyMs << " ms; kept boxes: " << legacyKept << std::endl;
+    std::cout << "vectorized nms: " << vectorizedMs << " ms; kept boxes: " << vectorizedKept << std::endl;
+    std::cout << "Speedup: " << legacyMs / vectorizedMs << "x" << std::endl;
+    if (legacyKept != vectorizedKept) {
+        std::cout << "Results differ" << std::endl;
+        return 1;
+    }
+    return 0;
+}
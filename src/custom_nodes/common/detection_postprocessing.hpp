@@ -0,0 +1,258 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace ovms {
+namespace custom_nodes_common {
+
+/**
+ * @brief Axis aligned boxes stored as structure of arrays.
+ * Keeping coordinates in separate arrays lets IoU of one box against many be computed with SIMD instructions.
+ */
+struct DetectionBoxes {
+    std::vector<float> x1;
+    std::vector<float> y1;
+    std::vector<float> x2;
+    std::vector<float> y2;
+
+    size_t size() const {
+        return x1.size();
+    }
+    void reserve(size_t count) {
+        x1.reserve(count);
+        y1.reserve(count);
+        x2.reserve(count);
+        y2.reserve(count);
+    }
+    void clear() {
+        x1.clear();
+        y1.clear();
+        x2.clear();
+        y2.clear();
+    }
+    void add(float boxX1, float boxY1, float boxX2, float boxY2) {
+        x1.push_back(boxX1);
+        y1.push_back(boxY1);
+        x2.push_back(boxX2);
+        y2.push_back(boxY2);
+    }
+};
+
+/**
+ * @brief Appends indexes of scores greater or equal to threshold, in increasing order.
+ * Compares 8 (AVX2) or 4 (SSE2) scores at once and only visits the lanes that passed.
+ */
+inline void select_scores_above_threshold(const float* scores, size_t count, float threshold, std::vector<uint32_t>& indexes) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256 thresholdVector = _mm256_set1_ps(threshold);
+    for (; i + 8 <= count; i += 8) {
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(scores + i), thresholdVector, _CMP_GE_OQ)));
+        while (mask != 0) {
+            indexes.push_back(static_cast<uint32_t>(i + __builtin_ctz(mask)));
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__SSE2__)
+    const __m128 thresholdVector = _mm_set1_ps(threshold);
+    for (; i + 4 <= count; i += 4) {
+        unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(scores + i), thresholdVector)));
+        while (mask != 0) {
+            indexes.push_back(static_cast<uint32_t>(i + __builtin_ctz(mask)));
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i < count; ++i) {
+        if (scores[i] >= threshold) {
+            indexes.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+/**
+ * @brief Same as select_scores_above_threshold for scores interleaved with other values,
+ * e.g. confidence field of [image_id, label, conf, x_min, y_min, x_max, y_max] detections.
+ */
+inline void select_strided_scores_above_threshold(const float* scores, size_t count, size_t stride, float threshold, std::vector<uint32_t>& indexes) {
+    for (size_t i = 0; i < count; ++i) {
+        if (scores[i * stride] >= threshold) {
+            indexes.push_back(static_cast<uint32_t>(i));
+        }
+    }
+}
+
+/**
+ * @brief Marks boxes [begin, count) whose IoU with the given box is greater than iouThreshold.
+ * Boxes are compared 8 (AVX2) or 4 (SSE2) at once, suppressed holds all bits set for suppressed boxes.
+ * Uses intersection > iouThreshold * union which avoids division and is false for two empty boxes.
+ */
+inline void suppress_overlapping_boxes(float boxX1, float boxY1, float boxX2, float boxY2, float boxArea,
+    const float* x1, const float* y1, const float* x2, const float* y2, const float* area,
+    size_t begin, size_t count, float iouThreshold, uint32_t* suppressed) {
+    size_t j = begin;
+#if defined(__AVX2__)
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 threshold = _mm256_set1_ps(iouThreshold);
+    const __m256 bx1 = _mm256_set1_ps(boxX1), by1 = _mm256_set1_ps(boxY1);
+    const __m256 bx2 = _mm256_set1_ps(boxX2), by2 = _mm256_set1_ps(boxY2);
+    const __m256 barea = _mm256_set1_ps(boxArea);
+    for (; j + 8 <= count; j += 8) {
+        const __m256 width = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(bx2, _mm256_loadu_ps(x2 + j)), _mm256_max_ps(bx1, _mm256_loadu_ps(x1 + j))));
+        const __m256 height = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(by2, _mm256_loadu_ps(y2 + j)), _mm256_max_ps(by1, _mm256_loadu_ps(y1 + j))));
+        const __m256 intersection = _mm256_mul_ps(width, height);
+        const __m256 unionArea = _mm256_sub_ps(_mm256_add_ps(barea, _mm256_loadu_ps(area + j)), intersection);
+        const __m256 overlaps = _mm256_cmp_ps(intersection, _mm256_mul_ps(threshold, unionArea), _CMP_GT_OQ);
+        float* suppressedLanes = reinterpret_cast<float*>(suppressed + j);
+        _mm256_storeu_ps(suppressedLanes, _mm256_or_ps(_mm256_loadu_ps(suppressedLanes), overlaps));
+    }
+#elif defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 threshold = _mm_set1_ps(iouThreshold);
+    const __m128 bx1 = _mm_set1_ps(boxX1), by1 = _mm_set1_ps(boxY1);
+    const __m128 bx2 = _mm_set1_ps(boxX2), by2 = _mm_set1_ps(boxY2);
+    const __m128 barea = _mm_set1_ps(boxArea);
+    for (; j + 4 <= count; j += 4) {
+        const __m128 width = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(bx2, _mm_loadu_ps(x2 + j)), _mm_max_ps(bx1, _mm_loadu_ps(x1 + j))));
+        const __m128 height = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(by2, _mm_loadu_ps(y2 + j)), _mm_max_ps(by1, _mm_loadu_ps(y1 + j))));
+        const __m128 intersection = _mm_mul_ps(width, height);
+        const __m128 unionArea = _mm_sub_ps(_mm_add_ps(barea, _mm_loadu_ps(area + j)), intersection);
+        const __m128 overlaps = _mm_cmpgt_ps(intersection, _mm_mul_ps(threshold, unionArea));
+        float* suppressedLanes = reinterpret_cast<float*>(suppressed + j);
+        _mm_storeu_ps(suppressedLanes, _mm_or_ps(_mm_loadu_ps(suppressedLanes), overlaps));
+    }
+#endif
+    for (; j < count; ++j) {
+        const float width = std::max(0.0f, std::min(boxX2, x2[j]) - std::max(boxX1, x1[j]));
+        const float height = std::max(0.0f, std::min(boxY2, y2[j]) - std::max(boxY1, y1[j]));
+        const float intersection = width * height;
+        const float unionArea = boxArea + area[j] - intersection;
+        if (intersection > iouThreshold * unionArea) {
+            suppressed[j] = std::numeric_limits<uint32_t>::max();
+        }
+    }
+}
+
+/**
+ * @brief Greedy non maximum suppression.
+ * Candidates are sorted once by decreasing score (ties by decreasing index, as in nms2) and copied into contiguous arrays.
+ * Each kept box then suppresses lower scored boxes with IoU greater than iouThreshold in a single vectorized pass.
+ * Appends indexes of kept boxes to keep, highest score first, stopping after maxOutputs boxes.
+ * @param boxes
+ * @param scores score per box, indexed the same as boxes; candidate scores must not be NaN
+ * @param candidates indexes of boxes taking part in suppression
+ * @param iouThreshold
+ * @param maxOutputs
+ * @param keep
+ */
+inline void nms(const DetectionBoxes& boxes,
+    const float* scores,
+    const std::vector<uint32_t>& candidates,
+    float iouThreshold,
+    size_t maxOutputs,
+    std::vector<uint32_t>& keep) {
+    const size_t count = candidates.size();
+    if (count == 0 || maxOutputs == 0) {
+        return;
+    }
+
+    std::vector<uint32_t> order(candidates);
+    std::sort(order.begin(), order.end(), [scores](uint32_t a, uint32_t b) {
+        return scores[a] > scores[b] || (scores[a] == scores[b] && a > b);
+    });
+
+    std::vector<float> x1(count), y1(count), x2(count), y2(count), area(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = order[i];
+        x1[i] = boxes.x1[index];
+        y1[i] = boxes.y1[index];
+        x2[i] = boxes.x2[index];
+        y2[i] = boxes.y2[index];
+        area[i] = std::max(0.0f, x2[i] - x1[i]) * std::max(0.0f, y2[i] - y1[i]);
+    }
+
+    std::vector<uint32_t> suppressed(count, 0);
+    size_t keptCount = 0;
+    for (size_t i = 0; i < count; ++i) {
+        if (suppressed[i]) {
+            continue;
+        }
+        keep.push_back(order[i]);
+        if (++keptCount == maxOutputs) {
+            break;
+        }
+        suppress_overlapping_boxes(x1[i], y1[i], x2[i], y2[i], area[i],
+            x1.data(), y1.data(), x2.data(), y2.data(), area.data(),
+            i + 1, count, iouThreshold, suppressed.data());
+    }
+}
+
+/**
+ * @brief Class aware non maximum suppression done with a single nms() call.
+ * Boxes are shifted by an offset specific to their label and larger than the extent of all candidate boxes,
+ * so boxes with different labels never overlap and suppress only boxes of the same label.
+ * Appends indexes of kept boxes to keep, highest score first, stopping after maxOutputs boxes.
+ */
+inline void multiclass_nms(const DetectionBoxes& boxes,
+    const float* scores,
+    const int* labels,
+    const std::vector<uint32_t>& candidates,
+    float iouThreshold,
+    size_t maxOutputs,
+    std::vector<uint32_t>& keep) {
+    const size_t count = candidates.size();
+    if (count == 0) {
+        return;
+    }
+    float minCoordinate = std::numeric_limits<float>::max();
+    float maxCoordinate = std::numeric_limits<float>::lowest();
+    for (uint32_t index : candidates) {
+        minCoordinate = std::min({minCoordinate, boxes.x1[index], boxes.y1[index], boxes.x2[index], boxes.y2[index]});
+        maxCoordinate = std::max({maxCoordinate, boxes.x1[index], boxes.y1[index], boxes.x2[index], boxes.y2[index]});
+    }
+    const float span = maxCoordinate - minCoordinate + 1.0f;
+
+    DetectionBoxes shiftedBoxes;
+    shiftedBoxes.reserve(count);
+    std::vector<float> candidateScores(count);
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t index = candidates[i];
+        const float offset = static_cast<float>(labels[index]) * span;
+        shiftedBoxes.add(boxes.x1[index] + offset, boxes.y1[index] + offset, boxes.x2[index] + offset, boxes.y2[index] + offset);
+        candidateScores[i] = scores[index];
+    }
+    std::vector<uint32_t> localCandidates(count);
+    std::iota(localCandidates.begin(), localCandidates.end(), 0);
+    std::vector<uint32_t> localKeep;
+    nms(shiftedBoxes, candidateScores.data(), localCandidates, iouThreshold, maxOutputs, localKeep);
+    for (uint32_t localIndex : localKeep) {
+        keep.push_back(candidates[localIndex]);
+    }
+}
+
+}  // namespace custom_nodes_common
+}  // namespace ovms
@@ -14,15 +14,21 @@
 // limitations under the License.
 //*****************************************************************************
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <string>
 #include <vector>
 
 #include "../../custom_node_interface.h"
+#include "../common/detection_postprocessing.hpp"
 #include "../common/opencv_utils.hpp"
 #include "../common/utils.hpp"
-#include "nms.hpp"
 #include "opencv2/opencv.hpp"
 
+using ovms::custom_nodes_common::DetectionBoxes;
+using ovms::custom_nodes_common::nms;
+using ovms::custom_nodes_common::select_scores_above_threshold;
+
 static constexpr const char* IMAGE_TENSOR_NAME = "image";
 static constexpr const char* SCORES_TENSOR_NAME = "scores";
 static constexpr const char* GEOMETRY_TENSOR_NAME = "geometry";
@@ -136,44 +142,97 @@ bool copy_confidences_into_output(struct CustomNodeTensor* output, const std::ve
     return true;
 }
 
+struct EastOcrParameters {
+    int originalImageHeight = -1;
+    int originalImageWidth = -1;
+    int targetImageHeight = -1;
+    int targetImageWidth = -1;
+    std::string originalImageLayout;
+    std::string targetImageLayout;
+    bool convertToGrayScale = false;
+    float confidenceThreshold = -1.0;
+    float overlapThreshold = 0.3;
+    uint64_t maxOutputBatch = 100;
+    bool debugMode = false;
+    float boxWidthAdjustment = 0.0;
+    float boxHeightAdjustment = 0.0;
+    int rotationAngleThreshold = 20;
+};
+
+int parse_parameters(const struct CustomNodeParam* params, int paramsCount, EastOcrParameters& parameters) {
+    parameters.originalImageHeight = get_int_parameter("original_image_height", params, paramsCount, -1);
+    parameters.originalImageWidth = get_int_parameter("original_image_width", params, paramsCount, -1);
+    NODE_ASSERT(parameters.originalImageHeight > 0, "original image height must be larger than 0");
+    NODE_ASSERT(parameters.originalImageWidth > 0, "original image width must be larger than 0");
+    NODE_ASSERT((parameters.originalImageHeight % 4) == 0, "original image height must be divisible by 4");
+    NODE_ASSERT((parameters.originalImageWidth % 4) == 0, "original image width must be divisible by 4");
+    parameters.targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
+    parameters.targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
+    NODE_ASSERT(parameters.targetImageHeight > 0, "target image height must be larger than 0");
+    NODE_ASSERT(parameters.targetImageWidth > 0, "target image width must be larger than 0");
+    parameters.originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount, "NCHW");
+    NODE_ASSERT(parameters.originalImageLayout == "NCHW" || parameters.originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
+    parameters.targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount, "NCHW");
+    NODE_ASSERT(parameters.targetImageLayout == "NCHW" || parameters.targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
+    parameters.convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
+    parameters.confidenceThreshold = get_float_parameter("confidence_threshold", params, paramsCount, -1.0);
+    NODE_ASSERT(parameters.confidenceThreshold >= 0 && parameters.confidenceThreshold <= 1.0, "confidence threshold must be in 0-1 range");
+    parameters.overlapThreshold = get_float_parameter("overlap_threshold", params, paramsCount, 0.3);
+    NODE_ASSERT(parameters.overlapThreshold >= 0 && parameters.overlapThreshold <= 1.0, "non max suppression filtering overlap threshold must be in 0-1 range");
+    parameters.maxOutputBatch = get_int_parameter("max_output_batch", params, paramsCount, 100);
+    NODE_ASSERT(parameters.maxOutputBatch > 0, "max output batch must be larger than 0");
+    parameters.debugMode = get_string_parameter("debug", params, paramsCount) == "true";
+    parameters.boxWidthAdjustment = get_float_parameter("box_width_adjustment", params, paramsCount, 0.0);
+    parameters.boxHeightAdjustment = get_float_parameter("box_height_adjustment", params, paramsCount, 0.0);
+    NODE_ASSERT(parameters.boxWidthAdjustment >= 0.0, "box width adjustment must be positive");
+    NODE_ASSERT(parameters.boxHeightAdjustment >= 0.0, "box height adjustment must be positive");
+    parameters.rotationAngleThreshold = get_int_parameter("rotation_angle_threshold", params, paramsCount, 20);
+    NODE_ASSERT(parameters.rotationAngleThreshold >= 0, "rotation angle threshold must be positive");
+    return 0;
+}
+
+// Returns parameters parsed once in initialize() or, when the library is used without it, parses them into fallback.
+const EastOcrParameters* get_parameters(void* customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount, EastOcrParameters& fallback) {
+    if (customNodeLibraryInternalManager != nullptr) {
+        return static_cast<const EastOcrParameters*>(customNodeLibraryInternalManager);
+    }
+    if (parse_parameters(params, paramsCount, fallback) != 0) {
+        return nullptr;
+    }
+    return &fallback;
+}
+
 int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount) {
+    // Parameters are parsed and validated once per pipeline definition load and reused by each execute() call.
+    auto parameters = std::make_unique<EastOcrParameters>();
+    NODE_ASSERT(parse_parameters(params, paramsCount, *parameters) == 0, "parameters parsing failed");
+    *customNodeLibraryInternalManager = parameters.release();
     return 0;
 }
 
 int deinitialize(void* customNodeLibraryInternalManager) {
+    delete static_cast<EastOcrParameters*>(customNodeLibraryInternalManager);
     return 0;
 }
 
 int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    // Parameters reading
-    int originalImageHeight = get_int_parameter("original_image_height", params, paramsCount, -1);
-    int originalImageWidth = get_int_parameter("original_image_width", params, paramsCount, -1);
-    NODE_ASSERT(originalImageHeight > 0, "original image height must be larger than 0");
-    NODE_ASSERT(originalImageWidth > 0, "original image width must be larger than 0");
-    NODE_ASSERT((originalImageHeight % 4) == 0, "original image height must be divisible by 4");
-    NODE_ASSERT((originalImageWidth % 4) == 0, "original image width must be divisible by 4");
-    int targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(targetImageHeight > 0, "target image height must be larger than 0");
-    NODE_ASSERT(targetImageWidth > 0, "target image width must be larger than 0");
-    std::string originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(originalImageLayout == "NCHW" || originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
-    std::string targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(targetImageLayout == "NCHW" || targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
-    bool convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
-    float confidenceThreshold = get_float_parameter("confidence_threshold", params, paramsCount, -1.0);
-    NODE_ASSERT(confidenceThreshold >= 0 && confidenceThreshold <= 1.0, "confidence threshold must be in 0-1 range");
-    float overlapThreshold = get_float_parameter("overlap_threshold", params, paramsCount, 0.3);
-    NODE_ASSERT(overlapThreshold >= 0 && overlapThreshold <= 1.0, "non max suppression filtering overlap threshold must be in 0-1 range");
-    uint64_t maxOutputBatch = get_int_parameter("max_output_batch", params, paramsCount, 100);
-    NODE_ASSERT(maxOutputBatch > 0, "max output batch must be larger than 0");
-    bool debugMode = get_string_parameter("debug", params, paramsCount) == "true";
-    float boxWidthAdjustment = get_float_parameter("box_width_adjustment", params, paramsCount, 0.0);
-    float boxHeightAdjustment = get_float_parameter("box_height_adjustment", params, paramsCount, 0.0);
-    NODE_ASSERT(boxWidthAdjustment >= 0.0, "box width adjustment must be positive");
-    NODE_ASSERT(boxHeightAdjustment >= 0.0, "box height adjustment must be positive");
-    int rotationAngleThreshold = get_int_parameter("rotation_angle_threshold", params, paramsCount, 20);
-    NODE_ASSERT(rotationAngleThreshold >= 0, "rotation angle threshold must be positive");
+    EastOcrParameters parsedParameters;
+    const EastOcrParameters* parameters = get_parameters(customNodeLibraryInternalManager, params, paramsCount, parsedParameters);
+    NODE_ASSERT(parameters != nullptr, "parameters parsing failed");
+    const int originalImageHeight = parameters->originalImageHeight;
+    const int originalImageWidth = parameters->originalImageWidth;
+    const int targetImageHeight = parameters->targetImageHeight;
+    const int targetImageWidth = parameters->targetImageWidth;
+    const std::string& originalImageLayout = parameters->originalImageLayout;
+    const std::string& targetImageLayout = parameters->targetImageLayout;
+    const bool convertToGrayScale = parameters->convertToGrayScale;
+    const float confidenceThreshold = parameters->confidenceThreshold;
+    const float overlapThreshold = parameters->overlapThreshold;
+    const uint64_t maxOutputBatch = parameters->maxOutputBatch;
+    const bool debugMode = parameters->debugMode;
+    const float boxWidthAdjustment = parameters->boxWidthAdjustment;
+    const float boxHeightAdjustment = parameters->boxHeightAdjustment;
+    const int rotationAngleThreshold = parameters->rotationAngleThreshold;
 
     const CustomNodeTensor* imageTensor = nullptr;
     const CustomNodeTensor* scoresTensor = nullptr;
@@ -240,102 +299,116 @@ int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct Custo
     NODE_ASSERT((numRows * 4) == imageHeight, "image is not x4 larger than score/geometry data");
     NODE_ASSERT((numCols * 4) == imageWidth, "image is not x4 larger than score/geometry data");
 
+    const float* scoresData = (const float*)scoresTensor->data;
+    const float* geometryData = (const float*)geometryTensor->data;
+
+    // Select scores with sufficient probability first, so geometry is decoded only for candidate boxes
+    std::vector<uint32_t> candidates;
+    select_scores_above_threshold(scoresData, _numRows * _numCols, confidenceThreshold, candidates);
+
     std::vector<cv::Rect> rects;
     std::vector<float> scores;
     std::vector<BoxMetadata> metadata;
-
-    // Extract the scores (probabilities), followed by the geometrical data used to derive potential bounding box coordinates that surround text
-    for (int y = 0; y < numRows; y++) {
-        float* scoresData = (float*)scoresTensor->data + (y * numCols);
-        float* geometryData = (float*)geometryTensor->data + (y * numCols * 5);
-
-        for (int x = 0; x < numCols; x++) {
-            float score = scoresData[x];
-            // If our score does not have sufficient probability, ignore it
-            if (score < confidenceThreshold) {
-                continue;
-            }
-
-            if (debugMode)
-                std::cout << "Found confidence: " << scoresData[x] << std::endl;
-
-            // Compute the offset factor as our resulting feature maps will be 4x smaller than the input image
-            int offsetX = x * 4;
-            int offsetY = y * 4;
-
-            // Extract the rotation angle for the prediction and then compute the sin and cosine
-            int dataOffset = (x * 5);
-            float angle = geometryData[dataOffset + 4];
-
-            if (debugMode)
-                std::cout << "Angle: " << angle << std::endl;
-            float cos = std::cos(angle);
-            float sin = std::sin(angle);
-
-            // Use the geometry volume to derive the width and height of the bounding box
-            float h = geometryData[dataOffset + 0] + geometryData[dataOffset + 2];
-            float w = geometryData[dataOffset + 1] + geometryData[dataOffset + 3];
-
-            cv::Point2i p2{
-                offsetX + static_cast<int>(cos * geometryData[dataOffset + 1] + sin * geometryData[dataOffset + 2]),
-                offsetY + static_cast<int>(-sin * geometryData[dataOffset + 1] + cos * geometryData[dataOffset + 2])};
-            cv::Point2i p1{
-                static_cast<int>(-sin * h) + p2.x,
-                static_cast<int>(-cos * h) + p2.y};
-            cv::Point2i p3{
-                static_cast<int>(-cos * w) + p2.x,
-                static_cast<int>(sin * w) + p2.y};
-            cv::Point2i p4{
-                p3.x + p1.x - p2.x,
-                p3.y + p1.y - p2.y};
-
-            int x1 = std::min(std::min(std::min(p2.x, p1.x), p3.x), p4.x);
-            int x2 = std::max(std::max(std::max(p2.x, p1.x), p3.x), p4.x);
-            int y1 = std::min(std::min(std::min(p2.y, p1.y), p3.y), p4.y);
-            int y2 = std::max(std::max(std::max(p2.y, p1.y), p3.y), p4.y);
-
-            x1 = std::max(0, (int)(x1 - (x2 - x1) * boxWidthAdjustment));
-            x2 = std::min(originalImageWidth, (int)(x2 + (x2 - x1) * boxWidthAdjustment));
-            y1 = std::max(0, (int)(y1 - (y2 - y1) * boxHeightAdjustment));
-            y2 = std::min(originalImageHeight, (int)(y2 + (y2 - y1) * boxHeightAdjustment));
-
-            if (debugMode) {
-                std::stringstream ss;
-                ss << "Angled polygon coordinates: " << std::endl;
-                ss << p4 << p3 << p1 << p2 << std::endl;
-                ss << "Polygon bounding box with no rotation: " << std::endl;
-                ss << cv::Point2i(x1, y1) << cv::Point2i(x2, y2) << std::endl;
-                ss << "---------------------------" << std::endl;
-                std::cout << ss.str() << std::endl;
-            }
-
-            NODE_ASSERT(x2 > x1, "detected box width must be greater than 0");
-            NODE_ASSERT(y2 > y1, "detected box height must be greater than 0");
-
-            NODE_ASSERT(x2 > x1, "detected box width must be greater than 0");
-            NODE_ASSERT(y2 > y1, "detected box height must be greater than 0");
-
-            rects.emplace_back(x1, y1, x2 - x1, y2 - y1);
-            scores.emplace_back(score);
-            metadata.emplace_back(BoxMetadata{angle, w * (1.0f + boxWidthAdjustment), h * (1.0f + boxHeightAdjustment)});
+    DetectionBoxes boxes;
+    rects.reserve(candidates.size());
+    scores.reserve(candidates.size());
+    metadata.reserve(candidates.size());
+    boxes.reserve(candidates.size());
+
+    // Derive potential bounding box coordinates that surround text from the geometrical data of each candidate
+    for (uint32_t candidate : candidates) {
+        int y = static_cast<int>(candidate / numCols);
+        int x = static_cast<int>(candidate % numCols);
+        float score = scoresData[candidate];
+
+        if (debugMode)
+            std::cout << "Found confidence: " << score << std::endl;
+
+        // Compute the offset factor as our resulting feature maps will be 4x smaller than the input image
+        int offsetX = x * 4;
+        int offsetY = y * 4;
+
+        // Extract the rotation angle for the prediction and then compute the sin and cosine
+        int dataOffset = (candidate * 5);
+        float angle = geometryData[dataOffset + 4];
+
+        if (debugMode)
+            std::cout << "Angle: " << angle << std::endl;
+        float cos = std::cos(angle);
+        float sin = std::sin(angle);
+
+        // Use the geometry volume to derive the width and height of the bounding box
+        float h = geometryData[dataOffset + 0] + geometryData[dataOffset + 2];
+        float w = geometryData[dataOffset + 1] + geometryData[dataOffset + 3];
+
+        cv::Point2i p2{
+            offsetX + static_cast<int>(cos * geometryData[dataOffset + 1] + sin * geometryData[dataOffset + 2]),
+            offsetY + static_cast<int>(-sin * geometryData[dataOffset + 1] + cos * geometryData[dataOffset + 2])};
+        cv::Point2i p1{
+            static_cast<int>(-sin * h) + p2.x,
+            static_cast<int>(-cos * h) + p2.y};
+        cv::Point2i p3{
+            static_cast<int>(-cos * w) + p2.x,
+            static_cast<int>(sin * w) + p2.y};
+        cv::Point2i p4{
+            p3.x + p1.x - p2.x,
+            p3.y + p1.y - p2.y};
+
+        int x1 = std::min(std::min(std::min(p2.x, p1.x), p3.x), p4.x);
+        int x2 = std::max(std::max(std::max(p2.x, p1.x), p3.x), p4.x);
+        int y1 = std::min(std::min(std::min(p2.y, p1.y), p3.y), p4.y);
+        int y2 = std::max(std::max(std::max(p2.y, p1.y), p3.y), p4.y);
+
+        x1 = std::max(0, (int)(x1 - (x2 - x1) * boxWidthAdjustment));
+        x2 = std::min(originalImageWidth, (int)(x2 + (x2 - x1) * boxWidthAdjustment));
+        y1 = std::max(0, (int)(y1 - (y2 - y1) * boxHeightAdjustment));
+        y2 = std::min(originalImageHeight, (int)(y2 + (y2 - y1) * boxHeightAdjustment));
+
+        if (debugMode) {
+            std::stringstream ss;
+            ss << "Angled polygon coordinates: " << std::endl;
+            ss << p4 << p3 << p1 << p2 << std::endl;
+            ss << "Polygon bounding box with no rotation: " << std::endl;
+            ss << cv::Point2i(x1, y1) << cv::Point2i(x2, y2) << std::endl;
+            ss << "---------------------------" << std::endl;
+            std::cout << ss.str() << std::endl;
         }
+
+        NODE_ASSERT(x2 > x1, "detected box width must be greater than 0");
+        NODE_ASSERT(y2 > y1, "detected box height must be greater than 0");
+
+        NODE_ASSERT(x2 > x1, "detected box width must be greater than 0");
+        NODE_ASSERT(y2 > y1, "detected box height must be greater than 0");
+
+        rects.emplace_back(x1, y1, x2 - x1, y2 - y1);
+        scores.emplace_back(score);
+        boxes.add(x1, y1, x2, y2);
+        metadata.emplace_back(BoxMetadata{angle, w * (1.0f + boxWidthAdjustment), h * (1.0f + boxHeightAdjustment)});
     }
 
     if (debugMode)
         std::cout << "Total findings: " << rects.size() << std::endl;
 
+    std::vector<uint32_t> allBoxes(rects.size());
+    std::iota(allBoxes.begin(), allBoxes.end(), 0);
+    std::vector<uint32_t> keep;
+    nms(boxes, scores.data(), allBoxes, overlapThreshold, maxOutputBatch, keep);
+
     std::vector<cv::Rect> filteredBoxes;
     std::vector<float> filteredScores;
     std::vector<BoxMetadata> filteredMetadata;
-    nms2(rects, scores, metadata, filteredBoxes, filteredScores, filteredMetadata, overlapThreshold);
-    NODE_ASSERT(filteredBoxes.size() == filteredScores.size(), "filtered boxes and scores are not equal length");
-    if (filteredBoxes.size() > maxOutputBatch) {
-        filteredBoxes.resize(maxOutputBatch);
-        filteredScores.resize(maxOutputBatch);
+    filteredBoxes.reserve(keep.size());
+    filteredScores.reserve(keep.size());
+    filteredMetadata.reserve(keep.size());
+    for (uint32_t index : keep) {
+        filteredBoxes.emplace_back(rects[index]);
+        filteredScores.emplace_back(scores[index]);
+        filteredMetadata.emplace_back(metadata[index]);
     }
+    NODE_ASSERT(filteredBoxes.size() == filteredScores.size(), "filtered boxes and scores are not equal length");
 
     if (debugMode) {
-        std::cout << "Total findings after NMS2 (non max suppression) filter: " << filteredBoxes.size() << std::endl;
+        std::cout << "Total findings after NMS (non max suppression) filter: " << filteredBoxes.size() << std::endl;
     }
 
     *outputsCount = 3;
@@ -370,14 +443,12 @@ int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct Custo
 }
 
 int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    int originalImageHeight = get_int_parameter("original_image_height", params, paramsCount, -1);
-    int originalImageWidth = get_int_parameter("original_image_width", params, paramsCount, -1);
-    NODE_ASSERT(originalImageHeight > 0, "original image height must be larger than 0");
-    NODE_ASSERT(originalImageWidth > 0, "original image width must be larger than 0");
-    NODE_ASSERT((originalImageHeight % 4) == 0, "original image height must be divisible by 4");
-    NODE_ASSERT((originalImageWidth % 4) == 0, "original image width must be divisible by 4");
-    std::string originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(originalImageLayout == "NCHW" || originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
+    EastOcrParameters parsedParameters;
+    const EastOcrParameters* parameters = get_parameters(customNodeLibraryInternalManager, params, paramsCount, parsedParameters);
+    NODE_ASSERT(parameters != nullptr, "parameters parsing failed");
+    const int originalImageHeight = parameters->originalImageHeight;
+    const int originalImageWidth = parameters->originalImageWidth;
+    const std::string& originalImageLayout = parameters->originalImageLayout;
 
     *infoCount = 3;
     *info = (struct CustomNodeTensorInfo*)malloc(*infoCount * sizeof(struct CustomNodeTensorInfo));
@@ -422,13 +493,13 @@ int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const stru
 }
 
 int getOutputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    int targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(targetImageHeight > 0, "target image height must be larger than 0");
-    NODE_ASSERT(targetImageWidth > 0, "target image width must be larger than 0");
-    std::string targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(targetImageLayout == "NCHW" || targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
-    bool convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
+    EastOcrParameters parsedParameters;
+    const EastOcrParameters* parameters = get_parameters(customNodeLibraryInternalManager, params, paramsCount, parsedParameters);
+    NODE_ASSERT(parameters != nullptr, "parameters parsing failed");
+    const int targetImageHeight = parameters->targetImageHeight;
+    const int targetImageWidth = parameters->targetImageWidth;
+    const std::string& targetImageLayout = parameters->targetImageLayout;
+    const bool convertToGrayScale = parameters->convertToGrayScale;
 
     *infoCount = 3;
     *info = (struct CustomNodeTensorInfo*)malloc(*infoCount * sizeof(struct CustomNodeTensorInfo));
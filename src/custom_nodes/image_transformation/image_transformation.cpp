@@ -15,7 +15,9 @@
 //*****************************************************************************
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "../../custom_node_interface.h"
 #include "../common/opencv_utils.hpp"
@@ -24,37 +26,42 @@
 
 static constexpr const char* TENSOR_NAME = "image";
 
-int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount) {
-    return 0;
-}
-
-int deinitialize(void* customNodeLibraryInternalManager) {
-    return 0;
-}
-
-int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    // Parameters reading
+struct ImageTransformationParameters {
+    int targetImageHeight = -1;
+    int targetImageWidth = -1;
+    std::string originalImageColorOrder;
+    std::string targetImageColorOrder;
+    uint64_t targetImageColorChannels = 3;
+    std::string originalImageLayout;
+    std::string targetImageLayout;
+    bool isScaleDefined = false;
+    float scale = -1;
+    std::vector<float> scaleValues;
+    std::vector<float> meanValues;
+    bool debugMode = false;
+};
 
+int parse_parameters(const struct CustomNodeParam* params, int paramsCount, ImageTransformationParameters& parameters) {
     // Image size.
     //
     // If not specified (-1), the image will not be resized.
     // When specified, cv::resize is used to resize an image.
     // Original image size must not specified, input size is dynamic.
-    int _targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int _targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(_targetImageHeight > 0 || _targetImageHeight == -1, "target image height - when specified, must be larger than 0");
-    NODE_ASSERT(_targetImageWidth > 0 || _targetImageWidth == -1, "target image width - when specified, must be larger than 0");
+    parameters.targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
+    parameters.targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
+    NODE_ASSERT(parameters.targetImageHeight > 0 || parameters.targetImageHeight == -1, "target image height - when specified, must be larger than 0");
+    NODE_ASSERT(parameters.targetImageWidth > 0 || parameters.targetImageWidth == -1, "target image width - when specified, must be larger than 0");
 
     // Color order.
     //
     // Possible orders: BGR (default), RGB and GRAY.
     // Depending on the order, number of color channels will be selected - 3 for BGR/RGB and 1 for GRAY.
-    std::string originalImageColorOrder = get_string_parameter("original_image_color_order", params, paramsCount, "BGR");
-    std::string targetImageColorOrder = get_string_parameter("target_image_color_order", params, paramsCount);
-    targetImageColorOrder = targetImageColorOrder.empty() ? originalImageColorOrder : targetImageColorOrder;
-    NODE_ASSERT(originalImageColorOrder == "BGR" || originalImageColorOrder == "RGB" || originalImageColorOrder == "GRAY", "original image layout must be BGR, RGB or GRAY");
-    NODE_ASSERT(targetImageColorOrder == "BGR" || targetImageColorOrder == "RGB" || targetImageColorOrder == "GRAY", "target image layout must be BGR, RGB or GRAY");
-    uint64_t targetImageColorChannels = targetImageColorOrder == "GRAY" ? 1 : 3;
+    parameters.originalImageColorOrder = get_string_parameter("original_image_color_order", params, paramsCount, "BGR");
+    parameters.targetImageColorOrder = get_string_parameter("target_image_color_order", params, paramsCount);
+    parameters.targetImageColorOrder = parameters.targetImageColorOrder.empty() ? parameters.originalImageColorOrder : parameters.targetImageColorOrder;
+    NODE_ASSERT(parameters.originalImageColorOrder == "BGR" || parameters.originalImageColorOrder == "RGB" || parameters.originalImageColorOrder == "GRAY", "original image layout must be BGR, RGB or GRAY");
+    NODE_ASSERT(parameters.targetImageColorOrder == "BGR" || parameters.targetImageColorOrder == "RGB" || parameters.targetImageColorOrder == "GRAY", "target image layout must be BGR, RGB or GRAY");
+    parameters.targetImageColorChannels = parameters.targetImageColorOrder == "GRAY" ? 1 : 3;
 
     // Image layout.
     //
@@ -62,24 +69,23 @@ int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct Custo
     // Since OpenCV is used for transformations, image will be converted to cv::Mat.
     // The container requires the data in NHWC format, so selecting input layout NCHW will convert data to NHWC, therefore decrease performance.
     // Selecting target layout NCHW will also perform conversion before copying data into output.
-    std::string originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount);
-    std::string targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount);
-    targetImageLayout = targetImageLayout.empty() ? originalImageLayout : targetImageLayout;
-    NODE_ASSERT(originalImageLayout == "NCHW" || originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
-    NODE_ASSERT(targetImageLayout == "NCHW" || targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
+    parameters.originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount);
+    parameters.targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount);
+    parameters.targetImageLayout = parameters.targetImageLayout.empty() ? parameters.originalImageLayout : parameters.targetImageLayout;
+    NODE_ASSERT(parameters.originalImageLayout == "NCHW" || parameters.originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
+    NODE_ASSERT(parameters.targetImageLayout == "NCHW" || parameters.targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
 
     // Scale.
     //
     // When specified, all pixel values will be divided by this value.
-    bool isScaleDefined = false;
-    float scale = get_float_parameter("scale", params, paramsCount, isScaleDefined, -1);
-    NODE_ASSERT(scale != 0, "cannot divide by scale equal to 0");
+    parameters.scale = get_float_parameter("scale", params, paramsCount, parameters.isScaleDefined, -1);
+    NODE_ASSERT(parameters.scale != 0, "cannot divide by scale equal to 0");
 
     // Scale values.
     //
     // Smilar to scale but scale value should be provided per color channel.
-    std::vector<float> scaleValues = get_float_list_parameter("scale_values", params, paramsCount);
-    for (auto scale : scaleValues) {
+    parameters.scaleValues = get_float_list_parameter("scale_values", params, paramsCount);
+    for (auto scale : parameters.scaleValues) {
         NODE_ASSERT(scale != 0, "cannot divide by scale equal to 0");
     }
 
@@ -88,10 +94,53 @@ int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct Custo
     // If not specified, the image will not be scaled.
     // When specified, all pixel values will be substracted by this value per channel.
     // The exact meaning and order of channels depend on input image.
-    std::vector<float> meanValues = get_float_list_parameter("mean_values", params, paramsCount);
+    parameters.meanValues = get_float_list_parameter("mean_values", params, paramsCount);
 
     // Debug flag for additional logging.
-    bool debugMode = get_string_parameter("debug", params, paramsCount) == "true";
+    parameters.debugMode = get_string_parameter("debug", params, paramsCount) == "true";
+    return 0;
+}
+
+// Returns parameters parsed once in initialize() or, when the library is used without it, parses them into fallback.
+const ImageTransformationParameters* get_parameters(void* customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount, ImageTransformationParameters& fallback) {
+    if (customNodeLibraryInternalManager != nullptr) {
+        return static_cast<const ImageTransformationParameters*>(customNodeLibraryInternalManager);
+    }
+    if (parse_parameters(params, paramsCount, fallback) != 0) {
+        return nullptr;
+    }
+    return &fallback;
+}
+
+int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount) {
+    // Parameters are parsed and validated once per pipeline definition load and reused by each execute() call.
+    auto parameters = std::make_unique<ImageTransformationParameters>();
+    NODE_ASSERT(parse_parameters(params, paramsCount, *parameters) == 0, "parameters parsing failed");
+    *customNodeLibraryInternalManager = parameters.release();
+    return 0;
+}
+
+int deinitialize(void* customNodeLibraryInternalManager) {
+    delete static_cast<ImageTransformationParameters*>(customNodeLibraryInternalManager);
+    return 0;
+}
+
+int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
+    ImageTransformationParameters parsedParameters;
+    const ImageTransformationParameters* parameters = get_parameters(customNodeLibraryInternalManager, params, paramsCount, parsedParameters);
+    NODE_ASSERT(parameters != nullptr, "parameters parsing failed");
+    const int _targetImageHeight = parameters->targetImageHeight;
+    const int _targetImageWidth = parameters->targetImageWidth;
+    const std::string& originalImageColorOrder = parameters->originalImageColorOrder;
+    const std::string& targetImageColorOrder = parameters->targetImageColorOrder;
+    const uint64_t targetImageColorChannels = parameters->targetImageColorChannels;
+    const std::string& originalImageLayout = parameters->originalImageLayout;
+    const std::string& targetImageLayout = parameters->targetImageLayout;
+    const bool isScaleDefined = parameters->isScaleDefined;
+    const float scale = parameters->scale;
+    const std::vector<float>& scaleValues = parameters->scaleValues;
+    const std::vector<float>& meanValues = parameters->meanValues;
+    const bool debugMode = parameters->debugMode;
 
     // ------------ validation start -------------
     NODE_ASSERT(inputsCount == 1, "there must be exactly one input");
@@ -262,23 +311,13 @@ int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const stru
 }
 
 int getOutputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    // Parameters reading
-    int targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(targetImageHeight > 0 || targetImageHeight == -1, "target image height - when specified, must be larger than 0");
-    NODE_ASSERT(targetImageWidth > 0 || targetImageWidth == -1, "target image width - when specified, must be larger than 0");
-
-    std::string originalImageColorOrder = get_string_parameter("original_image_color_order", params, paramsCount);
-    std::string targetImageColorOrder = get_string_parameter("target_image_color_order", params, paramsCount);
-    targetImageColorOrder = targetImageColorOrder.empty() ? originalImageColorOrder : targetImageColorOrder;
-    NODE_ASSERT(originalImageColorOrder == "BGR" || originalImageColorOrder == "RGB" || originalImageColorOrder == "GRAY", "original image layout must be BGR, RGB or GRAY");
-    NODE_ASSERT(targetImageColorOrder == "BGR" || targetImageColorOrder == "RGB" || targetImageColorOrder == "GRAY", "target image layout must be BGR, RGB or GRAY");
-
-    std::string originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount);
-    std::string targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount);
-    targetImageLayout = targetImageLayout.empty() ? originalImageLayout : targetImageLayout;
-    NODE_ASSERT(originalImageLayout == "NCHW" || originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
-    NODE_ASSERT(targetImageLayout == "NCHW" || targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
+    ImageTransformationParameters parsedParameters;
+    const ImageTransformationParameters* parameters = get_parameters(customNodeLibraryInternalManager, params, paramsCount, parsedParameters);
+    NODE_ASSERT(parameters != nullptr, "parameters parsing failed");
+    const int targetImageHeight = parameters->targetImageHeight;
+    const int targetImageWidth = parameters->targetImageWidth;
+    const std::string& targetImageColorOrder = parameters->targetImageColorOrder;
+    const std::string& targetImageLayout = parameters->targetImageLayout;
 
     *infoCount = 1;
     *info = (struct CustomNodeTensorInfo*)malloc(*infoCount * sizeof(struct CustomNodeTensorInfo));
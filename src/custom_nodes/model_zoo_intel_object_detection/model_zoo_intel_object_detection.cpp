@@ -14,17 +14,23 @@
 // limitations under the License.
 //*****************************************************************************
 #include <iostream>
+#include <memory>
+#include <numeric>
 #include <shared_mutex>
 #include <string>
 #include <vector>
 
 #include "../../custom_node_interface.h"
 #include "../common/custom_node_library_internal_manager.hpp"
+#include "../common/detection_postprocessing.hpp"
 #include "../common/opencv_utils.hpp"
 #include "../common/utils.hpp"
 #include "opencv2/opencv.hpp"
 
 using CustomNodeLibraryInternalManager = ovms::custom_nodes_common::CustomNodeLibraryInternalManager;
+using ovms::custom_nodes_common::DetectionBoxes;
+using ovms::custom_nodes_common::multiclass_nms;
+using ovms::custom_nodes_common::select_strided_scores_above_threshold;
 
 static constexpr const char* INPUT_IMAGE_TENSOR_NAME = "image";
 static constexpr const char* INPUT_DETECTION_TENSOR_NAME = "detection";
@@ -172,21 +178,75 @@ bool copy_label_ids_into_output(struct CustomNodeTensor* output, const std::vect
     return true;
 }
 
+struct ModelZooIntelObjectDetectionParameters {
+    int originalImageHeight = -1;
+    int originalImageWidth = -1;
+    int targetImageHeight = -1;
+    int targetImageWidth = -1;
+    std::string originalImageLayout;
+    std::string targetImageLayout;
+    bool convertToGrayScale = false;
+    float confidenceThreshold = -1.0;
+    float overlapThreshold = -1.0;
+    uint64_t maxOutputBatch = 100;
+    int filterLabelId = -1;
+    bool debugMode = false;
+    int queueSize = 24;
+};
+
+// Holds parameters parsed once in initialize() next to the output buffers, so execute() and metadata calls do not parse them again.
+class InternalManager : public CustomNodeLibraryInternalManager {
+    ModelZooIntelObjectDetectionParameters parameters;
+
+public:
+    const ModelZooIntelObjectDetectionParameters& getParameters() const {
+        return this->parameters;
+    }
+    ModelZooIntelObjectDetectionParameters& getParameters() {
+        return this->parameters;
+    }
+};
+
+int parse_parameters(const struct CustomNodeParam* params, int paramsCount, ModelZooIntelObjectDetectionParameters& parameters) {
+    parameters.originalImageHeight = get_int_parameter("original_image_height", params, paramsCount, -1);
+    parameters.originalImageWidth = get_int_parameter("original_image_width", params, paramsCount, -1);
+    NODE_ASSERT(parameters.originalImageHeight > 0, "original image height must be larger than 0");
+    NODE_ASSERT(parameters.originalImageWidth > 0, "original image width must be larger than 0");
+    parameters.targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
+    parameters.targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
+    NODE_ASSERT(parameters.targetImageHeight > 0, "target image height must be larger than 0");
+    NODE_ASSERT(parameters.targetImageWidth > 0, "target image width must be larger than 0");
+    parameters.originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount, "NCHW");
+    NODE_ASSERT(parameters.originalImageLayout == "NCHW" || parameters.originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
+    parameters.targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount, "NCHW");
+    NODE_ASSERT(parameters.targetImageLayout == "NCHW" || parameters.targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
+    parameters.convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
+    parameters.confidenceThreshold = get_float_parameter("confidence_threshold", params, paramsCount, -1.0);
+    NODE_ASSERT(parameters.confidenceThreshold >= 0 && parameters.confidenceThreshold <= 1.0, "confidence threshold must be in 0-1 range");
+    parameters.overlapThreshold = get_float_parameter("overlap_threshold", params, paramsCount, -1.0);
+    NODE_ASSERT(parameters.overlapThreshold == -1.0 || (parameters.overlapThreshold >= 0 && parameters.overlapThreshold <= 1.0), "non max suppression filtering overlap threshold - when specified, must be in 0-1 range");
+    parameters.maxOutputBatch = get_int_parameter("max_output_batch", params, paramsCount, 100);
+    NODE_ASSERT(parameters.maxOutputBatch > 0, "max output batch must be larger than 0");
+    parameters.filterLabelId = get_int_parameter("filter_label_id", params, paramsCount, -1);
+    parameters.debugMode = get_string_parameter("debug", params, paramsCount) == "true";
+    parameters.queueSize = get_int_parameter("buffer_queue_size", params, paramsCount, 24);
+    NODE_ASSERT(parameters.queueSize > 0, "buffer queue size must be larger than 0");
+    return 0;
+}
+
 int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount) {
     // creating InternalManager instance
-    std::unique_ptr<CustomNodeLibraryInternalManager> internalManager = std::make_unique<CustomNodeLibraryInternalManager>();
+    std::unique_ptr<InternalManager> internalManager = std::make_unique<InternalManager>();
     NODE_ASSERT(internalManager != nullptr, "internalManager allocation failed");
 
-    // reading parameters to determine size of pre-allocated buffers
-    uint64_t maxOutputBatch = get_int_parameter("max_output_batch", params, paramsCount, 100);
-    NODE_ASSERT(maxOutputBatch > 0, "max output batch must be larger than 0");
-    bool convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
-    int targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(targetImageHeight > 0, "target image height must be larger than 0");
-    NODE_ASSERT(targetImageWidth > 0, "target image width must be larger than 0");
-    const int queueSize = get_int_parameter("buffer_queue_size", params, paramsCount, 24);
-    NODE_ASSERT(queueSize > 0, "buffer queue size must be larger than 0");
+    // parameters are parsed once per pipeline definition load and reused by execute and metadata calls
+    NODE_ASSERT(parse_parameters(params, paramsCount, internalManager->getParameters()) == 0, "parameters parsing failed");
+    const ModelZooIntelObjectDetectionParameters& parameters = internalManager->getParameters();
+    const uint64_t maxOutputBatch = parameters.maxOutputBatch;
+    const bool convertToGrayScale = parameters.convertToGrayScale;
+    const int targetImageHeight = parameters.targetImageHeight;
+    const int targetImageWidth = parameters.targetImageWidth;
+    const int queueSize = parameters.queueSize;
 
     // creating BuffersQueues for output tensor
     NODE_ASSERT(internalManager->createBuffersQueue(OUTPUT_TENSOR_NAME, 4 * sizeof(CustomNodeTensor), queueSize), "buffer creation failed");
@@ -233,33 +293,28 @@ int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeP
 int deinitialize(void* customNodeLibraryInternalManager) {
     // deallocate InternalManager and its contents
     if (customNodeLibraryInternalManager != nullptr) {
-        CustomNodeLibraryInternalManager* internalManager = static_cast<CustomNodeLibraryInternalManager*>(customNodeLibraryInternalManager);
+        InternalManager* internalManager = static_cast<InternalManager*>(customNodeLibraryInternalManager);
         delete internalManager;
     }
     return 0;
 }
 
 int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    // Parameters reading
-    int originalImageHeight = get_int_parameter("original_image_height", params, paramsCount, -1);
-    int originalImageWidth = get_int_parameter("original_image_width", params, paramsCount, -1);
-    NODE_ASSERT(originalImageHeight > 0, "original image height must be larger than 0");
-    NODE_ASSERT(originalImageWidth > 0, "original image width must be larger than 0");
-    int targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(targetImageHeight > 0, "target image height must be larger than 0");
-    NODE_ASSERT(targetImageWidth > 0, "target image width must be larger than 0");
-    std::string originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(originalImageLayout == "NCHW" || originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
-    std::string targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(targetImageLayout == "NCHW" || targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
-    bool convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
-    float confidenceThreshold = get_float_parameter("confidence_threshold", params, paramsCount, -1.0);
-    NODE_ASSERT(confidenceThreshold >= 0 && confidenceThreshold <= 1.0, "confidence threshold must be in 0-1 range");
-    uint64_t maxOutputBatch = get_int_parameter("max_output_batch", params, paramsCount, 100);
-    NODE_ASSERT(maxOutputBatch > 0, "max output batch must be larger than 0");
-    int filterLabelId = get_int_parameter("filter_label_id", params, paramsCount, -1);
-    bool debugMode = get_string_parameter("debug", params, paramsCount) == "true";
+    const InternalManager* parametersManager = static_cast<const InternalManager*>(customNodeLibraryInternalManager);
+    NODE_ASSERT(parametersManager != nullptr, "internalManager is not initialized");
+    const ModelZooIntelObjectDetectionParameters& parameters = parametersManager->getParameters();
+    const int originalImageHeight = parameters.originalImageHeight;
+    const int originalImageWidth = parameters.originalImageWidth;
+    const int targetImageHeight = parameters.targetImageHeight;
+    const int targetImageWidth = parameters.targetImageWidth;
+    const std::string& originalImageLayout = parameters.originalImageLayout;
+    const std::string& targetImageLayout = parameters.targetImageLayout;
+    const bool convertToGrayScale = parameters.convertToGrayScale;
+    const float confidenceThreshold = parameters.confidenceThreshold;
+    const float overlapThreshold = parameters.overlapThreshold;
+    const uint64_t maxOutputBatch = parameters.maxOutputBatch;
+    const int filterLabelId = parameters.filterLabelId;
+    const bool debugMode = parameters.debugMode;
 
     const CustomNodeTensor* imageTensor = nullptr;
     const CustomNodeTensor* detectionTensor = nullptr;
@@ -317,35 +372,76 @@ int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct Custo
     uint64_t detectionsCount = detectionTensor->dims[2];
     uint64_t featuresCount = detectionTensor->dims[3];
 
+    const float* detectionsData = (const float*)detectionTensor->data;
+
+    // Select detections with sufficient confidence first, the remaining fields are read only for candidates
+    std::vector<uint32_t> candidates;
+    select_strided_scores_above_threshold(detectionsData + 2, detectionsCount, featuresCount, confidenceThreshold, candidates);
+
+    std::vector<uint32_t> selected;
+    std::vector<float> selectedConfidences;
+    std::vector<int> selectedLabelIds;
+    DetectionBoxes selectedBoxes;
+    selected.reserve(candidates.size());
+    selectedConfidences.reserve(candidates.size());
+    selectedLabelIds.reserve(candidates.size());
+    selectedBoxes.reserve(candidates.size());
+    for (uint32_t candidate : candidates) {
+        const float* detection = detectionsData + (candidate * featuresCount);
+        int imageId = static_cast<int>(detection[0]);
+        int labelId = static_cast<int>(detection[1]);
+        if (imageId != 0) {
+            continue;
+        }
+        if (filterLabelId != -1 && filterLabelId != labelId) {
+            if (debugMode) {
+                std::cout << "Skipping label ID: " << labelId << std::endl;
+            }
+            continue;
+        }
+        selected.emplace_back(candidate);
+        selectedConfidences.emplace_back(detection[2]);
+        selectedLabelIds.emplace_back(labelId);
+        selectedBoxes.add(detection[3], detection[4], detection[5], detection[6]);
+    }
+
+    // Positions in selected vector of detections returned by the node
+    std::vector<uint32_t> keep(selected.size());
+    std::iota(keep.begin(), keep.end(), 0);
+    // Optional class aware suppression of overlapping detections, keeps detections with highest confidence first
+    if (overlapThreshold >= 0) {
+        std::vector<uint32_t> nmsCandidates = std::move(keep);
+        keep.clear();
+        multiclass_nms(selectedBoxes, selectedConfidences.data(), selectedLabelIds.data(), nmsCandidates, overlapThreshold, maxOutputBatch, keep);
+        if (debugMode) {
+            std::cout << "Total detections after NMS (non max suppression) filter: " << keep.size() << " out of: " << selected.size() << std::endl;
+        }
+    }
+
     std::vector<cv::Rect> boxes;
     std::vector<cv::Vec4f> detections;
     std::vector<float> confidences;
     std::vector<int> labelIds;
-
-    for (uint64_t i = 0; i < detectionsCount; i++) {
-        float* detection = (float*)(detectionTensor->data + (i * featuresCount * sizeof(float)));
-        int imageId = static_cast<int>(detection[0]);
-        int labelId = static_cast<int>(detection[1]);
-        float confidence = detection[2];
+    boxes.reserve(keep.size());
+    detections.reserve(keep.size());
+    confidences.reserve(keep.size());
+    labelIds.reserve(keep.size());
+
+    for (uint32_t position : keep) {
+        const float* detection = detectionsData + (selected[position] * featuresCount);
+        int labelId = selectedLabelIds[position];
+        float confidence = selectedConfidences[position];
         int xMin = static_cast<int>(detection[3] * imageWidth);
         int yMin = static_cast<int>(detection[4] * imageHeight);
         int xMax = static_cast<int>(detection[5] * imageWidth);
         int yMax = static_cast<int>(detection[6] * imageHeight);
-        if (imageId == 0 && confidence >= confidenceThreshold) {
-            if (filterLabelId != -1 && filterLabelId != labelId) {
-                if (debugMode) {
-                    std::cout << "Skipping label ID: " << labelId << std::endl;
-                }
-                continue;
-            }
-            auto box = cv::Rect(cv::Point(xMin, yMin), cv::Point(xMax, yMax));
-            boxes.emplace_back(box);
-            detections.emplace_back(detection[3], detection[4], detection[5], detection[6]);
-            confidences.emplace_back(confidence);
-            labelIds.emplace_back(labelId);
-            if (debugMode) {
-                std::cout << "Detection:\nImageID: " << imageId << "; LabelID:" << labelId << "; Confidence:" << confidence << "; Box:" << box << std::endl;
-            }
+        auto box = cv::Rect(cv::Point(xMin, yMin), cv::Point(xMax, yMax));
+        boxes.emplace_back(box);
+        detections.emplace_back(detection[3], detection[4], detection[5], detection[6]);
+        confidences.emplace_back(confidence);
+        labelIds.emplace_back(labelId);
+        if (debugMode) {
+            std::cout << "Detection:\nImageID: 0; LabelID:" << labelId << "; Confidence:" << confidence << "; Box:" << box << std::endl;
         }
     }
 
@@ -401,15 +497,13 @@ int execute(const struct CustomNodeTensor* inputs, int inputsCount, struct Custo
 }
 
 int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    int originalImageHeight = get_int_parameter("original_image_height", params, paramsCount, -1);
-    int originalImageWidth = get_int_parameter("original_image_width", params, paramsCount, -1);
-    NODE_ASSERT(originalImageHeight > 0, "original image height must be larger than 0");
-    NODE_ASSERT(originalImageWidth > 0, "original image width must be larger than 0");
-    std::string originalImageLayout = get_string_parameter("original_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(originalImageLayout == "NCHW" || originalImageLayout == "NHWC", "original image layout must be NCHW or NHWC");
-
-    CustomNodeLibraryInternalManager* internalManager = static_cast<CustomNodeLibraryInternalManager*>(customNodeLibraryInternalManager);
+    InternalManager* internalManager = static_cast<InternalManager*>(customNodeLibraryInternalManager);
+    NODE_ASSERT(internalManager != nullptr, "internalManager is not initialized");
     std::shared_lock lock(internalManager->getInternalManagerLock());
+    const ModelZooIntelObjectDetectionParameters& parameters = internalManager->getParameters();
+    const int originalImageHeight = parameters.originalImageHeight;
+    const int originalImageWidth = parameters.originalImageWidth;
+    const std::string& originalImageLayout = parameters.originalImageLayout;
 
     *infoCount = 2;
     if (!get_buffer<struct CustomNodeTensorInfo>(internalManager, info, INPUT_TENSOR_INFO_NAME, *infoCount * sizeof(CustomNodeTensorInfo))) {
@@ -450,16 +544,14 @@ int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const stru
 }
 
 int getOutputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
-    int targetImageHeight = get_int_parameter("target_image_height", params, paramsCount, -1);
-    int targetImageWidth = get_int_parameter("target_image_width", params, paramsCount, -1);
-    NODE_ASSERT(targetImageHeight > 0, "target image height must be larger than 0");
-    NODE_ASSERT(targetImageWidth > 0, "target image width must be larger than 0");
-    std::string targetImageLayout = get_string_parameter("target_image_layout", params, paramsCount, "NCHW");
-    NODE_ASSERT(targetImageLayout == "NCHW" || targetImageLayout == "NHWC", "target image layout must be NCHW or NHWC");
-    bool convertToGrayScale = get_string_parameter("convert_to_gray_scale", params, paramsCount) == "true";
-
-    CustomNodeLibraryInternalManager* internalManager = static_cast<CustomNodeLibraryInternalManager*>(customNodeLibraryInternalManager);
+    InternalManager* internalManager = static_cast<InternalManager*>(customNodeLibraryInternalManager);
+    NODE_ASSERT(internalManager != nullptr, "internalManager is not initialized");
     std::shared_lock lock(internalManager->getInternalManagerLock());
+    const ModelZooIntelObjectDetectionParameters& parameters = internalManager->getParameters();
+    const int targetImageHeight = parameters.targetImageHeight;
+    const int targetImageWidth = parameters.targetImageWidth;
+    const std::string& targetImageLayout = parameters.targetImageLayout;
+    const bool convertToGrayScale = parameters.convertToGrayScale;
 
     *infoCount = 4;
     if (!get_buffer<struct CustomNodeTensorInfo>(internalManager, info, OUTPUT_TENSOR_INFO_NAME, *infoCount * sizeof(CustomNodeTensorInfo))) {
@@ -15,7 +15,11 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace ovms {
@@ -30,6 +34,17 @@ enum class CustomLoaderStatus {
     INTERNAL_ERROR     /*!< generic error */
 };
 
+/**
+     * @brief Model or weights buffer returned by custom loader.
+     * Data is not copied by OVMS, it has to stay valid for as long as owner is alive.
+     * Owner may be e.g. a memory mapping, a buffer cached by the loader or just the data itself.
+     */
+struct CustomLoaderBuffer {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    std::shared_ptr<const void> owner;
+};
+
 /**
      * @brief This class is the custom loader interface base class.
      * Custom Loader implementation shall derive from this base calss
@@ -109,6 +124,39 @@ public:
          *
          */
     virtual CustomLoaderStatus loaderDeInit() = 0;
+
+    /**
+         * @brief Load the model by the custom loader without copying its buffers
+         *
+         * Loaders able to return borrowed or memory mapped buffers should override it.
+         * By default it calls loadModel and takes over returned vectors.
+         * Declared after other virtual functions to keep the vtable layout of already built loaders.
+         *
+         * @param model name required to be loaded - defined under model config in the config file
+         * @param base path where the required model files are present
+         * @param version of the model
+         * @param loader config parameters json as string
+         * @param model buffer
+         * @param weights buffer
+         * @return status (On success, the return value will specify the type of model (IR,ONNX,BLOB) read into buffers)
+         */
+    virtual CustomLoaderStatus loadModelBuffers(const std::string& modelName,
+        const std::string& basePath,
+        const int version,
+        const std::string& loaderOptions,
+        CustomLoaderBuffer& modelBuffer,
+        CustomLoaderBuffer& weights) {
+        auto modelVector = std::make_shared<std::vector<uint8_t>>();
+        auto weightsVector = std::make_shared<std::vector<uint8_t>>();
+        CustomLoaderStatus status = loadModel(modelName, basePath, version, loaderOptions, *modelVector, *weightsVector);
+        modelBuffer.data = modelVector->data();
+        modelBuffer.size = modelVector->size();
+        modelBuffer.owner = std::move(modelVector);
+        weights.data = weightsVector->data();
+        weights.size = weightsVector->size();
+        weights.owner = std::move(weightsVector);
+        return status;
+    }
 };
 
 // the types of the class factories
@@ -16,6 +16,9 @@
 #include "deserialization.hpp"
 
 #include "buffer.hpp"
+#include "capi_frontend/capi_utils.hpp"
+#include "kfs_frontend/kfs_utils.hpp"
+#include "shared_memory_manager.hpp"
 
 namespace ovms {
 
@@ -43,12 +46,18 @@ Status InputSink<ov::InferRequest&>::give(const std::string& name, ov::Tensor& t
 ov::Tensor makeTensor(const InferenceTensor& requestInput,
     const std::shared_ptr<TensorInfo>& tensorInfo) {
     OVMS_PROFILE_FUNCTION();
+    ov::element::Type_t precision = tensorInfo->getOvPrecision();
+    ov::Tensor tensor = requestInput.getSharedTensor(precision);
+    if (tensor) {
+        return tensor;
+    }
     ov::Shape shape;
     for (const auto& dim : requestInput.getShape()) {
         shape.push_back(dim);
     }
-    ov::element::Type_t precision = tensorInfo->getOvPrecision();
-    return ov::Tensor(precision, shape, const_cast<void*>(reinterpret_cast<const void*>(requestInput.getBuffer()->data())));
+    tensor = ov::Tensor(precision, shape, const_cast<void*>(reinterpret_cast<const void*>(requestInput.getBuffer()->data())));
+    requestInput.setSharedTensor(tensor);
+    return tensor;
 }
 
 ov::Tensor makeTensor(const tensorflow::TensorProto& requestInput,
@@ -86,4 +95,101 @@ ov::Tensor makeTensor(const ::KFSRequest::InferInputTensor& requestInput,
     return tensor;
 }
 
+Status makeSharedMemoryTensor(const ::KFSRequest::InferInputTensor& requestInput,
+    const std::shared_ptr<TensorInfo>& tensorInfo,
+    ov::Tensor& tensor,
+    bool& isSharedMemoryUsed) {
+    OVMS_PROFILE_FUNCTION();
+    SharedMemoryReference reference;
+    auto status = getSharedMemoryReference(requestInput.parameters(), reference, isSharedMemoryUsed);
+    if (!status.ok() || !isSharedMemoryUsed) {
+        return status;
+    }
+    const SharedMemoryManager* manager = SharedMemoryScope::current();
+    if (manager == nullptr) {
+        return StatusCode::SHARED_MEMORY_DISABLED;
+    }
+    ov::Shape shape;
+    for (int i = 0; i < requestInput.shape_size(); i++) {
+        shape.push_back(requestInput.shape().at(i));
+    }
+    return manager->createTensor(reference, tensorInfo->getOvPrecision(), shape, tensor);
+}
+
+OutputBuffersBinding::~OutputBuffersBinding() {
+    this->restore();
+}
+
+Status OutputBuffersBinding::bind(const InferenceRequest& request, const tensor_map_t& outputsInfo, ov::InferRequest& inferRequest) {
+    OVMS_PROFILE_FUNCTION();
+    if (request.getOutputsSize() == 0) {
+        return StatusCode::OK;
+    }
+    this->inferRequest = &inferRequest;
+    size_t matchedOutputs = 0;
+    for (const auto& [name, outputInfo] : outputsInfo) {
+        const InferenceTensor* requestOutput{nullptr};
+        if (!request.getOutput(outputInfo->getMappedName().c_str(), &requestOutput).ok()) {
+            continue;
+        }
+        ++matchedOutputs;
+        const Buffer* buffer = requestOutput->getBuffer();
+        if (buffer == nullptr) {
+            // output without buffer is allocated by the server
+            continue;
+        }
+        if (buffer->getBufferType() != OVMS_BUFFERTYPE_CPU || (buffer->getDeviceId().has_value() && buffer->getDeviceId().value() != 0)) {
+            return Status(StatusCode::INVALID_BUFFER_TYPE, "Required output: " + outputInfo->getMappedName());
+        }
+        if (requestOutput->getDataType() != getPrecisionAsOVMSDataType(outputInfo->getPrecision())) {
+            return Status(StatusCode::INVALID_PRECISION, "Required output: " + outputInfo->getMappedName());
+        }
+        ov::Shape shape(requestOutput->getShape().begin(), requestOutput->getShape().end());
+        if (!outputInfo->getShape().match(shape)) {
+            return Status(StatusCode::INVALID_SHAPE, "Required output: " + outputInfo->getMappedName());
+        }
+        ov::element::Type precision = outputInfo->getOvPrecision();
+        if (ov::shape_size(shape) * precision.size() != buffer->getByteSize()) {
+            return Status(StatusCode::INVALID_CONTENT_SIZE, "Required output: " + outputInfo->getMappedName());
+        }
+        ov::Tensor original;
+        try {
+            original = inferRequest.get_tensor(outputInfo->getName());
+        } catch (const ov::Exception& e) {
+            SPDLOG_DEBUG("Output: {} is allocated by the server, could not get its tensor: {}", outputInfo->getMappedName(), e.what());
+        }
+        if (!original) {
+            // tensor which cannot be restored after inference is never replaced
+            continue;
+        }
+        try {
+            inferRequest.set_tensor(outputInfo->getName(), ov::Tensor(precision, shape, const_cast<void*>(buffer->data())));
+            this->originalTensors.emplace_back(outputInfo->getName(), std::move(original));
+        } catch (const ov::Exception& e) {
+            Status status = StatusCode::OV_INTERNAL_DESERIALIZATION_ERROR;
+            SPDLOG_DEBUG("{}: {}", status.string(), e.what());
+            return status;
+        }
+    }
+    if (matchedOutputs != request.getOutputsSize()) {
+        return StatusCode::INVALID_UNEXPECTED_OUTPUT;
+    }
+    return StatusCode::OK;
+}
+
+void OutputBuffersBinding::restore() {
+    if (this->inferRequest == nullptr) {
+        return;
+    }
+    for (auto& [name, tensor] : this->originalTensors) {
+        try {
+            this->inferRequest->set_tensor(name, tensor);
+        } catch (const ov::Exception& e) {
+            SPDLOG_ERROR("Could not restore output tensor: {}; {}", name, e.what());
+        }
+    }
+    this->originalTensors.clear();
+    this->inferRequest = nullptr;
+}
+
 }  // namespace ovms
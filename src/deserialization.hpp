@@ -17,6 +17,8 @@
 
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <openvino/openvino.hpp>
 #include <spdlog/spdlog.h>
@@ -32,6 +34,7 @@
 #include "binaryutils.hpp"
 #include "inferencerequest.hpp"
 #include "inferencetensor.hpp"
+#include "input_plan.hpp"
 #include "profiler.hpp"
 #include "status.hpp"
 #include "tensorinfo.hpp"
@@ -47,9 +50,38 @@ ov::Tensor makeTensor(const ::KFSRequest::InferInputTensor& requestInput,
 ov::Tensor makeTensor(const ::KFSRequest::InferInputTensor& requestInput,
     const std::shared_ptr<TensorInfo>& tensorInfo);
 
+/**
+ * @brief Wraps input data placed in registered shared memory region without copying it.
+ * Sets isSharedMemoryUsed to false when input does not refer to shared memory region.
+ */
+Status makeSharedMemoryTensor(const ::KFSRequest::InferInputTensor& requestInput,
+    const std::shared_ptr<TensorInfo>& tensorInfo,
+    ov::Tensor& tensor,
+    bool& isSharedMemoryUsed);
+
 ov::Tensor makeTensor(const InferenceTensor& requestInput,
     const std::shared_ptr<TensorInfo>& tensorInfo);
 
+/**
+ * @brief Binds caller provided output buffers of C-API request to infer request
+ * so that inference results are written directly to caller memory.
+ * Original output tensors are restored on destruction, so the infer request
+ * never keeps references to caller memory after inference is completed.
+ */
+class OutputBuffersBinding {
+    ov::InferRequest* inferRequest = nullptr;
+    std::vector<std::pair<std::string, ov::Tensor>> originalTensors;
+
+public:
+    OutputBuffersBinding() = default;
+    OutputBuffersBinding(const OutputBuffersBinding&) = delete;
+    OutputBuffersBinding& operator=(const OutputBuffersBinding&) = delete;
+    ~OutputBuffersBinding();
+
+    Status bind(const InferenceRequest& request, const tensor_map_t& outputsInfo, ov::InferRequest& inferRequest);
+    void restore();
+};
+
 class ConcreteTensorProtoDeserializator {
 public:
     static ov::Tensor deserializeTensorProto(
@@ -333,7 +365,7 @@ template <class TensorProtoDeserializator, class Sink>
 Status deserializePredictRequest(
     const tensorflow::serving::PredictRequest& request,
     const tensor_map_t& inputMap,
-    Sink& inputSink, bool isPipeline) {
+    Sink& inputSink, bool isPipeline, const InputPlan* inputPlan = nullptr, const RequestInputPositions* mappedInputPositions = nullptr) {
     OVMS_PROFILE_FUNCTION();
     Status status;
     for (const auto& pair : inputMap) {
@@ -391,25 +423,53 @@ template <class TensorProtoDeserializator, class Sink>
 Status deserializePredictRequest(
     const ::KFSRequest& request,
     const tensor_map_t& inputMap,
-    Sink& inputSink, bool isPipeline) {
+    Sink& inputSink, bool isPipeline, const InputPlan* inputPlan = nullptr, const RequestInputPositions* mappedInputPositions = nullptr) {
     OVMS_PROFILE_FUNCTION();
     Status status;
     bool deserializeFromSharedInputContents = request.raw_input_contents().size() > 0;
+    // mapping done during validation is reused, request inputs are mapped here only if it was not passed
+    RequestInputPositions localRequestInputPositions;
+    const RequestInputPositions* requestInputPositions = &localRequestInputPositions;
+    if (inputPlan != nullptr && inputPlan->isBuiltFor(inputMap)) {
+        if (mappedInputPositions != nullptr && mappedInputPositions->size() == inputMap.size()) {
+            requestInputPositions = mappedInputPositions;
+        } else {
+            inputPlan->mapRequestInputs(request, localRequestInputPositions);
+        }
+    }
+    size_t ordinal = 0;
     for (const auto& pair : inputMap) {
         try {
             const auto& name = pair.first;
             auto tensorInfo = pair.second;
-            auto requestInputItr = std::find_if(request.inputs().begin(), request.inputs().end(), [&name](const ::KFSRequest::InferInputTensor& tensor) { return tensor.name() == name; });
+            auto requestInputItr = request.inputs().end();
+            if (!requestInputPositions->empty()) {
+                int position = (*requestInputPositions)[ordinal++];
+                if (position != InputPlan::MISSING) {
+                    requestInputItr = request.inputs().begin() + position;
+                }
+            } else {
+                requestInputItr = std::find_if(request.inputs().begin(), request.inputs().end(), [&name](const ::KFSRequest::InferInputTensor& tensor) { return tensor.name() == name; });
+            }
             if (requestInputItr == request.inputs().end()) {
                 SPDLOG_DEBUG("Failed to deserialize request. Validation of request failed");
                 return Status(StatusCode::INTERNAL_ERROR, "Failed to deserialize request");
             }
             ov::Tensor tensor;
 
+            bool isSharedMemoryUsed = false;
+            status = makeSharedMemoryTensor(*requestInputItr, tensorInfo, tensor, isSharedMemoryUsed);
+            if (!status.ok()) {
+                SPDLOG_DEBUG("Shared memory input: {} deserialization failed: {}", name, status.string());
+                return status;
+            }
+
             auto inputIndex = requestInputItr - request.inputs().begin();
             auto bufferLocation = deserializeFromSharedInputContents ? &request.raw_input_contents()[inputIndex] : nullptr;
 
-            if (requestInputItr->datatype() == "BYTES") {
+            if (isSharedMemoryUsed) {
+                SPDLOG_DEBUG("Request contains input: {} placed in shared memory", name);
+            } else if (requestInputItr->datatype() == "BYTES") {
                 SPDLOG_DEBUG("Request contains binary input: {}", name);
                 status = convertBinaryRequestTensorToOVTensor(*requestInputItr, tensor, tensorInfo, bufferLocation);
                 if (!status.ok()) {
@@ -450,7 +510,7 @@ template <class TensorProtoDeserializator, class Sink>
 Status deserializePredictRequest(
     const InferenceRequest& request,
     const tensor_map_t& inputMap,
-    Sink& inputSink, bool isPipeline) {
+    Sink& inputSink, bool isPipeline, const InputPlan* inputPlan = nullptr, const RequestInputPositions* mappedInputPositions = nullptr) {
     OVMS_PROFILE_FUNCTION();
     Status status;
     for (const auto& [name, tensorInfo] : inputMap) {
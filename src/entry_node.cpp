@@ -23,6 +23,7 @@
 
 #include "binaryutils.hpp"
 #include "deserialization.hpp"
+#include "inferencerequest.hpp"
 #include "logging.hpp"
 #include "nodesession.hpp"
 #include "ov_utils.hpp"
@@ -106,6 +107,18 @@ Status EntryNode<::KFSRequest>::isInputBinary(const std::string& name, bool& isB
     isBinary = it->contents().bytes_contents_size() > 0;
     return StatusCode::OK;
 }
+template <>
+Status EntryNode<InferenceRequest>::isInputBinary(const std::string& name, bool& isBinary) const {
+    const InferenceTensor* tensor{nullptr};
+    auto status = request->getInput(name.c_str(), &tensor);
+    if (!status.ok()) {
+        SPDLOG_LOGGER_ERROR(dag_executor_logger, "Error during checking binary input; input: {} does not exist", name);
+        return StatusCode::INTERNAL_ERROR;
+    }
+    // C-API does not support binary inputs, entry tensors always wrap caller buffers
+    isBinary = false;
+    return StatusCode::OK;
+}
 
 template <typename RequestType>
 Status EntryNode<RequestType>::createShardedTensor(ov::Tensor& dividedTensor, Precision precision, const shape_t& shape, const ov::Tensor& tensor, size_t i, size_t step, const NodeSessionMetadata& metadata, const std::string tensorName) {
@@ -155,6 +168,16 @@ const Status EntryNode<::KFSRequest>::validate() {
         1,
         optionalInputNames);  // Pipelines are not versioned and always reports version 1
 }
+template <>
+const Status EntryNode<InferenceRequest>::validate() {
+    static const std::set<std::string> optionalInputNames = {};
+    return request_validation_utils::validate(
+        *request,
+        inputsInfo,
+        request->getServableName(),
+        1,
+        optionalInputNames);  // Pipelines are not versioned and always reports version 1
+}
 
 template Status EntryNode<tensorflow::serving::PredictRequest>::execute(session_key_t sessionId, PipelineEventQueue& notifyEndQueue);
 template Status EntryNode<::KFSRequest>::execute(session_key_t sessionId, PipelineEventQueue& notifyEndQueue);
@@ -168,4 +191,10 @@ template Status EntryNode<tensorflow::serving::PredictRequest>::createShardedTen
 template Status EntryNode<::KFSRequest>::createShardedTensor(ov::Tensor& dividedTensor, Precision precision, const shape_t& shape, const ov::Tensor& tensor, size_t i, size_t step, const NodeSessionMetadata& metadata, const std::string tensorName);
 template const Status EntryNode<tensorflow::serving::PredictRequest>::validate();
 template const Status EntryNode<::KFSRequest>::validate();
+template Status EntryNode<InferenceRequest>::execute(session_key_t sessionId, PipelineEventQueue& notifyEndQueue);
+template Status EntryNode<InferenceRequest>::fetchResults(NodeSession& nodeSession, SessionResults& nodeSessionOutputs);
+template Status EntryNode<InferenceRequest>::fetchResults(TensorWithSourceMap& outputs);
+template Status EntryNode<InferenceRequest>::isInputBinary(const std::string& name, bool& isBinary) const;
+template Status EntryNode<InferenceRequest>::createShardedTensor(ov::Tensor& dividedTensor, Precision precision, const shape_t& shape, const ov::Tensor& tensor, size_t i, size_t step, const NodeSessionMetadata& metadata, const std::string tensorName);
+template const Status EntryNode<InferenceRequest>::validate();
 }  //  namespace ovms
@@ -57,6 +57,9 @@ public:
 
     Status isInputBinary(const std::string& name, bool& isBinary) const;
 
+    // Binds node reused from pipeline graph pool to next request
+    void setRequest(const RequestType* request) { this->request = request; }
+
     const Status validate();
 };
 
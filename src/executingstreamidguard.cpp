@@ -38,6 +38,15 @@ ExecutingStreamIdGuard::ExecutingStreamIdGuard(OVInferRequestsQueue& inferReques
     INCREMENT_IF_ENABLED(this->reporter.inferReqActive);
 }
 
+ExecutingStreamIdGuard::ExecutingStreamIdGuard(OVInferRequestsQueue& inferRequestsQueue, ModelMetricReporter& reporter, int streamId) :
+    currentRequestsMetricGuard(reporter),
+    inferRequestsQueue_(inferRequestsQueue),
+    id_(streamId),
+    inferRequest(inferRequestsQueue.getInferRequest(id_)),
+    reporter(reporter) {
+    INCREMENT_IF_ENABLED(this->reporter.inferReqActive);
+}
+
 ExecutingStreamIdGuard::~ExecutingStreamIdGuard() {
     DECREMENT_IF_ENABLED(this->reporter.inferReqActive);
     this->inferRequestsQueue_.returnStream(this->id_);
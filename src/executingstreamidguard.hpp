@@ -15,6 +15,8 @@
 //*****************************************************************************
 #pragma once
 
+#include "threadlocalrecycled.hpp"
+
 namespace ov {
 class InferRequest;
 }
@@ -25,8 +27,12 @@ class OVInferRequestsQueue;
 class ModelMetricReporter;
 class OVInferRequestsQueue;
 
-struct ExecutingStreamIdGuard {
+struct ExecutingStreamIdGuard : public ThreadLocalRecycled<ExecutingStreamIdGuard> {
     ExecutingStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue, ModelMetricReporter& reporter);
+    /**
+     * @brief Takes ownership of stream already taken from the queue
+     */
+    ExecutingStreamIdGuard(ovms::OVInferRequestsQueue& inferRequestsQueue, ModelMetricReporter& reporter, int streamId);
     ~ExecutingStreamIdGuard();
 
     int getId();
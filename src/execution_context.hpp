@@ -23,6 +23,7 @@ struct ExecutionContext {
     enum class Interface : uint8_t {
         GRPC,
         REST,
+        CAPI,
     };
     enum class Method : uint8_t {
         // TensorflowServing
@@ -18,6 +18,7 @@
 #include <string>
 #include <utility>
 
+#include "inferenceresponse.hpp"
 #include "logging.hpp"
 #include "ov_utils.hpp"
 #include "serialization.hpp"
@@ -67,6 +68,14 @@ Status ExitNode<ResponseType>::fetchResults(const TensorMap& inputTensors) {
     return serializePredictResponse(outputGetter, name, version, this->outputsInfo, this->response, getOutputMapKeyName);
 }
 
+template <>
+Status ExitNode<InferenceResponse>::fetchResults(const TensorMap& inputTensors) {
+    OutputGetter<const TensorMap&> outputGetter(inputTensors);
+    static const std::string name{""};
+    static const model_version_t version{1};
+    return serializePredictResponse(outputGetter, name, version, this->outputsInfo, this->response, getOutputMapKeyName, nullptr, this->useSharedOutputContent);
+}
+
 template <typename ResponseType>
 std::unique_ptr<NodeSession> ExitNode<ResponseType>::createNodeSession(const NodeSessionMetadata& metadata, const CollapseDetails& collapsingDetails) {
     return std::make_unique<ExitNodeSession<ResponseType>>(metadata, getName(), previous.size(), collapsingDetails, response);
@@ -80,4 +89,8 @@ template Status ExitNode<::KFSResponse>::fetchResults(const TensorMap& inputTens
 template Status ExitNode<tensorflow::serving::PredictResponse>::fetchResults(const TensorMap& inputTensors);
 template std::unique_ptr<NodeSession> ExitNode<::KFSResponse>::createNodeSession(const NodeSessionMetadata& metadata, const CollapseDetails& collapsingDetails);
 template std::unique_ptr<NodeSession> ExitNode<tensorflow::serving::PredictResponse>::createNodeSession(const NodeSessionMetadata& metadata, const CollapseDetails& collapsingDetails);
+template Status ExitNode<InferenceResponse>::fetchResults(NodeSession& nodeSession, SessionResults& nodeSessionOutputs);
+template Status ExitNode<InferenceResponse>::execute(session_key_t sessionId, PipelineEventQueue& notifyEndQueue);
+template Status ExitNode<InferenceResponse>::fetchResults(const TensorMap& inputTensors);
+template std::unique_ptr<NodeSession> ExitNode<InferenceResponse>::createNodeSession(const NodeSessionMetadata& metadata, const CollapseDetails& collapsingDetails);
 }  // namespace ovms
@@ -60,6 +60,12 @@ public:
     }
 
     std::unique_ptr<NodeSession> createNodeSession(const NodeSessionMetadata& metadata, const CollapseDetails& collapsingDetails) override;
+
+    // Binds node reused from pipeline graph pool to next response
+    void setResponse(ResponseType* response, bool useSharedOutputContent) {
+        this->response = response;
+        this->useSharedOutputContent = useSharedOutputContent;
+    }
 };
 
 }  // namespace ovms
@@ -18,6 +18,7 @@
 #include <memory>
 
 #include "gatherexitnodeinputhandler.hpp"
+#include "inferenceresponse.hpp"
 #include "nodesessionmetadata.hpp"
 
 namespace ovms {
@@ -40,8 +41,10 @@ ExitNodeSession<ResponseType>::~ExitNodeSession() = default;
 
 template ExitNodeSession<tensorflow::serving::PredictResponse>::ExitNodeSession(const NodeSessionMetadata& metadata, const std::string& nodeName, uint32_t inputsCount, const CollapseDetails& collapsingDetails, tensorflow::serving::PredictResponse* response);
 template ExitNodeSession<::KFSResponse>::ExitNodeSession(const NodeSessionMetadata& metadata, const std::string& nodeName, uint32_t inputsCount, const CollapseDetails& collapsingDetails, ::KFSResponse* response);
+template ExitNodeSession<InferenceResponse>::ExitNodeSession(const NodeSessionMetadata& metadata, const std::string& nodeName, uint32_t inputsCount, const CollapseDetails& collapsingDetails, InferenceResponse* response);
 
 template const TensorMap& ExitNodeSession<tensorflow::serving::PredictResponse>::getInputTensors() const;
 template const TensorMap& ExitNodeSession<::KFSResponse>::getInputTensors() const;
+template const TensorMap& ExitNodeSession<InferenceResponse>::getInputTensors() const;
 
 }  // namespace ovms
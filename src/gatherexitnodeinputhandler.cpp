@@ -21,4 +21,10 @@
 #include "status.hpp"
 
 namespace ovms {
+template <>
+Status GatherExitNodeInputHandler<InferenceResponse>::prepareConsolidatedTensor(ov::Tensor& tensorOut, const std::string& name, ov::element::Type_t precision, const ov::Shape& shape) const {
+    OVMS_PROFILE_FUNCTION();
+    tensorOut = ov::Tensor(precision, shape);
+    return StatusCode::OK;
+}
 }  // namespace ovms
@@ -28,6 +28,7 @@
 #include "tfs_frontend/tfs_utils.hpp"
 
 namespace ovms {
+class InferenceResponse;
 
 template <class ResponseType>
 class GatherExitNodeInputHandler : public GatherNodeInputHandler {
@@ -55,4 +56,8 @@ public:
         response(response) {}
 };
 
+// C-API response references consolidated tensor, so it is allocated independently of the response
+template <>
+Status GatherExitNodeInputHandler<InferenceResponse>::prepareConsolidatedTensor(ov::Tensor& tensorOut, const std::string& name, ov::element::Type_t precision, const ov::Shape& shape) const;
+
 }  // namespace ovms
@@ -16,6 +16,7 @@
 
 #include "grpc_utils.hpp"
 
+#include <chrono>
 #include <string>
 #include <unordered_map>
 
@@ -69,6 +70,7 @@ const grpc::Status grpc(const Status& status) {
         {StatusCode::INVALID_BATCH_SIZE, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::INVALID_SHAPE, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::INVALID_BUFFER_TYPE, grpc::StatusCode::INVALID_ARGUMENT},
+        {StatusCode::INVALID_UNEXPECTED_OUTPUT, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::INVALID_DEVICE_ID, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::INVALID_PRECISION, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::INVALID_VALUE_COUNT, grpc::StatusCode::INVALID_ARGUMENT},
@@ -85,6 +87,13 @@ const grpc::Status grpc(const Status& status) {
         // Inference
         {StatusCode::OV_INTERNAL_INFERENCE_ERROR, grpc::StatusCode::INTERNAL},
 
+        // Admission control
+        {StatusCode::INVALID_PRIORITY, grpc::StatusCode::INVALID_ARGUMENT},
+        {StatusCode::INFER_QUEUE_FULL, grpc::StatusCode::RESOURCE_EXHAUSTED},
+        {StatusCode::INFER_QUEUE_WAIT_TIMEOUT, grpc::StatusCode::DEADLINE_EXCEEDED},
+        {StatusCode::REQUEST_DEADLINE_EXCEEDED, grpc::StatusCode::DEADLINE_EXCEEDED},
+        {StatusCode::REQUEST_CANCELLED, grpc::StatusCode::CANCELLED},
+
         // Serialization
 
         // Should never occur - it should be validated during model loading
@@ -99,6 +108,17 @@ const grpc::Status grpc(const Status& status) {
         {StatusCode::BINARY_IMAGES_RESOLUTION_MISMATCH, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::STRING_VAL_EMPTY, grpc::StatusCode::INVALID_ARGUMENT},
         {StatusCode::BYTES_CONTENTS_EMPTY, grpc::StatusCode::INVALID_ARGUMENT},
+
+        // Shared memory
+        {StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, grpc::StatusCode::ALREADY_EXISTS},
+        {StatusCode::SHARED_MEMORY_REGION_NOT_FOUND, grpc::StatusCode::NOT_FOUND},
+        {StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED, grpc::StatusCode::INVALID_ARGUMENT},
+        {StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS, grpc::StatusCode::INVALID_ARGUMENT},
+        {StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, grpc::StatusCode::INVALID_ARGUMENT},
+        {StatusCode::SHARED_MEMORY_DISABLED, grpc::StatusCode::UNIMPLEMENTED},
+
+        // Streaming
+        {StatusCode::STREAM_WRITE_FAILED, grpc::StatusCode::UNAVAILABLE},
     };
     auto it = grpcStatusMap.find(status.getCode());
     if (it != grpcStatusMap.end()) {
@@ -107,4 +127,34 @@ const grpc::Status grpc(const Status& status) {
         return grpc::Status(grpc::StatusCode::UNKNOWN, "Unknown error");
     }
 }
+
+Status getRequestPriority(const grpc::ServerContext* context, RequestPriority& priority) {
+    if (context == nullptr) {
+        return StatusCode::OK;
+    }
+    const auto& metadata = context->client_metadata();
+    auto it = metadata.find(PRIORITY_HEADER);
+    if (it == metadata.end()) {
+        return StatusCode::OK;
+    }
+    return parseRequestPriority(std::string(it->second.data(), it->second.size()), priority);
+}
+
+RequestScope::Deadline getRequestDeadline(const grpc::ServerContext* context) {
+    if (context == nullptr) {
+        return std::nullopt;
+    }
+    const auto deadline = context->deadline();
+    if (deadline == std::chrono::system_clock::time_point::max()) {
+        return std::nullopt;
+    }
+    return RequestScope::Clock::now() + std::chrono::duration_cast<RequestScope::Clock::duration>(deadline - std::chrono::system_clock::now());
+}
+
+RequestScope::CancellationCheck getCancellationCheck(const grpc::ServerContext* context) {
+    if (context == nullptr) {
+        return nullptr;
+    }
+    return [context]() { return context->IsCancelled(); };
+}
 }  // namespace ovms
@@ -16,8 +16,25 @@
 #pragma once
 #include <grpcpp/server_context.h>
 
+#include "request_scope.hpp"
+
 namespace ovms {
 class Status;
 
 const grpc::Status grpc(const Status& status);
+
+/**
+ * @brief Reads request priority from ovms-priority metadata, leaves priority unchanged when metadata is not sent
+ */
+Status getRequestPriority(const grpc::ServerContext* context, RequestPriority& priority);
+
+/**
+ * @brief Converts client deadline to server steady clock, std::nullopt when client did not set a deadline
+ */
+RequestScope::Deadline getRequestDeadline(const grpc::ServerContext* context);
+
+/**
+ * @brief Cancellation check of the call, empty when there is no gRPC call (e.g. KServe REST request)
+ */
+RequestScope::CancellationCheck getCancellationCheck(const grpc::ServerContext* context);
 }  // namespace ovms
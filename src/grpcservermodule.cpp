@@ -40,6 +40,7 @@
 #include "prediction_service.hpp"
 #include "servablemanagermodule.hpp"
 #include "server.hpp"
+#include "shared_memory_manager.hpp"
 #include "stringutils.hpp"
 #include "version.hpp"
 
@@ -121,6 +122,12 @@ Status GRPCServerModule::start(const ovms::Config& config) {
         return status;
     }
 
+    if (config.sharedMemoryEnabled()) {
+        SPDLOG_WARN("Shared memory API is enabled, clients can map any shared memory object available to the server");
+        this->sharedMemoryManager = std::make_unique<SharedMemoryManager>();
+        this->kfsGrpcInferenceService.setSharedMemoryManager(this->sharedMemoryManager.get());
+    }
+
     ServerBuilder builder;
     builder.SetMaxReceiveMessageSize(GIGABYTE);
     builder.SetMaxSendMessageSize(GIGABYTE);
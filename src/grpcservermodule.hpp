@@ -28,9 +28,12 @@
 namespace ovms {
 class Config;
 class Server;
+class SharedMemoryManager;
 
 class GRPCServerModule : public Module {
     Server& server;
+    // created only when enabled, outlives services referring to it
+    std::unique_ptr<SharedMemoryManager> sharedMemoryManager;
     PredictionServiceImpl tfsPredictService;
     ModelServiceImpl tfsModelService;
     mutable KFSInferenceServiceImpl kfsGrpcInferenceService;
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #include "http_rest_api_handler.hpp"
 
+#include <cmath>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -28,6 +29,8 @@
 #include <rapidjson/writer.h>
 #include <spdlog/spdlog.h>
 
+#include "access_log.hpp"
+#include "compression.hpp"
 #include "config.hpp"
 #include "execution_context.hpp"
 #include "filesystem.hpp"
@@ -35,6 +38,8 @@
 #include "grpcservermodule.hpp"
 #include "kfs_frontend/kfs_grpc_inference_service.hpp"
 #include "kfs_frontend/kfs_utils.hpp"
+#include "metric_config.hpp"
+#include "metric_family.hpp"
 #include "metric_module.hpp"
 #include "metric_registry.hpp"
 #include "model_metric_reporter.hpp"
@@ -46,9 +51,12 @@
 #include "pipelinedefinition.hpp"
 #include "pipelinedefinitionunloadguard.hpp"
 #include "prediction_service_utils.hpp"
+#include "profiler.hpp"
+#include "protobuf_arena_pool.hpp"
 #include "rest_parser.hpp"
 #include "rest_utils.hpp"
 #include "servablemanagermodule.hpp"
+#include "shared_memory_manager.hpp"
 #include "server.hpp"
 #include "status.hpp"
 #include "stringutils.hpp"
@@ -65,6 +73,7 @@ namespace {
 enum : unsigned int {
     TOTAL,
     PREPARE_GRPC_REQUEST,
+    RENDER_JSON_RESPONSE,
     TIMER_END
 };
 const std::string DEFAULT_VERSION = "DEFAULT";
@@ -91,10 +100,15 @@ const std::string HttpRestApiHandler::kfs_serverliveRegexExp =
     R"(/v2/health/live)";
 const std::string HttpRestApiHandler::kfs_servermetadataRegexExp =
     R"(/v2)";
+const std::string HttpRestApiHandler::kfs_sharedmemoryRegexExp =
+    R"(/v2/systemsharedmemory(?:/region/([^/]+))?/(status|register|unregister))";
 
 const std::string HttpRestApiHandler::metricsRegexExp = R"((.?)\/metrics)";
 
-HttpRestApiHandler::HttpRestApiHandler(ovms::Server& ovmsServer, int timeout_in_ms) :
+const std::string HttpRestApiHandler::profilerRegexExp = R"((.?)\/v1\/profiler)";
+const std::string HttpRestApiHandler::profilerTraceRegexExp = R"((.?)\/v1\/profiler\/trace)";
+
+HttpRestApiHandler::HttpRestApiHandler(ovms::Server& ovmsServer, int timeout_in_ms, std::shared_ptr<const RestServerLoad> serverLoad, std::optional<uint64_t> maxBodySize) :
     predictionRegex(predictionRegexExp),
     modelstatusRegex(modelstatusRegexExp),
     configReloadRegex(configReloadRegexExp),
@@ -105,13 +119,19 @@ HttpRestApiHandler::HttpRestApiHandler(ovms::Server& ovmsServer, int timeout_in_
     kfs_serverreadyRegex(kfs_serverreadyRegexExp),
     kfs_serverliveRegex(kfs_serverliveRegexExp),
     kfs_servermetadataRegex(kfs_servermetadataRegexExp),
+    kfs_sharedmemoryRegex(kfs_sharedmemoryRegexExp),
     metricsRegex(metricsRegexExp),
+    profilerRegex(profilerRegexExp),
+    profilerTraceRegex(profilerTraceRegexExp),
     timeout_in_ms(timeout_in_ms),
+    compressionThreshold(ovms::Config::instance().restCompressionThreshold()),
+    maxBodySize(maxBodySize.value_or(ovms::Config::instance().restMaxBodySize())),
     ovmsServer(ovmsServer),
 
     kfsGrpcImpl(dynamic_cast<const GRPCServerModule*>(this->ovmsServer.getModule(GRPC_SERVER_MODULE_NAME))->getKFSGrpcImpl()),
     grpcGetModelMetadataImpl(dynamic_cast<const GRPCServerModule*>(this->ovmsServer.getModule(GRPC_SERVER_MODULE_NAME))->getTFSModelMetadataImpl()),
-    modelManager(dynamic_cast<const ServableManagerModule*>(this->ovmsServer.getModule(SERVABLE_MANAGER_MODULE_NAME))->getServableManager()) {
+    modelManager(dynamic_cast<const ServableManagerModule*>(this->ovmsServer.getModule(SERVABLE_MANAGER_MODULE_NAME))->getServableManager()),
+    serverLoad(std::move(serverLoad)) {
     if (nullptr == this->ovmsServer.getModule(GRPC_SERVER_MODULE_NAME))
         throw std::logic_error("Tried to create http rest api handler without grpc server module");
     if (nullptr == this->ovmsServer.getModule(SERVABLE_MANAGER_MODULE_NAME))
@@ -138,8 +158,11 @@ void HttpRestApiHandler::registerHandler(RequestType type, std::function<Status(
 void HttpRestApiHandler::registerAll() {
     registerHandler(Predict, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
         if (request_components.processing_method == "predict") {
-            return processPredictRequest(request_components.model_name, request_components.model_version,
-                request_components.model_version_label, request_body, &response);
+            auto status = processPredictRequest(request_components.model_name, request_components.model_version,
+                request_components.model_version_label, request_body, &response, response_components.inferenceHeaderContentLength);
+            if (!status.ok())
+                return status;
+            return compressResponse(request_components, response, response_components);
         } else {
             SPDLOG_DEBUG("Requested REST resource not found");
             return StatusCode::REST_NOT_FOUND;
@@ -167,7 +190,10 @@ void HttpRestApiHandler::registerAll() {
         return processModelMetadataKFSRequest(request_components, response, request_body);
     });
     registerHandler(KFS_Infer, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
-        return processInferKFSRequest(request_components, response, request_body, response_components.inferenceHeaderContentLength);
+        auto status = processInferKFSRequest(request_components, response, request_body, response_components.inferenceHeaderContentLength);
+        if (!status.ok())
+            return status;
+        return compressResponse(request_components, response, response_components);
     });
     registerHandler(KFS_GetServerReady, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
         return processServerReadyKFSRequest(request_components, response, request_body);
@@ -179,7 +205,25 @@ void HttpRestApiHandler::registerAll() {
         return processServerMetadataKFSRequest(request_components, response, request_body);
     });
     registerHandler(Metrics, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
-        return processMetrics(request_components, response, request_body);
+        return processMetrics(request_components, response, request_body, response_components);
+    });
+    registerHandler(ProfilerStatus, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
+        return processProfilerStatusRequest(response);
+    });
+    registerHandler(ProfilerConfig, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
+        return processProfilerConfigRequest(request_body, response);
+    });
+    registerHandler(ProfilerTrace, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
+        return processProfilerTraceRequest(response);
+    });
+    registerHandler(KFS_SharedMemoryStatus, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
+        return processSharedMemoryStatusKFSRequest(request_components, response);
+    });
+    registerHandler(KFS_SharedMemoryRegister, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
+        return processSharedMemoryRegisterKFSRequest(request_components, response, request_body);
+    });
+    registerHandler(KFS_SharedMemoryUnregister, [this](const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) -> Status {
+        return processSharedMemoryUnregisterKFSRequest(request_components, response);
     });
 }
 
@@ -218,6 +262,70 @@ Status HttpRestApiHandler::processServerMetadataKFSRequest(const HttpRequestComp
     return StatusCode::OK;
 }
 
+Status HttpRestApiHandler::processSharedMemoryStatusKFSRequest(const HttpRequestComponents& request_components, std::string& response) {
+    ::KFSSharedMemoryStatusRequest grpc_request;
+    ::KFSSharedMemoryStatusResponse grpc_response;
+    grpc_request.set_name(request_components.shared_memory_region);
+    auto status = kfsGrpcImpl.SystemSharedMemoryStatusImpl(&grpc_request, &grpc_response);
+    if (!status.ok()) {
+        return status;
+    }
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartArray();
+    for (const auto& [name, region] : grpc_response.regions()) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(region.name().c_str());
+        writer.Key("key");
+        writer.String(region.key().c_str());
+        writer.Key("offset");
+        writer.Uint64(region.offset());
+        writer.Key("byte_size");
+        writer.Uint64(region.byte_size());
+        writer.EndObject();
+    }
+    writer.EndArray();
+    response = buffer.GetString();
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::processSharedMemoryRegisterKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body) {
+    rapidjson::Document doc;
+    if (doc.Parse(request_body.c_str()).HasParseError() || !doc.IsObject()) {
+        SPDLOG_DEBUG("Shared memory region registration request is not a valid JSON object");
+        return StatusCode::SHARED_MEMORY_PARAMETERS_INVALID;
+    }
+    ::KFSSharedMemoryRegisterRequest grpc_request;
+    ::KFSSharedMemoryRegisterResponse grpc_response;
+    grpc_request.set_name(request_components.shared_memory_region);
+    auto keyItr = doc.FindMember("key");
+    if (keyItr == doc.MemberEnd() || !keyItr->value.IsString()) {
+        return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Missing key of shared memory region");
+    }
+    grpc_request.set_key(keyItr->value.GetString());
+    auto offsetItr = doc.FindMember("offset");
+    if (offsetItr != doc.MemberEnd()) {
+        if (!offsetItr->value.IsUint64()) {
+            return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Invalid offset of shared memory region");
+        }
+        grpc_request.set_offset(offsetItr->value.GetUint64());
+    }
+    auto byteSizeItr = doc.FindMember("byte_size");
+    if (byteSizeItr == doc.MemberEnd() || !byteSizeItr->value.IsUint64()) {
+        return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Missing byte_size of shared memory region");
+    }
+    grpc_request.set_byte_size(byteSizeItr->value.GetUint64());
+    return kfsGrpcImpl.SystemSharedMemoryRegisterImpl(&grpc_request, &grpc_response);
+}
+
+Status HttpRestApiHandler::processSharedMemoryUnregisterKFSRequest(const HttpRequestComponents& request_components, std::string& response) {
+    ::KFSSharedMemoryUnregisterRequest grpc_request;
+    ::KFSSharedMemoryUnregisterResponse grpc_response;
+    grpc_request.set_name(request_components.shared_memory_region);
+    return kfsGrpcImpl.SystemSharedMemoryUnregisterImpl(&grpc_request, &grpc_response);
+}
+
 void HttpRestApiHandler::parseParams(Value& scope, Document& doc) {
     Value::ConstMemberIterator itr = scope.FindMember("parameters");
     if (itr != scope.MemberEnd()) {
@@ -437,6 +545,9 @@ static Status handleBinaryInputs(::KFSRequest& grpc_request, const std::string&
     size_t binary_input_offset = 0;
     for (int i = 0; i < grpc_request.mutable_inputs()->size(); i++) {
         auto input = grpc_request.mutable_inputs()->Mutable(i);
+        if (input->parameters().find(SHARED_MEMORY_REGION_PARAMETER) != input->parameters().end()) {
+            continue;
+        }
         auto binary_data_size_parameter = input->parameters().find("binary_data_size");
         if (binary_data_size_parameter != input->parameters().end()) {
             auto status = validateContentFieldsEmptiness(*input);
@@ -490,7 +601,7 @@ static Status handleBinaryInputs(::KFSRequest& grpc_request, const std::string&
 }
 
 Status HttpRestApiHandler::prepareGrpcRequest(const std::string modelName, const std::optional<int64_t>& modelVersion, const std::string& request_body, ::KFSRequest& grpc_request, const std::optional<int>& inferenceHeaderContentLength) {
-    KFSRestParser requestParser;
+    KFSRestParser requestParser(grpc_request);
 
     size_t endOfJson = inferenceHeaderContentLength.value_or(request_body.length());
     auto status = requestParser.parse(request_body.substr(0, endOfJson).c_str());
@@ -498,7 +609,6 @@ Status HttpRestApiHandler::prepareGrpcRequest(const std::string modelName, const
         SPDLOG_DEBUG("Parsing http request failed");
         return status;
     }
-    grpc_request = requestParser.getProto();
     status = handleBinaryInputs(grpc_request, request_body, endOfJson);
     if (!status.ok()) {
         return status;
@@ -538,17 +648,23 @@ static std::set<std::string> getRequestedBinaryOutputsNames(::KFSRequest& grpc_r
 }
 
 Status HttpRestApiHandler::processInferKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, std::optional<int>& inferenceHeaderContentLength) {
+    OVMS_PROFILE_REQUEST("REST ModelInfer");
+    OVMS_PROFILE_FUNCTION();
     Timer<TIMER_END> timer;
     timer.start(TOTAL);
     ServableMetricReporter* reporter = nullptr;
     std::string modelName(request_components.model_name);
     std::string modelVersionLog = request_components.model_version.has_value() ? std::to_string(request_components.model_version.value()) : DEFAULT_VERSION;
     SPDLOG_DEBUG("Processing REST request for model: {}; version: {}", modelName, modelVersionLog);
-    ::KFSRequest grpc_request;
+    // request and response are freed at once together with the arena
+    auto arena = ProtobufArenaPool::acquire();
+    ::KFSRequest& grpc_request = *arena.create<::KFSRequest>();
     timer.start(PREPARE_GRPC_REQUEST);
     using std::chrono::microseconds;
-    auto status = prepareGrpcRequest(modelName, request_components.model_version, request_body, grpc_request, request_components.inferenceHeaderContentLength);
     ExecutionContext executionContext{ExecutionContext::Interface::REST, ExecutionContext::Method::ModelInfer};
+    Status status;
+    AccessLogRecord accessLog(executionContext, modelName, request_components.model_version.value_or(0), status);
+    status = prepareGrpcRequest(modelName, request_components.model_version, request_body, grpc_request, request_components.inferenceHeaderContentLength);
     if (!status.ok()) {
         auto pstatus = this->getReporter(request_components, reporter);
         if (pstatus.ok()) {
@@ -559,11 +675,14 @@ Status HttpRestApiHandler::processInferKFSRequest(const HttpRequestComponents& r
     }
     timer.stop(PREPARE_GRPC_REQUEST);
     SPDLOG_DEBUG("Preparing grpc request time: {} ms", timer.elapsed<std::chrono::microseconds>(PREPARE_GRPC_REQUEST) / 1000);
-    ::KFSResponse grpc_response;
-    const Status gstatus = kfsGrpcImpl.ModelInferImpl(nullptr, &grpc_request, &grpc_response, executionContext, reporter);
-    if (!gstatus.ok()) {
-        return gstatus;
+    accessLog.addStage("prepare_grpc_request", timer.elapsed<std::chrono::microseconds>(PREPARE_GRPC_REQUEST));
+    ::KFSResponse& grpc_response = *arena.create<::KFSResponse>();
+    status = kfsGrpcImpl.ModelInferImpl(nullptr, &grpc_request, &grpc_response, executionContext, reporter);
+    if (!status.ok()) {
+        return status;
     }
+    OBSERVE_IF_ENABLED(reporter->requestParseTimeRest, timer.elapsed<std::chrono::microseconds>(PREPARE_GRPC_REQUEST));
+    timer.start(RENDER_JSON_RESPONSE);
     std::set<std::string> requestedBinaryOutputsNames = getRequestedBinaryOutputsNames(grpc_request);
     std::string output;
     status = ovms::makeJsonFromPredictResponse(grpc_response, &output, inferenceHeaderContentLength, requestedBinaryOutputsNames);
@@ -571,6 +690,9 @@ Status HttpRestApiHandler::processInferKFSRequest(const HttpRequestComponents& r
         return status;
     }
     response = std::move(output);
+    timer.stop(RENDER_JSON_RESPONSE);
+    OBSERVE_IF_ENABLED(reporter->responseRenderTimeRest, timer.elapsed<std::chrono::microseconds>(RENDER_JSON_RESPONSE));
+    accessLog.addStage("render_json_response", timer.elapsed<std::chrono::microseconds>(RENDER_JSON_RESPONSE));
     timer.stop(TOTAL);
     double totalTime = timer.elapsed<std::chrono::microseconds>(TOTAL);
     SPDLOG_DEBUG("Total REST request processing time: {} ms", totalTime / 1000);
@@ -593,7 +715,72 @@ Status HttpRestApiHandler::dispatchToProcessor(
     return StatusCode::UNKNOWN_REQUEST_COMPONENTS_TYPE;
 }
 
-Status HttpRestApiHandler::processMetrics(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body) {
+void HttpRestApiHandler::createScrapeMetrics(MetricRegistry& registry, const MetricConfig& metricConfig) {
+    if (metricConfig.isFamilyEnabled(METRIC_NAME_METRICS_SCRAPE_TIME)) {
+        auto family = registry.createFamily<MetricHistogram>(METRIC_NAME_METRICS_SCRAPE_TIME,
+            "Time of rendering and compressing metrics endpoint response.");
+        if (family) {
+            BucketBoundaries buckets;
+            for (int i = 0; i < 20; i++) {
+                buckets.emplace_back(floor(10 * pow(2, i)));
+            }
+            this->metricsScrapeTime = family->addMetric({}, buckets);
+        }
+    }
+    if (metricConfig.isFamilyEnabled(METRIC_NAME_METRICS_SCRAPE_SIZE)) {
+        auto family = registry.createFamily<MetricHistogram>(METRIC_NAME_METRICS_SCRAPE_SIZE,
+            "Size of metrics endpoint response sent to the client.");
+        if (family) {
+            BucketBoundaries buckets;
+            for (int i = 0; i < 12; i++) {
+                buckets.emplace_back(1024 * pow(4, i));
+            }
+            this->metricsScrapeSize = family->addMetric({}, buckets);
+        }
+    }
+}
+
+void HttpRestApiHandler::createServerLoadMetrics(MetricRegistry& registry, const MetricConfig& metricConfig) {
+    if (metricConfig.isFamilyEnabled(METRIC_NAME_REST_REQUESTS_ACTIVE)) {
+        auto family = registry.createFamily<MetricGauge>(METRIC_NAME_REST_REQUESTS_ACTIVE,
+            "Number of REST requests being processed by REST workers.");
+        if (family) {
+            this->restRequestsActive = family->addMetric();
+        }
+    }
+    if (metricConfig.isFamilyEnabled(METRIC_NAME_REST_REQUESTS_QUEUED)) {
+        auto family = registry.createFamily<MetricGauge>(METRIC_NAME_REST_REQUESTS_QUEUED,
+            "Number of REST requests waiting for a free REST worker.");
+        if (family) {
+            this->restRequestsQueued = family->addMetric();
+        }
+    }
+    if (metricConfig.isFamilyEnabled(METRIC_NAME_REST_REQUESTS_REJECTED)) {
+        auto family = registry.createFamily<MetricCounter>(METRIC_NAME_REST_REQUESTS_REJECTED,
+            "Number of REST requests rejected because rest_max_concurrent_requests was reached.");
+        if (family) {
+            this->restRequestsRejected = family->addMetric();
+        }
+    }
+}
+
+void HttpRestApiHandler::reportServerLoad() {
+    if (!this->serverLoad) {
+        return;
+    }
+    SET_IF_ENABLED(this->restRequestsActive, this->serverLoad->activeRequests.load());
+    SET_IF_ENABLED(this->restRequestsQueued, this->serverLoad->queuedRequests.load());
+    if (this->restRequestsRejected) {
+        std::lock_guard<std::mutex> lock(this->reportedRejectedRequestsMtx);
+        uint64_t rejectedRequests = this->serverLoad->rejectedRequests.load();
+        if (rejectedRequests > this->reportedRejectedRequests) {
+            this->restRequestsRejected->increment(rejectedRequests - this->reportedRejectedRequests);
+            this->reportedRejectedRequests = rejectedRequests;
+        }
+    }
+}
+
+Status HttpRestApiHandler::processMetrics(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components) {
     auto module = this->ovmsServer.getModule(METRICS_MODULE_NAME);
     if (nullptr == module) {
         SPDLOG_ERROR("Failed to process metrics - metrics module is missing");
@@ -606,11 +793,54 @@ Status HttpRestApiHandler::processMetrics(const HttpRequestComponents& request_c
     }
 
     auto metricModule = dynamic_cast<const MetricModule*>(module);
+    std::call_once(this->scrapeMetricsCreated, [this, metricModule, &metricConfig]() {
+        this->createScrapeMetrics(metricModule->getRegistry(), metricConfig);
+        this->createServerLoadMetrics(metricModule->getRegistry(), metricConfig);
+    });
+    this->reportServerLoad();
+
+    Timer<TIMER_END> timer;
+    timer.start(TOTAL);
     response = metricModule->getRegistry().collect();
+    if (isGzipAccepted(request_components.acceptEncoding)) {
+        std::string compressed;
+        auto status = gzipCompress(response, compressed);
+        if (!status.ok()) {
+            return status;
+        }
+        response = std::move(compressed);
+        response_components.contentEncoding = "gzip";
+    }
+    timer.stop(TOTAL);
+    OBSERVE_IF_ENABLED(this->metricsScrapeTime, timer.elapsed<std::chrono::microseconds>(TOTAL));
+    OBSERVE_IF_ENABLED(this->metricsScrapeSize, response.size());
 
     return StatusCode::OK;
 }
 
+Status HttpRestApiHandler::compressResponse(const HttpRequestComponents& request_components, std::string& response, HttpResponseComponents& response_components) {
+    if (response.size() < this->compressionThreshold) {
+        return StatusCode::OK;
+    }
+    auto encoding = selectContentEncoding(request_components.acceptEncoding);
+    if (encoding.empty()) {
+        return StatusCode::OK;
+    }
+    Timer<TIMER_END> timer;
+    timer.start(TOTAL);
+    std::string compressed;
+    auto status = compress(response, encoding, compressed);
+    if (!status.ok()) {
+        return status;
+    }
+    timer.stop(TOTAL);
+    SPDLOG_DEBUG("REST response compressed with {} from {} to {} bytes in {} ms", encoding, response.size(), compressed.size(),
+        timer.elapsed<std::chrono::microseconds>(TOTAL) / 1000);
+    response = std::move(compressed);
+    response_components.contentEncoding = encoding;
+    return StatusCode::OK;
+}
+
 Status HttpRestApiHandler::processModelReadyKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body) {
     ::KFSGetModelStatusRequest grpc_request;
     ::KFSGetModelStatusResponse grpc_response;
@@ -698,6 +928,21 @@ Status HttpRestApiHandler::parseRequestComponents(HttpRequestComponents& request
     const std::vector<std::pair<std::string, std::string>>& headers) {
     std::smatch sm;
     requestComponents.http_method = http_method;
+    for (const auto& header : headers) {
+        if (header.first == "Accept-Encoding") {
+            requestComponents.acceptEncoding = header.second;
+        }
+        if (header.first == "Content-Encoding") {
+            requestComponents.contentEncoding = header.second;
+        }
+        if (header.first == PRIORITY_HEADER) {
+            RequestPriority priority;
+            auto status = parseRequestPriority(header.second, priority);
+            if (!status.ok())
+                return status;
+            requestComponents.priority = priority;
+        }
+    }
     if (http_method != "POST" && http_method != "GET") {
         return StatusCode::REST_UNSUPPORTED_METHOD;
     }
@@ -743,6 +988,22 @@ Status HttpRestApiHandler::parseRequestComponents(HttpRequestComponents& request
             requestComponents.type = ConfigReload;
             return StatusCode::OK;
         }
+        if (std::regex_match(request_path, sm, kfs_sharedmemoryRegex)) {
+            requestComponents.shared_memory_region = sm[1];
+            if (sm[2] == "register" && !requestComponents.shared_memory_region.empty()) {
+                requestComponents.type = KFS_SharedMemoryRegister;
+                return StatusCode::OK;
+            }
+            if (sm[2] == "unregister") {
+                requestComponents.type = KFS_SharedMemoryUnregister;
+                return StatusCode::OK;
+            }
+            return StatusCode::REST_UNSUPPORTED_METHOD;
+        }
+        if (std::regex_match(request_path, sm, profilerRegex)) {
+            requestComponents.type = ProfilerConfig;
+            return StatusCode::OK;
+        }
         if (std::regex_match(request_path, sm, modelstatusRegex))
             return StatusCode::REST_UNSUPPORTED_METHOD;
     } else if (http_method == "GET") {
@@ -782,6 +1043,14 @@ Status HttpRestApiHandler::parseRequestComponents(HttpRequestComponents& request
             requestComponents.type = KFS_GetServerMetadata;
             return StatusCode::OK;
         }
+        if (std::regex_match(request_path, sm, kfs_sharedmemoryRegex)) {
+            if (sm[2] != "status") {
+                return StatusCode::REST_UNSUPPORTED_METHOD;
+            }
+            requestComponents.shared_memory_region = sm[1];
+            requestComponents.type = KFS_SharedMemoryStatus;
+            return StatusCode::OK;
+        }
         if (std::regex_match(request_path, sm, kfs_modelmetadataRegex)) {
             requestComponents.model_name = sm[1];
             std::string model_version_str = sm[2];
@@ -806,10 +1075,41 @@ Status HttpRestApiHandler::parseRequestComponents(HttpRequestComponents& request
             requestComponents.type = Metrics;
             return StatusCode::OK;
         }
+        if (std::regex_match(request_path, sm, profilerRegex)) {
+            requestComponents.type = ProfilerStatus;
+            return StatusCode::OK;
+        }
+        if (std::regex_match(request_path, sm, profilerTraceRegex)) {
+            requestComponents.type = ProfilerTrace;
+            return StatusCode::OK;
+        }
     }
     return StatusCode::REST_INVALID_URL;
 }
 
+Status HttpRestApiHandler::decompressRequestBody(const std::string& contentEncoding, const std::string& request_body, std::optional<std::string>& decompressedBody) {
+    if (contentEncoding.empty()) {
+        return StatusCode::OK;
+    }
+    // HTTP server already inflates gzip encoded bodies when reading them, leaving Content-Encoding header in place
+    if (isGzipEncoding(contentEncoding) && !isGzipCompressed(request_body)) {
+        return StatusCode::OK;
+    }
+    Timer<TIMER_END> timer;
+    timer.start(TOTAL);
+    decompressedBody.emplace();
+    // limit applies to decompressed body as well, protecting against decompression bombs
+    auto status = decompress(request_body, contentEncoding, this->maxBodySize, decompressedBody.value());
+    if (!status.ok()) {
+        SPDLOG_DEBUG("Failed to decompress {} bytes of REST request body with Content-Encoding: {}", request_body.size(), contentEncoding);
+        return status;
+    }
+    timer.stop(TOTAL);
+    SPDLOG_DEBUG("REST request body decompressed with {} from {} to {} bytes in {} ms", contentEncoding, request_body.size(), decompressedBody.value().size(),
+        timer.elapsed<std::chrono::microseconds>(TOTAL) / 1000);
+    return StatusCode::OK;
+}
+
 Status HttpRestApiHandler::processRequest(
     const std::string_view http_method,
     const std::string_view request_path,
@@ -834,7 +1134,12 @@ Status HttpRestApiHandler::processRequest(
 
     if (!status.ok())
         return status;
-    return dispatchToProcessor(request_body, response, requestComponents, responseComponents);
+    RequestScope requestScope(requestComponents.priority.value_or(RequestScope::currentPriority()));
+    std::optional<std::string> decompressedBody;
+    status = decompressRequestBody(requestComponents.contentEncoding, request_body, decompressedBody);
+    if (!status.ok())
+        return status;
+    return dispatchToProcessor(decompressedBody.has_value() ? decompressedBody.value() : request_body, response, requestComponents, responseComponents);
 }
 
 Status HttpRestApiHandler::processPredictRequest(
@@ -842,8 +1147,11 @@ Status HttpRestApiHandler::processPredictRequest(
     const std::optional<int64_t>& modelVersion,
     const std::optional<std::string_view>& modelVersionLabel,
     const std::string& request,
-    std::string* response) {
+    std::string* response,
+    std::optional<int>& inferenceHeaderContentLength) {
     // model_version_label currently is not in use
+    OVMS_PROFILE_REQUEST("REST Predict");
+    OVMS_PROFILE_FUNCTION();
 
     Timer<TIMER_END> timer;
     timer.start(TOTAL);
@@ -854,16 +1162,20 @@ Status HttpRestApiHandler::processPredictRequest(
         modelName, modelVersionLog);
 
     Order requestOrder;
-    tensorflow::serving::PredictResponse responseProto;
+    bool binaryDataOutput = false;
+    auto arena = ProtobufArenaPool::acquire();
+    tensorflow::serving::PredictResponse& responseProto = *arena.create<tensorflow::serving::PredictResponse>();
     Status status;
+    AccessLogRecord accessLog(ExecutionContext{ExecutionContext::Interface::REST, ExecutionContext::Method::Predict},
+        modelName, modelVersion.value_or(0), status);
 
     ServableMetricReporter* reporterOut = nullptr;
     if (this->modelManager.modelExists(modelName)) {
         SPDLOG_DEBUG("Found model with name: {}. Searching for requested version...", modelName);
-        status = processSingleModelRequest(modelName, modelVersion, request, requestOrder, responseProto, reporterOut);
+        status = processSingleModelRequest(modelName, modelVersion, request, requestOrder, binaryDataOutput, responseProto, reporterOut);
     } else if (this->modelManager.pipelineDefinitionExists(modelName)) {
         SPDLOG_DEBUG("Found pipeline with name: {}", modelName);
-        status = processPipelineRequest(modelName, request, requestOrder, responseProto, reporterOut);
+        status = processPipelineRequest(modelName, request, requestOrder, binaryDataOutput, responseProto, reporterOut);
     } else {
         SPDLOG_DEBUG("Model or pipeline matching request parameters not found - name: {}, version: {}", modelName, modelVersionLog);
         status = StatusCode::MODEL_NAME_MISSING;
@@ -874,9 +1186,17 @@ Status HttpRestApiHandler::processPredictRequest(
         return StatusCode::INTERNAL_ERROR;  // should not happen
     }
 
-    status = makeJsonFromPredictResponse(responseProto, response, requestOrder);
+    timer.start(RENDER_JSON_RESPONSE);
+    if (binaryDataOutput) {
+        status = makeBinaryFromPredictResponse(responseProto, response, inferenceHeaderContentLength);
+    } else {
+        status = makeJsonFromPredictResponse(responseProto, response, requestOrder);
+    }
     if (!status.ok())
         return status;
+    timer.stop(RENDER_JSON_RESPONSE);
+    OBSERVE_IF_ENABLED(reporterOut->responseRenderTimeRest, timer.elapsed<std::chrono::microseconds>(RENDER_JSON_RESPONSE));
+    accessLog.addStage("render_json_response", timer.elapsed<std::chrono::microseconds>(RENDER_JSON_RESPONSE));
 
     timer.stop(TOTAL);
     double requestTime = timer.elapsed<std::chrono::microseconds>(TOTAL);
@@ -889,6 +1209,7 @@ Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelNam
     const std::optional<int64_t>& modelVersion,
     const std::string& request,
     Order& requestOrder,
+    bool& binaryDataOutput,
     tensorflow::serving::PredictResponse& responseProto,
     ServableMetricReporter*& reporterOut) {
 
@@ -911,15 +1232,18 @@ Status HttpRestApiHandler::processSingleModelRequest(const std::string& modelNam
     reporterOut = &modelInstance->getMetricReporter();
     Timer<TIMER_END> timer;
     timer.start(TOTAL);
-    TFSRestParser requestParser(modelInstance->getInputsInfo());
+    auto arena = ProtobufArenaPool::acquire();
+    TFSRestParser requestParser(modelInstance->getInputsInfo(), arena.get());
     status = requestParser.parse(request.c_str());
     if (!status.ok()) {
         INCREMENT_IF_ENABLED(modelInstance->getMetricReporter().requestFailRestPredict);
         return status;
     }
     requestOrder = requestParser.getOrder();
+    binaryDataOutput = requestParser.isBinaryDataOutputRequested();
     timer.stop(TOTAL);
     SPDLOG_DEBUG("JSON request parsing time: {} ms", timer.elapsed<std::chrono::microseconds>(TOTAL) / 1000);
+    OBSERVE_IF_ENABLED(reporterOut->requestParseTimeRest, timer.elapsed<std::chrono::microseconds>(TOTAL));
 
     tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
     requestProto.mutable_model_spec()->set_name(modelName);
@@ -968,9 +1292,12 @@ Status HttpRestApiHandler::getPipelineInputsAndReporter(const std::string& model
 Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
     const std::string& request,
     Order& requestOrder,
+    bool& binaryDataOutput,
     tensorflow::serving::PredictResponse& responseProto,
     ServableMetricReporter*& reporterOut) {
     ExecutionContext executionContext{ExecutionContext::Interface::REST, ExecutionContext::Method::Predict};
+    // leased before pipeline, so that request outlives it
+    auto arena = ProtobufArenaPool::acquire();
     std::unique_ptr<Pipeline> pipelinePtr;
 
     Timer<TIMER_END> timer;
@@ -984,15 +1311,17 @@ Status HttpRestApiHandler::processPipelineRequest(const std::string& modelName,
         return status;
     }
 
-    TFSRestParser requestParser(inputs);
+    TFSRestParser requestParser(inputs, arena.get());
     status = requestParser.parse(request.c_str());
     if (!status.ok()) {
         INCREMENT_IF_ENABLED(reporterOut->getInferRequestMetric(executionContext, false));
         return status;
     }
     requestOrder = requestParser.getOrder();
+    binaryDataOutput = requestParser.isBinaryDataOutputRequested();
     timer.stop(TOTAL);
     SPDLOG_DEBUG("JSON request parsing time: {} ms", timer.elapsed<std::chrono::microseconds>(TOTAL) / 1000);
+    OBSERVE_IF_ENABLED(reporterOut->requestParseTimeRest, timer.elapsed<std::chrono::microseconds>(TOTAL));
 
     tensorflow::serving::PredictRequest& requestProto = requestParser.getProto();
     requestProto.mutable_model_spec()->set_name(modelName);
@@ -1143,4 +1472,60 @@ Status HttpRestApiHandler::processConfigStatusRequest(std::string& response, Mod
     return StatusCode::OK;
 }
 
+Status HttpRestApiHandler::processProfilerStatusRequest(std::string& response) {
+    auto& tracer = SampledTracer::instance();
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("enable");
+    writer.Bool(tracer.isEnabled());
+    writer.Key("sampling_rate");
+    writer.Uint(tracer.getSamplingRate());
+    writer.Key("retention_seconds");
+    writer.Uint(tracer.getRetentionSeconds());
+    writer.EndObject();
+    response = buffer.GetString();
+    return StatusCode::OK;
+}
+
+Status HttpRestApiHandler::processProfilerConfigRequest(const std::string& request_body, std::string& response) {
+    auto& tracer = SampledTracer::instance();
+    bool enable = tracer.isEnabled();
+    uint32_t samplingRate = tracer.getSamplingRate();
+    uint32_t retentionSeconds = tracer.getRetentionSeconds();
+
+    rapidjson::Document doc;
+    if (doc.Parse(request_body.c_str()).HasParseError() || !doc.IsObject()) {
+        SPDLOG_DEBUG("Profiler settings are not a valid JSON object");
+        return StatusCode::REST_PROFILER_SETTINGS_INVALID;
+    }
+    if (doc.HasMember("enable")) {
+        if (!doc["enable"].IsBool()) {
+            return StatusCode::REST_PROFILER_SETTINGS_INVALID;
+        }
+        enable = doc["enable"].GetBool();
+    }
+    if (doc.HasMember("sampling_rate")) {
+        if (!doc["sampling_rate"].IsUint() || doc["sampling_rate"].GetUint() == 0) {
+            return StatusCode::REST_PROFILER_SETTINGS_INVALID;
+        }
+        samplingRate = doc["sampling_rate"].GetUint();
+    }
+    if (doc.HasMember("retention_seconds")) {
+        if (!doc["retention_seconds"].IsUint() || doc["retention_seconds"].GetUint() == 0) {
+            return StatusCode::REST_PROFILER_SETTINGS_INVALID;
+        }
+        retentionSeconds = doc["retention_seconds"].GetUint();
+    }
+    tracer.configure(enable, samplingRate, retentionSeconds);
+    SPDLOG_INFO("Sampled profiler {}, sampling rate: 1 in {} requests, retention: {} seconds",
+        enable ? "enabled" : "disabled", samplingRate, retentionSeconds);
+    return processProfilerStatusRequest(response);
+}
+
+Status HttpRestApiHandler::processProfilerTraceRequest(std::string& response) {
+    response = SampledTracer::instance().dump();
+    return StatusCode::OK;
+}
+
 }  // namespace ovms
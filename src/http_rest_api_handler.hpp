@@ -15,8 +15,12 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
 #include <functional>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
 #include <string>
 #include <utility>
@@ -27,11 +31,15 @@
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 #pragma GCC diagnostic pop
 
+#include "metric.hpp"
+#include "request_scope.hpp"
 #include "rest_parser.hpp"
 #include "status.hpp"
 
 namespace ovms {
 class ServableMetricReporter;
+class MetricConfig;
+class MetricRegistry;
 class KFSInferenceServiceImpl;
 class GetModelMetadataImpl;
 class Server;
@@ -48,7 +56,13 @@ enum RequestType { Predict,
     KFS_GetServerReady,
     KFS_GetServerLive,
     KFS_GetServerMetadata,
-    Metrics };
+    Metrics,
+    ProfilerStatus,
+    ProfilerConfig,
+    ProfilerTrace,
+    KFS_SharedMemoryStatus,
+    KFS_SharedMemoryRegister,
+    KFS_SharedMemoryUnregister };
 
 struct HttpRequestComponents {
     RequestType type;
@@ -58,11 +72,28 @@ struct HttpRequestComponents {
     std::optional<std::string_view> model_version_label;
     std::string processing_method;
     std::string model_subresource;
+    std::string shared_memory_region;
     std::optional<int> inferenceHeaderContentLength;
+    std::string acceptEncoding;
+    std::string contentEncoding;
+    std::optional<RequestPriority> priority;
 };
 
 struct HttpResponseComponents {
     std::optional<int> inferenceHeaderContentLength;
+    std::optional<std::string> contentEncoding;
+};
+
+/**
+ * @brief Load of the REST server updated by its event loops and workers, reported on metrics endpoint
+ */
+struct RestServerLoad {
+    // requests being processed by REST workers
+    std::atomic<int64_t> activeRequests{0};
+    // requests with complete body waiting for a free REST worker
+    std::atomic<int64_t> queuedRequests{0};
+    // requests rejected over rest_max_concurrent_requests
+    std::atomic<uint64_t> rejectedRequests{0};
 };
 
 class HttpRestApiHandler {
@@ -78,15 +109,22 @@ public:
 
     static const std::string metricsRegexExp;
 
+    static const std::string profilerRegexExp;
+    static const std::string profilerTraceRegexExp;
+
     static const std::string kfs_serverreadyRegexExp;
     static const std::string kfs_serverliveRegexExp;
     static const std::string kfs_servermetadataRegexExp;
+
+    static const std::string kfs_sharedmemoryRegexExp;
     /**
      * @brief Construct a new HttpRest Api Handler
      *
      * @param timeout_in_ms
+     * @param serverLoad load of the REST server reported on metrics endpoint, may be null
+     * @param maxBodySize limit of decompressed request body size, rest_max_body_size if not set
      */
-    HttpRestApiHandler(ovms::Server& ovmsServer, int timeout_in_ms);
+    HttpRestApiHandler(ovms::Server& ovmsServer, int timeout_in_ms, std::shared_ptr<const RestServerLoad> serverLoad = nullptr, std::optional<uint64_t> maxBodySize = std::nullopt);
 
     Status parseRequestComponents(HttpRequestComponents& components,
         const std::string_view http_method,
@@ -133,6 +171,7 @@ public:
      * @param modelVersionLabel
      * @param request
      * @param response
+     * @param inferenceHeaderContentLength set when outputs are sent as binary data
      *
      * @return StatusCode
      */
@@ -141,13 +180,15 @@ public:
         const std::optional<int64_t>& modelVersion,
         const std::optional<std::string_view>& modelVersionLabel,
         const std::string& request,
-        std::string* response);
+        std::string* response,
+        std::optional<int>& inferenceHeaderContentLength);
 
     Status processSingleModelRequest(
         const std::string& modelName,
         const std::optional<int64_t>& modelVersion,
         const std::string& request,
         Order& requestOrder,
+        bool& binaryDataOutput,
         tensorflow::serving::PredictResponse& responseProto,
         ServableMetricReporter*& reporterOut);
 
@@ -155,6 +196,7 @@ public:
         const std::string& modelName,
         const std::string& request,
         Order& requestOrder,
+        bool& binaryDataOutput,
         tensorflow::serving::PredictResponse& responseProto,
         ServableMetricReporter*& reporterOut);
 
@@ -197,12 +239,20 @@ public:
     Status processModelMetadataKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
     Status processModelReadyKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
     Status processInferKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, std::optional<int>& inferenceHeaderContentLength);
-    Status processMetrics(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
+    Status processMetrics(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body, HttpResponseComponents& response_components);
+
+    Status processProfilerStatusRequest(std::string& response);
+    Status processProfilerConfigRequest(const std::string& request_body, std::string& response);
+    Status processProfilerTraceRequest(std::string& response);
 
     Status processServerReadyKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
     Status processServerLiveKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
     Status processServerMetadataKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
 
+    Status processSharedMemoryStatusKFSRequest(const HttpRequestComponents& request_components, std::string& response);
+    Status processSharedMemoryRegisterKFSRequest(const HttpRequestComponents& request_components, std::string& response, const std::string& request_body);
+    Status processSharedMemoryUnregisterKFSRequest(const HttpRequestComponents& request_components, std::string& response);
+
 private:
     const std::regex predictionRegex;
     const std::regex modelstatusRegex;
@@ -216,17 +266,53 @@ private:
     const std::regex kfs_serverreadyRegex;
     const std::regex kfs_serverliveRegex;
     const std::regex kfs_servermetadataRegex;
+    const std::regex kfs_sharedmemoryRegex;
 
     const std::regex metricsRegex;
 
+    const std::regex profilerRegex;
+    const std::regex profilerTraceRegex;
+
     std::map<RequestType, std::function<Status(const HttpRequestComponents&, std::string&, const std::string&, HttpResponseComponents&)>> handlers;
     int timeout_in_ms;
+    const uint32_t compressionThreshold;
+    const uint64_t maxBodySize;
 
     ovms::Server& ovmsServer;
     ovms::KFSInferenceServiceImpl& kfsGrpcImpl;
     const GetModelMetadataImpl& grpcGetModelMetadataImpl;
     ovms::ModelManager& modelManager;
 
+    std::once_flag scrapeMetricsCreated;
+    std::unique_ptr<MetricHistogram> metricsScrapeTime;
+    std::unique_ptr<MetricHistogram> metricsScrapeSize;
+    void createScrapeMetrics(MetricRegistry& registry, const MetricConfig& metricConfig);
+
+    std::shared_ptr<const RestServerLoad> serverLoad;
+    std::unique_ptr<MetricGauge> restRequestsActive;
+    std::unique_ptr<MetricGauge> restRequestsQueued;
+    std::unique_ptr<MetricCounter> restRequestsRejected;
+    std::mutex reportedRejectedRequestsMtx;
+    uint64_t reportedRejectedRequests = 0;
+    void createServerLoadMetrics(MetricRegistry& registry, const MetricConfig& metricConfig);
+
+    /**
+     * @brief Copies REST server load to its metrics, done on scrape so that the event loops do not touch metric registry
+     */
+    void reportServerLoad();
+
+    /**
+     * @brief Compresses inference response with content coding accepted by the client if it is not smaller than rest_compression_threshold.
+     * Runs synchronously on the REST worker thread handling the request.
+     */
+    Status compressResponse(const HttpRequestComponents& request_components, std::string& response, HttpResponseComponents& response_components);
+
+    /**
+     * @brief Decompresses request body sent with Content-Encoding header, decompressedBody is left empty if body is not compressed.
+     * Body decompressed to more than maxBodySize bytes is rejected.
+     */
+    Status decompressRequestBody(const std::string& contentEncoding, const std::string& request_body, std::optional<std::string>& decompressedBody);
+
     Status getReporter(const HttpRequestComponents& components, ovms::ServableMetricReporter*& reporter);
     Status getPipelineInputsAndReporter(const std::string& modelName, ovms::tensor_map_t& inputs, ovms::ServableMetricReporter*& reporter);
 };
@@ -15,6 +15,14 @@
 //*****************************************************************************
 #include "http_server.hpp"
 
+#include <netdb.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <regex>
 #include <string>
@@ -33,13 +41,14 @@
 #pragma GCC diagnostic pop
 
 #include "http_rest_api_handler.hpp"
+#include "request_scope.hpp"
 #include "status.hpp"
 
 namespace ovms {
 
 namespace net_http = tensorflow::serving::net_http;
 
-const net_http::HTTPStatusCode http(const ovms::Status& status) {
+net_http::HTTPStatusCode http(const ovms::Status& status) {
     const std::unordered_map<const StatusCode, net_http::HTTPStatusCode> httpStatusMap = {
         {StatusCode::OK, net_http::HTTPStatusCode::OK},
         {StatusCode::OK_RELOADED, net_http::HTTPStatusCode::CREATED},
@@ -52,6 +61,7 @@ const net_http::HTTPStatusCode http(const ovms::Status& status) {
 
         // REST parser failure
         {StatusCode::REST_BODY_IS_NOT_AN_OBJECT, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::REST_PROFILER_SETTINGS_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::REST_PREDICT_UNKNOWN_ORDER, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::REST_INSTANCES_NOT_AN_ARRAY, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::REST_NAMED_INSTANCE_NOT_AN_OBJECT, net_http::HTTPStatusCode::BAD_REQUEST},
@@ -68,6 +78,9 @@ const net_http::HTTPStatusCode http(const ovms::Status& status) {
         {StatusCode::REST_PROTO_TO_STRING_ERROR, net_http::HTTPStatusCode::ERROR},
         {StatusCode::REST_UNSUPPORTED_PRECISION, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE, net_http::HTTPStatusCode::ERROR},
+        {StatusCode::REST_UNSUPPORTED_CONTENT_ENCODING, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::REST_DECOMPRESSION_ERROR, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::REST_TOO_MANY_CONCURRENT_REQUESTS, net_http::HTTPStatusCode::SERVICE_UNAV},
 
         {StatusCode::PATH_INVALID, net_http::HTTPStatusCode::ERROR},
         {StatusCode::FILE_INVALID, net_http::HTTPStatusCode::ERROR},
@@ -111,6 +124,7 @@ const net_http::HTTPStatusCode http(const ovms::Status& status) {
         {StatusCode::INVALID_BATCH_SIZE, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::INVALID_SHAPE, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::INVALID_BUFFER_TYPE, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::INVALID_UNEXPECTED_OUTPUT, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::INVALID_DEVICE_ID, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::INVALID_PRECISION, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::INVALID_VALUE_COUNT, net_http::HTTPStatusCode::BAD_REQUEST},
@@ -127,6 +141,13 @@ const net_http::HTTPStatusCode http(const ovms::Status& status) {
         // Inference
         {StatusCode::OV_INTERNAL_INFERENCE_ERROR, net_http::HTTPStatusCode::ERROR},
 
+        // Admission control
+        {StatusCode::INVALID_PRIORITY, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::INFER_QUEUE_FULL, net_http::HTTPStatusCode::SERVICE_UNAV},
+        {StatusCode::INFER_QUEUE_WAIT_TIMEOUT, net_http::HTTPStatusCode::SERVICE_UNAV},
+        {StatusCode::REQUEST_DEADLINE_EXCEEDED, net_http::HTTPStatusCode::SERVICE_UNAV},
+        {StatusCode::REQUEST_CANCELLED, net_http::HTTPStatusCode::SERVICE_UNAV},
+
         // Serialization
 
         // Should never occur - it should be validated during model loading
@@ -140,6 +161,14 @@ const net_http::HTTPStatusCode http(const ovms::Status& status) {
         {StatusCode::INVALID_NO_OF_CHANNELS, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::BINARY_IMAGES_RESOLUTION_MISMATCH, net_http::HTTPStatusCode::BAD_REQUEST},
         {StatusCode::STRING_VAL_EMPTY, net_http::HTTPStatusCode::BAD_REQUEST},
+
+        // Shared memory
+        {StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, net_http::HTTPStatusCode::CONFLICT},
+        {StatusCode::SHARED_MEMORY_REGION_NOT_FOUND, net_http::HTTPStatusCode::NOT_FOUND},
+        {StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, net_http::HTTPStatusCode::BAD_REQUEST},
+        {StatusCode::SHARED_MEMORY_DISABLED, net_http::HTTPStatusCode::FORBIDDEN},
     };
     auto it = httpStatusMap.find(status.getCode());
     if (it != httpStatusMap.end()) {
@@ -149,26 +178,69 @@ const net_http::HTTPStatusCode http(const ovms::Status& status) {
     }
 }
 
-class RequestExecutor final : public net_http::EventExecutor {
-public:
-    explicit RequestExecutor(int num_threads) :
-        executor_(tensorflow::Env::Default(), "httprestserver", num_threads) {}
+thread_local bool RequestExecutor::runNextInline_ = false;
 
-    void Schedule(std::function<void()> fn) override { executor_.Schedule(fn); }
+RequestExecutor::RequestExecutor(std::shared_ptr<tensorflow::serving::Executor> executor, std::shared_ptr<RestServerLoad> serverLoad) :
+    executor_(std::move(executor)),
+    serverLoad_(std::move(serverLoad)) {}
 
-private:
-    tensorflow::serving::ThreadPoolExecutor executor_;
-};
+void RequestExecutor::runNextInline() {
+    runNextInline_ = true;
+}
+
+void RequestExecutor::Schedule(std::function<void()> fn) {
+    if (runNextInline_) {
+        runNextInline_ = false;
+        fn();
+        return;
+    }
+    serverLoad_->queuedRequests++;
+    executor_->Schedule([serverLoad = serverLoad_, fn = std::move(fn)]() {
+        serverLoad->queuedRequests--;
+        fn();
+    });
+}
+
+RestRequestLimiter::RestRequestLimiter(uint32_t maxConcurrentRequests, std::shared_ptr<RestServerLoad> serverLoad) :
+    maxConcurrentRequests(maxConcurrentRequests),
+    serverLoad(std::move(serverLoad)) {}
+
+bool RestRequestLimiter::tryAcquire() {
+    uint32_t pending = this->pendingRequests++;
+    if (this->maxConcurrentRequests != 0 && pending >= this->maxConcurrentRequests) {
+        this->pendingRequests--;
+        this->serverLoad->rejectedRequests++;
+        return false;
+    }
+    return true;
+}
+
+void RestRequestLimiter::release() {
+    this->pendingRequests--;
+}
 
 class RestApiRequestDispatcher {
 public:
-    RestApiRequestDispatcher(ovms::Server& ovmsServer, int timeout_in_ms) {
-        handler_ = std::make_unique<HttpRestApiHandler>(ovmsServer, timeout_in_ms);
+    RestApiRequestDispatcher(ovms::Server& ovmsServer, int timeout_in_ms, std::shared_ptr<RestServerLoad> serverLoad, uint32_t maxConcurrentRequests) :
+        serverLoad_(serverLoad),
+        limiter_(maxConcurrentRequests, serverLoad) {
+        handler_ = std::make_unique<HttpRestApiHandler>(ovmsServer, timeout_in_ms, serverLoad);
     }
 
+    // Called by event loop once the whole request body is read, returned handler is run by a worker
     net_http::RequestHandler dispatch(net_http::ServerRequestInterface* req) {
+        if (!limiter_.tryAcquire()) {
+            // rejection is not counted as pending, so it must not wait in workers queue
+            RequestExecutor::runNextInline();
+            return [this](net_http::ServerRequestInterface* req) {
+                this->rejectRequest(req);
+            };
+        }
         return [this](net_http::ServerRequestInterface* req) {
+            serverLoad_->activeRequests++;
             this->processRequest(req);
+            serverLoad_->activeRequests--;
+            limiter_.release();
         };
     }
 
@@ -178,6 +250,15 @@ private:
             std::pair<std::string, std::string> header{"Inference-Header-Content-Length", req->GetRequestHeader("Inference-Header-Content-Length")};
             headers->emplace_back(header);
         }
+        if (req->GetRequestHeader("Accept-Encoding").size() > 0) {
+            headers->emplace_back("Accept-Encoding", req->GetRequestHeader("Accept-Encoding"));
+        }
+        if (req->GetRequestHeader("Content-Encoding").size() > 0) {
+            headers->emplace_back("Content-Encoding", req->GetRequestHeader("Content-Encoding"));
+        }
+        if (req->GetRequestHeader(PRIORITY_HEADER).size() > 0) {
+            headers->emplace_back(PRIORITY_HEADER, req->GetRequestHeader(PRIORITY_HEADER));
+        }
     }
     void processRequest(net_http::ServerRequestInterface* req) {
         SPDLOG_DEBUG("REST request {}", req->uri_path());
@@ -206,6 +287,9 @@ private:
             std::pair<std::string, std::string> header{"Inference-Header-Content-Length", std::to_string(responseComponents.inferenceHeaderContentLength.value())};
             headers.emplace_back(header);
         }
+        if (responseComponents.contentEncoding.has_value()) {
+            headers.emplace_back("Content-Encoding", responseComponents.contentEncoding.value());
+        }
         for (const auto& kv : headers) {
             req->OverwriteResponseHeader(kv.first, kv.second);
         }
@@ -218,37 +302,121 @@ private:
         }
         req->ReplyWithStatus(http_status);
     }
+    void rejectRequest(net_http::ServerRequestInterface* req) {
+        const Status status = StatusCode::REST_TOO_MANY_CONCURRENT_REQUESTS;
+        SPDLOG_DEBUG("Processing HTTP/REST request failed: {} {}. Reason: {}: {}",
+            req->http_method(),
+            req->uri_path(),
+            status.string(),
+            limiter_.getMaxConcurrentRequests());
+        req->WriteResponseString("{\"error\": \"" + status.string() + "\"}");
+        req->ReplyWithStatus(http(status));
+    }
 
     std::unique_ptr<HttpRestApiHandler> handler_;
+    std::shared_ptr<RestServerLoad> serverLoad_;
+    RestRequestLimiter limiter_;
 };
 
-std::unique_ptr<http_server> createAndStartHttpServer(const std::string& address, int port, int num_threads, ovms::Server& ovmsServer, int timeout_in_ms) {
-    auto options = std::make_unique<net_http::ServerOptions>();
-    options->AddPort(static_cast<uint32_t>(port));
-    options->SetAddress(address);
-    options->SetExecutor(std::make_unique<RequestExecutor>(num_threads));
+int createReusePortListenSocket(const std::string& address, int port) {
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    struct addrinfo* addresses = nullptr;
+    int ret = getaddrinfo(address.c_str(), std::to_string(port).c_str(), &hints, &addresses);
+    if (ret != 0) {
+        SPDLOG_ERROR("Failed to resolve REST bind address {}: {}", address, gai_strerror(ret));
+        return -1;
+    }
+    int fd = -1;
+    int error = 0;
+    for (struct addrinfo* ai = addresses; ai != nullptr; ai = ai->ai_next) {
+        // event loop requires non-blocking socket
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            error = errno;
+            continue;
+        }
+        int enable = 1;
+        if (setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) == 0 &&
+            setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) == 0 &&
+            bind(fd, ai->ai_addr, ai->ai_addrlen) == 0 &&
+            listen(fd, SOMAXCONN) == 0) {
+            break;
+        }
+        error = errno;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0) {
+        SPDLOG_ERROR("Failed to bind REST server socket to {}:{}: {}", address, port, std::strerror(error));
+    }
+    return fd;
+}
 
-    auto server = net_http::CreateEvHTTPServer(std::move(options));
-    if (server == nullptr) {
-        SPDLOG_ERROR("Failed to create http server");
-        return nullptr;
+static void terminateHttpServers(std::vector<std::unique_ptr<http_server>>& servers) {
+    for (auto& server : servers) {
+        server->Terminate();
+    }
+    for (auto& server : servers) {
+        server->WaitForTermination();
     }
+    servers.clear();
+}
 
+std::vector<std::unique_ptr<http_server>> createAndStartHttpServer(const std::string& address, int port, int num_threads, const HttpServerLimits& limits, ovms::Server& ovmsServer, int timeout_in_ms) {
+    std::vector<std::unique_ptr<http_server>> servers;
+    auto serverLoad = std::make_shared<RestServerLoad>();
+    // each event loop takes one thread of the pool, single event loop leaves num_threads - 1 workers as before
+    auto executor = std::make_shared<tensorflow::serving::ThreadPoolExecutor>(tensorflow::Env::Default(), "httprestserver", num_threads + limits.eventLoops - 1);
     std::shared_ptr<RestApiRequestDispatcher> dispatcher =
-        std::make_shared<RestApiRequestDispatcher>(ovmsServer, timeout_in_ms);
-
-    net_http::RequestHandlerOptions handler_options;
-    server->RegisterRequestDispatcher(
-        [dispatcher](net_http::ServerRequestInterface* req) {
-            return dispatcher->dispatch(req);
-        },
-        handler_options);
-
-    if (server->StartAcceptingRequests()) {
-        SPDLOG_INFO("REST server listening on port {} with {} threads", port, num_threads);
-        return server;
-    }
+        std::make_shared<RestApiRequestDispatcher>(ovmsServer, timeout_in_ms, serverLoad, limits.maxConcurrentRequests);
+
+    for (uint32_t i = 0; i < limits.eventLoops; i++) {
+        auto options = std::make_unique<net_http::ServerOptions>();
+        options->AddPort(static_cast<uint32_t>(port));
+        options->SetAddress(address);
+        options->SetMaxBodySize(limits.maxBodySize);
+        int listenSocket = -1;
+        if (limits.eventLoops > 1) {
+            listenSocket = createReusePortListenSocket(address, port);
+            if (listenSocket < 0) {
+                terminateHttpServers(servers);
+                return servers;
+            }
+            options->SetListenSocket(listenSocket);
+        }
+        options->SetExecutor(std::make_unique<RequestExecutor>(executor, serverLoad));
+
+        auto server = net_http::CreateEvHTTPServer(std::move(options));
+        if (server == nullptr) {
+            SPDLOG_ERROR("Failed to create http server");
+            // server takes ownership of listen socket only when it starts accepting connections
+            if (listenSocket >= 0) {
+                close(listenSocket);
+            }
+            terminateHttpServers(servers);
+            return servers;
+        }
 
-    return nullptr;
+        net_http::RequestHandlerOptions handler_options;
+        server->RegisterRequestDispatcher(
+            [dispatcher](net_http::ServerRequestInterface* req) {
+                return dispatcher->dispatch(req);
+            },
+            handler_options);
+
+        if (!server->StartAcceptingRequests()) {
+            SPDLOG_ERROR("Failed to start http server on port {}", port);
+            terminateHttpServers(servers);
+            return servers;
+        }
+        servers.emplace_back(std::move(server));
+    }
+    SPDLOG_INFO("REST server listening on port {} with {} threads and {} event loops", port, num_threads, limits.eventLoops);
+    return servers;
 }
 }  // namespace ovms
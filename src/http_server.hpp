@@ -15,27 +15,105 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wall"
+#include "tensorflow_serving/util/executor.h"
 #include "tensorflow_serving/util/net_http/server/public/httpserver_interface.h"
+#include "tensorflow_serving/util/net_http/server/public/response_code_enum.h"
 #pragma GCC diagnostic pop
 
 namespace ovms {
 class Server;
+class Status;
+struct RestServerLoad;
 
 using http_server = tensorflow::serving::net_http::HTTPServerInterface;
 
+struct HttpServerLimits {
+    // event loops accepting connections on the same port, each is a separate http server
+    uint32_t eventLoops = 1;
+    // larger request bodies are rejected by the event loop with 413
+    size_t maxBodySize = 1024 * 1024 * 1024;
+    // requests queued and processed by workers at once, 0 for no limit
+    uint32_t maxConcurrentRequests = 0;
+};
+
+/**
+ * @brief Maps status of processed request to HTTP status code of the response
+ */
+tensorflow::serving::net_http::HTTPStatusCode http(const ovms::Status& status);
+
+/**
+ * @brief Schedules request handlers on workers shared by all event loops, each event loop takes one of them for event polling
+ */
+class RequestExecutor final : public tensorflow::serving::net_http::EventExecutor {
+public:
+    RequestExecutor(std::shared_ptr<tensorflow::serving::Executor> executor, std::shared_ptr<RestServerLoad> serverLoad);
+
+    /**
+     * @brief Makes the next handler scheduled by the calling event loop thread run inline instead of on a worker.
+     * Used for rejected requests, so that they are answered without waiting behind requests queued for workers.
+     */
+    static void runNextInline();
+
+    void Schedule(std::function<void()> fn) override;
+
+private:
+    static thread_local bool runNextInline_;
+
+    std::shared_ptr<tensorflow::serving::Executor> executor_;
+    std::shared_ptr<RestServerLoad> serverLoad_;
+};
+
+/**
+ * @brief Limits requests dispatched to workers and not finished yet
+ */
+class RestRequestLimiter {
+public:
+    /**
+     * @param maxConcurrentRequests 0 for no limit
+     */
+    RestRequestLimiter(uint32_t maxConcurrentRequests, std::shared_ptr<RestServerLoad> serverLoad);
+
+    /**
+     * @return false if the limit is reached, the request is then counted as rejected
+     */
+    bool tryAcquire();
+
+    void release();
+
+    uint32_t getMaxConcurrentRequests() const { return this->maxConcurrentRequests; }
+
+private:
+    const uint32_t maxConcurrentRequests;
+    std::shared_ptr<RestServerLoad> serverLoad;
+    std::atomic<uint32_t> pendingRequests{0};
+};
+
 /**
  * @brief Creates a and starts Http Server
  * 
  * @param port 
- * @param num_threads 
+ * @param num_threads workers shared by all event loops
+ * @param limits
  * @param timeout_in_m not implemented
  *  
- * @return std::unique_ptr<http_server> 
+ * @return http servers, one per event loop, empty if any of them failed to start
+ */
+std::vector<std::unique_ptr<http_server>> createAndStartHttpServer(const std::string& address, int port, int num_threads, const HttpServerLimits& limits, ovms::Server& ovmsServer, int timeout_in_ms = -1);
+
+/**
+ * @brief Creates socket listening on address and port with SO_REUSEPORT, so that each event loop accepts connections on its own socket
+ *
+ * @return socket descriptor or -1 on failure
  */
-std::unique_ptr<http_server> createAndStartHttpServer(const std::string& address, int port, int num_threads, ovms::Server& ovmsServer, int timeout_in_ms = -1);
+int createReusePortListenSocket(const std::string& address, int port);
 }  // namespace ovms
@@ -34,9 +34,14 @@ Status HTTPServerModule::start(const ovms::Config& config) {
     const std::string server_address = config.restBindAddress() + ":" + std::to_string(config.restPort());
     int workers = config.restWorkers() ? config.restWorkers() : 10;
 
+    HttpServerLimits limits;
+    limits.eventLoops = config.restEventLoops();
+    limits.maxBodySize = config.restMaxBodySize();
+    limits.maxConcurrentRequests = config.restMaxConcurrentRequests();
+
     SPDLOG_INFO("Will start {} REST workers", workers);
-    server = ovms::createAndStartHttpServer(config.restBindAddress(), config.restPort(), workers, this->ovmsServer);
-    if (server == nullptr) {
+    servers = ovms::createAndStartHttpServer(config.restBindAddress(), config.restPort(), workers, limits, this->ovmsServer);
+    if (servers.empty()) {
         std::stringstream ss;
         ss << "at " << server_address;
         auto status = Status(StatusCode::FAILED_TO_START_REST_SERVER, ss.str());
@@ -49,13 +54,17 @@ Status HTTPServerModule::start(const ovms::Config& config) {
     return StatusCode::OK;
 }
 void HTTPServerModule::shutdown() {
-    if (server == nullptr)
+    if (servers.empty())
         return;
     SPDLOG_INFO("{} shutting down", HTTP_SERVER_MODULE_NAME);
     state = ModuleState::STARTED_SHUTDOWN;
-    server->Terminate();
-    server->WaitForTermination();
-    server.reset();
+    for (auto& server : servers) {
+        server->Terminate();
+    }
+    for (auto& server : servers) {
+        server->WaitForTermination();
+    }
+    servers.clear();
     SPDLOG_INFO("Shutdown HTTP server");
     state = ModuleState::SHUTDOWN;
 }
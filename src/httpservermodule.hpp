@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "http_server.hpp"
 #include "module.hpp"
@@ -25,7 +26,8 @@ namespace ovms {
 class Config;
 class Server;
 class HTTPServerModule : public Module {
-    std::unique_ptr<ovms::http_server> server;
+    // one server per REST event loop
+    std::vector<std::unique_ptr<ovms::http_server>> servers;
     Server& ovmsServer;
 
 public:
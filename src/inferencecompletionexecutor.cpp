@@ -0,0 +1,104 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "inferencecompletionexecutor.hpp"
+
+#include <exception>
+#include <utility>
+
+#include <spdlog/spdlog.h>
+
+namespace ovms {
+
+InferenceCompletionExecutor::InferenceCompletionExecutor(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    this->workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        this->workers.emplace_back([this]() { this->run(); });
+    }
+}
+
+InferenceCompletionExecutor::~InferenceCompletionExecutor() {
+    {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        if (this->pending > 0) {
+            SPDLOG_DEBUG("Waiting for {} asynchronous inferences to complete", this->pending);
+        }
+        this->pendingEmpty.wait(lock, [this]() { return this->pending == 0; });
+        this->stopped = true;
+        this->taskAvailable.notify_all();
+    }
+    for (auto& worker : this->workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void InferenceCompletionExecutor::expect() {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    this->pending++;
+}
+
+void InferenceCompletionExecutor::withdraw() {
+    this->finished();
+}
+
+void InferenceCompletionExecutor::submit(std::function<void()> task) {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    this->tasks.push(std::move(task));
+    this->taskAvailable.notify_one();
+}
+
+size_t InferenceCompletionExecutor::getPendingCount() const {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    return this->pending;
+}
+
+void InferenceCompletionExecutor::finished() {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    if (--this->pending == 0) {
+        this->pendingEmpty.notify_all();
+    }
+}
+
+void InferenceCompletionExecutor::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mtx);
+            this->taskAvailable.wait(lock, [this]() { return this->stopped || !this->tasks.empty(); });
+            if (this->tasks.empty()) {
+                return;
+            }
+            task = std::move(this->tasks.front());
+            this->tasks.pop();
+        }
+        try {
+            task();
+        } catch (const std::exception& e) {
+            SPDLOG_ERROR("Unexpected exception while completing asynchronous inference: {}", e.what());
+        } catch (...) {
+            SPDLOG_ERROR("Unexpected exception while completing asynchronous inference");
+        }
+        // Task is destroyed before announcing completion, it may own resources of the inference
+        task = nullptr;
+        this->finished();
+    }
+}
+
+}  // namespace ovms
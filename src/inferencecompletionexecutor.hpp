@@ -0,0 +1,76 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ovms {
+
+/**
+ * @brief Small pool of threads finishing asynchronous inferences.
+ *
+ * OpenVINO completion callbacks run on plugin threads, so they only hand
+ * the request over to this executor. Workers then collect the outputs,
+ * release the infer request back to its queue and notify the caller.
+ * Every started request is announced with expect() so that the executor
+ * can wait for in-flight inferences before shutting down.
+ */
+class InferenceCompletionExecutor {
+public:
+    explicit InferenceCompletionExecutor(size_t threadCount);
+    ~InferenceCompletionExecutor();
+
+    InferenceCompletionExecutor(const InferenceCompletionExecutor&) = delete;
+    InferenceCompletionExecutor& operator=(const InferenceCompletionExecutor&) = delete;
+
+    /**
+     * @brief Announce an inference that will later submit its completion
+     */
+    void expect();
+
+    /**
+     * @brief Withdraw an announced inference which failed to start
+     */
+    void withdraw();
+
+    /**
+     * @brief Queue completion of an announced inference. Safe to call from OpenVINO callbacks.
+     */
+    void submit(std::function<void()> task);
+
+    size_t getPendingCount() const;
+
+private:
+    void run();
+    void finished();
+
+    // Notifications are sent under the lock so that submitting thread
+    // never touches the executor after its task could have been finished
+    mutable std::mutex mtx;
+    std::condition_variable taskAvailable;
+    std::condition_variable pendingEmpty;
+    std::queue<std::function<void()>> tasks;
+    size_t pending = 0;
+    bool stopped = false;
+    std::vector<std::thread> workers;
+};
+
+}  // namespace ovms
@@ -15,6 +15,9 @@
 //*****************************************************************************
 #include "inferencerequest.hpp"
 
+#include <utility>
+
+#include "inferenceresponse.hpp"
 #include "status.hpp"
 namespace ovms {
 // this constructor can be removed with prediction tests overhaul
@@ -31,6 +34,18 @@ const std::string& InferenceRequest::getServableName() const {
 model_version_t InferenceRequest::getServableVersion() const {
     return this->servableVersion;
 }
+void InferenceRequest::prepare(std::shared_ptr<Model> model) {
+    this->preparedModel = std::move(model);
+    if (!this->responsePool) {
+        this->responsePool = std::make_shared<InferenceResponsePool>(this->servableName, this->servableVersion);
+    }
+}
+const std::shared_ptr<Model>& InferenceRequest::getPreparedModel() const {
+    return this->preparedModel;
+}
+const std::shared_ptr<InferenceResponsePool>& InferenceRequest::getResponsePool() const {
+    return this->responsePool;
+}
 Status InferenceRequest::addInput(const char* name, OVMS_DataType datatype, const size_t* shape, size_t dimCount) {
     auto [it, emplaced] = inputs.emplace(name, InferenceTensor{datatype, shape, dimCount});
     return emplaced ? StatusCode::OK : StatusCode::DOUBLE_TENSOR_INSERT;
@@ -72,6 +87,44 @@ Status InferenceRequest::removeInput(const char* name) {
     }
     return StatusCode::NONEXISTENT_TENSOR_FOR_REMOVAL;
 }
+Status InferenceRequest::addOutput(const char* name, OVMS_DataType datatype, const size_t* shape, size_t dimCount) {
+    auto [it, emplaced] = outputs.emplace(name, InferenceTensor{datatype, shape, dimCount});
+    return emplaced ? StatusCode::OK : StatusCode::DOUBLE_TENSOR_INSERT;
+}
+Status InferenceRequest::getOutput(const char* name, const InferenceTensor** tensor) const {
+    auto it = outputs.find(name);
+    if (it == outputs.end()) {
+        *tensor = nullptr;
+        return StatusCode::NONEXISTENT_TENSOR;
+    }
+    *tensor = &it->second;
+    return StatusCode::OK;
+}
+uint64_t InferenceRequest::getOutputsSize() const {
+    return outputs.size();
+}
+Status InferenceRequest::removeOutput(const char* name) {
+    auto count = outputs.erase(name);
+    if (count) {
+        return StatusCode::OK;
+    }
+    return StatusCode::NONEXISTENT_TENSOR_FOR_REMOVAL;
+}
+Status InferenceRequest::setOutputBuffer(const char* name, void* addr, size_t byteSize, OVMS_BufferType bufferType, std::optional<uint32_t> deviceId) {
+    auto it = outputs.find(name);
+    if (it == outputs.end()) {
+        return StatusCode::NONEXISTENT_TENSOR_FOR_SET_BUFFER;
+    }
+    // output buffer is never copied, results are written directly to caller memory
+    return it->second.setBuffer(addr, byteSize, bufferType, deviceId);
+}
+Status InferenceRequest::removeOutputBuffer(const char* name) {
+    auto it = outputs.find(name);
+    if (it == outputs.end()) {
+        return StatusCode::NONEXISTENT_TENSOR_FOR_REMOVE_BUFFER;
+    }
+    return it->second.removeBuffer();
+}
 Status InferenceRequest::addParameter(const char* parameterName, OVMS_DataType datatype, const void* data) {
     auto [it, emplaced] = parameters.emplace(parameterName, InferenceParameter{parameterName, datatype, data});
     return emplaced ? StatusCode::OK : StatusCode::DOUBLE_PARAMETER_INSERT;
@@ -15,6 +15,7 @@
 // limitations under the License.
 //*****************************************************************************
 #include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -25,6 +26,8 @@
 
 namespace ovms {
 
+class InferenceResponsePool;
+class Model;
 class Status;
 
 class InferenceRequest {
@@ -32,6 +35,10 @@ class InferenceRequest {
     const model_version_t servableVersion;
     std::unordered_map<std::string, InferenceParameter> parameters;
     std::unordered_map<std::string, InferenceTensor> inputs;
+    std::unordered_map<std::string, InferenceTensor> outputs;
+    // Set when request is prepared for repeated inference
+    std::shared_ptr<Model> preparedModel;
+    std::shared_ptr<InferenceResponsePool> responsePool;
 
 public:
     // this constructor can be removed with prediction tests overhaul
@@ -45,6 +52,12 @@ public:
 
     Status setInputBuffer(const char* name, const void* addr, size_t byteSize, OVMS_BufferType, std::optional<uint32_t> deviceId);
     Status removeInputBuffer(const char* name);
+    Status addOutput(const char* name, OVMS_DataType datatype, const size_t* shape, size_t dimCount);
+    Status getOutput(const char* name, const InferenceTensor** tensor) const;
+    uint64_t getOutputsSize() const;
+    Status removeOutput(const char* name);
+    Status setOutputBuffer(const char* name, void* addr, size_t byteSize, OVMS_BufferType, std::optional<uint32_t> deviceId);
+    Status removeOutputBuffer(const char* name);
     Status addParameter(const char* parameterName, OVMS_DataType datatype, const void* data);
     Status removeParameter(const char* parameterName);
     const InferenceParameter* getParameter(const char* name) const;
@@ -64,5 +77,9 @@ public:
 
     Status getBatchSize(size_t& batchSize, size_t batchSizeIndex) const;
     std::map<std::string, shape_t> getRequestShapes() const;
+
+    void prepare(std::shared_ptr<Model> model);
+    const std::shared_ptr<Model>& getPreparedModel() const;
+    const std::shared_ptr<InferenceResponsePool>& getResponsePool() const;
 };
 }  // namespace ovms
@@ -20,6 +20,7 @@
 #include <unordered_map>
 #include <utility>
 
+#include "buffer.hpp"
 #include "inferenceparameter.hpp"
 #include "inferencetensor.hpp"
 #include "modelversion.hpp"
@@ -44,22 +45,36 @@ model_version_t InferenceResponse::getServableVersion() const {
 }
 
 Status InferenceResponse::addOutput(const std::string& name, OVMS_DataType datatype, const size_t* shape, size_t dimCount) {
+    auto end = outputs.begin() + outputsInUse;
     auto it = std::find_if(outputs.begin(),
-        outputs.end(),
+        end,
         [&name](const std::pair<std::string, InferenceTensor>& pair) {
             return name == pair.first;
         });
-    if (outputs.end() != it) {
+    if (end != it) {
         return StatusCode::DOUBLE_TENSOR_INSERT;
     }
+    if (outputsInUse < outputs.size()) {
+        const auto& [recycledName, recycledTensor] = outputs[outputsInUse];
+        if ((recycledName == name) &&
+            (recycledTensor.getDataType() == datatype) &&
+            std::equal(recycledTensor.getShape().begin(), recycledTensor.getShape().end(), shape, shape + dimCount)) {
+            ++outputsInUse;
+            return StatusCode::OK;
+        }
+        while (outputs.size() > outputsInUse) {
+            outputs.pop_back();
+        }
+    }
 
     auto pair = std::pair<std::string, InferenceTensor>(name, InferenceTensor{datatype, shape, dimCount});
     outputs.push_back(std::move(pair));
+    ++outputsInUse;
     return StatusCode::OK;
 }
 
 Status InferenceResponse::getOutput(uint32_t id, const std::string** name, const InferenceTensor** tensor) const {
-    if (outputs.size() <= id) {
+    if (outputsInUse <= id) {
         *tensor = nullptr;
         return StatusCode::NONEXISTENT_TENSOR;
     }
@@ -93,7 +108,7 @@ const InferenceParameter* InferenceResponse::getParameter(uint32_t id) const {
 }
 
 uint32_t InferenceResponse::getOutputCount() const {
-    return this->outputs.size();
+    return this->outputsInUse;
 }
 
 uint32_t InferenceResponse::getParameterCount() const {
@@ -102,6 +117,60 @@ uint32_t InferenceResponse::getParameterCount() const {
 
 void InferenceResponse::Clear() {
     outputs.clear();
+    outputsInUse = 0;
+    parameters.clear();
+}
+
+void InferenceResponse::recycle() {
+    for (auto& [name, tensor] : outputs) {
+        const Buffer* buffer = tensor.getBuffer();
+        if ((buffer != nullptr) && !buffer->isOwned()) {
+            tensor.removeBuffer();
+        }
+    }
+    outputsInUse = 0;
     parameters.clear();
 }
+
+void InferenceResponse::setPool(std::shared_ptr<InferenceResponsePool> pool) {
+    this->pool = std::move(pool);
+}
+
+std::shared_ptr<InferenceResponsePool> InferenceResponse::getPool() const {
+    return this->pool;
+}
+
+InferenceResponsePool::InferenceResponsePool(const std::string& servableName, model_version_t servableVersion) :
+    servableName(servableName),
+    servableVersion(servableVersion) {}
+
+std::unique_ptr<InferenceResponse> InferenceResponsePool::acquire() {
+    std::unique_ptr<InferenceResponse> response;
+    {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        if (!this->spareResponses.empty()) {
+            response = std::move(this->spareResponses.back());
+            this->spareResponses.pop_back();
+        }
+    }
+    if (!response) {
+        response = std::make_unique<InferenceResponse>(this->servableName, this->servableVersion);
+    }
+    response->setPool(shared_from_this());
+    return response;
+}
+
+void InferenceResponsePool::giveBack(std::unique_ptr<InferenceResponse> response) {
+    // response may hold the last reference to the pool
+    auto self = response->getPool();
+    response->setPool(nullptr);
+    response->recycle();
+    std::unique_lock<std::mutex> lock(this->mtx);
+    this->spareResponses.push_back(std::move(response));
+}
+
+size_t InferenceResponsePool::getSpareCount() {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    return this->spareResponses.size();
+}
 }  // namespace ovms
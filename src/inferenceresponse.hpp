@@ -14,6 +14,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -25,13 +27,17 @@
 
 namespace ovms {
 
+class InferenceResponsePool;
 class Status;
 
 class InferenceResponse {
-    const std::string& servableName;
+    const std::string servableName;
     const model_version_t servableVersion;
     std::vector<InferenceParameter> parameters;
     std::vector<std::pair<std::string, InferenceTensor>> outputs;
+    // Outputs past this index are kept from previous use of recycled response
+    size_t outputsInUse = 0;
+    std::shared_ptr<InferenceResponsePool> pool;
 
 public:
     // this constructor can be removed with prediction tests overhaul
@@ -54,5 +60,24 @@ public:
     InferenceParameter* getInferenceParameter(const char* name);
 
     void Clear();
+    // Prepares response for reuse keeping output tensors and their owned buffers
+    void recycle();
+
+    void setPool(std::shared_ptr<InferenceResponsePool> pool);
+    std::shared_ptr<InferenceResponsePool> getPool() const;
+};
+
+// Keeps responses of prepared C-API inference request for reuse across inferences
+class InferenceResponsePool : public std::enable_shared_from_this<InferenceResponsePool> {
+    const std::string servableName;
+    const model_version_t servableVersion;
+    std::mutex mtx;
+    std::vector<std::unique_ptr<InferenceResponse>> spareResponses;
+
+public:
+    InferenceResponsePool(const std::string& servableName, model_version_t servableVersion);
+    std::unique_ptr<InferenceResponse> acquire();
+    void giveBack(std::unique_ptr<InferenceResponse> response);
+    size_t getSpareCount();
 };
 }  // namespace ovms
@@ -37,6 +37,25 @@ Status InferenceTensor::setBuffer(const void* addr, size_t byteSize, OVMS_Buffer
     buffer = std::make_unique<Buffer>(addr, byteSize, bufferType, deviceId, createCopy);
     return StatusCode::OK;
 }
+Status InferenceTensor::refillBuffer(const void* addr, size_t byteSize) {
+    if ((nullptr == buffer) || !buffer->refill(addr, byteSize)) {
+        return StatusCode::INVALID_CONTENT_SIZE;
+    }
+    return StatusCode::OK;
+}
+ov::Tensor InferenceTensor::getSharedTensor(const ov::element::Type& precision) const {
+    std::unique_lock<std::mutex> lock(this->sharedTensorMtx);
+    if (!this->sharedTensor || (nullptr == this->buffer) ||
+        (this->sharedTensor.data() != this->buffer->data()) ||
+        (this->sharedTensor.get_element_type() != precision)) {
+        return ov::Tensor();
+    }
+    return this->sharedTensor;
+}
+void InferenceTensor::setSharedTensor(const ov::Tensor& tensor) const {
+    std::unique_lock<std::mutex> lock(this->sharedTensorMtx);
+    this->sharedTensor = tensor;
+}
 
 OVMS_DataType InferenceTensor::getDataType() const {
     return this->datatype;
@@ -49,6 +68,7 @@ const Buffer* const InferenceTensor::getBuffer() const {
 }
 Status InferenceTensor::removeBuffer() {
     if (nullptr != this->buffer) {
+        this->setSharedTensor(ov::Tensor());
         this->buffer.reset();
         return StatusCode::OK;
     }
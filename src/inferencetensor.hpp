@@ -15,9 +15,12 @@
 // limitations under the License.
 //*****************************************************************************
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
+#include <openvino/openvino.hpp>
+
 #include "ovms.h"  // NOLINT
 #include "shape.hpp"
 
@@ -29,6 +32,10 @@ class InferenceTensor {
     const OVMS_DataType datatype;
     shape_t shape;
     std::unique_ptr<Buffer> buffer;
+    // ov::Tensor sharing memory with the buffer. Either wraps request input for reuse
+    // by consecutive inferences or keeps alive pipeline result referenced by response output
+    mutable std::mutex sharedTensorMtx;
+    mutable ov::Tensor sharedTensor;
 
 public:
     InferenceTensor(OVMS_DataType datatype, const size_t* shape, size_t dimCount);
@@ -39,8 +46,11 @@ public:
     InferenceTensor& operator=(const InferenceTensor&&);
     Status setBuffer(const void* addr, size_t byteSize, OVMS_BufferType bufferType, std::optional<uint32_t> deviceId, bool createCopy = false);
     Status removeBuffer();
+    Status refillBuffer(const void* addr, size_t byteSize);
     OVMS_DataType getDataType() const;
     const shape_t& getShape() const;
     const Buffer* const getBuffer() const;
+    ov::Tensor getSharedTensor(const ov::element::Type& precision) const;
+    void setSharedTensor(const ov::Tensor& tensor) const;
 };
 }  // namespace ovms
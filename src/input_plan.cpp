@@ -0,0 +1,57 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "input_plan.hpp"
+
+#include "kfs_frontend/kfs_grpc_inference_service.hpp"
+
+namespace ovms {
+
+InputPlan::InputPlan(const tensor_map_t& inputs) :
+    source(&inputs) {
+    this->ordinals.reserve(inputs.size());
+    size_t ordinal = 0;
+    for (const auto& [name, _] : inputs) {
+        this->ordinals.emplace(name, ordinal++);
+    }
+}
+
+bool InputPlan::isBuiltFor(const tensor_map_t& inputs) const {
+    return this->source == &inputs && this->ordinals.size() == inputs.size();
+}
+
+void RequestInputPositions::assign(size_t count, int value) {
+    this->count = count;
+    if (count <= INLINE_CAPACITY) {
+        this->inlinePositions.fill(value);
+    } else {
+        this->heapPositions.assign(count, value);
+    }
+}
+
+void InputPlan::mapRequestInputs(const KFSRequest& request, RequestInputPositions& positions) const {
+    positions.assign(this->ordinals.size(), MISSING);
+    for (int i = 0; i < request.inputs_size(); i++) {
+        auto it = this->ordinals.find(request.inputs(i).name());
+        if (it == this->ordinals.end()) {
+            continue;
+        }
+        // first occurrence wins, the same as when searching request by name
+        if (positions[it->second] == MISSING) {
+            positions[it->second] = i;
+        }
+    }
+}
+}  // namespace ovms
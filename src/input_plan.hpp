@@ -0,0 +1,91 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tensorinfo.hpp"
+
+namespace inference {
+class ModelInferRequest;
+}  // namespace inference
+
+namespace ovms {
+
+/**
+ * @brief Request input index of each servable input in inputs map order, mapped once per request.
+ *
+ * Mapping done by request validation is passed to deserialization, so request inputs are not hashed twice.
+ * Positions of servables with up to INLINE_CAPACITY inputs are stored inline, without heap allocation.
+ */
+class RequestInputPositions {
+public:
+    static constexpr size_t INLINE_CAPACITY = 8;
+
+private:
+    std::array<int, INLINE_CAPACITY> inlinePositions;
+    std::vector<int> heapPositions;
+    size_t count = 0;
+
+public:
+    void assign(size_t count, int value);
+    void clear() { this->count = 0; }
+    bool empty() const { return this->count == 0; }
+    size_t size() const { return this->count; }
+
+    int& operator[](size_t ordinal) {
+        return this->count <= INLINE_CAPACITY ? this->inlinePositions[ordinal] : this->heapPositions[ordinal];
+    }
+    int operator[](size_t ordinal) const {
+        return this->count <= INLINE_CAPACITY ? this->inlinePositions[ordinal] : this->heapPositions[ordinal];
+    }
+};
+
+/**
+ * @brief Lookup table of servable inputs built once when model version is loaded.
+ *
+ * KServe requests keep inputs in a list, so finding each servable input by name requires
+ * scanning whole request. Plan maps all request inputs to servable inputs in a single pass instead,
+ * which is then used by both request validation and deserialization.
+ */
+class InputPlan {
+    const tensor_map_t* source = nullptr;
+    std::unordered_map<std::string, size_t> ordinals;
+
+public:
+    static constexpr int MISSING = -1;
+
+    InputPlan() = default;
+    explicit InputPlan(const tensor_map_t& inputs);
+
+    /**
+     * @brief Checks if plan was built for given inputs, plans of other inputs must not be used
+     */
+    bool isBuiltFor(const tensor_map_t& inputs) const;
+
+    size_t size() const { return this->ordinals.size(); }
+
+    /**
+     * @brief Maps request inputs to servable inputs
+     * @param positions for each servable input in inputs map order - index of request input or MISSING
+     */
+    void mapRequestInputs(const inference::ModelInferRequest& request, RequestInputPositions& positions) const;
+};
+}  // namespace ovms
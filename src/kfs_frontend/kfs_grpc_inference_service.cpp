@@ -15,14 +15,20 @@
 //*****************************************************************************
 #include "kfs_grpc_inference_service.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "../access_log.hpp"
 #include "../deserialization.hpp"
 #include "../execution_context.hpp"
 #include "../grpc_utils.hpp"
 #include "../kfs_frontend/kfs_utils.hpp"
+#include "../kfs_frontend/kfs_stream_infer_session.hpp"
 #include "../metric.hpp"
 #include "../modelinstance.hpp"
 #include "../modelinstanceunloadguard.hpp"
@@ -33,8 +39,11 @@
 #include "../pipelinedefinitionstatus.hpp"
 #include "../pipelinedefinitionunloadguard.hpp"
 #include "../prediction_service_utils.hpp"
+#include "../profiler.hpp"
+#include "../request_scope.hpp"
 #include "../serialization.hpp"
 #include "../servablemanagermodule.hpp"
+#include "../shared_memory_manager.hpp"
 #include "../server.hpp"
 #include "../status.hpp"
 #include "../stringutils.hpp"
@@ -52,6 +61,13 @@ enum : unsigned int {
 namespace ovms {
 
 Status KFSInferenceServiceImpl::getModelInstance(const KFSRequest* request,
+    std::shared_ptr<ovms::ModelInstance>& modelInstance,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
+    return getModelInstance(request, nullptr, modelInstance, modelInstanceUnloadGuardPtr);
+}
+
+Status KFSInferenceServiceImpl::getModelInstance(const KFSRequest* request,
+    const std::shared_ptr<Model>& model,
     std::shared_ptr<ovms::ModelInstance>& modelInstance,
     std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) {
     OVMS_PROFILE_FUNCTION();
@@ -65,6 +81,9 @@ Status KFSInferenceServiceImpl::getModelInstance(const KFSRequest* request,
             return StatusCode::MODEL_VERSION_INVALID_FORMAT;
         }
     }
+    if (model) {
+        return this->modelManager.getModelInstance(model, requestedVersion, modelInstance, modelInstanceUnloadGuardPtr);
+    }
     return this->modelManager.getModelInstance(request->model_name(), requestedVersion, modelInstance, modelInstanceUnloadGuardPtr);
 }
 
@@ -75,6 +94,14 @@ Status KFSInferenceServiceImpl::getPipeline(const KFSRequest* request,
     return this->modelManager.createPipeline(pipelinePtr, request->model_name(), request, response);
 }
 
+Status KFSInferenceServiceImpl::getPipeline(const KFSRequest* request,
+    KFSResponse* response,
+    PipelineDefinition& pipelineDefinition,
+    std::unique_ptr<ovms::Pipeline>& pipelinePtr) {
+    OVMS_PROFILE_FUNCTION();
+    return pipelineDefinition.create(pipelinePtr, request, response, this->modelManager);
+}
+
 const std::string PLATFORM = "OpenVINO";
 
 ::grpc::Status KFSInferenceServiceImpl::ServerLive(::grpc::ServerContext* context, const ::inference::ServerLiveRequest* request, ::inference::ServerLiveResponse* response) {
@@ -214,7 +241,9 @@ Status KFSInferenceServiceImpl::ModelMetadataImpl(::grpc::ServerContext* context
     return status;
 }
 
+// TODO messages of synchronous service are allocated by gRPC, placing them on ProtobufArenaPool arenas requires callback service with message allocator
 ::grpc::Status KFSInferenceServiceImpl::ModelInfer(::grpc::ServerContext* context, const KFSRequest* request, KFSResponse* response) {
+    OVMS_PROFILE_REQUEST("gRPC ModelInfer");
     OVMS_PROFILE_FUNCTION();
     Timer<TIMER_END> timer;
     timer.start(TOTAL);
@@ -236,16 +265,41 @@ Status KFSInferenceServiceImpl::ModelMetadataImpl(::grpc::ServerContext* context
     return grpc(status);
 }
 
-Status KFSInferenceServiceImpl::ModelInferImpl(::grpc::ServerContext* context, const KFSRequest* request, KFSResponse* response, ExecutionContext executionContext, ServableMetricReporter*& reporterOut) {
+Status KFSInferenceServiceImpl::ModelInferImpl(::grpc::ServerContext* context, const KFSRequest* request, KFSResponse* response, ExecutionContext executionContext, ServableMetricReporter*& reporterOut, const std::shared_ptr<Model>& model, PipelineDefinition* pipelineDefinition) {
     OVMS_PROFILE_FUNCTION();
     std::shared_ptr<ovms::ModelInstance> modelInstance;
     std::unique_ptr<ovms::Pipeline> pipelinePtr;
 
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
-    auto status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
-    if (status == StatusCode::MODEL_NAME_MISSING) {
-        SPDLOG_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", request->model_name());
-        status = getPipeline(request, response, pipelinePtr);
+    Status status;
+    // version is filled in by the model instance serving the request
+    AccessLogRecord accessLog(executionContext, request->model_name(), 0, status);
+    // request parameter takes precedence over gRPC metadata and HTTP header
+    RequestPriority priority = RequestScope::currentPriority();
+    status = getRequestPriority(context, priority);
+    if (status.ok()) {
+        status = getRequestPriority(request->parameters(), priority);
+    }
+    if (!status.ok()) {
+        SPDLOG_DEBUG("Invalid request priority. {}", status.string());
+        return status;
+    }
+    // REST requests come without gRPC context and keep deadline of the enclosing scope
+    std::optional<RequestScope> requestScope;
+    if (context) {
+        requestScope.emplace(priority, getRequestDeadline(context), getCancellationCheck(context));
+    } else {
+        requestScope.emplace(priority);
+    }
+    SharedMemoryScope sharedMemoryScope(this->sharedMemoryManager);
+    if (pipelineDefinition) {
+        status = getPipeline(request, response, *pipelineDefinition, pipelinePtr);
+    } else {
+        status = getModelInstance(request, model, modelInstance, modelInstanceUnloadGuard);
+        if (status == StatusCode::MODEL_NAME_MISSING) {
+            SPDLOG_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", request->model_name());
+            status = getPipeline(request, response, pipelinePtr);
+        }
     }
     if (!status.ok()) {
         if (modelInstance) {
@@ -261,6 +315,9 @@ Status KFSInferenceServiceImpl::ModelInferImpl(::grpc::ServerContext* context, c
         reporterOut = &modelInstance->getMetricReporter();
         status = modelInstance->infer(request, response, modelInstanceUnloadGuard);
     }
+    if (status.ok()) {
+        status = writeOutputsToSharedMemory(this->sharedMemoryManager, *request, *response);
+    }
     INCREMENT_IF_ENABLED(reporterOut->getInferRequestMetric(executionContext, status.ok()));
     if (!status.ok()) {
         return status;
@@ -269,6 +326,73 @@ Status KFSInferenceServiceImpl::ModelInferImpl(::grpc::ServerContext* context, c
     return StatusCode::OK;
 }
 
+::grpc::Status KFSInferenceServiceImpl::ModelStreamInfer(::grpc::ServerContext* context, ::grpc::ServerReaderWriter<KFSStreamResponse, KFSRequest>* stream) {
+    OVMS_PROFILE_REQUEST("gRPC ModelStreamInfer");
+    OVMS_PROFILE_FUNCTION();
+    return grpc(this->ModelStreamInferImpl(context, stream));
+}
+
+Status KFSInferenceServiceImpl::ModelStreamInferImpl(::grpc::ServerContext* context, KFSStreamReaderWriter* stream) {
+    KFSStreamInferSession session(*this, this->modelManager, getStreamInferExecutor(), context, stream);
+    return session.run();
+}
+
+KFSStreamInferExecutor& KFSInferenceServiceImpl::getStreamInferExecutor() {
+    // threads are started only when the first stream is opened
+    std::call_once(this->streamInferExecutorCreated, [this]() {
+        size_t threadCount = std::max<size_t>(KFSStreamInferSession::MAX_IN_FLIGHT_REQUESTS, std::thread::hardware_concurrency());
+        this->streamInferExecutor = std::make_unique<KFSStreamInferExecutor>(threadCount);
+    });
+    return *this->streamInferExecutor;
+}
+
+::grpc::Status KFSInferenceServiceImpl::SystemSharedMemoryStatus(::grpc::ServerContext* context, const KFSSharedMemoryStatusRequest* request, KFSSharedMemoryStatusResponse* response) {
+    return grpc(SystemSharedMemoryStatusImpl(request, response));
+}
+
+::grpc::Status KFSInferenceServiceImpl::SystemSharedMemoryRegister(::grpc::ServerContext* context, const KFSSharedMemoryRegisterRequest* request, KFSSharedMemoryRegisterResponse* response) {
+    return grpc(SystemSharedMemoryRegisterImpl(request, response));
+}
+
+::grpc::Status KFSInferenceServiceImpl::SystemSharedMemoryUnregister(::grpc::ServerContext* context, const KFSSharedMemoryUnregisterRequest* request, KFSSharedMemoryUnregisterResponse* response) {
+    return grpc(SystemSharedMemoryUnregisterImpl(request, response));
+}
+
+Status KFSInferenceServiceImpl::SystemSharedMemoryStatusImpl(const KFSSharedMemoryStatusRequest* request, KFSSharedMemoryStatusResponse* response) {
+    if (this->sharedMemoryManager == nullptr) {
+        return StatusCode::SHARED_MEMORY_DISABLED;
+    }
+    std::vector<std::shared_ptr<const SharedMemoryRegion>> regions;
+    auto status = this->sharedMemoryManager->getRegions(request->name(), regions);
+    if (!status.ok()) {
+        return status;
+    }
+    for (const auto& region : regions) {
+        auto& regionStatus = (*response->mutable_regions())[region->getName()];
+        regionStatus.set_name(region->getName());
+        regionStatus.set_key(region->getKey());
+        regionStatus.set_offset(region->getOffset());
+        regionStatus.set_byte_size(region->getByteSize());
+    }
+    return StatusCode::OK;
+}
+
+Status KFSInferenceServiceImpl::SystemSharedMemoryRegisterImpl(const KFSSharedMemoryRegisterRequest* request, KFSSharedMemoryRegisterResponse* response) {
+    (void)response;
+    if (this->sharedMemoryManager == nullptr) {
+        return StatusCode::SHARED_MEMORY_DISABLED;
+    }
+    return this->sharedMemoryManager->registerRegion(request->name(), request->key(), request->offset(), request->byte_size());
+}
+
+Status KFSInferenceServiceImpl::SystemSharedMemoryUnregisterImpl(const KFSSharedMemoryUnregisterRequest* request, KFSSharedMemoryUnregisterResponse* response) {
+    (void)response;
+    if (this->sharedMemoryManager == nullptr) {
+        return StatusCode::SHARED_MEMORY_DISABLED;
+    }
+    return this->sharedMemoryManager->unregisterRegion(request->name());
+}
+
 Status KFSInferenceServiceImpl::buildResponse(
     std::shared_ptr<ModelInstance> instance,
     KFSGetModelStatusResponse* response) {
@@ -331,6 +455,8 @@ KFSInferenceServiceImpl::KFSInferenceServiceImpl(const Server& server) :
     }
 }
 
+KFSInferenceServiceImpl::~KFSInferenceServiceImpl() = default;
+
 Status KFSInferenceServiceImpl::buildResponse(
     PipelineDefinition& pipelineDefinition,
     KFSModelMetadataResponse* response) {
@@ -16,10 +16,12 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 
 #include <grpcpp/server_context.h>
+#include <grpcpp/support/sync_stream.h>
 
 #include "src/kfserving_api/grpc_predict_v2.grpc.pb.h"
 #include "src/kfserving_api/grpc_predict_v2.pb.h"
@@ -31,22 +33,32 @@ using KFSModelMetadataRequest = inference::ModelMetadataRequest;
 using KFSModelMetadataResponse = inference::ModelMetadataResponse;
 using KFSRequest = inference::ModelInferRequest;
 using KFSResponse = inference::ModelInferResponse;
+using KFSStreamResponse = inference::ModelStreamInferResponse;
+using KFSStreamReaderWriter = ::grpc::ServerReaderWriterInterface<KFSStreamResponse, KFSRequest>;
 using KFSTensorInputProto = inference::ModelInferRequest::InferInputTensor;
 using KFSTensorOutputProto = inference::ModelInferResponse::InferOutputTensor;
 using KFSShapeType = google::protobuf::RepeatedField<int64_t>;
 using KFSGetModelStatusRequest = inference::ModelReadyRequest;
 using KFSGetModelStatusResponse = inference::ModelReadyResponse;
+using KFSSharedMemoryStatusRequest = inference::SystemSharedMemoryStatusRequest;
+using KFSSharedMemoryStatusResponse = inference::SystemSharedMemoryStatusResponse;
+using KFSSharedMemoryRegisterRequest = inference::SystemSharedMemoryRegisterRequest;
+using KFSSharedMemoryRegisterResponse = inference::SystemSharedMemoryRegisterResponse;
+using KFSSharedMemoryUnregisterRequest = inference::SystemSharedMemoryUnregisterRequest;
+using KFSSharedMemoryUnregisterResponse = inference::SystemSharedMemoryUnregisterResponse;
 using KFSDataType = std::string;
 using KFSInputTensorIteratorType = google::protobuf::internal::RepeatedPtrIterator<const ::inference::ModelInferRequest_InferInputTensor>;
 using KFSOutputTensorIteratorType = google::protobuf::internal::RepeatedPtrIterator<const ::inference::ModelInferResponse_InferOutputTensor>;
 
 namespace ovms {
 class ExecutionContext;
+class KFSStreamInferExecutor;
 class Model;
 class ModelInstance;
 class ModelInstanceUnloadGuard;
 class ModelManager;
 class ServableMetricReporter;
+class SharedMemoryManager;
 class Pipeline;
 class Server;
 class Status;
@@ -56,19 +68,43 @@ class PipelineDefinition;
 class KFSInferenceServiceImpl final : public GRPCInferenceService::Service {
     const Server& ovmsServer;
     ModelManager& modelManager;
+    SharedMemoryManager* sharedMemoryManager = nullptr;
+    std::once_flag streamInferExecutorCreated;
+    std::unique_ptr<KFSStreamInferExecutor> streamInferExecutor;
+
+    KFSStreamInferExecutor& getStreamInferExecutor();
 
 public:
     Status ModelReadyImpl(::grpc::ServerContext* context, const KFSGetModelStatusRequest* request, KFSGetModelStatusResponse* response, ExecutionContext executionContext);
     Status ServerMetadataImpl(::grpc::ServerContext* context, const KFSServerMetadataRequest* request, KFSServerMetadataResponse* response);
     Status ModelMetadataImpl(::grpc::ServerContext* context, const KFSModelMetadataRequest* request, KFSModelMetadataResponse* response, ExecutionContext executionContext);
-    Status ModelInferImpl(::grpc::ServerContext* context, const KFSRequest* request, KFSResponse* response, ExecutionContext executionContext, ServableMetricReporter*& reporterOut);
+    /**
+     * @brief Performs inference of model or pipeline requested by name
+     * @param model already resolved model, if provided it skips model lookup by name
+     * @param pipelineDefinition already resolved pipeline, if provided it skips pipeline lookup by name
+     */
+    Status ModelInferImpl(::grpc::ServerContext* context, const KFSRequest* request, KFSResponse* response, ExecutionContext executionContext, ServableMetricReporter*& reporterOut, const std::shared_ptr<Model>& model = nullptr, PipelineDefinition* pipelineDefinition = nullptr);
+    Status ModelStreamInferImpl(::grpc::ServerContext* context, KFSStreamReaderWriter* stream);
+    Status SystemSharedMemoryStatusImpl(const KFSSharedMemoryStatusRequest* request, KFSSharedMemoryStatusResponse* response);
+    Status SystemSharedMemoryRegisterImpl(const KFSSharedMemoryRegisterRequest* request, KFSSharedMemoryRegisterResponse* response);
+    Status SystemSharedMemoryUnregisterImpl(const KFSSharedMemoryUnregisterRequest* request, KFSSharedMemoryUnregisterResponse* response);
     KFSInferenceServiceImpl(const Server& server);
+    ~KFSInferenceServiceImpl();
+    /**
+     * @brief Enables system shared memory API with regions kept by given manager, nullptr disables it.
+     * Has to be set before the service starts handling requests.
+     */
+    void setSharedMemoryManager(SharedMemoryManager* manager) { this->sharedMemoryManager = manager; }
     ::grpc::Status ServerLive(::grpc::ServerContext* context, const ::inference::ServerLiveRequest* request, ::inference::ServerLiveResponse* response) override;
     ::grpc::Status ServerReady(::grpc::ServerContext* context, const ::inference::ServerReadyRequest* request, ::inference::ServerReadyResponse* response) override;
     ::grpc::Status ModelReady(::grpc::ServerContext* context, const KFSGetModelStatusRequest* request, KFSGetModelStatusResponse* response) override;
     ::grpc::Status ServerMetadata(::grpc::ServerContext* context, const KFSServerMetadataRequest* request, KFSServerMetadataResponse* response) override;
     ::grpc::Status ModelMetadata(::grpc::ServerContext* context, const KFSModelMetadataRequest* request, KFSModelMetadataResponse* response) override;
     ::grpc::Status ModelInfer(::grpc::ServerContext* context, const KFSRequest* request, KFSResponse* response) override;
+    ::grpc::Status ModelStreamInfer(::grpc::ServerContext* context, ::grpc::ServerReaderWriter<KFSStreamResponse, KFSRequest>* stream) override;
+    ::grpc::Status SystemSharedMemoryStatus(::grpc::ServerContext* context, const KFSSharedMemoryStatusRequest* request, KFSSharedMemoryStatusResponse* response) override;
+    ::grpc::Status SystemSharedMemoryRegister(::grpc::ServerContext* context, const KFSSharedMemoryRegisterRequest* request, KFSSharedMemoryRegisterResponse* response) override;
+    ::grpc::Status SystemSharedMemoryUnregister(::grpc::ServerContext* context, const KFSSharedMemoryUnregisterRequest* request, KFSSharedMemoryUnregisterResponse* response) override;
     static Status buildResponse(Model& model, ModelInstance& instance, KFSModelMetadataResponse* response);
     static Status buildResponse(PipelineDefinition& pipelineDefinition, KFSModelMetadataResponse* response);
     static Status buildResponse(std::shared_ptr<ModelInstance> instance, KFSGetModelStatusResponse* response);
@@ -80,8 +116,16 @@ protected:
     Status getModelInstance(const KFSRequest* request,
         std::shared_ptr<ovms::ModelInstance>& modelInstance,
         std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr);
+    Status getModelInstance(const KFSRequest* request,
+        const std::shared_ptr<Model>& model,
+        std::shared_ptr<ovms::ModelInstance>& modelInstance,
+        std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr);
+    Status getPipeline(const KFSRequest* request,
+        KFSResponse* response,
+        std::unique_ptr<ovms::Pipeline>& pipelinePtr);
     Status getPipeline(const KFSRequest* request,
         KFSResponse* response,
+        PipelineDefinition& pipelineDefinition,
         std::unique_ptr<ovms::Pipeline>& pipelinePtr);
 };
 
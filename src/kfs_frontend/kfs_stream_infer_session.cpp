@@ -0,0 +1,209 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "kfs_stream_infer_session.hpp"
+
+#include <utility>
+
+#include "../execution_context.hpp"
+#include "../logging.hpp"
+#include "../model.hpp"
+#include "../modelmanager.hpp"
+#include "../pipeline_factory.hpp"
+#include "../profiler.hpp"
+#include "../statefulmodelinstance.hpp"
+#include "../status.hpp"
+
+namespace ovms {
+
+KFSStreamInferExecutor::KFSStreamInferExecutor(size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = 1;
+    }
+    this->workers.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        this->workers.emplace_back([this]() { this->run(); });
+    }
+}
+
+KFSStreamInferExecutor::~KFSStreamInferExecutor() {
+    {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        this->stopped = true;
+        this->taskAvailable.notify_all();
+    }
+    for (auto& worker : this->workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void KFSStreamInferExecutor::submit(std::function<void()> task) {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    this->tasks.push(std::move(task));
+    this->taskAvailable.notify_one();
+}
+
+void KFSStreamInferExecutor::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(this->mtx);
+            this->taskAvailable.wait(lock, [this]() { return this->stopped || !this->tasks.empty(); });
+            if (this->tasks.empty()) {
+                return;
+            }
+            task = std::move(this->tasks.front());
+            this->tasks.pop();
+        }
+        task();
+    }
+}
+
+KFSStreamInferSession::KFSStreamInferSession(KFSInferenceServiceImpl& service, ModelManager& modelManager, KFSStreamInferExecutor& executor, ::grpc::ServerContext* context, KFSStreamReaderWriter* stream, size_t maxInFlightRequests) :
+    service(service),
+    modelManager(modelManager),
+    executor(executor),
+    context(context),
+    stream(stream),
+    slots(maxInFlightRequests > 0 ? maxInFlightRequests : 1) {}
+
+bool KFSStreamInferSession::requiresSequentialProcessing(const KFSRequest& request, const Model* model) {
+    if (model != nullptr && model->isStateful()) {
+        return true;
+    }
+    for (const auto& input : request.inputs()) {
+        if (StatefulModelInstance::SPECIAL_INPUT_NAMES.count(input.name()) > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void KFSStreamInferSession::resolveServable(const std::string& name) {
+    if ((this->resolvedModel || this->resolvedPipelineDefinition) && this->resolvedName == name) {
+        return;
+    }
+    this->resolvedName = name;
+    this->resolvedModel = this->modelManager.findModelByName(name);
+    // definitions are only retired, never removed from the factory, so the pointer stays valid
+    this->resolvedPipelineDefinition = this->resolvedModel ? nullptr : this->modelManager.getPipelineFactory().findDefinitionByName(name);
+    SPDLOG_DEBUG("ModelStreamInfer resolved servable: {}; model found: {}; pipeline found: {}", name, this->resolvedModel != nullptr, this->resolvedPipelineDefinition != nullptr);
+}
+
+Status KFSStreamInferSession::run() {
+    OVMS_PROFILE_FUNCTION();
+    std::unique_lock<std::mutex> lock(this->mtx);
+    while (true) {
+        this->readerCv.wait(lock, [this]() { return this->writeFailed || this->readCount - this->writeCount < this->slots.size(); });
+        if (this->writeFailed) {
+            break;
+        }
+        // slot is not visible to executor until readCount is increased
+        Slot& slot = this->slots[this->readCount % this->slots.size()];
+        lock.unlock();
+        slot.request.Clear();
+        if (!this->stream->Read(&slot.request)) {
+            lock.lock();
+            break;
+        }
+        resolveServable(slot.request.model_name());
+        slot.model = this->resolvedModel;
+        slot.pipelineDefinition = this->resolvedPipelineDefinition;
+        slot.sequential = requiresSequentialProcessing(slot.request, slot.model.get());
+        lock.lock();
+        // sequential request starts after all previous ones are finished and following ones wait for it
+        this->readerCv.wait(lock, [this, &slot]() {
+            return this->writeFailed || (!this->sequentialInFlight && (!slot.sequential || this->writeCount == this->readCount));
+        });
+        if (this->writeFailed) {
+            break;
+        }
+        slot.processed = false;
+        this->sequentialInFlight = slot.sequential;
+        this->readCount++;
+        this->executor.submit([this, &slot, traceRequestId = SampledTracer::currentRequestId]() {
+            SampledTraceContinuation trace(traceRequestId);
+            this->processSlot(slot);
+        });
+    }
+    // submitted requests refer to the session, it has to wait for all of them
+    this->readerCv.wait(lock, [this]() { return this->writeCount == this->readCount; });
+    SPDLOG_DEBUG("ModelStreamInfer finished; requests: {}; responses written: {}", this->readCount, this->writeCount);
+    if (this->writeFailed) {
+        return StatusCode::STREAM_WRITE_FAILED;
+    }
+    return StatusCode::OK;
+}
+
+void KFSStreamInferSession::processSlot(Slot& slot) {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    bool skip = this->writeFailed;
+    lock.unlock();
+    if (!skip) {
+        process(slot);
+    }
+    lock.lock();
+    slot.processed = true;
+    if (slot.sequential) {
+        this->sequentialInFlight = false;
+        this->readerCv.notify_one();
+    }
+    writeResponses(lock);
+}
+
+void KFSStreamInferSession::process(Slot& slot) {
+    OVMS_PROFILE_FUNCTION();
+    slot.response.Clear();
+    ServableMetricReporter* reporter = nullptr;
+    auto status = this->service.ModelInferImpl(this->context, &slot.request, slot.response.mutable_infer_response(),
+        ExecutionContext{ExecutionContext::Interface::GRPC, ExecutionContext::Method::ModelInfer}, reporter, slot.model, slot.pipelineDefinition);
+    if (!status.ok()) {
+        SPDLOG_DEBUG("ModelStreamInfer request for servable: {} failed: {}", slot.request.model_name(), status.string());
+        slot.response.Clear();
+        slot.response.set_error_message(status.string());
+        slot.response.mutable_infer_response()->set_id(slot.request.id());
+    }
+    slot.model.reset();
+}
+
+void KFSStreamInferSession::writeResponses(std::unique_lock<std::mutex>& lock) {
+    // only one task writes at a time, the one which completed the oldest request takes over writing
+    if (this->writing) {
+        return;
+    }
+    this->writing = true;
+    while (this->writeCount < this->readCount) {
+        Slot& slot = this->slots[this->writeCount % this->slots.size()];
+        if (!slot.processed) {
+            break;
+        }
+        if (!this->writeFailed) {
+            lock.unlock();
+            bool written = this->stream->Write(slot.response);
+            lock.lock();
+            if (!written) {
+                SPDLOG_DEBUG("ModelStreamInfer writing response failed, stream is closed");
+                this->writeFailed = true;
+            }
+        }
+        slot.processed = false;
+        this->writeCount++;
+        this->readerCv.notify_one();
+    }
+    this->writing = false;
+}
+}  // namespace ovms
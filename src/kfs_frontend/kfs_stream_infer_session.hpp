@@ -0,0 +1,125 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../kfs_frontend/kfs_grpc_inference_service.hpp"
+
+namespace ovms {
+class Model;
+class ModelManager;
+class PipelineDefinition;
+class Status;
+
+/**
+ * @brief Pool of threads processing requests of all ModelStreamInfer streams.
+ *
+ * Streams only submit requests they have read, so the number of threads does not grow with the number of open streams.
+ */
+class KFSStreamInferExecutor {
+public:
+    explicit KFSStreamInferExecutor(size_t threadCount);
+    ~KFSStreamInferExecutor();
+
+    KFSStreamInferExecutor(const KFSStreamInferExecutor&) = delete;
+    KFSStreamInferExecutor& operator=(const KFSStreamInferExecutor&) = delete;
+
+    void submit(std::function<void()> task);
+
+private:
+    void run();
+
+    std::mutex mtx;
+    std::condition_variable taskAvailable;
+    std::queue<std::function<void()>> tasks;
+    bool stopped = false;
+    std::vector<std::thread> workers;
+};
+
+/**
+ * @brief Handles single ModelStreamInfer stream.
+ *
+ * Requests are read by the calling thread and processed by the shared executor, so several frames
+ * of the stream are in flight at the same time. Requests to stateful models and requests with sequence
+ * control inputs are processed one at a time, in the order of the stream. Responses are written
+ * in the order of requests. Model or pipeline requested by the stream is resolved only when the
+ * requested name changes, versions are still selected per request, so that model reloads
+ * are handled the same way as for unary requests.
+ */
+class KFSStreamInferSession {
+public:
+    static constexpr size_t MAX_IN_FLIGHT_REQUESTS = 4;
+
+private:
+    struct Slot {
+        KFSRequest request;
+        KFSStreamResponse response;
+        std::shared_ptr<Model> model;
+        PipelineDefinition* pipelineDefinition = nullptr;
+        bool sequential = false;
+        bool processed = false;
+    };
+
+    KFSInferenceServiceImpl& service;
+    ModelManager& modelManager;
+    KFSStreamInferExecutor& executor;
+    ::grpc::ServerContext* context;
+    KFSStreamReaderWriter* stream;
+
+    // slots are reused in a ring, messages are cleared instead of being reallocated for each frame
+    std::vector<Slot> slots;
+    std::mutex mtx;
+    std::condition_variable readerCv;
+    uint64_t readCount = 0;
+    uint64_t writeCount = 0;
+    bool sequentialInFlight = false;
+    bool writing = false;
+    bool writeFailed = false;
+
+    std::string resolvedName;
+    std::shared_ptr<Model> resolvedModel;
+    PipelineDefinition* resolvedPipelineDefinition = nullptr;
+
+    void resolveServable(const std::string& name);
+    void processSlot(Slot& slot);
+    void process(Slot& slot);
+    void writeResponses(std::unique_lock<std::mutex>& lock);
+
+public:
+    KFSStreamInferSession(KFSInferenceServiceImpl& service, ModelManager& modelManager, KFSStreamInferExecutor& executor, ::grpc::ServerContext* context, KFSStreamReaderWriter* stream, size_t maxInFlightRequests = MAX_IN_FLIGHT_REQUESTS);
+
+    /**
+     * @brief Processes stream until client finishes writing and all responses are written
+     * @return Status STREAM_WRITE_FAILED if writing response to the stream failed
+     */
+    Status run();
+
+    /**
+     * @brief Checks whether request has to wait for all previous requests of the stream and block the following ones
+     * @param model resolved model, nullptr for pipelines
+     */
+    static bool requiresSequentialProcessing(const KFSRequest& request, const Model* model);
+};
+}  // namespace ovms
@@ -23,6 +23,8 @@
 
 #include "../logging.hpp"
 #include "../profiler.hpp"
+#include "../request_scope.hpp"
+#include "../shared_memory_manager.hpp"
 #include "../status.hpp"
 
 namespace ovms {
@@ -132,4 +134,89 @@ Status prepareConsolidatedTensorImpl(KFSResponse* response, char*& bufferOut, co
     bufferOut = content->data();
     return StatusCode::OK;
 }
+
+Status getSharedMemoryReference(const KFSParameters& parameters, SharedMemoryReference& reference, bool& isSharedMemoryUsed) {
+    auto regionIt = parameters.find(SHARED_MEMORY_REGION_PARAMETER);
+    auto offsetIt = parameters.find(SHARED_MEMORY_OFFSET_PARAMETER);
+    auto byteSizeIt = parameters.find(SHARED_MEMORY_BYTE_SIZE_PARAMETER);
+    isSharedMemoryUsed = (regionIt != parameters.end());
+    if (!isSharedMemoryUsed) {
+        if ((offsetIt != parameters.end()) || (byteSizeIt != parameters.end())) {
+            return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Missing " + SHARED_MEMORY_REGION_PARAMETER + " parameter");
+        }
+        return StatusCode::OK;
+    }
+    if (regionIt->second.parameter_choice_case() != inference::InferParameter::ParameterChoiceCase::kStringParam ||
+        regionIt->second.string_param().empty()) {
+        return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, SHARED_MEMORY_REGION_PARAMETER + " has to be not empty string");
+    }
+    if (byteSizeIt == parameters.end() ||
+        byteSizeIt->second.parameter_choice_case() != inference::InferParameter::ParameterChoiceCase::kInt64Param ||
+        byteSizeIt->second.int64_param() <= 0) {
+        return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, SHARED_MEMORY_BYTE_SIZE_PARAMETER + " has to be positive integer");
+    }
+    int64_t offset = 0;
+    if (offsetIt != parameters.end()) {
+        if (offsetIt->second.parameter_choice_case() != inference::InferParameter::ParameterChoiceCase::kInt64Param ||
+            offsetIt->second.int64_param() < 0) {
+            return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, SHARED_MEMORY_OFFSET_PARAMETER + " has to be non negative integer");
+        }
+        offset = offsetIt->second.int64_param();
+    }
+    reference.regionName = regionIt->second.string_param();
+    reference.offset = offset;
+    reference.byteSize = byteSizeIt->second.int64_param();
+    return StatusCode::OK;
+}
+
+Status writeOutputsToSharedMemory(const SharedMemoryManager* manager, const KFSRequest& request, KFSResponse& response) {
+    OVMS_PROFILE_FUNCTION();
+    for (const auto& requestedOutput : request.outputs()) {
+        SharedMemoryReference reference;
+        bool isSharedMemoryUsed = false;
+        auto status = getSharedMemoryReference(requestedOutput.parameters(), reference, isSharedMemoryUsed);
+        if (!status.ok()) {
+            return status;
+        }
+        if (!isSharedMemoryUsed) {
+            continue;
+        }
+        if (manager == nullptr) {
+            return StatusCode::SHARED_MEMORY_DISABLED;
+        }
+        for (int i = 0; i < response.outputs_size(); i++) {
+            auto* output = response.mutable_outputs(i);
+            if (output->name() != requestedOutput.name()) {
+                continue;
+            }
+            if (response.raw_output_contents_size() <= i) {
+                SPDLOG_DEBUG("Output: {} has no raw content to be placed in shared memory region: {}", output->name(), reference.regionName);
+                return StatusCode::INTERNAL_ERROR;
+            }
+            auto* content = response.mutable_raw_output_contents(i);
+            status = manager->write(reference, content->data(), content->size());
+            if (!status.ok()) {
+                return status;
+            }
+            auto& parameters = *output->mutable_parameters();
+            parameters[SHARED_MEMORY_REGION_PARAMETER].set_string_param(reference.regionName);
+            parameters[SHARED_MEMORY_OFFSET_PARAMETER].set_int64_param(reference.offset);
+            parameters[SHARED_MEMORY_BYTE_SIZE_PARAMETER].set_int64_param(content->size());
+            content->clear();
+            break;
+        }
+    }
+    return StatusCode::OK;
+}
+
+Status getRequestPriority(const KFSParameters& parameters, RequestPriority& priority) {
+    auto it = parameters.find(PRIORITY_PARAMETER);
+    if (it == parameters.end()) {
+        return StatusCode::OK;
+    }
+    if (it->second.parameter_choice_case() != inference::InferParameter::ParameterChoiceCase::kStringParam) {
+        return Status(StatusCode::INVALID_PRIORITY, PRIORITY_PARAMETER + " has to be string");
+    }
+    return parseRequestPriority(it->second.string_param(), priority);
+}
 }  // namespace ovms
@@ -21,6 +21,11 @@
 
 namespace ovms {
 class Status;
+class SharedMemoryManager;
+struct SharedMemoryReference;
+enum class RequestPriority : int;
+
+using KFSParameters = google::protobuf::Map<std::string, inference::InferParameter>;
 std::string tensorShapeToString(const KFSShapeType& tensorShape);
 
 Precision KFSPrecisionToOvmsPrecision(const KFSDataType& s);
@@ -28,4 +33,24 @@ const KFSDataType& ovmsPrecisionToKFSPrecision(Precision precision);
 
 size_t KFSDataTypeSize(const KFSDataType& datatype);
 Status prepareConsolidatedTensorImpl(KFSResponse* response, char*& tensorOut, const std::string& name, size_t size);
+
+/**
+ * @brief Reads shared_memory_region, shared_memory_offset and shared_memory_byte_size tensor parameters
+ * @param parameters
+ * @param reference
+ * @param isSharedMemoryUsed set to false when tensor does not refer to shared memory region
+ */
+Status getSharedMemoryReference(const KFSParameters& parameters, SharedMemoryReference& reference, bool& isSharedMemoryUsed);
+
+/**
+ * @brief Moves contents of outputs requested to be placed in shared memory regions out of the response.
+ * Serialized contents of such outputs are left empty so that raw_output_contents indexes still match outputs.
+ * @param manager nullptr when shared memory API is disabled
+ */
+Status writeOutputsToSharedMemory(const SharedMemoryManager* manager, const KFSRequest& request, KFSResponse& response);
+
+/**
+ * @brief Reads priority request parameter, leaves priority unchanged when parameter is not sent
+ */
+Status getRequestPriority(const KFSParameters& parameters, RequestPriority& priority);
 }  // namespace ovms
@@ -15,8 +15,11 @@
 //*****************************************************************************
 #include "logging.hpp"
 
+#include <chrono>
 #include <vector>
 
+#include <spdlog/async.h>
+
 namespace ovms {
 
 std::shared_ptr<spdlog::logger> gcs_logger = std::make_shared<spdlog::logger>("gcs");
@@ -25,8 +28,11 @@ std::shared_ptr<spdlog::logger> s3_logger = std::make_shared<spdlog::logger>("s3
 std::shared_ptr<spdlog::logger> modelmanager_logger = std::make_shared<spdlog::logger>("modelmanager");
 std::shared_ptr<spdlog::logger> dag_executor_logger = std::make_shared<spdlog::logger>("dag_executor");
 std::shared_ptr<spdlog::logger> sequence_manager_logger = std::make_shared<spdlog::logger>("sequence_manager");
+std::shared_ptr<spdlog::logger> access_logger;
 
 const std::string default_pattern = "[%Y-%m-%d %T.%e][%t][%n][%l][%s:%#] %v";
+const std::string access_log_pattern = "{\"time\":\"%Y-%m-%dT%T.%e\",%v}";
+const auto async_flush_interval = std::chrono::seconds(1);
 
 static void set_log_level(const std::string log_level, std::shared_ptr<spdlog::logger> logger) {
     logger->set_level(spdlog::level::info);
@@ -47,6 +53,55 @@ static void set_log_level(const std::string log_level, std::shared_ptr<spdlog::l
     }
 }
 
+// In async mode flushing on each message would only add work for the background thread,
+// sinks are flushed periodically instead and on errors to not lose them on crash.
+static void set_async_flush_level(std::shared_ptr<spdlog::logger> logger) {
+    logger->flush_on(spdlog::level::err);
+}
+
+static spdlog::async_overflow_policy get_overflow_policy(const LoggingSettings& settings) {
+    return settings.asyncOverflowPolicy == "overrun_oldest" ? spdlog::async_overflow_policy::overrun_oldest : spdlog::async_overflow_policy::block;
+}
+
+static std::shared_ptr<spdlog::logger> make_async_logger(const std::string& name, const std::vector<spdlog::sink_ptr>& sinks, spdlog::async_overflow_policy policy) {
+    auto logger = std::make_shared<spdlog::async_logger>(name, begin(sinks), end(sinks), spdlog::thread_pool(), policy);
+    spdlog::register_logger(logger);
+    return logger;
+}
+
+static void register_async_loggers(const std::string log_level, std::vector<spdlog::sink_ptr> sinks, const LoggingSettings& settings) {
+    // single worker thread keeps messages ordered
+    spdlog::init_thread_pool(settings.asyncQueueSize, 1);
+    auto policy = get_overflow_policy(settings);
+    gcs_logger = make_async_logger("gcs", sinks, policy);
+    azurestorage_logger = make_async_logger("azurestorage", sinks, policy);
+    s3_logger = make_async_logger("s3", sinks, policy);
+    modelmanager_logger = make_async_logger("modelmanager", sinks, policy);
+    dag_executor_logger = make_async_logger("dag_executor", sinks, policy);
+    sequence_manager_logger = make_async_logger("sequence_manager", sinks, policy);
+    std::shared_ptr<spdlog::logger> serving_logger = std::make_shared<spdlog::async_logger>("serving", begin(sinks), end(sinks), spdlog::thread_pool(), policy);
+    for (auto logger : {serving_logger, gcs_logger, azurestorage_logger, s3_logger, modelmanager_logger, dag_executor_logger, sequence_manager_logger}) {
+        logger->set_pattern(default_pattern);
+        set_log_level(log_level, logger);
+        set_async_flush_level(logger);
+    }
+    spdlog::set_default_logger(serving_logger);
+}
+
+static void register_access_logger(const LoggingSettings& settings) {
+    auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(settings.accessLogPath);
+    if (settings.async) {
+        access_logger = std::make_shared<spdlog::async_logger>("access", sink, spdlog::thread_pool(), get_overflow_policy(settings));
+    } else {
+        access_logger = std::make_shared<spdlog::logger>("access", sink);
+    }
+    access_logger->set_pattern(access_log_pattern);
+    access_logger->set_level(spdlog::level::info);
+    // entries are flushed periodically, not on each request
+    access_logger->flush_on(spdlog::level::off);
+    spdlog::register_logger(access_logger);
+}
+
 static void register_loggers(const std::string log_level, std::vector<spdlog::sink_ptr> sinks) {
     auto serving_logger = std::make_shared<spdlog::logger>("serving", begin(sinks), end(sinks));
     serving_logger->set_pattern(default_pattern);
@@ -74,17 +129,32 @@ static void register_loggers(const std::string log_level, std::vector<spdlog::si
     spdlog::set_default_logger(serving_logger);
 }
 
-void configure_logger(const std::string log_level, const std::string log_path) {
+void configure_logger(const std::string log_level, const std::string log_path, const LoggingSettings& settings) {
     static bool wasRun = false;
     if (wasRun)
         return;
     wasRun = true;
     std::vector<spdlog::sink_ptr> sinks;
-    sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_st>());
+    if (settings.async) {
+        // sinks are written by the background thread and flushed by the periodic flusher thread
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_mt>());
+    } else {
+        sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_st>());
+    }
     if (!log_path.empty()) {
         sinks.push_back(std::make_shared<spdlog::sinks::basic_file_sink_mt>(log_path));
     }
-    register_loggers(log_level, sinks);
+    if (settings.async) {
+        register_async_loggers(log_level, sinks, settings);
+    } else {
+        register_loggers(log_level, sinks);
+    }
+    if (!settings.accessLogPath.empty()) {
+        register_access_logger(settings);
+    }
+    if (settings.async || !settings.accessLogPath.empty()) {
+        spdlog::flush_every(async_flush_interval);
+    }
 }
 
 }  // namespace ovms
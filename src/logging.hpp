@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
@@ -30,7 +31,19 @@ extern std::shared_ptr<spdlog::logger> s3_logger;
 extern std::shared_ptr<spdlog::logger> modelmanager_logger;
 extern std::shared_ptr<spdlog::logger> dag_executor_logger;
 extern std::shared_ptr<spdlog::logger> sequence_manager_logger;
+// nullptr unless access log is enabled
+extern std::shared_ptr<spdlog::logger> access_logger;
 
-void configure_logger(const std::string log_level, const std::string log_path);
+struct LoggingSettings {
+    // pass messages through a bounded queue to a background thread writing them to sinks
+    bool async = false;
+    size_t asyncQueueSize = 8192;
+    // "block" - wait for free slot in the queue, "overrun_oldest" - drop the oldest queued message
+    std::string asyncOverflowPolicy = "block";
+    // enables access log when not empty
+    std::string accessLogPath;
+};
+
+void configure_logger(const std::string log_level, const std::string log_path, const LoggingSettings& settings = LoggingSettings());
 
 }  // namespace ovms
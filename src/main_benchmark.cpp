@@ -15,23 +15,39 @@
 //*****************************************************************************
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
 #include <future>
 #include <iomanip>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <new>
 #include <numeric>
+#include <optional>
+#include <random>
 #include <sstream>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include <cxxopts.hpp>
+#include <grpcpp/grpcpp.h>
 #include <signal.h>
 #include <stdio.h>
 #include <sysexits.h>
+#include <time.h>
 
 #include "ovms.h"  // NOLINT
+#include "src/kfserving_api/grpc_predict_v2.grpc.pb.h"
 #include "stringutils.hpp"
 
 namespace {
+// Heap allocations made by current thread, counted by replaced global operator new
+thread_local size_t heapAllocationsCount = 0;
 
 class BenchmarkCLIParser {
     std::unique_ptr<cxxopts::Options> options;
@@ -74,6 +90,26 @@ void BenchmarkCLIParser::parse(int argc, char** argv) {
                 "number of inferences to conduct",
                 cxxopts::value<uint32_t>()->default_value("1000"),
                 "NITER")
+            ("warmup_iter",
+                "number of inferences conducted before measurement starts, excluded from results",
+                cxxopts::value<uint32_t>()->default_value("0"),
+                "WARMUP_ITER")
+            ("load_mode",
+                "load generation - closed (each thread waits for inference completion before sending next one) or open (inferences sent at Poisson distributed arrival times with target_qps rate regardless of completions)",
+                cxxopts::value<std::string>()->default_value("closed"),
+                "LOAD_MODE")
+            ("target_qps",
+                "average rate of inference arrivals per second in open load mode",
+                cxxopts::value<double>()->default_value("100"),
+                "TARGET_QPS")
+            ("seed",
+                "seed for arrival times and servables mix",
+                cxxopts::value<uint64_t>()->default_value("0"),
+                "SEED")
+            ("json_output",
+                "path to file where results are saved in JSON format",
+                cxxopts::value<std::string>()->default_value(""),
+                "JSON_OUTPUT")
             ("nireq",
                 "nireq from OVMS configuration",
                 cxxopts::value<uint32_t>()->default_value("1"),
@@ -82,21 +118,41 @@ void BenchmarkCLIParser::parse(int argc, char** argv) {
                 "workload threads per ireq",
                 cxxopts::value<uint32_t>()->default_value("2"),
                 "THREADS_PER_IREQ")
+            ("mode",
+                "inference mode - sync (OVMS_Inference), async (OVMS_InferenceAsync) or grpc (KServe ModelInfer sent to gRPC port of the same server, for comparison)",
+                cxxopts::value<std::string>()->default_value("sync"),
+                "MODE")
+            ("async_threads",
+                "workload threads in async mode",
+                cxxopts::value<uint32_t>()->default_value("1"),
+                "ASYNC_THREADS")
+            ("async_inflight_per_thread",
+                "inferences kept in flight by each thread in async mode, by default nireq * threads_per_ireq / async_threads",
+                cxxopts::value<uint32_t>()->default_value("0"),
+                "ASYNC_INFLIGHT_PER_THREAD")
+            ("prepared",
+                "prepare inference request with OVMS_InferenceRequestPrepare for reuse of servable lookup, input wrappers and responses",
+                cxxopts::value<bool>()->default_value("false"),
+                "PREPARED")
             // inference data
             ("servable_name",
-                "Model name to sent request to",
+                "Model name to sent request to. Comma separated list of names sends requests to multiple servables",
                 cxxopts::value<std::string>(),
                 "MODEL_NAME")
+            ("servable_weights",
+                "Comma separated list of relative frequencies of requests to each servable. By default requests are evenly distributed",
+                cxxopts::value<std::string>()->default_value(""),
+                "SERVABLE_WEIGHTS")
             ("servable_version",
                 "workload threads per ireq",
                 cxxopts::value<uint64_t>()->default_value("0"),
                 "MODEL_VERSION")
             ("inputs_names",
-                "Comma separated list of inputs names",
+                "Comma separated list of inputs names, one per servable",
                 cxxopts::value<std::string>(),
                 "INPUTS_NAMES")
             ("shape",
-                "Semicolon separated list of inputs names followed by their shapes in brackers. For example: \"inputA[1,3,224,224],inputB[1,10]\"",
+                "Semicolon separated list of inputs names followed by their shapes in brackers, one per servable. For example: \"inputA[1,3,224,224];inputB[1,10]\"",
                 cxxopts::value<std::string>(),
                 "INPUTS_NAMES");
 
@@ -112,22 +168,16 @@ void BenchmarkCLIParser::parse(int argc, char** argv) {
     }
 }
 
-std::vector<size_t> parseShapes(const std::string& cliInputShapes) {
-    auto inputShapes = ovms::tokenize(cliInputShapes, ';');
-    if (inputShapes.size() != 1) {
-        std::cout << __LINE__ << std::endl;
-        throw std::invalid_argument("Invalid shape argument");
-    }
-    std::string firstShape = inputShapes[0];
-    size_t leftBracket = firstShape.find("[");
-    size_t rightBracket = firstShape.find("]");
+std::vector<size_t> parseShape(const std::string& cliShape) {
+    size_t leftBracket = cliShape.find("[");
+    size_t rightBracket = cliShape.find("]");
     if ((leftBracket == std::string::npos) ||
         (rightBracket == std::string::npos) ||
         (leftBracket > rightBracket)) {
         std::cout << __LINE__ << std::endl;
         throw std::invalid_argument("Invalid shape argument");
     }
-    std::string shapeString = firstShape.substr(leftBracket + 1, rightBracket - leftBracket - 1);
+    std::string shapeString = cliShape.substr(leftBracket + 1, rightBracket - leftBracket - 1);
     auto dimsString = ovms::tokenize(shapeString, ',');
     std::vector<std::size_t> shape;
     std::transform(dimsString.begin(), dimsString.end(), std::back_inserter(shape),
@@ -176,51 +226,518 @@ static void installSignalHandlers() {
 }
 
 using shape_t = std::vector<size_t>;
+using clock_type = std::chrono::high_resolution_clock;
+
+uint64_t elapsedNs(const clock_type::time_point& start, const clock_type::time_point& end) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+}
+
+uint64_t cpuTimeNs(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return uint64_t(ts.tv_sec) * 1'000'000'000 + ts.tv_nsec;
+}
+
+// Latency histogram in the manner of HdrHistogram. Values in nanoseconds are counted in power of two ranges,
+// each split into 128 buckets, so percentiles are reported with error below 1%. Recording does not allocate.
+class LatencyHistogram {
+    static constexpr size_t SUB_BUCKET_BITS = 8;
+    static constexpr uint64_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint64_t SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2;
+    static constexpr size_t BUCKETS_COUNT = SUB_BUCKET_COUNT + (64 - SUB_BUCKET_BITS) * SUB_BUCKET_HALF_COUNT;
+
+    std::vector<uint64_t> counts;
+    uint64_t totalCount = 0;
+    uint64_t sum = 0;
+    uint64_t minValue = std::numeric_limits<uint64_t>::max();
+    uint64_t maxValue = 0;
+
+    static size_t bucketIndex(uint64_t value) {
+        if (value < SUB_BUCKET_COUNT) {
+            return value;
+        }
+        size_t shift = (63 - __builtin_clzll(value)) - (SUB_BUCKET_BITS - 1);
+        return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF_COUNT + ((value >> shift) - SUB_BUCKET_HALF_COUNT);
+    }
+
+    static uint64_t highestEquivalentValue(size_t index) {
+        if (index < SUB_BUCKET_COUNT) {
+            return index;
+        }
+        size_t shift = (index - SUB_BUCKET_COUNT) / SUB_BUCKET_HALF_COUNT + 1;
+        uint64_t subBucket = (index - SUB_BUCKET_COUNT) % SUB_BUCKET_HALF_COUNT + SUB_BUCKET_HALF_COUNT;
+        return ((subBucket + 1) << shift) - 1;
+    }
+
+public:
+    LatencyHistogram() :
+        counts(BUCKETS_COUNT, 0) {}
+
+    void record(uint64_t valueNs) {
+        this->counts[bucketIndex(valueNs)]++;
+        this->totalCount++;
+        this->sum += valueNs;
+        this->minValue = std::min(this->minValue, valueNs);
+        this->maxValue = std::max(this->maxValue, valueNs);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t i = 0; i < BUCKETS_COUNT; ++i) {
+            this->counts[i] += other.counts[i];
+        }
+        this->totalCount += other.totalCount;
+        this->sum += other.sum;
+        this->minValue = std::min(this->minValue, other.minValue);
+        this->maxValue = std::max(this->maxValue, other.maxValue);
+    }
+
+    uint64_t count() const { return this->totalCount; }
+    uint64_t min() const { return this->totalCount > 0 ? this->minValue : 0; }
+    uint64_t max() const { return this->maxValue; }
+    double mean() const { return this->totalCount > 0 ? double(this->sum) / this->totalCount : 0; }
+
+    uint64_t percentile(double percentile) const {
+        if (this->totalCount == 0) {
+            return 0;
+        }
+        uint64_t target = std::max<uint64_t>(1, std::ceil(percentile / 100 * this->totalCount));
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < BUCKETS_COUNT; ++i) {
+            cumulative += this->counts[i];
+            if (cumulative >= target) {
+                return std::min(highestEquivalentValue(i), this->maxValue);
+            }
+        }
+        return this->maxValue;
+    }
+};
+
+struct Servable {
+    std::string name;
+    std::string inputName;
+    shape_t shape;
+    uint32_t weight = 1;
+    std::vector<float> data;
+    OVMS_InferenceRequest* request{nullptr};
+    inference::ModelInferRequest grpcRequest;
+};
+
+struct WorkloadStats {
+    LatencyHistogram whole;
+    LatencyHistogram pure;
+    std::vector<LatencyHistogram> wholePerServable;
+    uint64_t callingThreadCpuTimeNs = 0;
+    size_t allocations = 0;
+    size_t failed = 0;
+    uint64_t wholeThreadTimeUs = 0;
+
+    explicit WorkloadStats(size_t servablesCount) :
+        wholePerServable(servablesCount) {}
+
+    void merge(const WorkloadStats& other) {
+        this->whole.merge(other.whole);
+        this->pure.merge(other.pure);
+        for (size_t i = 0; i < this->wholePerServable.size(); ++i) {
+            this->wholePerServable[i].merge(other.wholePerServable[i]);
+        }
+        this->callingThreadCpuTimeNs += other.callingThreadCpuTimeNs;
+        this->allocations += other.allocations;
+        this->failed += other.failed;
+        this->wholeThreadTimeUs += other.wholeThreadTimeUs;
+    }
+
+    void recordWhole(size_t servableId, uint64_t wholeNs) {
+        this->whole.record(wholeNs);
+        this->wholePerServable[servableId].record(wholeNs);
+    }
+};
+
+struct Workload {
+    OVMS_Server* server;
+    const std::vector<Servable>& servables;
+    inference::GRPCInferenceService::Stub* grpcStub;
+    bool grpcMode;
+    // copied by each thread drawing servables for consecutive inferences
+    std::discrete_distribution<size_t> servablesMix;
+};
 
 OVMS_InferenceRequest* prepareRequest(OVMS_Server* server, const std::string& servableName, uint32_t servableVersion, OVMS_DataType datatype, const shape_t& shape, const std::string& inputName, const void* data) {
     OVMS_InferenceRequest* request{nullptr};
     OVMS_InferenceRequestNew(&request, server, servableName.c_str(), servableVersion);
     OVMS_InferenceRequestAddInput(request, inputName.c_str(), datatype, shape.data(), shape.size());
-    size_t elementsCount = std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>());
+    size_t elementsCount = std::accumulate(shape.begin(), shape.end(), size_t(1), std::multiplies<size_t>());
     OVMS_InferenceRequestInputSetData(request, inputName.c_str(), data, sizeof(float) * elementsCount, OVMS_BUFFERTYPE_CPU, 0);
     return request;
 }
 
+// Conducts single inference with OVMS_Inference or gRPC ModelInfer, pureNs is set to the time of the call itself
+bool inferOnce(const Workload& workload, size_t servableId, uint64_t& pureNs) {
+    const Servable& servable = workload.servables[servableId];
+    if (workload.grpcMode) {
+        grpc::ClientContext context;
+        inference::ModelInferResponse response;
+        auto start = clock_type::now();
+        grpc::Status status = workload.grpcStub->ModelInfer(&context, servable.grpcRequest, &response);
+        pureNs = elapsedNs(start, clock_type::now());
+        return status.ok();
+    }
+    OVMS_InferenceResponse* response{nullptr};
+    auto start = clock_type::now();
+    OVMS_Status* res = OVMS_Inference(workload.server, servable.request, &response);
+    pureNs = elapsedNs(start, clock_type::now());
+    if (res != nullptr) {
+        OVMS_StatusDelete(res);
+        return false;
+    }
+    OVMS_InferenceResponseDelete(response);
+    return true;
+}
+
+// Closed loop - next inference is sent once previous one is completed
 void triggerInferenceInALoop(
+    std::promise<void>& readySignal,
     std::future<void>& startSignal,
-    std::future<void>& stopSignal,
+    const Workload& workload,
+    const size_t warmupPerThread,
     const size_t niterPerThread,
-    size_t& wholeThreadTimeUs,
-    double& averageWholeLatency,
-    double& averagePureLatency,
-    OVMS_Server* server,
-    OVMS_InferenceRequest* request) {
-    OVMS_InferenceResponse* response{nullptr};
-    std::vector<uint64_t> latenciesWhole(niterPerThread);
-    std::vector<uint64_t> latenciesPure(niterPerThread);
+    const uint64_t seed,
+    WorkloadStats& stats) {
+    std::mt19937_64 generator(seed);
+    auto servablesMix = workload.servablesMix;
+    uint64_t pureNs = 0;
+    for (size_t iter = 0; iter < warmupPerThread; ++iter) {
+        inferOnce(workload, servablesMix(generator), pureNs);
+    }
+    readySignal.set_value();
     startSignal.get();
-    auto workloadStart = std::chrono::high_resolution_clock::now();
+    auto workloadStart = clock_type::now();
+    size_t allocationsStart = heapAllocationsCount;
     size_t iter = niterPerThread;
-    while (iter-- > 0) {
-        // stopSignal will be used with ctrl-c app stopping or with total requestCount
-        // stopSignal.wait_for(std::chrono::milliseconds(0));
-        auto iterationWholeStart = std::chrono::high_resolution_clock::now();
-        auto iterationPureStart = std::chrono::high_resolution_clock::now();
-        // aternatively we are changing request
-        OVMS_Inference(server, request, &response);
-        auto iterationPureEnd = std::chrono::high_resolution_clock::now();
-        OVMS_InferenceResponseDelete(response);
-        auto iterationWholeEnd = std::chrono::high_resolution_clock::now();
-        latenciesWhole[iter] = std::chrono::duration_cast<std::chrono::microseconds>(iterationWholeEnd - iterationWholeStart).count();
-        latenciesPure[iter] = std::chrono::duration_cast<std::chrono::microseconds>(iterationPureEnd - iterationPureStart).count();
-    }
-    auto workloadEnd = std::chrono::high_resolution_clock::now();
-    wholeThreadTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(workloadEnd - workloadStart).count();
-    averageWholeLatency = std::accumulate(latenciesWhole.begin(), latenciesWhole.end(), 0) / (double(niterPerThread) * 1'000);
-    averagePureLatency = std::accumulate(latenciesPure.begin(), latenciesPure.end(), 0) / (double(niterPerThread) * 1'000);
+    while (iter-- > 0 && shutdown_request == 0) {
+        size_t servableId = servablesMix(generator);
+        auto iterationWholeStart = clock_type::now();
+        uint64_t cpuStart = cpuTimeNs(CLOCK_THREAD_CPUTIME_ID);
+        if (!inferOnce(workload, servableId, pureNs)) {
+            stats.failed++;
+        }
+        uint64_t cpuEnd = cpuTimeNs(CLOCK_THREAD_CPUTIME_ID);
+        auto iterationWholeEnd = clock_type::now();
+        stats.recordWhole(servableId, elapsedNs(iterationWholeStart, iterationWholeEnd));
+        stats.pure.record(pureNs);
+        stats.callingThreadCpuTimeNs += cpuEnd - cpuStart;
+    }
+    auto workloadEnd = clock_type::now();
+    stats.allocations = heapAllocationsCount - allocationsStart;
+    stats.wholeThreadTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(workloadEnd - workloadStart).count();
+}
+
+struct AsyncWorkloadState {
+    std::mutex mtx;
+    std::condition_variable completion;
+    size_t inFlight = 0;
+    WorkloadStats stats;
+
+    explicit AsyncWorkloadState(size_t servablesCount) :
+        stats(servablesCount) {}
+};
+
+struct AsyncInference {
+    AsyncWorkloadState* state;
+    clock_type::time_point start;
+    size_t servableId;
+    bool measured;
+};
+
+void onAsyncInferenceCompleted(OVMS_InferenceResponse* response, OVMS_Status* status, void* userdata) {
+    auto end = clock_type::now();
+    std::unique_ptr<AsyncInference> inference(reinterpret_cast<AsyncInference*>(userdata));
+    bool failed = (status != nullptr);
+    OVMS_StatusDelete(status);
+    OVMS_InferenceResponseDelete(response);
+    AsyncWorkloadState& state = *inference->state;
+    std::unique_lock<std::mutex> lock(state.mtx);
+    if (inference->measured) {
+        state.stats.recordWhole(inference->servableId, elapsedNs(inference->start, end));
+        if (failed) {
+            state.stats.failed++;
+        }
+    }
+    state.inFlight--;
+    state.completion.notify_one();
+}
+
+// Schedules inference with OVMS_InferenceAsync once less than inflightLimit are in flight.
+// Whole latency is measured from arrival if provided, otherwise from scheduling.
+void scheduleAsyncInference(const Workload& workload, AsyncWorkloadState& state, size_t servableId, size_t inflightLimit, std::optional<clock_type::time_point> arrival, bool measured) {
+    {
+        std::unique_lock<std::mutex> lock(state.mtx);
+        state.completion.wait(lock, [&state, inflightLimit]() { return state.inFlight < inflightLimit; });
+        state.inFlight++;
+    }
+    auto schedulingStart = clock_type::now();
+    uint64_t cpuStart = cpuTimeNs(CLOCK_THREAD_CPUTIME_ID);
+    auto inference = new AsyncInference{&state, arrival.value_or(schedulingStart), servableId, measured};
+    OVMS_Status* res = OVMS_InferenceAsync(workload.server, workload.servables[servableId].request, onAsyncInferenceCompleted, inference);
+    uint64_t cpuEnd = cpuTimeNs(CLOCK_THREAD_CPUTIME_ID);
+    auto schedulingEnd = clock_type::now();
+    std::unique_lock<std::mutex> lock(state.mtx);
+    if (measured) {
+        state.stats.pure.record(elapsedNs(schedulingStart, schedulingEnd));
+        state.stats.callingThreadCpuTimeNs += cpuEnd - cpuStart;
+    }
+    if (res != nullptr) {
+        OVMS_StatusDelete(res);
+        delete inference;
+        if (measured) {
+            state.stats.failed++;
+        }
+        state.inFlight--;
+        state.completion.notify_one();
+    }
+}
+
+void waitForAsyncInferences(AsyncWorkloadState& state) {
+    std::unique_lock<std::mutex> lock(state.mtx);
+    state.completion.wait(lock, [&state]() { return state.inFlight == 0; });
+}
+
+// Keeps inflightLimit inferences scheduled with OVMS_InferenceAsync until niterPerThread are completed
+void triggerAsyncInferenceInALoop(
+    std::promise<void>& readySignal,
+    std::future<void>& startSignal,
+    const Workload& workload,
+    const size_t warmupPerThread,
+    const size_t niterPerThread,
+    const size_t inflightLimit,
+    const uint64_t seed,
+    WorkloadStats& stats) {
+    AsyncWorkloadState state(workload.servables.size());
+    std::mt19937_64 generator(seed);
+    auto servablesMix = workload.servablesMix;
+    for (size_t iter = 0; iter < warmupPerThread; ++iter) {
+        scheduleAsyncInference(workload, state, servablesMix(generator), inflightLimit, std::nullopt, false);
+    }
+    waitForAsyncInferences(state);
+    readySignal.set_value();
+    startSignal.get();
+    auto workloadStart = clock_type::now();
+    size_t iter = niterPerThread;
+    while (iter-- > 0 && shutdown_request == 0) {
+        scheduleAsyncInference(workload, state, servablesMix(generator), inflightLimit, std::nullopt, true);
+    }
+    waitForAsyncInferences(state);
+    auto workloadEnd = clock_type::now();
+    state.stats.wholeThreadTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(workloadEnd - workloadStart).count();
+    stats.merge(state.stats);
+}
+
+struct Arrival {
+    clock_type::time_point time;
+    size_t servableId;
+    bool measured;
+};
+
+// Arrivals waiting for free thread in open load mode
+class ArrivalsQueue {
+    std::mutex mtx;
+    std::condition_variable arrived;
+    std::deque<Arrival> arrivals;
+    bool closed = false;
+
+public:
+    void push(const Arrival& arrival) {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        this->arrivals.push_back(arrival);
+        this->arrived.notify_one();
+    }
+
+    void close() {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        this->closed = true;
+        this->arrived.notify_all();
+    }
+
+    // Returns false once queue is closed and all arrivals are taken
+    bool pop(Arrival& arrival) {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        this->arrived.wait(lock, [this]() { return this->closed || !this->arrivals.empty(); });
+        if (this->arrivals.empty()) {
+            return false;
+        }
+        arrival = this->arrivals.front();
+        this->arrivals.pop_front();
+        return true;
+    }
+};
+
+// Open loop - conducts inferences for arrivals taken from the queue. Whole latency is measured from arrival
+// so time spent waiting for free thread is included.
+void serveArrivals(ArrivalsQueue& queue, const Workload& workload, WorkloadStats& stats) {
+    Arrival arrival;
+    uint64_t pureNs = 0;
+    while (queue.pop(arrival)) {
+        uint64_t cpuStart = cpuTimeNs(CLOCK_THREAD_CPUTIME_ID);
+        bool succeeded = inferOnce(workload, arrival.servableId, pureNs);
+        uint64_t cpuEnd = cpuTimeNs(CLOCK_THREAD_CPUTIME_ID);
+        auto end = clock_type::now();
+        if (!arrival.measured) {
+            continue;
+        }
+        if (!succeeded) {
+            stats.failed++;
+        }
+        stats.recordWhole(arrival.servableId, elapsedNs(arrival.time, end));
+        stats.pure.record(pureNs);
+        stats.callingThreadCpuTimeNs += cpuEnd - cpuStart;
+    }
+}
+
+// Generates warmupCount + niter arrivals with exponentially distributed intervals (Poisson process) and passes them
+// to dispatch at their time. Time and process CPU time of the first measured arrival are stored in measuredStart*.
+template <typename Dispatch>
+void generateArrivals(
+    const Workload& workload,
+    const double targetQps,
+    const size_t warmupCount,
+    const size_t niter,
+    const uint64_t seed,
+    clock_type::time_point& measuredStart,
+    uint64_t& measuredStartProcessCpuNs,
+    Dispatch dispatch) {
+    std::mt19937_64 generator(seed);
+    auto servablesMix = workload.servablesMix;
+    std::exponential_distribution<double> intervals(targetQps);
+    auto next = clock_type::now();
+    measuredStart = next;
+    measuredStartProcessCpuNs = cpuTimeNs(CLOCK_PROCESS_CPUTIME_ID);
+    for (size_t i = 0; i < warmupCount + niter && shutdown_request == 0; ++i) {
+        next += std::chrono::duration_cast<clock_type::duration>(std::chrono::duration<double>(intervals(generator)));
+        std::this_thread::sleep_until(next);
+        if (i == warmupCount) {
+            measuredStart = next;
+            measuredStartProcessCpuNs = cpuTimeNs(CLOCK_PROCESS_CPUTIME_ID);
+        }
+        dispatch(Arrival{next, servablesMix(generator), i >= warmupCount});
+    }
+}
+
+inference::ModelInferRequest prepareGrpcRequest(const std::string& servableName, uint64_t servableVersion, const shape_t& shape, const std::string& inputName, const std::vector<float>& data) {
+    inference::ModelInferRequest request;
+    request.set_model_name(servableName);
+    if (servableVersion != 0) {
+        request.set_model_version(std::to_string(servableVersion));
+    }
+    auto* input = request.add_inputs();
+    input->set_name(inputName);
+    input->set_datatype("FP32");
+    for (auto dim : shape) {
+        input->add_shape(dim);
+    }
+    request.add_raw_input_contents()->assign(reinterpret_cast<const char*>(data.data()), data.size() * sizeof(float));
+    return request;
+}
+
+void printPercentiles(const std::string& label, const LatencyHistogram& histogram) {
+    std::cout << label << " percentiles p50/p90/p99/p99.9/max:"
+              << histogram.percentile(50) / 1'000'000.0 << "/"
+              << histogram.percentile(90) / 1'000'000.0 << "/"
+              << histogram.percentile(99) / 1'000'000.0 << "/"
+              << histogram.percentile(99.9) / 1'000'000.0 << "/"
+              << histogram.max() / 1'000'000.0 << "ms" << std::endl;
+}
+
+std::string escapeJson(const std::string& str) {
+    std::string escaped;
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+
+void writeLatencyJson(std::ostream& os, const LatencyHistogram& histogram) {
+    os << "{\"count\": " << histogram.count()
+       << ", \"mean\": " << histogram.mean() / 1'000
+       << ", \"min\": " << histogram.min() / 1'000.0
+       << ", \"p50\": " << histogram.percentile(50) / 1'000.0
+       << ", \"p90\": " << histogram.percentile(90) / 1'000.0
+       << ", \"p99\": " << histogram.percentile(99) / 1'000.0
+       << ", \"p99_9\": " << histogram.percentile(99.9) / 1'000.0
+       << ", \"max\": " << histogram.max() / 1'000.0 << "}";
+}
+
+struct BenchmarkSummary {
+    std::string mode;
+    std::string loadMode;
+    double targetQps;
+    size_t threadCount;
+    size_t warmupIterations;
+    uint64_t wholeTimeUs;
+    uint64_t processCpuTimeNs;
+};
+
+// Saves results in form suitable for comparison between builds, latencies are in microseconds
+bool writeJsonReport(const std::string& path, const BenchmarkSummary& summary, const WorkloadStats& total, const std::vector<Servable>& servables) {
+    std::ofstream os(path);
+    if (!os.is_open()) {
+        return false;
+    }
+    size_t count = std::max<size_t>(1, total.whole.count());
+    os << std::fixed << std::setprecision(3);
+    os << "{\n"
+       << "  \"mode\": \"" << summary.mode << "\",\n"
+       << "  \"load_mode\": \"" << summary.loadMode << "\",\n"
+       << "  \"target_qps\": " << (summary.loadMode == "open" ? summary.targetQps : 0) << ",\n"
+       << "  \"threads\": " << summary.threadCount << ",\n"
+       << "  \"warmup_iterations\": " << summary.warmupIterations << ",\n"
+       << "  \"requests\": " << total.whole.count() << ",\n"
+       << "  \"failed\": " << total.failed << ",\n"
+       << "  \"duration_s\": " << summary.wholeTimeUs / 1'000'000.0 << ",\n"
+       << "  \"fps\": " << double(total.whole.count()) / std::max<uint64_t>(1, summary.wholeTimeUs) * 1'000'000 << ",\n"
+       << "  \"latency_us\": ";
+    writeLatencyJson(os, total.whole);
+    os << ",\n  \"call_latency_us\": ";
+    writeLatencyJson(os, total.pure);
+    os << ",\n  \"cpu_time_per_request_us\": {\"calling_thread\": " << total.callingThreadCpuTimeNs / 1'000.0 / std::max<size_t>(1, total.pure.count())
+       << ", \"process\": " << summary.processCpuTimeNs / 1'000.0 / count << "},\n"
+       << "  \"servables\": [";
+    for (size_t i = 0; i < servables.size(); ++i) {
+        os << (i == 0 ? "\n" : ",\n")
+           << "    {\"name\": \"" << escapeJson(servables[i].name) << "\", \"weight\": " << servables[i].weight << ", \"latency_us\": ";
+        writeLatencyJson(os, total.wholePerServable[i]);
+        os << "}";
+    }
+    os << "\n  ]\n}\n";
+    return os.good();
 }
 }  // namespace
 
+void* operator new(std::size_t size) {
+    ++heapAllocationsCount;
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
 int main(int argc, char** argv) {
     installSignalHandlers();
     BenchmarkCLIParser cliparser;
@@ -278,149 +795,290 @@ int main(int argc, char** argv) {
     ///////////////////////
     // model parameters
     ///////////////////////
-    std::string servableName(cliparser.result->operator[]("servable_name").as<std::string>());
+    auto servablesNames = ovms::tokenize(cliparser.result->operator[]("servable_name").as<std::string>(), ',');
     uint64_t  servableVersion(cliparser.result->operator[]("servable_version").as<uint64_t>());
-    // input names handling
+    // input names handling, single input per servable
     std::string cliInputsNames(cliparser.result->operator[]("inputs_names").as<std::string>());
     auto inputsNames = ovms::tokenize(cliInputsNames, ',');
-    if (inputsNames.size() != 1) {
+    auto shapes = ovms::tokenize(cliparser.result->operator[]("shape").as<std::string>(), ';');
+    auto weights = ovms::tokenize(cliparser.result->operator[]("servable_weights").as<std::string>(), ',');
+    if ((servablesNames.size() == 0) ||
+        (inputsNames.size() != servablesNames.size()) ||
+        (shapes.size() != servablesNames.size()) ||
+        (weights.size() != 0 && weights.size() != servablesNames.size())) {
         std::cout << __LINE__ << std::endl;
         return EX_USAGE;
     }
-    std::string inputName = inputsNames[0];
     // datatype handling
     OVMS_DataType datatype = OVMS_DATATYPE_FP32;
-    // shape handling
-    std::vector<std::size_t> shape = parseShapes(cliparser.result->operator[]("shape").as<std::string>());
+    std::vector<Servable> servables(servablesNames.size());
+    for (size_t i = 0; i < servables.size(); ++i) {
+        servables[i].name = servablesNames[i];
+        servables[i].inputName = inputsNames[i];
+        // shape handling
+        servables[i].shape = parseShape(shapes[i]);
+        if (weights.size() != 0) {
+            auto weight = ovms::stou32(weights[i]);
+            if (!weight.has_value()) {
+                std::cout << __LINE__ << std::endl;
+                return EX_USAGE;
+            }
+            servables[i].weight = weight.value();
+        }
+        size_t elementsCount = std::accumulate(servables[i].shape.begin(), servables[i].shape.end(), size_t(1), std::multiplies<size_t>());
+        servables[i].data.assign(elementsCount, 0.1);
+    }
+    std::vector<double> servablesMix;
+    std::transform(servables.begin(), servables.end(), std::back_inserter(servablesMix), [](const Servable& servable) { return double(servable.weight); });
+    if (std::accumulate(servablesMix.begin(), servablesMix.end(), double(0)) == 0) {
+        std::cout << __LINE__ << std::endl;
+        return EX_USAGE;
+    }
     ///////////////////////
     // benchmark parameters
     ///////////////////////
     size_t nireq = cliparser.result->operator[]("nireq").as<uint32_t>();
     size_t niter = cliparser.result->operator[]("niter").as<uint32_t>();
+    size_t warmupIter = cliparser.result->operator[]("warmup_iter").as<uint32_t>();
     size_t threadsPerIreq = cliparser.result->operator[]("threads_per_ireq").as<uint32_t>();
+    uint64_t seed = cliparser.result->operator[]("seed").as<uint64_t>();
+    std::string mode(cliparser.result->operator[]("mode").as<std::string>());
+    if (mode != "sync" && mode != "async" && mode != "grpc") {
+        std::cout << __LINE__ << std::endl;
+        return EX_USAGE;
+    }
+    std::string loadMode(cliparser.result->operator[]("load_mode").as<std::string>());
+    double targetQps = cliparser.result->operator[]("target_qps").as<double>();
+    if ((loadMode != "closed" && loadMode != "open") ||
+        (loadMode == "open" && !(targetQps > 0))) {
+        std::cout << __LINE__ << std::endl;
+        return EX_USAGE;
+    }
+    bool asyncMode = (mode == "async");
+    bool grpcMode = (mode == "grpc");
+    bool openLoop = (loadMode == "open");
     size_t threadCount = nireq * threadsPerIreq;
+    size_t asyncInflightPerThread = 0;
+    if (openLoop) {
+        if (asyncMode) {
+            threadCount = 1;
+            std::cout << "Open load mode with " << targetQps << " QPS target scheduled asynchronously" << std::endl;
+        } else {
+            std::cout << "Open load mode with " << targetQps << " QPS target served by " << threadCount << " threads" << std::endl;
+        }
+    } else if (asyncMode) {
+        threadCount = std::max<size_t>(1, cliparser.result->operator[]("async_threads").as<uint32_t>());
+        asyncInflightPerThread = cliparser.result->operator[]("async_inflight_per_thread").as<uint32_t>();
+        if (asyncInflightPerThread == 0) {
+            asyncInflightPerThread = std::max<size_t>(1, nireq * threadsPerIreq / threadCount);
+        }
+        std::cout << "Async mode with " << threadCount << " threads keeping " << asyncInflightPerThread << " inferences in flight each" << std::endl;
+    }
     size_t niterPerThread = niter / threadCount;
-
-    size_t elementsCount = std::accumulate(shape.begin(), shape.end(), 1, std::multiplies<size_t>());
-    std::vector<float> data(elementsCount, 0.1);
-
-    ///////////////////////
-    // prepare time measuring
-    ///////////////////////
-    std::vector<double> wholeTimes;
-    wholeTimes.resize(threadCount);
-    std::vector<double> pureTimes;
-    pureTimes.resize(threadCount);
+    size_t warmupPerThread = warmupIter / threadCount;
 
     ///////////////////////
     // prepare requests
     ///////////////////////
-    OVMS_InferenceRequest* request = prepareRequest(srv, servableName, servableVersion, datatype, shape, inputName, (const void*)data.data());
-    ///////////////////////
-    // check request
-    ///////////////////////
-    OVMS_InferenceResponse* response;
-    res = OVMS_Inference(srv, request, &response);
-    if (res != nullptr) {
-        uint32_t code = 0;
-        const char* details = 0;
-        OVMS_StatusGetCode(res, &code);
-        OVMS_StatusGetDetails(res, &details);
-        std::cerr << "Error occured during inference. Code:" << code
-                  << ", details:" << details << std::endl;
-        OVMS_StatusDelete(res);
-        OVMS_InferenceRequestDelete(request);
-        OVMS_ServerDelete(srv);
-        OVMS_ModelsSettingsDelete(modelsSettings);
-        OVMS_ServerSettingsDelete(serverSettings);
-        exit(EX_CONFIG);
+    auto deleteRequests = [&servables]() {
+        for (auto& servable : servables) {
+            OVMS_InferenceRequestDelete(servable.request);
+        }
+    };
+    bool prepared = cliparser.result->operator[]("prepared").as<bool>();
+    for (auto& servable : servables) {
+        servable.request = prepareRequest(srv, servable.name, servableVersion, datatype, servable.shape, servable.inputName, (const void*)servable.data.data());
+        if (prepared) {
+            res = OVMS_InferenceRequestPrepare(srv, servable.request);
+            if (res != nullptr) {
+                const char* details = 0;
+                OVMS_StatusGetDetails(res, &details);
+                std::cerr << "Error occured during request preparation, details:" << details << std::endl;
+                OVMS_StatusDelete(res);
+                deleteRequests();
+                OVMS_ServerDelete(srv);
+                OVMS_ModelsSettingsDelete(modelsSettings);
+                OVMS_ServerSettingsDelete(serverSettings);
+                exit(EX_CONFIG);
+            }
+        }
+        ///////////////////////
+        // check request
+        ///////////////////////
+        OVMS_InferenceResponse* response;
+        res = OVMS_Inference(srv, servable.request, &response);
+        if (res != nullptr) {
+            uint32_t code = 0;
+            const char* details = 0;
+            OVMS_StatusGetCode(res, &code);
+            OVMS_StatusGetDetails(res, &details);
+            std::cerr << "Error occured during inference. Code:" << code
+                      << ", details:" << details << std::endl;
+            OVMS_StatusDelete(res);
+            deleteRequests();
+            OVMS_ServerDelete(srv);
+            OVMS_ModelsSettingsDelete(modelsSettings);
+            OVMS_ServerSettingsDelete(serverSettings);
+            exit(EX_CONFIG);
+        }
+        OVMS_InferenceResponseDelete(response);
+        servable.grpcRequest = prepareGrpcRequest(servable.name, servableVersion, servable.shape, servable.inputName, servable.data);
     }
-    OVMS_InferenceResponseDelete(response);
+    auto grpcStub = inference::GRPCInferenceService::NewStub(
+        grpc::CreateChannel("localhost:" + std::to_string(grpcPort), grpc::InsecureChannelCredentials()));
+    Workload workload{srv, servables, grpcStub.get(), grpcMode, std::discrete_distribution<size_t>(servablesMix.begin(), servablesMix.end())};
 
-    ///////////////////////
-    // prepare response data
-    ///////////////////////
-    uint32_t outputCount = 0;
-    const void* voutputData;
-    size_t bytesize = 0;
-    uint32_t outputId = outputCount - 1;
-    OVMS_DataType responseDatatype = (OVMS_DataType) 42;
-    const uint64_t* outputShape{nullptr};
-    uint32_t dimCount = 0;
-    OVMS_BufferType bufferType = (OVMS_BufferType)42;
-    uint32_t deviceId = 42;
-    const char* outputName{nullptr};
     ///////////////////////
     // setup workload machinery
     ///////////////////////
     std::vector<std::unique_ptr<std::thread>> workerThreads;
+    std::vector<std::promise<void>> readySignals(threadCount);
     std::vector<std::promise<void>> startSignals(threadCount);
-    std::vector<std::promise<void>> stopSignals(threadCount);
     std::vector<std::future<void>> futureStartSignals;
-    std::vector<std::future<void>> futureStopSignals;
-    std::vector<size_t> wholeThreadsTimesUs(threadCount, 0);
+    std::vector<WorkloadStats> stats(threadCount, WorkloadStats(servables.size()));
     std::transform(startSignals.begin(),
         startSignals.end(),
         std::back_inserter(futureStartSignals),
         [](auto& p) { return p.get_future(); });
-    std::transform(stopSignals.begin(),
-        stopSignals.end(),
-        std::back_inserter(futureStopSignals),
-        [](auto& p) { return p.get_future(); });
+    clock_type::time_point workloadStart;
+    uint64_t processCpuStart = 0;
 
-    ///////////////////////
-    // prepare threads
-    ///////////////////////
-    for (size_t i = 0; i < threadCount; ++i) {
-        workerThreads.emplace_back(std::make_unique<std::thread>(
-            [&futureStartSignals,
-             &futureStopSignals,
-             &niterPerThread,
-             &wholeThreadsTimesUs,
-             &wholeTimes,
-             &pureTimes,
-             &srv,
-             &request,
-             i]() {
-                triggerInferenceInALoop(
-                    futureStartSignals[i],
-                    futureStopSignals[i],
+    if (openLoop) {
+        ///////////////////////
+        // open loop workload, warmup arrivals are not measured
+        ///////////////////////
+        std::cout << "Benchmark starting workload" << std::endl;
+        if (asyncMode) {
+            AsyncWorkloadState state(servables.size());
+            generateArrivals(workload, targetQps, warmupIter, niter, seed, workloadStart, processCpuStart,
+                [&workload, &state](const Arrival& arrival) {
+                    scheduleAsyncInference(workload, state, arrival.servableId, std::numeric_limits<size_t>::max(), arrival.time, arrival.measured);
+                });
+            waitForAsyncInferences(state);
+            stats[0].merge(state.stats);
+        } else {
+            ArrivalsQueue queue;
+            for (size_t i = 0; i < threadCount; ++i) {
+                workerThreads.emplace_back(std::make_unique<std::thread>(
+                    [&queue, &workload, &stats, i]() {
+                        serveArrivals(queue, workload, stats[i]);
+                    }));
+            }
+            generateArrivals(workload, targetQps, warmupIter, niter, seed, workloadStart, processCpuStart,
+                [&queue](const Arrival& arrival) { queue.push(arrival); });
+            queue.close();
+            std::for_each(workerThreads.begin(), workerThreads.end(), [](auto& t) { t->join(); });
+        }
+    } else {
+        ///////////////////////
+        // prepare threads, each conducts its warmup before reporting readiness
+        ///////////////////////
+        for (size_t i = 0; i < threadCount; ++i) {
+            workerThreads.emplace_back(std::make_unique<std::thread>(
+                [&readySignals,
+                    &futureStartSignals,
+                    &workload,
+                    &stats,
+                    warmupPerThread,
                     niterPerThread,
-                    wholeThreadsTimesUs[i],
-                    wholeTimes[i],
-                    pureTimes[i],
-                    srv,
-                    request);
-            }));
-    }
-    // sleep to allow all threads to initialize
-    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    ///////////////////////
-    // start workload
-    ///////////////////////
-    std::cout << "Benchmark starting workload" << std::endl;
-    auto workloadStart = std::chrono::high_resolution_clock::now();
-    std::for_each(startSignals.begin(), startSignals.end(), [](auto& startSignal) { startSignal.set_value(); });
+                    asyncMode,
+                    asyncInflightPerThread,
+                    seed,
+                    i]() {
+                    if (asyncMode) {
+                        triggerAsyncInferenceInALoop(
+                            readySignals[i],
+                            futureStartSignals[i],
+                            workload,
+                            warmupPerThread,
+                            niterPerThread,
+                            asyncInflightPerThread,
+                            seed + i,
+                            stats[i]);
+                        return;
+                    }
+                    triggerInferenceInALoop(
+                        readySignals[i],
+                        futureStartSignals[i],
+                        workload,
+                        warmupPerThread,
+                        niterPerThread,
+                        seed + i,
+                        stats[i]);
+                }));
+        }
+        std::for_each(readySignals.begin(), readySignals.end(), [](auto& readySignal) { readySignal.get_future().wait(); });
+        ///////////////////////
+        // start workload
+        ///////////////////////
+        std::cout << "Benchmark starting workload" << std::endl;
+        workloadStart = clock_type::now();
+        processCpuStart = cpuTimeNs(CLOCK_PROCESS_CPUTIME_ID);
+        std::for_each(startSignals.begin(), startSignals.end(), [](auto& startSignal) { startSignal.set_value(); });
+        std::for_each(workerThreads.begin(), workerThreads.end(), [](auto& t) { t->join(); });
+    }
     ///////////////////////
     // end workload
     ///////////////////////
-    std::for_each(workerThreads.begin(), workerThreads.end(), [](auto& t) { t->join(); });
-    auto workloadEnd = std::chrono::high_resolution_clock::now();
-    auto wholeTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(workloadEnd - workloadStart).count();
-    std::cout << "FPS: " << double(niter) / wholeTimeUs * 1'000'000 << std::endl;
-    auto totalUs = std::accumulate(wholeThreadsTimesUs.begin(), wholeThreadsTimesUs.end(), 0);
-    std::cout << "Average per thread FPS: " << double(niter) * threadCount/totalUs * 1'000'000 << std::endl;
-    OVMS_InferenceRequestDelete(request);
-    double totalWhole = std::accumulate(wholeTimes.begin(), wholeTimes.end(), double(0)) / threadCount;
-    double totalPure = std::accumulate(pureTimes.begin(), pureTimes.end(), double(0)) / threadCount;
+    auto workloadEnd = clock_type::now();
+    uint64_t processCpuTimeNs = cpuTimeNs(CLOCK_PROCESS_CPUTIME_ID) - processCpuStart;
+    deleteRequests();
+    WorkloadStats total(servables.size());
+    std::for_each(stats.begin(), stats.end(), [&total](const WorkloadStats& threadStats) { total.merge(threadStats); });
+    uint64_t measuredCount = total.whole.count();
+    int exitCode = EX_OK;
+    uint64_t wholeTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(workloadEnd - workloadStart).count();
+    std::cout << "FPS: " << double(measuredCount) / wholeTimeUs * 1'000'000 << std::endl;
+    if (!openLoop) {
+        std::cout << "Average per thread FPS: " << double(measuredCount) * threadCount / total.wholeThreadTimeUs * 1'000'000 << std::endl;
+    }
+    if (total.failed > 0) {
+        std::cerr << "Failed inferences:" << total.failed << std::endl;
+    }
     std::cout << std::fixed << std::setprecision(3);
-    std::cout << "Average latency whole prediction path:" << totalWhole << "ms" << std::endl;
-    std::cout << "Average latency pure C-API inference:" << totalPure << "ms" << std::endl;
+    if (openLoop) {
+        std::cout << "Whole prediction path latencies are measured from scheduled arrival time" << std::endl;
+    }
+    std::cout << "Average latency whole prediction path:" << total.whole.mean() / 1'000'000 << "ms" << std::endl;
+    printPercentiles("Latency whole prediction path", total.whole);
+    double totalPure = total.pure.mean() / 1'000'000;
+    if (asyncMode) {
+        std::cout << "Average time of scheduling with C-API:" << totalPure << "ms" << std::endl;
+    } else if (grpcMode) {
+        std::cout << "Average latency gRPC inference:" << totalPure << "ms" << std::endl;
+    } else {
+        std::cout << "Average latency pure C-API inference:" << totalPure << "ms" << std::endl;
+        if (!openLoop) {
+            double averageAllocations = double(total.allocations) / std::max<uint64_t>(1, measuredCount);
+            std::cout << "Average heap allocations per inference in calling thread:" << averageAllocations << std::endl;
+            // prepared request in steady state is expected to be served without heap allocations
+            if (prepared && total.allocations > 0) {
+                std::cerr << "Prepared requests made heap allocations in steady state:" << total.allocations << std::endl;
+                exitCode = EX_SOFTWARE;
+            }
+        }
+    }
+    std::cout << "Average CPU time per inference in calling thread:" << total.callingThreadCpuTimeNs / 1'000.0 / std::max<uint64_t>(1, total.pure.count()) << "us" << std::endl;
+    std::cout << "Average process CPU time per inference:" << processCpuTimeNs / 1'000.0 / std::max<uint64_t>(1, measuredCount) << "us" << std::endl;
+    if (servables.size() > 1) {
+        for (size_t i = 0; i < servables.size(); ++i) {
+            std::cout << "Servable " << servables[i].name << " inferences:" << total.wholePerServable[i].count()
+                      << " average latency:" << total.wholePerServable[i].mean() / 1'000'000 << "ms" << std::endl;
+            printPercentiles("Servable " + servables[i].name + " latency", total.wholePerServable[i]);
+        }
+    }
+    std::string jsonOutput(cliparser.result->operator[]("json_output").as<std::string>());
+    if (!jsonOutput.empty()) {
+        BenchmarkSummary summary{mode, loadMode, targetQps, threadCount, warmupIter, wholeTimeUs, processCpuTimeNs};
+        if (!writeJsonReport(jsonOutput, summary, total, servables)) {
+            std::cerr << "Failed to write results to:" << jsonOutput << std::endl;
+        }
+    }
     // OVMS cleanup
     OVMS_ServerDelete(srv);
     OVMS_ModelsSettingsDelete(modelsSettings);
     OVMS_ServerSettingsDelete(serverSettings);
     std::cout << "main() exit" << std::endl;
-    return 0;
+    return exitCode;
 }
 // adjustable nireq, adjustable shape, model name
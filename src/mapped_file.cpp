@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logging.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+namespace {
+struct MappedFileCacheEntry {
+    std::weak_ptr<const MappedFile> file;
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    struct timespec modificationTime;
+};
+
+bool isSameFile(const MappedFileCacheEntry& entry, const struct stat& fileStat) {
+    return entry.device == fileStat.st_dev &&
+           entry.inode == fileStat.st_ino &&
+           entry.size == fileStat.st_size &&
+           entry.modificationTime.tv_sec == fileStat.st_mtim.tv_sec &&
+           entry.modificationTime.tv_nsec == fileStat.st_mtim.tv_nsec;
+}
+
+std::mutex cacheMtx;
+std::unordered_map<std::string, MappedFileCacheEntry> cache;
+}  // namespace
+
+MappedFile::MappedFile(const std::string& path) :
+    path(path) {}
+
+MappedFile::~MappedFile() {
+    if (this->data != nullptr) {
+        munmap(this->data, this->size);
+    }
+}
+
+Status MappedFile::map(const std::string& path, std::shared_ptr<const MappedFile>& result) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        SPDLOG_DEBUG("Could not open file: {}; error: {}", path, std::strerror(errno));
+        return StatusCode::FILE_INVALID;
+    }
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) == -1 || fileStat.st_size == 0) {
+        close(fd);
+        SPDLOG_DEBUG("Could not map empty or inaccessible file: {}", path);
+        return StatusCode::FILE_INVALID;
+    }
+    std::unique_lock lock(cacheMtx);
+    for (auto it = cache.begin(); it != cache.end();) {
+        if (it->second.file.expired()) {
+            it = cache.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    auto it = cache.find(path);
+    if (it != cache.end() && isSameFile(it->second, fileStat)) {
+        result = it->second.file.lock();
+        if (result) {
+            close(fd);
+            SPDLOG_DEBUG("Reusing memory mapping of file: {}", path);
+            return StatusCode::OK;
+        }
+    }
+    std::shared_ptr<MappedFile> file(new MappedFile(path));
+    file->size = fileStat.st_size;
+    // private mapping shares page cache with other processes and instances reading the file
+    // and ensures that possible writes are never propagated to the file
+    void* data = mmap(nullptr, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        SPDLOG_DEBUG("Could not map file: {}; error: {}", path, std::strerror(errno));
+        return StatusCode::FILE_INVALID;
+    }
+    file->data = data;
+    cache[path] = MappedFileCacheEntry{file, fileStat.st_dev, fileStat.st_ino, fileStat.st_size, fileStat.st_mtim};
+    result = std::move(file);
+    return StatusCode::OK;
+}
+}  // namespace ovms
@@ -0,0 +1,52 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace ovms {
+class Status;
+
+/**
+ * @brief Read only, private memory mapping of a whole file.
+ * Mappings are shared between all users of the same unmodified file, e.g. model instances
+ * loading the same weights, and released when the last reference is dropped.
+ */
+class MappedFile {
+    const std::string path;
+    void* data = nullptr;
+    size_t size = 0;
+
+    MappedFile(const std::string& path);
+
+public:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    /**
+     * @brief Maps file or reuses existing mapping of the same file
+     * @return Status FILE_INVALID if file could not be opened or mapped
+     */
+    static Status map(const std::string& path, std::shared_ptr<const MappedFile>& result);
+
+    const std::string& getPath() const { return this->path; }
+    const void* getData() const { return this->data; }
+    size_t getSize() const { return this->size; }
+};
+}  // namespace ovms
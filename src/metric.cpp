@@ -15,17 +15,103 @@
 //*****************************************************************************
 #include "metric.hpp"
 
+#include <algorithm>
+#include <limits>
+
 #include <prometheus/counter.h>
 #include <prometheus/gauge.h>
 #include <prometheus/histogram.h>
 
 namespace ovms {
 
-MetricCounter::MetricCounter(prometheus::Counter& counterImpl) :
+static void atomicAdd(std::atomic<double>& target, double value) {
+    double current = target.load(std::memory_order_relaxed);
+    while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+    }
+}
+
+size_t getMetricShardIndex() {
+    static std::atomic<size_t> nextShardIndex{0};
+    thread_local const size_t shardIndex = nextShardIndex.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARDS_COUNT;
+    return shardIndex;
+}
+
+CounterAccumulator::CounterAccumulator(prometheus::Counter& counterImpl) :
+    MetricAccumulator(&counterImpl),
     counterImpl(counterImpl) {}
 
+void CounterAccumulator::add(double value) {
+    // prometheus::Counter ignores negative increments, so do we
+    if (value < 0.0) {
+        return;
+    }
+    atomicAdd(this->shards[getMetricShardIndex()].value, value);
+}
+
+void CounterAccumulator::flush() {
+    double total = 0.0;
+    for (auto& shard : this->shards) {
+        total += shard.value.exchange(0.0, std::memory_order_relaxed);
+    }
+    if (total > 0.0) {
+        this->counterImpl.Increment(total);
+    }
+}
+
+HistogramAccumulator::HistogramAccumulator(prometheus::Histogram& histogramImpl) :
+    MetricAccumulator(&histogramImpl),
+    histogramImpl(histogramImpl) {
+    // Boundaries are taken from prometheus::Histogram since metric with the same labels
+    // may have been added earlier with different buckets and is reused by the family
+    for (const auto& bucket : histogramImpl.Collect().histogram.bucket) {
+        if (bucket.upper_bound != std::numeric_limits<double>::infinity()) {
+            this->bucketBoundaries.emplace_back(bucket.upper_bound);
+        }
+    }
+    // Last bucket is +Inf
+    const size_t bucketsCount = this->bucketBoundaries.size() + 1;
+    for (auto& shard : this->shards) {
+        shard.bucketCounts = std::make_unique<std::atomic<uint64_t>[]>(bucketsCount);
+        for (size_t i = 0; i < bucketsCount; i++) {
+            shard.bucketCounts[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void HistogramAccumulator::observe(double value) {
+    // Same bucket selection as prometheus::Histogram::Observe - first boundary which is >= value
+    const size_t bucketIndex = std::distance(this->bucketBoundaries.begin(),
+        std::lower_bound(this->bucketBoundaries.begin(), this->bucketBoundaries.end(), value));
+    auto& shard = this->shards[getMetricShardIndex()];
+    shard.bucketCounts[bucketIndex].fetch_add(1, std::memory_order_relaxed);
+    atomicAdd(shard.sum, value);
+}
+
+void HistogramAccumulator::flush() {
+    // Bucket counts and sum are not moved atomically as a whole. Observation happening
+    // during flush may have its count reported in this scrape and its value in the next one.
+    std::vector<double> bucketIncrements(this->bucketBoundaries.size() + 1, 0.0);
+    double sum = 0.0;
+    uint64_t observationsCount = 0;
+    for (auto& shard : this->shards) {
+        for (size_t i = 0; i < bucketIncrements.size(); i++) {
+            uint64_t count = shard.bucketCounts[i].exchange(0, std::memory_order_relaxed);
+            bucketIncrements[i] += count;
+            observationsCount += count;
+        }
+        sum += shard.sum.exchange(0.0, std::memory_order_relaxed);
+    }
+    if (observationsCount > 0) {
+        this->histogramImpl.ObserveMultiple(bucketIncrements, sum);
+    }
+}
+
+MetricCounter::MetricCounter(prometheus::Counter& counterImpl) :
+    counterImpl(counterImpl),
+    accumulator(std::make_shared<CounterAccumulator>(counterImpl)) {}
+
 void MetricCounter::increment(double value) {
-    this->counterImpl.Increment(value);
+    this->accumulator->add(value);
 }
 
 MetricGauge::MetricGauge(prometheus::Gauge& gaugeImpl) :
@@ -44,10 +130,11 @@ void MetricGauge::set(double value) {
 }
 
 MetricHistogram::MetricHistogram(prometheus::Histogram& histogramImpl) :
-    histogramImpl(histogramImpl) {}
+    histogramImpl(histogramImpl),
+    accumulator(std::make_shared<HistogramAccumulator>(histogramImpl)) {}
 
 void MetricHistogram::observe(double value) {
-    this->histogramImpl.Observe(value);
+    this->accumulator->observe(value);
 }
 
 }  // namespace ovms
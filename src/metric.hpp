@@ -15,7 +15,13 @@
 //*****************************************************************************
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace prometheus {
 class Counter;
@@ -44,6 +50,71 @@ namespace ovms {
 
 template <typename T>
 class MetricFamily;
+class MetricRegistry;
+
+// Counters and histograms are updated by every request, from many threads at once.
+// To keep that path lock-free, each update goes to one of METRIC_SHARDS_COUNT cache line
+// aligned shards picked per thread. Shards are merged into prometheus-cpp objects
+// only when MetricRegistry::collect() serves a scrape.
+constexpr size_t METRIC_SHARDS_COUNT = 16;
+constexpr size_t METRIC_SHARD_ALIGNMENT = 64;
+
+size_t getMetricShardIndex();
+
+class MetricAccumulator {
+public:
+    MetricAccumulator(const void* metricImplRef) :
+        metricImplRef(metricImplRef) {}
+    virtual ~MetricAccumulator() = default;
+
+    // Moves values gathered in shards to prometheus-cpp metric. Called by MetricRegistry under its lock.
+    virtual void flush() = 0;
+
+    const void* getMetricImplRef() const { return metricImplRef; }
+    const void* getFamilyImplRef() const { return familyImplRef; }
+    bool isAttached() const { return attached; }
+    void detach() { attached = false; }
+
+private:
+    const void* metricImplRef;
+    const void* familyImplRef = nullptr;
+    bool attached = true;
+
+    template <typename T>
+    friend class MetricFamily;
+};
+
+class CounterAccumulator : public MetricAccumulator {
+public:
+    CounterAccumulator(prometheus::Counter& counterImpl);
+
+    void add(double value);
+    void flush() override;
+
+private:
+    struct alignas(METRIC_SHARD_ALIGNMENT) Shard {
+        std::atomic<double> value{0.0};
+    };
+    prometheus::Counter& counterImpl;
+    std::array<Shard, METRIC_SHARDS_COUNT> shards;
+};
+
+class HistogramAccumulator : public MetricAccumulator {
+public:
+    HistogramAccumulator(prometheus::Histogram& histogramImpl);
+
+    void observe(double value);
+    void flush() override;
+
+private:
+    struct alignas(METRIC_SHARD_ALIGNMENT) Shard {
+        std::unique_ptr<std::atomic<uint64_t>[]> bucketCounts;
+        std::atomic<double> sum{0.0};
+    };
+    prometheus::Histogram& histogramImpl;
+    std::vector<double> bucketBoundaries;
+    std::array<Shard, METRIC_SHARDS_COUNT> shards;
+};
 
 class MetricCounter {
 private:
@@ -57,6 +128,7 @@ public:
 
 private:
     prometheus::Counter& counterImpl;
+    std::shared_ptr<CounterAccumulator> accumulator;
 
     friend class MetricFamily<MetricCounter>;
 };
@@ -89,6 +161,7 @@ public:
 
 private:
     prometheus::Histogram& histogramImpl;
+    std::shared_ptr<HistogramAccumulator> accumulator;
 
     friend class MetricFamily<MetricHistogram>;
 };
@@ -43,6 +43,25 @@ const std::string METRIC_NAME_INFERENCE_TIME = "ovms_inference_time_us";
 const std::string METRIC_NAME_CURRENT_REQUESTS = "ovms_current_requests";
 const std::string METRIC_NAME_REQUEST_TIME = "ovms_request_time_us";
 const std::string METRIC_NAME_WAIT_FOR_INFER_REQ_TIME = "ovms_wait_for_infer_req_time_us";
+const std::string METRIC_NAME_INFERENCE_STAGE_TIME = "ovms_inference_stage_time_us";
+const std::string METRIC_NAME_REQUEST_STAGE_TIME = "ovms_request_stage_time_us";
+const std::string METRIC_NAME_DAG_NODE_WAIT_TIME = "ovms_dag_node_wait_time_us";
+const std::string METRIC_NAME_MODEL_EVICTION_TIME = "ovms_model_eviction_time_us";
+const std::string METRIC_NAME_MODEL_RELOAD_TIME = "ovms_model_reload_time_us";
+const std::string METRIC_NAME_MODEL_CPU_CORES = "ovms_model_cpu_cores";
+const std::string METRIC_NAME_MODEL_CPU_TIME = "ovms_model_cpu_time_us";
+const std::string METRIC_NAME_REQUESTS_QUEUED = "ovms_requests_queued";
+const std::string METRIC_NAME_QUEUE_WAIT_TIME = "ovms_queue_wait_time_us";
+const std::string METRIC_NAME_REQUESTS_REJECTED = "ovms_requests_rejected";
+const std::string METRIC_NAME_REQUESTS_CANCELLED = "ovms_requests_cancelled";
+const std::string METRIC_NAME_DAG_NODES_CANCELLED = "ovms_dag_nodes_cancelled";
+
+const std::string METRIC_NAME_METRICS_SCRAPE_TIME = "ovms_metrics_scrape_time_us";
+const std::string METRIC_NAME_METRICS_SCRAPE_SIZE = "ovms_metrics_scrape_size_bytes";
+
+const std::string METRIC_NAME_REST_REQUESTS_ACTIVE = "ovms_rest_requests_active";
+const std::string METRIC_NAME_REST_REQUESTS_QUEUED = "ovms_rest_requests_queued";
+const std::string METRIC_NAME_REST_REQUESTS_REJECTED = "ovms_rest_requests_rejected";
 
 bool MetricConfig::validateEndpointPath(const std::string& endpoint) {
     std::regex valid_endpoint_regex("^/[a-zA-Z0-9]*$");
@@ -35,6 +35,25 @@ extern const std::string METRIC_NAME_INFERENCE_TIME;
 extern const std::string METRIC_NAME_CURRENT_REQUESTS;
 extern const std::string METRIC_NAME_REQUEST_TIME;
 extern const std::string METRIC_NAME_WAIT_FOR_INFER_REQ_TIME;
+extern const std::string METRIC_NAME_INFERENCE_STAGE_TIME;
+extern const std::string METRIC_NAME_REQUEST_STAGE_TIME;
+extern const std::string METRIC_NAME_DAG_NODE_WAIT_TIME;
+extern const std::string METRIC_NAME_MODEL_EVICTION_TIME;
+extern const std::string METRIC_NAME_MODEL_RELOAD_TIME;
+extern const std::string METRIC_NAME_MODEL_CPU_CORES;
+extern const std::string METRIC_NAME_MODEL_CPU_TIME;
+extern const std::string METRIC_NAME_REQUESTS_QUEUED;
+extern const std::string METRIC_NAME_QUEUE_WAIT_TIME;
+extern const std::string METRIC_NAME_REQUESTS_REJECTED;
+extern const std::string METRIC_NAME_REQUESTS_CANCELLED;
+extern const std::string METRIC_NAME_DAG_NODES_CANCELLED;
+
+extern const std::string METRIC_NAME_METRICS_SCRAPE_TIME;
+extern const std::string METRIC_NAME_METRICS_SCRAPE_SIZE;
+
+extern const std::string METRIC_NAME_REST_REQUESTS_ACTIVE;
+extern const std::string METRIC_NAME_REST_REQUESTS_QUEUED;
+extern const std::string METRIC_NAME_REST_REQUESTS_REJECTED;
 
 class Status;
 /**
@@ -74,7 +93,24 @@ private:
 
     std::unordered_set<std::string> additionalMetricFamilies = {
         {METRIC_NAME_INFER_REQ_QUEUE_SIZE},
-        {METRIC_NAME_INFER_REQ_ACTIVE}};
+        {METRIC_NAME_INFER_REQ_ACTIVE},
+        {METRIC_NAME_METRICS_SCRAPE_TIME},
+        {METRIC_NAME_METRICS_SCRAPE_SIZE},
+        {METRIC_NAME_INFERENCE_STAGE_TIME},
+        {METRIC_NAME_REQUEST_STAGE_TIME},
+        {METRIC_NAME_DAG_NODE_WAIT_TIME},
+        {METRIC_NAME_MODEL_EVICTION_TIME},
+        {METRIC_NAME_MODEL_RELOAD_TIME},
+        {METRIC_NAME_MODEL_CPU_CORES},
+        {METRIC_NAME_MODEL_CPU_TIME},
+        {METRIC_NAME_REQUESTS_QUEUED},
+        {METRIC_NAME_QUEUE_WAIT_TIME},
+        {METRIC_NAME_REQUESTS_REJECTED},
+        {METRIC_NAME_REQUESTS_CANCELLED},
+        {METRIC_NAME_DAG_NODES_CANCELLED},
+        {METRIC_NAME_REST_REQUESTS_ACTIVE},
+        {METRIC_NAME_REST_REQUESTS_QUEUED},
+        {METRIC_NAME_REST_REQUESTS_REJECTED}};
 
     std::unordered_set<std::string> defaultMetricFamilies = {
         {METRIC_NAME_CURRENT_REQUESTS},
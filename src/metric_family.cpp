@@ -21,47 +21,55 @@
 #include <prometheus/registry.h>
 
 #include "metric.hpp"
+#include "metric_registry.hpp"
 
 namespace ovms {
 
 template <>
-MetricFamily<MetricCounter>::MetricFamily(const std::string& name, const std::string& description, prometheus::Registry& registryImplRef) :
-    registryImplRef(registryImplRef),
+MetricFamily<MetricCounter>::MetricFamily(const std::string& name, const std::string& description, MetricRegistry& registry) :
+    registry(registry),
     familyImplRef(&prometheus::BuildCounter()
                        .Name(name)
                        .Help(description)
-                       .Register(this->registryImplRef)) {
+                       .Register(this->registry.registryImpl)) {
+    this->registry.registerFamily(this->familyImplRef, MetricRegistry::MetricKind::COUNTER, name, description);
 }
 
 template <>
-MetricFamily<MetricGauge>::MetricFamily(const std::string& name, const std::string& description, prometheus::Registry& registryImplRef) :
-    registryImplRef(registryImplRef),
+MetricFamily<MetricGauge>::MetricFamily(const std::string& name, const std::string& description, MetricRegistry& registry) :
+    registry(registry),
     familyImplRef(&prometheus::BuildGauge()
                        .Name(name)
                        .Help(description)
-                       .Register(this->registryImplRef)) {
+                       .Register(this->registry.registryImpl)) {
+    this->registry.registerFamily(this->familyImplRef, MetricRegistry::MetricKind::GAUGE, name, description);
 }
 
 template <>
-MetricFamily<MetricHistogram>::MetricFamily(const std::string& name, const std::string& description, prometheus::Registry& registryImplRef) :
-    registryImplRef(registryImplRef),
+MetricFamily<MetricHistogram>::MetricFamily(const std::string& name, const std::string& description, MetricRegistry& registry) :
+    registry(registry),
     familyImplRef(&prometheus::BuildHistogram()
                        .Name(name)
                        .Help(description)
-                       .Register(this->registryImplRef)) {
+                       .Register(this->registry.registryImpl)) {
+    this->registry.registerFamily(this->familyImplRef, MetricRegistry::MetricKind::HISTOGRAM, name, description);
 }
 
 template <>
 std::unique_ptr<MetricCounter> MetricFamily<MetricCounter>::addMetric(const MetricLabels& labels, const BucketBoundaries& bucketBoundaries) {
     auto familyImpl = static_cast<prometheus::Family<prometheus::Counter>*>(this->familyImplRef);
     prometheus::Counter& counterImpl = familyImpl->Add(labels);
-    return std::unique_ptr<MetricCounter>(new MetricCounter(counterImpl));
+    auto metric = std::unique_ptr<MetricCounter>(new MetricCounter(counterImpl));
+    metric->accumulator->familyImplRef = this->familyImplRef;
+    this->registry.registerMetric(this->familyImplRef, &counterImpl, labels, metric->accumulator);
+    return metric;
 }
 
 template <>
 std::unique_ptr<MetricGauge> MetricFamily<MetricGauge>::addMetric(const MetricLabels& labels, const BucketBoundaries& bucketBoundaries) {
     auto familyImpl = static_cast<prometheus::Family<prometheus::Gauge>*>(this->familyImplRef);
     prometheus::Gauge& gaugeImpl = familyImpl->Add(labels);
+    this->registry.registerMetric(this->familyImplRef, &gaugeImpl, labels);
     return std::unique_ptr<MetricGauge>(new MetricGauge(gaugeImpl));
 }
 
@@ -69,24 +77,30 @@ template <>
 std::unique_ptr<MetricHistogram> MetricFamily<MetricHistogram>::addMetric(const MetricLabels& labels, const BucketBoundaries& bucketBoundaries) {
     auto familyImpl = static_cast<prometheus::Family<prometheus::Histogram>*>(this->familyImplRef);
     prometheus::Histogram& histogramImpl = familyImpl->Add(labels, bucketBoundaries);
-    return std::unique_ptr<MetricHistogram>(new MetricHistogram(histogramImpl));
+    auto metric = std::unique_ptr<MetricHistogram>(new MetricHistogram(histogramImpl));
+    metric->accumulator->familyImplRef = this->familyImplRef;
+    this->registry.registerMetric(this->familyImplRef, &histogramImpl, labels, metric->accumulator);
+    return metric;
 }
 
 template <>
 void MetricFamily<MetricCounter>::remove(std::unique_ptr<MetricCounter>& metric) {
     auto family = static_cast<prometheus::Family<prometheus::Counter>*>(this->familyImplRef);
+    this->registry.removeMetric(this->familyImplRef, &metric->counterImpl);
     family->Remove(&metric->counterImpl);
 }
 
 template <>
 void MetricFamily<MetricGauge>::remove(std::unique_ptr<MetricGauge>& metric) {
     auto family = static_cast<prometheus::Family<prometheus::Gauge>*>(this->familyImplRef);
+    this->registry.removeMetric(this->familyImplRef, &metric->gaugeImpl);
     family->Remove(&metric->gaugeImpl);
 }
 
 template <>
 void MetricFamily<MetricHistogram>::remove(std::unique_ptr<MetricHistogram>& metric) {
     auto family = static_cast<prometheus::Family<prometheus::Histogram>*>(this->familyImplRef);
+    this->registry.removeMetric(this->familyImplRef, &metric->histogramImpl);
     family->Remove(&metric->histogramImpl);
 }
 
@@ -20,10 +20,6 @@
 #include <string>
 #include <vector>
 
-namespace prometheus {
-class Registry;
-}
-
 namespace ovms {
 
 using MetricLabels = std::map<std::string, std::string>;
@@ -34,7 +30,7 @@ class MetricRegistry;
 template <typename MetricType>
 class MetricFamily {
 private:
-    MetricFamily(const std::string& name, const std::string& description, prometheus::Registry& registryImplRef);
+    MetricFamily(const std::string& name, const std::string& description, MetricRegistry& registry);
     MetricFamily(const MetricFamily&) = delete;
     MetricFamily(MetricFamily&&) = delete;
     MetricFamily& operator=(const MetricFamily&) = delete;
@@ -47,7 +43,7 @@ public:
     void remove(std::unique_ptr<MetricType>& metric);
 
 private:
-    prometheus::Registry& registryImplRef;
+    MetricRegistry& registry;
     void* familyImplRef;  // This is reference to prometheus::Family<T> where T is prometheus::Counter/Gauge/Histogram depending on MetricType.
 
     friend class MetricRegistry;
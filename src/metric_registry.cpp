@@ -15,33 +15,252 @@
 //*****************************************************************************
 #include "metric_registry.hpp"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <utility>
+
+#include <prometheus/counter.h>
 #include <prometheus/family.h>
-#include <prometheus/text_serializer.h>
+#include <prometheus/gauge.h>
+#include <prometheus/histogram.h>
 
 #include "metric.hpp"
-#include "metric_family.hpp"
 
 namespace ovms {
 
+// Same formatting as prometheus::TextSerializer which uses max_digits10 - 1 precision
+static void appendValue(std::string& out, double value) {
+    if (std::isnan(value)) {
+        out += "Nan";
+        return;
+    }
+    if (std::isinf(value)) {
+        out += value < 0 ? "-Inf" : "+Inf";
+        return;
+    }
+    char buffer[32];
+    int size = std::snprintf(buffer, sizeof(buffer), "%.*g", std::numeric_limits<double>::max_digits10 - 1, value);
+    out.append(buffer, size);
+}
+
+static void appendValue(std::string& out, uint64_t value) {
+    char buffer[24];
+    int size = std::snprintf(buffer, sizeof(buffer), "%" PRIu64, value);
+    out.append(buffer, size);
+}
+
+static void appendEscapedLabelValue(std::string& out, const std::string& value) {
+    for (char c : value) {
+        switch (c) {
+        case '\n':
+            out += "\\n";
+            break;
+        case '\\':
+        case '"':
+            out += '\\';
+            out += c;
+            break;
+        default:
+            out += c;
+        }
+    }
+}
+
+static std::string renderLinePrefix(const std::string& name, const std::string& suffix, const MetricLabels& labels, const std::string& le = "") {
+    std::string prefix = name + suffix;
+    if (!labels.empty() || !le.empty()) {
+        prefix += '{';
+        const char* separator = "";
+        for (const auto& [labelName, labelValue] : labels) {
+            prefix += separator;
+            prefix += labelName;
+            prefix += "=\"";
+            appendEscapedLabelValue(prefix, labelValue);
+            prefix += '"';
+            separator = ",";
+        }
+        if (!le.empty()) {
+            prefix += separator;
+            prefix += "le=\"";
+            prefix += le;
+            prefix += '"';
+        }
+        prefix += '}';
+    }
+    prefix += ' ';
+    return prefix;
+}
+
 MetricRegistry::MetricRegistry() = default;
 
+void MetricRegistry::registerFamily(const void* familyImplRef, MetricKind kind, const std::string& name, const std::string& description) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    // Prometheus registry returns already existing family when the same name is registered again
+    auto it = std::find_if(this->renderedFamilies.begin(), this->renderedFamilies.end(),
+        [familyImplRef](const RenderedFamily& family) { return family.familyImplRef == familyImplRef; });
+    if (it != this->renderedFamilies.end()) {
+        return;
+    }
+    std::string header;
+    if (!description.empty()) {
+        header += "# HELP " + name + " " + description + "\n";
+    }
+    header += "# TYPE " + name;
+    switch (kind) {
+    case MetricKind::COUNTER:
+        header += " counter\n";
+        break;
+    case MetricKind::GAUGE:
+        header += " gauge\n";
+        break;
+    case MetricKind::HISTOGRAM:
+        header += " histogram\n";
+        break;
+    }
+    this->renderedFamilies.emplace_back(RenderedFamily{familyImplRef, kind, name, std::move(header), {}});
+}
+
+void MetricRegistry::registerMetric(const void* familyImplRef, const void* metricImplRef, const MetricLabels& labels, std::shared_ptr<MetricAccumulator> accumulator) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    if (accumulator) {
+        this->accumulators.emplace_back(std::move(accumulator));
+    }
+    auto family = std::find_if(this->renderedFamilies.begin(), this->renderedFamilies.end(),
+        [familyImplRef](const RenderedFamily& family) { return family.familyImplRef == familyImplRef; });
+    if (family == this->renderedFamilies.end()) {
+        return;
+    }
+    // Metric with the same labels added again refers to the same prometheus object
+    if (std::any_of(family->metrics.begin(), family->metrics.end(),
+            [metricImplRef](const RenderedMetric& metric) { return metric.metricImplRef == metricImplRef; })) {
+        return;
+    }
+    RenderedMetric metric{metricImplRef, {}};
+    if (family->kind != MetricKind::HISTOGRAM) {
+        metric.linePrefixes.emplace_back(renderLinePrefix(family->name, "", labels));
+    } else {
+        metric.linePrefixes.emplace_back(renderLinePrefix(family->name, "_count", labels));
+        metric.linePrefixes.emplace_back(renderLinePrefix(family->name, "_sum", labels));
+        auto histogramImpl = static_cast<const prometheus::Histogram*>(metricImplRef);
+        for (const auto& bucket : histogramImpl->Collect().histogram.bucket) {
+            std::string le;
+            appendValue(le, bucket.upper_bound);
+            metric.linePrefixes.emplace_back(renderLinePrefix(family->name, "_bucket", labels, le));
+        }
+    }
+    family->metrics.emplace_back(std::move(metric));
+}
+
+void MetricRegistry::removeMetric(const void* familyImplRef, const void* metricImplRef) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    for (auto& accumulator : this->accumulators) {
+        if (accumulator->getFamilyImplRef() != familyImplRef) {
+            continue;
+        }
+        if (metricImplRef != nullptr && accumulator->getMetricImplRef() != metricImplRef) {
+            continue;
+        }
+        accumulator->detach();
+    }
+    auto family = std::find_if(this->renderedFamilies.begin(), this->renderedFamilies.end(),
+        [familyImplRef](const RenderedFamily& family) { return family.familyImplRef == familyImplRef; });
+    if (family == this->renderedFamilies.end()) {
+        return;
+    }
+    if (metricImplRef == nullptr) {
+        this->renderedFamilies.erase(family);
+        return;
+    }
+    family->metrics.erase(std::remove_if(family->metrics.begin(), family->metrics.end(),
+                              [metricImplRef](const RenderedMetric& metric) { return metric.metricImplRef == metricImplRef; }),
+        family->metrics.end());
+}
+
+void MetricRegistry::flushAccumulators() const {
+    auto it = this->accumulators.begin();
+    while (it != this->accumulators.end()) {
+        auto& accumulator = *it;
+        if (accumulator->isAttached()) {
+            accumulator->flush();
+        }
+        // Registry is the last owner when metric was already destroyed, values are flushed so it can be dropped
+        if (!accumulator->isAttached() || accumulator.use_count() == 1) {
+            it = this->accumulators.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void MetricRegistry::renderValues(const RenderedFamily& family, std::string& out) const {
+    for (const auto& metric : family.metrics) {
+        switch (family.kind) {
+        case MetricKind::COUNTER:
+            out += metric.linePrefixes[0];
+            appendValue(out, static_cast<const prometheus::Counter*>(metric.metricImplRef)->Value());
+            out += '\n';
+            break;
+        case MetricKind::GAUGE:
+            out += metric.linePrefixes[0];
+            appendValue(out, static_cast<const prometheus::Gauge*>(metric.metricImplRef)->Value());
+            out += '\n';
+            break;
+        case MetricKind::HISTOGRAM: {
+            auto histogram = static_cast<const prometheus::Histogram*>(metric.metricImplRef)->Collect().histogram;
+            out += metric.linePrefixes[0];
+            appendValue(out, histogram.sample_count);
+            out += '\n';
+            out += metric.linePrefixes[1];
+            appendValue(out, histogram.sample_sum);
+            out += '\n';
+            for (size_t i = 0; i < histogram.bucket.size() && i + 2 < metric.linePrefixes.size(); i++) {
+                out += metric.linePrefixes[i + 2];
+                appendValue(out, histogram.bucket[i].cumulative_count);
+                out += '\n';
+            }
+            break;
+        }
+        }
+    }
+}
+
 std::string MetricRegistry::collect() const {
-    prometheus::TextSerializer serializer;
-    return serializer.Serialize(this->registryImpl.Collect());
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->flushAccumulators();
+    std::string out;
+    out.reserve(this->lastCollectSize);
+    // Same order as prometheus::Registry::Collect - families grouped by type, in registration order within the group
+    for (MetricKind kind : {MetricKind::COUNTER, MetricKind::GAUGE, MetricKind::HISTOGRAM}) {
+        for (const auto& family : this->renderedFamilies) {
+            if (family.kind != kind || family.metrics.empty()) {
+                continue;
+            }
+            out += family.header;
+            this->renderValues(family, out);
+        }
+    }
+    this->lastCollectSize = out.size();
+    return out;
 }
 
 template <>
 bool MetricRegistry::remove(std::shared_ptr<MetricFamily<MetricCounter>> family) {
+    this->removeMetric(family->familyImplRef);
     return this->registryImpl.Remove(*static_cast<prometheus::Family<prometheus::Counter>*>(family->familyImplRef));
 }
 
 template <>
 bool MetricRegistry::remove(std::shared_ptr<MetricFamily<MetricGauge>> family) {
+    this->removeMetric(family->familyImplRef);
     return this->registryImpl.Remove(*static_cast<prometheus::Family<prometheus::Gauge>*>(family->familyImplRef));
 }
 
 template <>
 bool MetricRegistry::remove(std::shared_ptr<MetricFamily<MetricHistogram>> family) {
+    this->removeMetric(family->familyImplRef);
     return this->registryImpl.Remove(*static_cast<prometheus::Family<prometheus::Histogram>*>(family->familyImplRef));
 }
 
@@ -15,15 +15,21 @@
 //*****************************************************************************
 #pragma once
 
+#include <list>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include <prometheus/registry.h>
 
+#include "metric_family.hpp"
+
 namespace ovms {
 
 template <typename MetricType>
 class MetricFamily;
+class MetricAccumulator;
 
 class MetricRegistry {
 public:
@@ -36,7 +42,7 @@ public:
     std::shared_ptr<MetricFamily<MetricType>> createFamily(const std::string& name, const std::string& description) {
         try {
             return std::shared_ptr<MetricFamily<MetricType>>(
-                new MetricFamily<MetricType>(name, description, this->registryImpl));
+                new MetricFamily<MetricType>(name, description, *this));
         } catch (std::invalid_argument&) {
             return nullptr;
         }
@@ -49,7 +55,44 @@ public:
     std::string collect() const;
 
 private:
+    enum class MetricKind {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    // Text exposition of family and its metrics is rendered once, at registration.
+    // During collect only values are formatted and appended after prerendered line prefixes.
+    struct RenderedMetric {
+        const void* metricImplRef;
+        // Counter and gauge have single line. Histogram has _count, _sum and _bucket line for each boundary (including +Inf).
+        std::vector<std::string> linePrefixes;
+    };
+
+    struct RenderedFamily {
+        const void* familyImplRef;
+        MetricKind kind;
+        std::string name;
+        std::string header;
+        std::vector<RenderedMetric> metrics;
+    };
+
+    void registerFamily(const void* familyImplRef, MetricKind kind, const std::string& name, const std::string& description);
+    void registerMetric(const void* familyImplRef, const void* metricImplRef, const MetricLabels& labels, std::shared_ptr<MetricAccumulator> accumulator = nullptr);
+    // Stops flushing and rendering removed metric. Passing nullptr as metricImplRef removes whole family.
+    void removeMetric(const void* familyImplRef, const void* metricImplRef = nullptr);
+    void flushAccumulators() const;
+    void renderValues(const RenderedFamily& family, std::string& out) const;
+
     prometheus::Registry registryImpl;
+
+    mutable std::mutex mtx;
+    mutable std::list<std::shared_ptr<MetricAccumulator>> accumulators;
+    std::list<RenderedFamily> renderedFamilies;
+    mutable size_t lastCollectSize = 0;
+
+    template <typename MetricType>
+    friend class MetricFamily;
 };
 
 }  // namespace ovms
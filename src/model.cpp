@@ -26,6 +26,7 @@
 #include "filesystem.hpp"
 #include "localfilesystem.hpp"
 #include "logging.hpp"
+#include "model_memory_budget.hpp"
 #include "modelinstance.hpp"
 #include "pipelinedefinition.hpp"
 #include "statefulmodelinstance.hpp"
@@ -87,9 +88,11 @@ void Model::updateDefaultVersion(int ignoredVersion) {
     model_version_t newDefaultVersion = 0;
     SPDLOG_INFO("Updating default version for model: {}, from: {}", getName(), defaultVersion);
     for (const auto& [version, versionInstance] : modelVersions) {
+        // evicted versions are loaded back on request, so they remain eligible
         if (version != ignoredVersion &&
             version > newDefaultVersion &&
-            ModelVersionState::AVAILABLE == versionInstance->getStatus().getState()) {
+            (ModelVersionState::AVAILABLE == versionInstance->getStatus().getState() ||
+                versionInstance->isEvicted())) {
             newDefaultVersion = version;
         }
     }
@@ -128,6 +131,13 @@ Status Model::addVersion(const ModelConfig& config, ov::Core& ieCore, MetricRegi
     const auto& version = config.getVersion();
     std::shared_ptr<ModelInstance> modelInstance = modelInstanceFactory(config.getName(), version, ieCore, registry, metricConfig);
 
+    if (this->memoryBudget) {
+        modelInstance->setMemoryBudget(this->memoryBudget);
+        this->memoryBudget->add(modelInstance);
+    }
+    modelInstance->setModelSubscriptionManager(&this->subscriptionManager);
+    modelInstance->setCpuResourceManager(this->cpuResourceManager);
+
     std::unique_lock lock(modelVersionsMtx);
     modelVersions.emplace(version, modelInstance);
     lock.unlock();
@@ -135,6 +145,9 @@ Status Model::addVersion(const ModelConfig& config, ov::Core& ieCore, MetricRegi
     if (!status.ok()) {
         return status;
     }
+    if (this->memoryBudget) {
+        this->memoryBudget->enforce(modelInstance.get());
+    }
     updateDefaultVersion();
     subscriptionManager.notifySubscribers();
     return StatusCode::OK;
@@ -36,6 +36,8 @@ class FileSystem;
 class GlobalSequencesViewer;
 class ModelConfig;
 class ModelInstance;
+class CpuResourceManager;
+class ModelMemoryBudget;
 class PipelineDefinition;
 class MetricConfig;
 class MetricRegistry;
@@ -114,6 +116,16 @@ protected:
          */
     std::string customLoaderName;
 
+    /**
+         * @brief Memory budget shared by all models, nullptr if not limited
+         */
+    std::shared_ptr<ModelMemoryBudget> memoryBudget;
+
+    /**
+         * @brief Partitions CPU cores between models, nullptr if not used
+         */
+    std::shared_ptr<CpuResourceManager> cpuResourceManager;
+
 public:
     /**
          * @brief Constructor
@@ -131,6 +143,20 @@ public:
          */
     virtual ~Model() {}
 
+    /**
+         * @brief Sets memory budget applied to versions added afterwards
+         */
+    void setMemoryBudget(std::shared_ptr<ModelMemoryBudget> memoryBudget) {
+        this->memoryBudget = std::move(memoryBudget);
+    }
+
+    /**
+         * @brief Sets CPU resource manager used by versions added afterwards
+         */
+    void setCpuResourceManager(std::shared_ptr<CpuResourceManager> cpuResourceManager) {
+        this->cpuResourceManager = std::move(cpuResourceManager);
+    }
+
     /**
          * @brief Gets the model name
          * 
@@ -0,0 +1,88 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "model_memory_budget.hpp"
+
+#include <algorithm>
+
+#include "logging.hpp"
+#include "modelinstance.hpp"
+
+namespace ovms {
+
+void ModelMemoryBudget::add(const std::shared_ptr<ModelInstance>& instance) {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    this->instances.emplace_back(instance);
+}
+
+size_t ModelMemoryBudget::getResidentBytes() const {
+    std::lock_guard<std::mutex> lock(this->mtx);
+    size_t resident = 0;
+    for (const auto& weakInstance : this->instances) {
+        auto instance = weakInstance.lock();
+        if (instance && instance->isResident()) {
+            resident += instance->getMemoryFootprint();
+        }
+    }
+    return resident;
+}
+
+size_t ModelMemoryBudget::enforce(const ModelInstance* protectedInstance) {
+    size_t resident = 0;
+    std::vector<std::shared_ptr<ModelInstance>> candidates;
+    {
+        std::lock_guard<std::mutex> lock(this->mtx);
+        this->instances.erase(std::remove_if(this->instances.begin(), this->instances.end(),
+                                  [](const std::weak_ptr<ModelInstance>& instance) { return instance.expired(); }),
+            this->instances.end());
+        for (const auto& weakInstance : this->instances) {
+            auto instance = weakInstance.lock();
+            if (!instance || !instance->isResident()) {
+                continue;
+            }
+            resident += instance->getMemoryFootprint();
+            if (instance.get() != protectedInstance && instance->isEvictable()) {
+                candidates.emplace_back(std::move(instance));
+            }
+        }
+    }
+    // Eviction waits for requests in progress which may load back other evicted models
+    // and enforce the budget themselves, so it has to be done without holding the lock.
+    if (resident <= this->budgetBytes) {
+        return 0;
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [](const std::shared_ptr<ModelInstance>& a, const std::shared_ptr<ModelInstance>& b) {
+            return a->getLastUsedTimestamp() < b->getLastUsedTimestamp();
+        });
+    size_t evictedCount = 0;
+    for (const auto& candidate : candidates) {
+        if (resident <= this->budgetBytes) {
+            break;
+        }
+        size_t footprint = candidate->getMemoryFootprint();
+        if (candidate->evict()) {
+            resident -= footprint;
+            ++evictedCount;
+        }
+    }
+    if (resident > this->budgetBytes) {
+        SPDLOG_LOGGER_WARN(modelmanager_logger, "Loaded models use estimated {} bytes exceeding models memory budget of {} bytes. No more models can be evicted at the moment",
+            resident, this->budgetBytes);
+    }
+    return evictedCount;
+}
+
+}  // namespace ovms
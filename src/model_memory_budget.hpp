@@ -0,0 +1,62 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ovms {
+
+class ModelInstance;
+
+/**
+ * @brief Limits memory of loaded models by unloading least recently used model instances.
+ *
+ * Evicted instances keep their config and are loaded back by ModelInstance::waitForLoaded on the next request,
+ * which makes room for them by evicting other instances. Memory of an instance is estimated from its model files size.
+ */
+class ModelMemoryBudget {
+    const size_t budgetBytes;
+
+    mutable std::mutex mtx;
+    std::vector<std::weak_ptr<ModelInstance>> instances;
+
+public:
+    explicit ModelMemoryBudget(size_t budgetBytes) :
+        budgetBytes(budgetBytes) {}
+
+    size_t getBudgetBytes() const { return this->budgetBytes; }
+
+    void add(const std::shared_ptr<ModelInstance>& instance);
+
+    /**
+     * @brief Sum of estimated memory of instances which are loaded and not evicted
+     */
+    size_t getResidentBytes() const;
+
+    /**
+     * @brief Evicts least recently used instances until resident memory fits in the budget
+     *
+     * @param protectedInstance instance which is not evicted, e.g. one which has just been loaded
+     *
+     * @return number of evicted instances
+     */
+    size_t enforce(const ModelInstance* protectedInstance = nullptr);
+};
+
+}  // namespace ovms
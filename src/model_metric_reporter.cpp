@@ -17,6 +17,7 @@
 
 #include <cmath>
 #include <exception>
+#include <utility>
 
 #include "execution_context.hpp"
 #include "logging.hpp"
@@ -246,6 +247,26 @@ ServableMetricReporter::ServableMetricReporter(const MetricConfig* metricConfig,
             this->buckets);
         THROW_IF_NULL(this->requestTimeRest, "cannot create metric");
     }
+
+    familyName = METRIC_NAME_REQUEST_STAGE_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricHistogram>(familyName,
+            "Time of request processing stages outside of the inference, per interface.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->requestParseTimeRest = family->addMetric({{"name", modelName},
+                                                           {"version", std::to_string(modelVersion)},
+                                                           {"interface", "REST"},
+                                                           {"stage", "parse"}},
+            this->buckets);
+        THROW_IF_NULL(this->requestParseTimeRest, "cannot create metric");
+
+        this->responseRenderTimeRest = family->addMetric({{"name", modelName},
+                                                             {"version", std::to_string(modelVersion)},
+                                                             {"interface", "REST"},
+                                                             {"stage", "render"}},
+            this->buckets);
+        THROW_IF_NULL(this->responseRenderTimeRest, "cannot create metric");
+    }
 }
 
 ModelMetricReporter::ModelMetricReporter(const MetricConfig* metricConfig, MetricRegistry* registry, const std::string& modelName, model_version_t modelVersion) :
@@ -280,6 +301,128 @@ ModelMetricReporter::ModelMetricReporter(const MetricConfig* metricConfig, Metri
         THROW_IF_NULL(this->waitForInferReqTime, "cannot create metric");
     }
 
+    familyName = METRIC_NAME_INFERENCE_STAGE_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricHistogram>(familyName,
+            "Time of inference processing stages in a model.");
+        THROW_IF_NULL(family, "cannot create family");
+        const std::vector<std::pair<std::string, std::unique_ptr<MetricHistogram>*>> stages{
+            {"get_infer_request", &this->stageTimeGetInferRequest},
+            {"preprocess", &this->stageTimePreprocess},
+            {"deserialize", &this->stageTimeDeserialize},
+            {"prediction", &this->stageTimePrediction},
+            {"serialize", &this->stageTimeSerialize},
+            {"postprocess", &this->stageTimePostprocess}};
+        for (auto& [stage, metric] : stages) {
+            *metric = family->addMetric(
+                {{"name", modelName}, {"version", std::to_string(modelVersion)}, {"stage", stage}},
+                this->buckets);
+            THROW_IF_NULL(*metric, "cannot create metric");
+        }
+    }
+
+    familyName = METRIC_NAME_MODEL_EVICTION_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricHistogram>(familyName,
+            "Time of unloading a model to fit in the models memory budget.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->evictionTime = family->addMetric(
+            {{"name", modelName}, {"version", std::to_string(modelVersion)}},
+            this->buckets);
+        THROW_IF_NULL(this->evictionTime, "cannot create metric");
+    }
+
+    familyName = METRIC_NAME_MODEL_RELOAD_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricHistogram>(familyName,
+            "Time of loading back an evicted model on request.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->reloadAfterEvictionTime = family->addMetric(
+            {{"name", modelName}, {"version", std::to_string(modelVersion)}},
+            this->buckets);
+        THROW_IF_NULL(this->reloadAfterEvictionTime, "cannot create metric");
+    }
+
+    familyName = METRIC_NAME_MODEL_CPU_CORES;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricGauge>(familyName,
+            "Number of CPU threads used by model inferences.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->cpuCores = family->addMetric(
+            {{"name", modelName}, {"version", std::to_string(modelVersion)}});
+        THROW_IF_NULL(this->cpuCores, "cannot create metric");
+    }
+
+    familyName = METRIC_NAME_MODEL_CPU_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricCounter>(familyName,
+            "Estimated CPU time of model inferences.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->cpuTime = family->addMetric(
+            {{"name", modelName}, {"version", std::to_string(modelVersion)}});
+        THROW_IF_NULL(this->cpuTime, "cannot create metric");
+    }
+
+    familyName = METRIC_NAME_REQUESTS_QUEUED;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricGauge>(familyName,
+            "Number of requests waiting for inference request.");
+        THROW_IF_NULL(family, "cannot create family");
+        for (auto priority : REQUEST_PRIORITIES) {
+            auto& metric = this->requestsQueued[toIndex(priority)];
+            metric = family->addMetric(
+                {{"name", modelName}, {"version", std::to_string(modelVersion)}, {"priority", toString(priority)}});
+            THROW_IF_NULL(metric, "cannot create metric");
+        }
+    }
+
+    familyName = METRIC_NAME_QUEUE_WAIT_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricHistogram>(familyName,
+            "Time requests wait for inference request.");
+        THROW_IF_NULL(family, "cannot create family");
+        for (auto priority : REQUEST_PRIORITIES) {
+            auto& metric = this->queueWaitTime[toIndex(priority)];
+            metric = family->addMetric(
+                {{"name", modelName}, {"version", std::to_string(modelVersion)}, {"priority", toString(priority)}},
+                this->buckets);
+            THROW_IF_NULL(metric, "cannot create metric");
+        }
+    }
+
+    familyName = METRIC_NAME_REQUESTS_REJECTED;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricCounter>(familyName,
+            "Number of requests rejected by admission control.");
+        THROW_IF_NULL(family, "cannot create family");
+        for (auto priority : REQUEST_PRIORITIES) {
+            const std::vector<std::pair<std::string, std::unique_ptr<MetricCounter>*>> reasons{
+                {"queue_full", &this->requestsRejectedQueueFull[toIndex(priority)]},
+                {"queue_timeout", &this->requestsRejectedQueueTimeout[toIndex(priority)]}};
+            for (auto& [reason, metric] : reasons) {
+                *metric = family->addMetric(
+                    {{"name", modelName}, {"version", std::to_string(modelVersion)}, {"priority", toString(priority)}, {"reason", reason}});
+                THROW_IF_NULL(*metric, "cannot create metric");
+            }
+        }
+    }
+
+    familyName = METRIC_NAME_REQUESTS_CANCELLED;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricCounter>(familyName,
+            "Number of requests dropped because client deadline passed or client cancelled the request.");
+        THROW_IF_NULL(family, "cannot create family");
+        const std::vector<std::pair<std::string, std::unique_ptr<MetricCounter>*>> stages{
+            {"get_infer_request", &this->requestsCancelledGetInferRequest},
+            {"inference", &this->requestsCancelledInference},
+            {"serialize", &this->requestsCancelledSerialize}};
+        for (auto& [stage, metric] : stages) {
+            *metric = family->addMetric(
+                {{"name", modelName}, {"version", std::to_string(modelVersion)}, {"stage", stage}});
+            THROW_IF_NULL(*metric, "cannot create metric");
+        }
+    }
+
     familyName = METRIC_NAME_STREAMS;
     if (metricConfig->isFamilyEnabled(familyName)) {
         auto family = registry->createFamily<MetricGauge>(familyName,
@@ -321,4 +464,46 @@ ModelMetricReporter::ModelMetricReporter(const MetricConfig* metricConfig, Metri
     }
 }
 
+PipelineMetricReporter::PipelineMetricReporter(const MetricConfig* metricConfig, MetricRegistry* registry, const std::string& pipelineName, model_version_t pipelineVersion) :
+    ServableMetricReporter(metricConfig, registry, pipelineName, pipelineVersion) {
+    if (!registry) {
+        return;
+    }
+
+    if (!metricConfig || !metricConfig->metricsEnabled) {
+        return;
+    }
+
+    std::string familyName = METRIC_NAME_DAG_NODE_WAIT_TIME;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricHistogram>(familyName,
+            "Time DAG node sessions wait for a free inference request before execution.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->dagNodeWaitTime = family->addMetric(
+            {{"name", pipelineName}, {"version", std::to_string(pipelineVersion)}},
+            this->buckets);
+        THROW_IF_NULL(this->dagNodeWaitTime, "cannot create metric");
+    }
+
+    familyName = METRIC_NAME_REQUESTS_CANCELLED;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricCounter>(familyName,
+            "Number of requests dropped because client deadline passed or client cancelled the request.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->dagRequestsCancelled = family->addMetric(
+            {{"name", pipelineName}, {"version", std::to_string(pipelineVersion)}, {"stage", "pipeline"}});
+        THROW_IF_NULL(this->dagRequestsCancelled, "cannot create metric");
+    }
+
+    familyName = METRIC_NAME_DAG_NODES_CANCELLED;
+    if (metricConfig->isFamilyEnabled(familyName)) {
+        auto family = registry->createFamily<MetricCounter>(familyName,
+            "Number of DAG nodes not executed because client deadline passed or client cancelled the request.");
+        THROW_IF_NULL(family, "cannot create family");
+        this->dagNodesCancelled = family->addMetric(
+            {{"name", pipelineName}, {"version", std::to_string(pipelineVersion)}});
+        THROW_IF_NULL(this->dagNodesCancelled, "cannot create metric");
+    }
+}
+
 }  // namespace ovms
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "execution_context.hpp"
 #include "metric.hpp"
 #include "modelversion.hpp"
+#include "request_scope.hpp"
 
 namespace ovms {
 
@@ -74,6 +76,14 @@ public:
     std::unique_ptr<MetricHistogram> requestTimeGrpc;
     std::unique_ptr<MetricHistogram> requestTimeRest;
 
+    std::unique_ptr<MetricHistogram> requestParseTimeRest;
+    std::unique_ptr<MetricHistogram> responseRenderTimeRest;
+
+    // Populated only for DAGs, see PipelineMetricReporter
+    std::unique_ptr<MetricHistogram> dagNodeWaitTime;
+    std::unique_ptr<MetricCounter> dagRequestsCancelled;
+    std::unique_ptr<MetricCounter> dagNodesCancelled;
+
     inline std::unique_ptr<MetricCounter>& getGetModelStatusRequestSuccessMetric(const ExecutionContext& context) {
         if (context.method != ExecutionContext::Method::GetModelStatus) {
             static std::unique_ptr<MetricCounter> empty = nullptr;
@@ -103,6 +113,10 @@ public:
     }
 
     inline std::unique_ptr<MetricCounter>& getInferRequestMetric(const ExecutionContext& context, bool success = true) {
+        if (context.interface == ExecutionContext::Interface::CAPI) {
+            static std::unique_ptr<MetricCounter> empty = nullptr;
+            return empty;  // C-API requests are not counted
+        }
         if (context.method == ExecutionContext::Method::Predict) {
             if (context.interface == ExecutionContext::Interface::GRPC) {
                 return success ? this->requestSuccessGrpcPredict : this->requestFailGrpcPredict;
@@ -142,6 +156,32 @@ public:
     std::unique_ptr<MetricHistogram> inferenceTime;
     std::unique_ptr<MetricHistogram> waitForInferReqTime;
 
+    std::unique_ptr<MetricHistogram> stageTimeGetInferRequest;
+    std::unique_ptr<MetricHistogram> stageTimePreprocess;
+    std::unique_ptr<MetricHistogram> stageTimeDeserialize;
+    std::unique_ptr<MetricHistogram> stageTimePrediction;
+    std::unique_ptr<MetricHistogram> stageTimeSerialize;
+    std::unique_ptr<MetricHistogram> stageTimePostprocess;
+
+    // Memory budget, histogram count is the number of evictions and reloads
+    std::unique_ptr<MetricHistogram> evictionTime;
+    std::unique_ptr<MetricHistogram> reloadAfterEvictionTime;
+
+    // CPU threads available to the model and estimated CPU time of its inferences
+    std::unique_ptr<MetricGauge> cpuCores;
+    std::unique_ptr<MetricCounter> cpuTime;
+
+    // Admission control, indexed by toIndex(RequestPriority)
+    std::array<std::unique_ptr<MetricGauge>, REQUEST_PRIORITIES.size()> requestsQueued;
+    std::array<std::unique_ptr<MetricHistogram>, REQUEST_PRIORITIES.size()> queueWaitTime;
+    std::array<std::unique_ptr<MetricCounter>, REQUEST_PRIORITIES.size()> requestsRejectedQueueFull;
+    std::array<std::unique_ptr<MetricCounter>, REQUEST_PRIORITIES.size()> requestsRejectedQueueTimeout;
+
+    // Requests dropped after deadline or client cancellation, by the first stage which was skipped
+    std::unique_ptr<MetricCounter> requestsCancelledGetInferRequest;
+    std::unique_ptr<MetricCounter> requestsCancelledInference;
+    std::unique_ptr<MetricCounter> requestsCancelledSerialize;
+
     std::unique_ptr<MetricGauge> streams;
     std::unique_ptr<MetricGauge> inferReqQueueSize;
     std::unique_ptr<MetricGauge> inferReqActive;
@@ -150,4 +190,9 @@ public:
     ModelMetricReporter(const MetricConfig* metricConfig, MetricRegistry* registry, const std::string& modelName, model_version_t modelVersion);
 };
 
+class PipelineMetricReporter : public ServableMetricReporter {
+public:
+    PipelineMetricReporter(const MetricConfig* metricConfig, MetricRegistry* registry, const std::string& pipelineName, model_version_t pipelineVersion);
+};
+
 }  // namespace ovms
@@ -60,6 +60,7 @@ ModelConfig::ModelConfig(const std::string& name,
     layout(""),
     shapes({}),
     layouts({}),
+    preprocessing({}),
     mappingInputs({}),
     mappingOutputs({}) {
     setBatchingParams(configBatchSize);
@@ -119,6 +120,14 @@ bool ModelConfig::isReloadRequired(const ModelConfig& rhs) const {
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "ModelConfig {} reload required due to nireq mismatch", this->name);
         return true;
     }
+    if (this->cpuCores != rhs.cpuCores) {
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "ModelConfig {} reload required due to cpu cores mismatch", this->name);
+        return true;
+    }
+    if (this->maxQueueDepth != rhs.maxQueueDepth || this->maxQueueWaitMs != rhs.maxQueueWaitMs) {
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "ModelConfig {} reload required due to queue limits mismatch", this->name);
+        return true;
+    }
     if (this->pluginConfig != rhs.pluginConfig) {
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "ModelConfig {} reload required due to plugin config mismatch", this->name);
         return true;
@@ -131,6 +140,10 @@ bool ModelConfig::isReloadRequired(const ModelConfig& rhs) const {
         SPDLOG_LOGGER_DEBUG(modelmanager_logger, "ModelConfig {} reload required due to shape configuration mismatch", this->name);
         return true;
     }
+    if (!isPreprocessingConfigurationEqual(rhs)) {
+        SPDLOG_LOGGER_DEBUG(modelmanager_logger, "ModelConfig {} reload required due to preprocessing configuration mismatch", this->name);
+        return true;
+    }
     if (isCustomLoaderConfigChanged(rhs)) {
         return true;
     }
@@ -184,6 +197,22 @@ bool ModelConfig::isLayoutConfigurationEqual(const ModelConfig& rhs) const {
     return true;
 }
 
+bool ModelConfig::isPreprocessingConfigurationEqual(const ModelConfig& rhs) const {
+    if (this->preprocessing.size() != rhs.preprocessing.size()) {
+        return false;
+    }
+    for (const auto& [name, preprocessingConfig] : this->preprocessing) {
+        auto it = rhs.preprocessing.find(name);
+        if (it == rhs.preprocessing.end()) {
+            return false;
+        }
+        if (preprocessingConfig != it->second) {
+            return false;
+        }
+    }
+    return true;
+}
+
 bool ModelConfig::isShapeConfigurationEqual(const ModelConfig& rhs) const {
     if (this->shapes.size() != rhs.shapes.size()) {
         return false;
@@ -412,6 +441,25 @@ Status ModelConfig::parseLayoutParameter(const rapidjson::Value& node) {
     return StatusCode::OK;
 }
 
+Status ModelConfig::parsePreprocessingParameter(const rapidjson::Value& node) {
+    if (!node.IsObject()) {
+        return StatusCode::PREPROCESSING_WRONG_FORMAT;
+    }
+    preprocessing_configurations_map_t preprocessing;
+    for (auto it = node.MemberBegin(); it != node.MemberEnd(); ++it) {
+        PreprocessingConfiguration preprocessingConfig;
+        auto status = PreprocessingConfiguration::fromJson(it->value, preprocessingConfig);
+        if (!status.ok()) {
+            SPDLOG_WARN("Preprocessing of input: {} is in wrong format", it->name.GetString());
+            return status;
+        }
+        preprocessing[it->name.GetString()] = preprocessingConfig;
+    }
+    setPreprocessing(preprocessing);
+
+    return StatusCode::OK;
+}
+
 Status ModelConfig::parseLayoutParameter(const std::string& command) {
     this->layouts.clear();
     this->layout = LayoutConfiguration();
@@ -519,6 +567,12 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
     }
     if (v.HasMember("nireq"))
         this->setNireq(v["nireq"].GetUint64());
+    if (v.HasMember("cpu_cores"))
+        this->setCpuCores(v["cpu_cores"].GetUint());
+    if (v.HasMember("max_queue_depth"))
+        this->setMaxQueueDepth(v["max_queue_depth"].GetUint());
+    if (v.HasMember("max_queue_wait_ms"))
+        this->setMaxQueueWaitMs(v["max_queue_wait_ms"].GetUint());
 
     if (v.HasMember("shape")) {
         // Legacy format as string
@@ -596,6 +650,13 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
         }
     }
 
+    if (v.HasMember("preprocess")) {
+        Status status = this->parsePreprocessingParameter(v["preprocess"]);
+        if (!status.ok()) {
+            return status;
+        }
+    }
+
     if (v.HasMember("plugin_config")) {
         auto status = parsePluginConfig(v["plugin_config"]);
         if (!status.ok()) {
@@ -670,6 +731,9 @@ Status ModelConfig::parseNode(const rapidjson::Value& v) {
         SPDLOG_DEBUG("model_version_policy: {}", std::string(*getModelVersionPolicy()));
     }
     SPDLOG_DEBUG("nireq: {}", getNireq());
+    SPDLOG_DEBUG("cpu_cores: {}", getCpuCores());
+    SPDLOG_DEBUG("max_queue_depth: {}", getMaxQueueDepth());
+    SPDLOG_DEBUG("max_queue_wait_ms: {}", getMaxQueueWaitMs());
     SPDLOG_DEBUG("target_device: {}", getTargetDevice());
     SPDLOG_DEBUG("plugin_config:");
     for (auto& [pluginParameter, pluginValue] : getPluginConfig()) {
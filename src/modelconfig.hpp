@@ -27,6 +27,7 @@
 #include <rapidjson/document.h>
 
 #include "layout_configuration.hpp"
+#include "preprocessing_configuration.hpp"
 #include "metric_config.hpp"
 #include "modelversion.hpp"
 #include "shape.hpp"
@@ -88,6 +89,21 @@ private:
          */
     uint64_t nireq;
 
+    /**
+         * @brief Number of CPU cores reserved for the model, 0 if it uses cores shared with other models
+         */
+    uint32_t cpuCores = 0;
+
+    /**
+         * @brief Maximum number of requests waiting for infer request, 0 if not limited
+         */
+    uint32_t maxQueueDepth = 0;
+
+    /**
+         * @brief Maximum time in milliseconds a request can wait for infer request, 0 if not limited
+         */
+    uint32_t maxQueueWaitMs = 0;
+
     /**
          * @brief Flag determining if model is stateful
          */
@@ -144,6 +160,11 @@ private:
          */
     layout_configurations_map_t layouts;
 
+    /**
+         * @brief Map of inputs preprocessing
+         */
+    preprocessing_configurations_map_t preprocessing;
+
     /**
          * @brief Input mapping configuration
          */
@@ -252,6 +273,15 @@ public:
          */
     bool isLayoutConfigurationEqual(const ModelConfig& rhs) const;
 
+    /**
+         * @brief Compares two ModelConfig instances for inputs preprocessing configuration
+         * 
+         * @param rhs
+         *  
+         * @return true if configurations are equal false otherwise
+         */
+    bool isPreprocessingConfigurationEqual(const ModelConfig& rhs) const;
+
     /**
          * @brief Compares two ModelConfig instances for shape configuration
          * 
@@ -502,6 +532,60 @@ public:
         this->nireq = nireq;
     }
 
+    /**
+         * @brief Get the number of reserved CPU cores
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getCpuCores() const {
+        return this->cpuCores;
+    }
+
+    /**
+         * @brief Set the number of reserved CPU cores
+         * 
+         * @param cpuCores 
+         */
+    void setCpuCores(const uint32_t cpuCores) {
+        this->cpuCores = cpuCores;
+    }
+
+    /**
+         * @brief Get the maximum number of requests waiting for infer request
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getMaxQueueDepth() const {
+        return this->maxQueueDepth;
+    }
+
+    /**
+         * @brief Set the maximum number of requests waiting for infer request
+         * 
+         * @param maxQueueDepth 
+         */
+    void setMaxQueueDepth(const uint32_t maxQueueDepth) {
+        this->maxQueueDepth = maxQueueDepth;
+    }
+
+    /**
+         * @brief Get the maximum time of waiting for infer request
+         * 
+         * @return uint32_t 
+         */
+    uint32_t getMaxQueueWaitMs() const {
+        return this->maxQueueWaitMs;
+    }
+
+    /**
+         * @brief Set the maximum time of waiting for infer request
+         * 
+         * @param maxQueueWaitMs 
+         */
+    void setMaxQueueWaitMs(const uint32_t maxQueueWaitMs) {
+        this->maxQueueWaitMs = maxQueueWaitMs;
+    }
+
     /**
          * @brief Get the plugin config
          * 
@@ -656,6 +740,15 @@ public:
          */
     Status parseLayoutParameter(const std::string& command);
 
+    /**
+         * @brief Parses value from json and extracts inputs preprocessing info
+         * 
+         * @param rapidjson::Value& node
+         * 
+         * @return status
+         */
+    Status parsePreprocessingParameter(const rapidjson::Value& node);
+
     /**
          * @brief Returns true if any input shape specified in shapes map is in AUTO mode
          * 
@@ -776,6 +869,24 @@ public:
         this->layout = LayoutConfiguration();
     }
 
+    /**
+         * @brief Get the inputs preprocessing
+         * 
+         * @return const preprocessing_configurations_map_t& 
+         */
+    const preprocessing_configurations_map_t& getPreprocessing() const {
+        return this->preprocessing;
+    }
+
+    /**
+         * @brief Set the inputs preprocessing
+         * 
+         * @param preprocessing 
+         */
+    void setPreprocessing(const preprocessing_configurations_map_t& preprocessing) {
+        this->preprocessing = preprocessing;
+    }
+
     /**
          * @brief Get the version
          * 
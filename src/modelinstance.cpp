@@ -16,35 +16,49 @@
 #include "modelinstance.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <set>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 #include <dirent.h>
 #include <spdlog/spdlog.h>
 #include <sys/types.h>
 
+#include "access_log.hpp"
 #include "config.hpp"
+#include "cpu_resource_manager.hpp"
 #include "customloaderinterface.hpp"
 #include "customloaders.hpp"
 #include "deserialization.hpp"
 #include "executingstreamidguard.hpp"
 #include "filesystem.hpp"
+#include "inferencecompletionexecutor.hpp"
 #include "layout.hpp"
 #include "layout_configuration.hpp"
 #include "logging.hpp"
+#include "mapped_file.hpp"
+#include "model_memory_budget.hpp"
 #include "model_metric_reporter.hpp"
 #include "modelconfig.hpp"
 #include "modelinstanceunloadguard.hpp"
 #include "ov_utils.hpp"
 #include "predict_request_validation_utils.hpp"
+#include "preprocessing_configuration.hpp"
 #include "prediction_service_utils.hpp"
 #include "profiler.hpp"
+#include "request_scope.hpp"
 #include "serialization.hpp"
+#include "shared_buffer_allocator.hpp"
 #include "shape.hpp"
 #include "status.hpp"
 #include "stringutils.hpp"
@@ -167,6 +181,15 @@ static Status validateConfigurationAgainstNetwork(const ModelConfig& config, std
             return StatusCode::CONFIG_LAYOUT_IS_NOT_IN_MODEL;
         }
     }
+    for (const auto& [name, _] : config.getPreprocessing()) {
+        if (hasInputWithName(model, name) && config.getMappingInputByKey(name) != "") {
+            SPDLOG_LOGGER_WARN(modelmanager_logger, "Config preprocessing - {} is mapped by {}. Changes will not apply", name, config.getMappingInputByKey(name));
+            return StatusCode::CONFIG_PREPROCESSING_MAPPED_BUT_USED_REAL_NAME;
+        } else if (!hasInputWithName(model, name) && !hasInputWithName(model, config.getRealInputNameByValue(name))) {
+            SPDLOG_LOGGER_WARN(modelmanager_logger, "Config preprocessing - {} not found in model inputs", name);
+            return StatusCode::CONFIG_PREPROCESSING_IS_NOT_IN_MODEL;
+        }
+    }
     return StatusCode::OK;
 }
 
@@ -246,6 +269,15 @@ static Status applyLayoutConfiguration(const ModelConfig& config, std::shared_pt
                 }
                 preproc.input(name).model().set_layout(targetModelLayout);
             }
+            auto preprocessingIt = config.getPreprocessing().find(mappedName);
+            if (preprocessingIt != config.getPreprocessing().end()) {
+                SPDLOG_LOGGER_DEBUG(modelmanager_logger, "model: {}, version: {}; Adding preprocessing steps: {}; input name: {}",
+                    modelName,
+                    modelVersion,
+                    preprocessingIt->second.toString(),
+                    mappedName);
+                preprocessingIt->second.apply(preproc.input(name));
+            }
         } catch (const ov::Exception& e) {
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Failed to configure input layout for model:{}; version:{}; from OpenVINO with error:{}",
                 modelName,
@@ -316,7 +348,7 @@ static Status applyLayoutConfiguration(const ModelConfig& config, std::shared_pt
     try {
         model = preproc.build();
     } catch (std::exception& e) {
-        SPDLOG_LOGGER_ERROR(modelmanager_logger, "Cannot change layout");
+        SPDLOG_LOGGER_ERROR(modelmanager_logger, "Cannot change layout or apply preprocessing: {}", e.what());
         return StatusCode::MODEL_NOT_LOADED;
     }
     return StatusCode::OK;
@@ -340,6 +372,7 @@ Status ModelInstance::loadTensors(const ModelConfig& config, bool needsToApplyLa
         SPDLOG_LOGGER_ERROR(modelmanager_logger, "Error during loading input tensors");
         return status;
     }
+    this->inputPlan = InputPlan(this->inputsInfo);
     status = loadOutputTensors(config);
     if (!status.ok()) {
         SPDLOG_LOGGER_ERROR(modelmanager_logger, "Error during loading output tensors");
@@ -588,6 +621,18 @@ uint ModelInstance::getNumOfParallelInferRequests(const ModelConfig& modelConfig
 }
 
 std::shared_ptr<ov::Model> ModelInstance::loadOVModelPtr(const std::string& modelFile) {
+    if (endsWith(modelFile, OV_MODEL_FILES_EXTENSIONS[0])) {
+        // weights are memory mapped, so that model versions and instances using the same file share page cache
+        const std::string weightsFile = modelFile.substr(0, modelFile.size() - std::strlen(OV_MODEL_FILES_EXTENSIONS[0])) + OV_MODEL_FILES_EXTENSIONS[1];
+        std::shared_ptr<const MappedFile> weights;
+        if (MappedFile::map(weightsFile, weights).ok()) {
+            std::ifstream modelStream(modelFile, std::ios::in | std::ios::binary);
+            std::string strModel((std::istreambuf_iterator<char>(modelStream)), std::istreambuf_iterator<char>());
+            ov::Tensor weightsTensor = makeSharedBufferTensor(ov::element::u8, ov::Shape{weights->getSize()}, weights, weights->getData());
+            return ieCore.read_model(strModel, weightsTensor);
+        }
+        SPDLOG_DEBUG("Could not map weights file: {}; reading model: {} without memory mapping", weightsFile, modelFile);
+    }
     return ieCore.read_model(modelFile);
 }
 
@@ -606,8 +651,8 @@ Status ModelInstance::loadOVModel() {
 Status ModelInstance::loadOVModelUsingCustomLoader() {
     SPDLOG_DEBUG("Try reading model using a custom loader");
     try {
-        std::vector<uint8_t> modelBinary;
-        std::vector<uint8_t> weights;
+        CustomLoaderBuffer modelBinary;
+        CustomLoaderBuffer weights;
 
         SPDLOG_INFO("loading ov::Model for model: {} basepath: {} <> {} version: {}", getName(), getPath(), this->config.getBasePath().c_str(), getVersion());
 
@@ -621,7 +666,7 @@ Status ModelInstance::loadOVModelUsingCustomLoader() {
             throw std::invalid_argument("customloader not exisiting");
         }
 
-        CustomLoaderStatus res = customLoaderInterfacePtr->loadModel(this->config.getName(),
+        CustomLoaderStatus res = customLoaderInterfacePtr->loadModelBuffers(this->config.getName(),
             this->config.getBasePath(),
             getVersion(),
             this->config.getCustomLoaderOptionsConfigStr(), modelBinary, weights);
@@ -634,11 +679,11 @@ Status ModelInstance::loadOVModelUsingCustomLoader() {
             return StatusCode::INTERNAL_ERROR;
         }
 
-        std::string strModel(modelBinary.begin(), modelBinary.end());
+        std::string strModel(reinterpret_cast<const char*>(modelBinary.data), modelBinary.size);
 
         if (res == CustomLoaderStatus::MODEL_TYPE_IR) {
-            ov::Tensor tensorWts(ov::element::u8, ov::Shape{weights.size()});
-            std::memcpy(tensorWts.data(), weights.data(), weights.size());
+            // weights stay owned by custom loader buffer for as long as OpenVINO uses them
+            ov::Tensor tensorWts = makeSharedBufferTensor(ov::element::u8, ov::Shape{weights.size}, std::move(weights.owner), weights.data);
             model = ieCore.read_model(strModel, tensorWts);
         } else if (res == CustomLoaderStatus::MODEL_TYPE_ONNX) {
             model = ieCore.read_model(strModel, ov::Tensor());
@@ -672,6 +717,9 @@ plugin_config_t ModelInstance::prepareDefaultPluginConfig(const ModelConfig& con
 
 Status ModelInstance::loadOVCompiledModel(const ModelConfig& config) {
     plugin_config_t pluginConfig = prepareDefaultPluginConfig(config);
+    if (this->cpuResourceManager && this->targetDevice == "CPU") {
+        this->cpuResourceManager->applyToPluginConfig(getName(), pluginConfig);
+    }
     try {
         loadCompiledModelPtr(pluginConfig);
     } catch (ov::Exception& e) {
@@ -705,6 +753,21 @@ Status ModelInstance::loadOVCompiledModel(const ModelConfig& config) {
     }
     SET_IF_ENABLED(getMetricReporter().streams, numberOfStreams);
 
+    this->cpuThreadsPerInference = 0;
+    if (this->targetDevice == "CPU") {
+        uint32_t numberOfThreads = 0;
+        try {
+            numberOfThreads = compiledModel->get_property(ov::inference_num_threads);
+        } catch (...) {
+            SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Unable to get information about number of threads; model: {}; version: {}", getName(), getVersion());
+        }
+        if (numberOfThreads == 0) {
+            numberOfThreads = std::thread::hardware_concurrency();
+        }
+        this->cpuThreadsPerInference = std::max<uint32_t>(1, numberOfThreads / std::max<uint32_t>(1, numberOfStreams));
+        SET_IF_ENABLED(getMetricReporter().cpuCores, numberOfThreads);
+    }
+
     SPDLOG_LOGGER_INFO(modelmanager_logger, "Plugin config for device: {}", targetDevice);
     for (const auto pair : pluginConfig) {
         const auto key = pair.first;
@@ -807,7 +870,8 @@ void ModelInstance::configureBatchSize(const ModelConfig& config, const DynamicM
 }
 
 Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicModelParameter& parameter) {
-    bool isLayoutConfigurationChanged = !config.isLayoutConfigurationEqual(this->config);
+    // preprocessing is built together with layouts, so its change requires reading the model again as well
+    bool isLayoutConfigurationChanged = !config.isLayoutConfigurationEqual(this->config) || !config.isPreprocessingConfigurationEqual(this->config);
     bool needsToApplyLayoutConfiguration = isLayoutConfigurationChanged || !this->model;
 
     subscriptionManager.notifySubscribers();
@@ -865,11 +929,27 @@ Status ModelInstance::loadModelImpl(const ModelConfig& config, const DynamicMode
         this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
         return StatusCode::MODEL_NOT_LOADED;
     }
+    this->memoryFootprint = estimateMemoryFootprint();
+    this->lastUsedTimestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    this->evicted = false;
     this->status.setAvailable();
     modelLoadedNotify.notify_all();
     return status;
 }
 
+size_t ModelInstance::estimateMemoryFootprint() const {
+    // weights dominate memory usage of compiled model, so size of model files is used as an estimate
+    size_t footprint = 0;
+    for (const auto& file : this->modelFiles) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(file, ec);
+        if (!ec) {
+            footprint += size;
+        }
+    }
+    return footprint;
+}
+
 Status ModelInstance::setCacheOptions(const ModelConfig& config) {
     if (!config.getCacheDir().empty()) {
         if (!config.isAllowCacheSetToTrue() && (config.isCustomLoaderRequiredToLoadModel() || config.anyShapeSetToAuto() || (config.getBatchingMode() == Mode::AUTO))) {
@@ -1011,10 +1091,24 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
     modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
     if (getStatus().getState() == ModelVersionState::AVAILABLE) {
         SPDLOG_DEBUG("Model: {}, version: {} already loaded", getName(), getVersion());
+        markUsed();
         return StatusCode::OK;
     }
     modelInstanceUnloadGuard.reset();
 
+    if (this->evicted) {
+        auto status = reloadAfterEviction();
+        if (!status.ok()) {
+            return status;
+        }
+        modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
+        if (getStatus().getState() == ModelVersionState::AVAILABLE) {
+            markUsed();
+            return StatusCode::OK;
+        }
+        modelInstanceUnloadGuard.reset();
+    }
+
     // wait several time since no guarantee that cv wakeup will be triggered before calling wait_for
     const uint waitLoadedTimestepMilliseconds = 100;
     const uint waitCheckpoints = waitForModelLoadedTimeoutMilliseconds / waitLoadedTimestepMilliseconds;
@@ -1035,6 +1129,7 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
         modelInstanceUnloadGuard = std::make_unique<ModelInstanceUnloadGuard>(*this);
         if (getStatus().getState() == ModelVersionState::AVAILABLE) {
             SPDLOG_INFO("Succesfully waited for model: {}, version: {}", getName(), getVersion());
+            markUsed();
             return StatusCode::OK;
         }
         modelInstanceUnloadGuard.reset();
@@ -1054,8 +1149,175 @@ Status ModelInstance::waitForLoaded(const uint waitForModelLoadedTimeoutMillisec
     }
 }
 
+static Status checkRequestAwaited(const ModelInstance& instance, std::unique_ptr<MetricCounter>& cancelledAtStage, const char* stage) {
+    auto status = RequestScope::checkCurrent();
+    if (!status.ok()) {
+        INCREMENT_IF_ENABLED(cancelledAtStage);
+        SPDLOG_DEBUG("Dropping request to model: {}, version: {} before {} stage; {}",
+            instance.getName(), instance.getVersion(), stage, status.string());
+    }
+    return status;
+}
+
+Status ModelInstance::acquireInferRequest(std::unique_ptr<ExecutingStreamIdGuard>& executingStreamIdGuard) {
+    OVMS_PROFILE_FUNCTION();
+    auto& reporter = this->getMetricReporter();
+    auto status = checkRequestAwaited(*this, reporter.requestsCancelledGetInferRequest, "get_infer_request");
+    if (!status.ok())
+        return status;
+    const RequestScope* scope = RequestScope::current();
+    const RequestPriority priority = scope ? scope->getPriority() : RequestPriority::NORMAL;
+    const size_t priorityIndex = toIndex(priority);
+    auto& queue = getInferRequestsQueue();
+    uint64_t waiterId = 0;
+    auto idleStream = queue.getIdleStream(static_cast<int>(priority), this->config.getMaxQueueDepth(), waiterId);
+    if (!idleStream.has_value()) {
+        INCREMENT_IF_ENABLED(reporter.requestsRejectedQueueFull[priorityIndex]);
+        SPDLOG_DEBUG("Rejected request with priority: {} to model: {}, version: {}; {} requests are waiting for infer request",
+            toString(priority), getName(), getVersion(), this->config.getMaxQueueDepth());
+        return StatusCode::INFER_QUEUE_FULL;
+    }
+    if (waiterId == 0) {
+        OBSERVE_IF_ENABLED(reporter.queueWaitTime[priorityIndex], 0);
+        executingStreamIdGuard = std::make_unique<ExecutingStreamIdGuard>(queue, reporter, idleStream->get());
+        return StatusCode::OK;
+    }
+    // waiting request is counted as current one, as it was before it got an infer request
+    INCREMENT_IF_ENABLED(reporter.currentRequests);
+    INCREMENT_IF_ENABLED(reporter.requestsQueued[priorityIndex]);
+    const auto waitStart = RequestScope::Clock::now();
+    // waiting ends at the earlier of queue wait limit and client deadline
+    RequestScope::Deadline waitUntil;
+    const uint32_t maxQueueWaitMs = this->config.getMaxQueueWaitMs();
+    if (maxQueueWaitMs > 0) {
+        waitUntil = waitStart + std::chrono::milliseconds(maxQueueWaitMs);
+    }
+    if (scope && scope->getDeadline() && (!waitUntil || scope->getDeadline().value() < waitUntil.value())) {
+        waitUntil = scope->getDeadline();
+    }
+    // client cancellation is only polled, so wait in slices when it can happen
+    const bool pollCancellation = scope && scope->isCancellable();
+    while (true) {
+        auto sliceEnd = waitUntil;
+        if (pollCancellation) {
+            auto pollAt = RequestScope::Clock::now() + CANCELLATION_POLL_INTERVAL;
+            if (!sliceEnd || pollAt < sliceEnd.value()) {
+                sliceEnd = pollAt;
+            }
+        }
+        if (!sliceEnd) {
+            idleStream->wait();
+            break;
+        }
+        if (idleStream->wait_until(sliceEnd.value()) == std::future_status::ready) {
+            break;
+        }
+        if (scope) {
+            status = scope->check();
+        }
+        if (status.ok() && waitUntil && RequestScope::Clock::now() >= waitUntil.value()) {
+            status = StatusCode::INFER_QUEUE_WAIT_TIMEOUT;
+        }
+        if (status.ok()) {
+            continue;
+        }
+        if (queue.cancelWaiting(static_cast<int>(priority), waiterId)) {
+            break;
+        }
+        // infer request was given right after waiting ended, then it is used
+        status = StatusCode::OK;
+        idleStream->wait();
+        break;
+    }
+    if (status.ok()) {
+        executingStreamIdGuard = std::make_unique<ExecutingStreamIdGuard>(queue, reporter, idleStream->get());
+    }
+    DECREMENT_IF_ENABLED(reporter.requestsQueued[priorityIndex]);
+    DECREMENT_IF_ENABLED(reporter.currentRequests);
+    OBSERVE_IF_ENABLED(reporter.queueWaitTime[priorityIndex],
+        std::chrono::duration_cast<std::chrono::microseconds>(RequestScope::Clock::now() - waitStart).count());
+    if (status == StatusCode::INFER_QUEUE_WAIT_TIMEOUT) {
+        INCREMENT_IF_ENABLED(reporter.requestsRejectedQueueTimeout[priorityIndex]);
+        SPDLOG_DEBUG("Request with priority: {} to model: {}, version: {} did not get infer request within {} ms",
+            toString(priority), getName(), getVersion(), maxQueueWaitMs);
+    } else if (!status.ok()) {
+        INCREMENT_IF_ENABLED(reporter.requestsCancelledGetInferRequest);
+        SPDLOG_DEBUG("Dropping request to model: {}, version: {} waiting for infer request; {}",
+            getName(), getVersion(), status.string());
+    }
+    return status;
+}
+
+void ModelInstance::reportCpuTime(double inferTimeMicroseconds) {
+    // estimate, threads of a stream are assumed to be busy for the whole inference
+    uint32_t threads = this->cpuThreadsPerInference;
+    auto& cpuTime = this->getMetricReporter().cpuTime;
+    if (threads > 0 && cpuTime) {
+        cpuTime->increment(inferTimeMicroseconds * threads);
+    }
+}
+
+void ModelInstance::markUsed() {
+    if (this->memoryBudget) {
+        this->lastUsedTimestamp.store(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+    }
+}
+
+bool ModelInstance::isResident() const {
+    return !this->evicted && getStatus().getState() == ModelVersionState::AVAILABLE;
+}
+
+bool ModelInstance::isEvictable() const {
+    return !this->config.isStateful() &&
+           !this->config.isCustomLoaderRequiredToLoadModel() &&
+           !this->subscriptionManager.isSubscribed() &&
+           !(this->modelSubscriptionManager && this->modelSubscriptionManager->isSubscribed());
+}
+
+bool ModelInstance::evict() {
+    std::unique_lock<std::recursive_mutex> loadingLock(loadingMutex, std::try_to_lock);
+    if (!loadingLock.owns_lock() || !isResident() || !isEvictable() || !canUnloadInstance()) {
+        return false;
+    }
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Evicting model: {}, version: {} to fit in memory budget; estimated memory: {} bytes",
+        getName(), getVersion(), getMemoryFootprint());
+    auto start = std::chrono::steady_clock::now();
+    // flag is set before state change, so requests which see the model not available know it has to be loaded back
+    this->evicted = true;
+    this->status.setLoading();
+    unloadModelComponents();
+    double evictionTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    OBSERVE_IF_ENABLED(this->getMetricReporter().evictionTime, evictionTime);
+    return true;
+}
+
+Status ModelInstance::reloadAfterEviction() {
+    {
+        std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+        if (!this->evicted) {
+            // loaded back by concurrent request
+            return StatusCode::OK;
+        }
+        SPDLOG_LOGGER_INFO(modelmanager_logger, "Loading back evicted model: {}, version: {}", getName(), getVersion());
+        auto start = std::chrono::steady_clock::now();
+        ModelConfig config = this->config;
+        auto status = loadModelImpl(config);
+        if (!status.ok()) {
+            SPDLOG_LOGGER_ERROR(modelmanager_logger, "Loading back evicted model: {}, version: {} failed: {}", getName(), getVersion(), status.string());
+            return status;
+        }
+        double reloadTime = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        OBSERVE_IF_ENABLED(this->getMetricReporter().reloadAfterEvictionTime, reloadTime);
+    }
+    if (this->memoryBudget) {
+        this->memoryBudget->enforce(this);
+    }
+    return StatusCode::OK;
+}
+
 void ModelInstance::retireModel(bool isPermanent) {
     std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+    this->evicted = false;
     if (isPermanent) {
         this->status.setUnloading();
     } else {
@@ -1069,6 +1331,7 @@ void ModelInstance::retireModel(bool isPermanent) {
 
 void ModelInstance::cleanupFailedLoad() {
     std::lock_guard<std::recursive_mutex> loadingLock(loadingMutex);
+    this->evicted = false;
     this->status.setLoading(ModelVersionStatusErrorCode::UNKNOWN);
     unloadModelComponents();
 }
@@ -1082,11 +1345,13 @@ void ModelInstance::unloadModelComponents() {
     }
     SET_IF_ENABLED(this->getMetricReporter().inferReqQueueSize, 0);
     SET_IF_ENABLED(this->getMetricReporter().streams, 0);
+    SET_IF_ENABLED(this->getMetricReporter().cpuCores, 0);
     inferRequestsQueue.reset();
     compiledModel.reset();
     model.reset();
     outputsInfo.clear();
     inputsInfo.clear();
+    inputPlan = InputPlan();
     modelFiles.clear();
 
     if (this->config.isCustomLoaderRequiredToLoadModel()) {
@@ -1110,7 +1375,7 @@ const std::set<std::string>& ModelInstance::getOptionalInputNames() {
 }
 
 template <typename RequestType>
-const Status ModelInstance::validate(const RequestType* request) {
+const Status ModelInstance::validate(const RequestType* request, RequestInputPositions* requestInputPositions) {
     OVMS_PROFILE_FUNCTION();
     return request_validation_utils::validate(
         *request,
@@ -1119,12 +1384,14 @@ const Status ModelInstance::validate(const RequestType* request) {
         getVersion(),
         this->getOptionalInputNames(),
         getModelConfig().getBatchingMode(),
-        getModelConfig().getShapes());
+        getModelConfig().getShapes(),
+        &getInputPlan(),
+        requestInputPositions);
 }
 
-template const Status ModelInstance::validate(const InferenceRequest* request);
-template const Status ModelInstance::validate(const ::KFSRequest* request);
-template const Status ModelInstance::validate(const tensorflow::serving::PredictRequest* request);
+template const Status ModelInstance::validate(const InferenceRequest* request, RequestInputPositions* requestInputPositions);
+template const Status ModelInstance::validate(const ::KFSRequest* request, RequestInputPositions* requestInputPositions);
+template const Status ModelInstance::validate(const tensorflow::serving::PredictRequest* request, RequestInputPositions* requestInputPositions);
 
 Status ModelInstance::performInference(ov::InferRequest& inferRequest) {
     OVMS_PROFILE_FUNCTION();
@@ -1144,6 +1411,7 @@ Status ModelInstance::performInference(ov::InferRequest& inferRequest) {
         timer.stop(INFER);
         double inferTime = timer.elapsed<std::chrono::microseconds>(INFER);
         OBSERVE_IF_ENABLED(this->getMetricReporter().inferenceTime, inferTime);
+        reportCpuTime(inferTime);
     } catch (const ov::Exception& e) {
         Status status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
         SPDLOG_ERROR("Async caught an exception {}: {}", status.string(), e.what());
@@ -1160,13 +1428,19 @@ Status ModelInstance::infer(const RequestType* requestProto,
     Timer<TIMER_END> timer;
     using std::chrono::microseconds;
 
+    AccessLogRecord* accessLog = AccessLogRecord::current(getName());
+    if (accessLog)
+        accessLog->setServableVersion(getVersion());
+
     auto requestProcessor = createRequestProcessor(requestProto, responseProto);  // request, response passed only to deduce type
     auto status = requestProcessor->extractRequestParameters(requestProto);
     if (!status.ok())
         return status;
-    status = validate(requestProto);
+    RequestInputPositions requestInputPositions;
+    status = validate(requestProto, &requestInputPositions);
     auto requestBatchSize = getRequestBatchSize(requestProto, this->getBatchSizeIndex());
-    auto requestShapes = getRequestShapes(requestProto);
+    // shapes are needed only for reshape, map is not built in steady state
+    auto requestShapes = status.reshapeRequired() ? getRequestShapes(requestProto) : std::map<std::string, shape_t>{};
     status = reloadModelIfRequired(status, requestBatchSize, requestShapes, modelUnloadGuardPtr);
     if (!status.ok())
         return status;
@@ -1176,13 +1450,19 @@ Status ModelInstance::infer(const RequestType* requestProto,
 
     timer.start(GET_INFER_REQUEST);
     OVMS_PROFILE_SYNC_BEGIN("getInferRequest");
-    ExecutingStreamIdGuard executingStreamIdGuard(getInferRequestsQueue(), this->getMetricReporter());
-    int executingInferId = executingStreamIdGuard.getId();
-    ov::InferRequest& inferRequest = executingStreamIdGuard.getInferRequest();
+    std::unique_ptr<ExecutingStreamIdGuard> executingStreamIdGuard;
+    status = acquireInferRequest(executingStreamIdGuard);
     OVMS_PROFILE_SYNC_END("getInferRequest");
+    if (!status.ok())
+        return status;
+    int executingInferId = executingStreamIdGuard->getId();
+    ov::InferRequest& inferRequest = executingStreamIdGuard->getInferRequest();
     timer.stop(GET_INFER_REQUEST);
     double getInferRequestTime = timer.elapsed<microseconds>(GET_INFER_REQUEST);
     OBSERVE_IF_ENABLED(this->getMetricReporter().waitForInferReqTime, getInferRequestTime);
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimeGetInferRequest, getInferRequestTime);
+    if (accessLog)
+        accessLog->addStage("get_infer_request", getInferRequestTime);
     SPDLOG_DEBUG("Getting infer req duration in model {}, version {}, nireq {}: {:.3f} ms",
         getName(), getVersion(), executingInferId, getInferRequestTime / 1000);
 
@@ -1191,33 +1471,61 @@ Status ModelInstance::infer(const RequestType* requestProto,
     timer.stop(PREPROCESS);
     if (!status.ok())
         return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimePreprocess, timer.elapsed<microseconds>(PREPROCESS));
+    if (accessLog)
+        accessLog->addStage("preprocess", timer.elapsed<microseconds>(PREPROCESS));
     SPDLOG_DEBUG("Preprocessing duration in model {}, version {}, nireq {}: {:.3f} ms",
         getName(), getVersion(), executingInferId, timer.elapsed<microseconds>(PREPROCESS) / 1000);
 
     timer.start(DESERIALIZE);
     InputSink<ov::InferRequest&> inputSink(inferRequest);
     bool isPipeline = false;
-    status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(*requestProto, getInputsInfo(), inputSink, isPipeline);
+    status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(*requestProto, getInputsInfo(), inputSink, isPipeline, &getInputPlan(), &requestInputPositions);
+    OutputBuffersBinding outputBuffersBinding;
+    if constexpr (std::is_same_v<RequestType, InferenceRequest>) {
+        if (status.ok()) {
+            status = outputBuffersBinding.bind(*requestProto, getOutputsInfo(), inferRequest);
+        }
+    }
     timer.stop(DESERIALIZE);
     if (!status.ok())
         return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimeDeserialize, timer.elapsed<microseconds>(DESERIALIZE));
+    if (accessLog)
+        accessLog->addStage("deserialize", timer.elapsed<microseconds>(DESERIALIZE));
     SPDLOG_DEBUG("Deserialization duration in model {}, version {}, nireq {}: {:.3f} ms",
         getName(), getVersion(), executingInferId, timer.elapsed<microseconds>(DESERIALIZE) / 1000);
 
+    status = checkRequestAwaited(*this, this->getMetricReporter().requestsCancelledInference, "inference");
+    if (!status.ok())
+        return status;
     timer.start(PREDICTION);
     status = performInference(inferRequest);
     timer.stop(PREDICTION);
     if (!status.ok())
         return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimePrediction, timer.elapsed<microseconds>(PREDICTION));
+    if (accessLog)
+        accessLog->addStage("prediction", timer.elapsed<microseconds>(PREDICTION));
     SPDLOG_DEBUG("Prediction duration in model {}, version {}, nireq {}: {:.3f} ms",
         getName(), getVersion(), executingInferId, timer.elapsed<microseconds>(PREDICTION) / 1000);
 
+    status = checkRequestAwaited(*this, this->getMetricReporter().requestsCancelledSerialize, "serialize");
+    if (!status.ok())
+        return status;
     timer.start(SERIALIZE);
     OutputGetter<ov::InferRequest&> outputGetter(inferRequest);
-    status = serializePredictResponse(outputGetter, getName(), getVersion(), getOutputsInfo(), responseProto, getTensorInfoName);
+    if constexpr (std::is_same_v<RequestType, InferenceRequest>) {
+        status = serializePredictResponse(outputGetter, getName(), getVersion(), getOutputsInfo(), responseProto, getTensorInfoName, requestProto);
+    } else {
+        status = serializePredictResponse(outputGetter, getName(), getVersion(), getOutputsInfo(), responseProto, getTensorInfoName);
+    }
     timer.stop(SERIALIZE);
     if (!status.ok())
         return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimeSerialize, timer.elapsed<microseconds>(SERIALIZE));
+    if (accessLog)
+        accessLog->addStage("serialize", timer.elapsed<microseconds>(SERIALIZE));
     SPDLOG_DEBUG("Serialization duration in model {}, version {}, nireq {}: {:.3f} ms",
         getName(), getVersion(), executingInferId, timer.elapsed<microseconds>(SERIALIZE) / 1000);
 
@@ -1226,6 +1534,9 @@ Status ModelInstance::infer(const RequestType* requestProto,
     timer.stop(POSTPROCESS);
     if (!status.ok())
         return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimePostprocess, timer.elapsed<microseconds>(POSTPROCESS));
+    if (accessLog)
+        accessLog->addStage("postprocess", timer.elapsed<microseconds>(POSTPROCESS));
     SPDLOG_DEBUG("Postprocessing duration in model {}, version {}, nireq {}: {:.3f} ms",
         getName(), getVersion(), executingInferId, timer.elapsed<microseconds>(POSTPROCESS) / 1000);
 
@@ -1238,6 +1549,154 @@ template Status ModelInstance::infer<tensorflow::serving::PredictRequest, tensor
 template Status ModelInstance::infer(const ::KFSRequest* requestProto,
     ::KFSResponse* responseProto,
     std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr);
+struct AsyncInferenceContext {
+    const InferenceRequest* request;
+    std::unique_ptr<InferenceResponse> response;
+    std::unique_ptr<ModelInstanceUnloadGuard> modelUnloadGuard;
+    std::unique_ptr<RequestProcessor<InferenceRequest, InferenceResponse>> requestProcessor;
+    std::unique_ptr<ExecutingStreamIdGuard> executingStreamIdGuard;
+    OutputBuffersBinding outputBuffersBinding;
+    ModelInstance::InferenceCompletionCallback completion;
+    Timer<TIMER_END> timer;
+    uint64_t traceRequestId = 0;
+};
+
+Status ModelInstance::inferAsync(const InferenceRequest* request,
+    std::unique_ptr<InferenceResponse> response,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+    InferenceCompletionExecutor& executor,
+    InferenceCompletionCallback completion) {
+    OVMS_PROFILE_FUNCTION();
+    using std::chrono::microseconds;
+    auto context = std::make_shared<AsyncInferenceContext>();
+    context->request = request;
+    context->response = std::move(response);
+    context->completion = std::move(completion);
+    context->traceRequestId = SampledTracer::currentRequestId;
+    Timer<TIMER_END>& timer = context->timer;
+
+    context->requestProcessor = createRequestProcessor(request, context->response.get());
+    auto status = context->requestProcessor->extractRequestParameters(request);
+    if (!status.ok())
+        return status;
+    RequestInputPositions requestInputPositions;
+    status = validate(request, &requestInputPositions);
+    auto requestBatchSize = getRequestBatchSize(request, this->getBatchSizeIndex());
+    auto requestShapes = status.reshapeRequired() ? getRequestShapes(request) : std::map<std::string, shape_t>{};
+    status = reloadModelIfRequired(status, requestBatchSize, requestShapes, modelUnloadGuardPtr);
+    if (!status.ok())
+        return status;
+    status = context->requestProcessor->prepare();
+    if (!status.ok())
+        return status;
+
+    timer.start(GET_INFER_REQUEST);
+    OVMS_PROFILE_SYNC_BEGIN("getInferRequest");
+    status = acquireInferRequest(context->executingStreamIdGuard);
+    OVMS_PROFILE_SYNC_END("getInferRequest");
+    if (!status.ok())
+        return status;
+    ov::InferRequest& inferRequest = context->executingStreamIdGuard->getInferRequest();
+    timer.stop(GET_INFER_REQUEST);
+    double getInferRequestTime = timer.elapsed<microseconds>(GET_INFER_REQUEST);
+    OBSERVE_IF_ENABLED(this->getMetricReporter().waitForInferReqTime, getInferRequestTime);
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimeGetInferRequest, getInferRequestTime);
+
+    timer.start(PREPROCESS);
+    status = context->requestProcessor->preInferenceProcessing(inferRequest);
+    timer.stop(PREPROCESS);
+    if (!status.ok())
+        return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimePreprocess, timer.elapsed<microseconds>(PREPROCESS));
+
+    timer.start(DESERIALIZE);
+    InputSink<ov::InferRequest&> inputSink(inferRequest);
+    bool isPipeline = false;
+    status = deserializePredictRequest<ConcreteTensorProtoDeserializator>(*request, getInputsInfo(), inputSink, isPipeline, &getInputPlan(), &requestInputPositions);
+    if (status.ok()) {
+        status = context->outputBuffersBinding.bind(*request, getOutputsInfo(), inferRequest);
+    }
+    timer.stop(DESERIALIZE);
+    if (!status.ok())
+        return status;
+    OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimeDeserialize, timer.elapsed<microseconds>(DESERIALIZE));
+    status = checkRequestAwaited(*this, this->getMetricReporter().requestsCancelledInference, "inference");
+    if (!status.ok())
+        return status;
+
+    // Unload guard is held by context from now on, until outputs are collected
+    context->modelUnloadGuard = std::move(modelUnloadGuardPtr);
+    executor.expect();
+    try {
+        inferRequest.set_callback([this, &executor, context](std::exception_ptr) {
+            // Runs on OpenVINO thread, results are collected after wait() on executor thread
+            executor.submit([this, context]() {
+                SampledTraceContinuation trace(context->traceRequestId);
+                this->completeAsyncInference(*context);
+            });
+        });
+        timer.start(PREDICTION);
+        OVMS_PROFILE_SYNC_BEGIN("ov::InferRequest::start_async");
+        inferRequest.start_async();
+        OVMS_PROFILE_SYNC_END("ov::InferRequest::start_async");
+    } catch (const ov::Exception& e) {
+        inferRequest.set_callback([](std::exception_ptr) {});
+        executor.withdraw();
+        modelUnloadGuardPtr = std::move(context->modelUnloadGuard);
+        status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        SPDLOG_ERROR("Async caught an exception {}: {}", status.string(), e.what());
+        return status;
+    }
+    return StatusCode::OK;
+}
+
+void ModelInstance::completeAsyncInference(AsyncInferenceContext& context) {
+    OVMS_PROFILE_FUNCTION();
+    using std::chrono::microseconds;
+    Timer<TIMER_END>& timer = context.timer;
+    ov::InferRequest& inferRequest = context.executingStreamIdGuard->getInferRequest();
+    Status status = StatusCode::OK;
+    try {
+        OVMS_PROFILE_SYNC_BEGIN("ov::InferRequest::wait");
+        inferRequest.wait();
+        OVMS_PROFILE_SYNC_END("ov::InferRequest::wait");
+    } catch (const ov::Exception& e) {
+        status = StatusCode::OV_INTERNAL_INFERENCE_ERROR;
+        SPDLOG_ERROR("Async caught an exception {}: {}", status.string(), e.what());
+    }
+    // Request is idle after wait(), so the callback holding the context can be dropped
+    inferRequest.set_callback([](std::exception_ptr) {});
+    timer.stop(PREDICTION);
+    if (status.ok()) {
+        double inferTime = timer.elapsed<microseconds>(PREDICTION);
+        OBSERVE_IF_ENABLED(this->getMetricReporter().inferenceTime, inferTime);
+        reportCpuTime(inferTime);
+        OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimePrediction, inferTime);
+
+        timer.start(SERIALIZE);
+        OutputGetter<ov::InferRequest&> outputGetter(inferRequest);
+        status = serializePredictResponse(outputGetter, getName(), getVersion(), getOutputsInfo(), context.response.get(), getTensorInfoName, context.request);
+        timer.stop(SERIALIZE);
+        OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimeSerialize, timer.elapsed<microseconds>(SERIALIZE));
+    }
+    if (status.ok()) {
+        timer.start(POSTPROCESS);
+        status = context.requestProcessor->postInferenceProcessing(context.response.get(), inferRequest);
+        timer.stop(POSTPROCESS);
+        OBSERVE_IF_ENABLED(this->getMetricReporter().stageTimePostprocess, timer.elapsed<microseconds>(POSTPROCESS));
+    }
+    if (status.ok()) {
+        status = context.requestProcessor->release();
+    }
+    context.outputBuffersBinding.restore();
+    context.executingStreamIdGuard.reset();
+    context.modelUnloadGuard.reset();
+    if (!status.ok()) {
+        context.response.reset();
+    }
+    context.completion(status, std::move(context.response));
+}
+
 const size_t ModelInstance::getBatchSizeIndex() const {
     const auto& inputItr = this->inputsInfo.cbegin();
     if (inputItr == this->inputsInfo.cend()) {
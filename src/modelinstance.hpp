@@ -15,6 +15,8 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <map>
@@ -28,6 +30,7 @@
 
 #include "inferencerequest.hpp"
 #include "inferenceresponse.hpp"
+#include "input_plan.hpp"
 #include "kfs_frontend/kfs_grpc_inference_service.hpp"
 #include "model_metric_reporter.hpp"
 #include "modelchangesubscription.hpp"
@@ -37,10 +40,16 @@
 #include "ovinferrequestsqueue.hpp"
 #include "tensorinfo.hpp"
 #include "tfs_frontend/tfs_utils.hpp"
+#include "threadlocalrecycled.hpp"
 
 namespace ovms {
+struct AsyncInferenceContext;
+class InferenceCompletionExecutor;
 class MetricRegistry;
 class ModelInstanceUnloadGuard;
+class CpuResourceManager;
+struct ExecutingStreamIdGuard;
+class ModelMemoryBudget;
 class PipelineDefinition;
 class Status;
 template <typename T1, typename T2>
@@ -116,6 +125,11 @@ protected:
          */
     ModelChangeSubscription subscriptionManager;
 
+    /**
+         * @brief Subscription manager of the model owning this version, used by pipelines referring to the model without version
+         */
+    const ModelChangeSubscription* modelSubscriptionManager = nullptr;
+
     /**
          * @brief A model status
          */
@@ -228,8 +242,12 @@ protected:
          */
     Status loadOVModelUsingCustomLoader();
 
+    /**
+     * @brief Validates request against model inputs
+     * @param requestInputPositions if set, filled with mapping of request inputs to be reused by deserialization
+     */
     template <typename RequestType>
-    const Status validate(const RequestType* request);
+    const Status validate(const RequestType* request, RequestInputPositions* requestInputPositions = nullptr);
 
 private:
     /**
@@ -237,6 +255,11 @@ private:
          */
     tensor_map_t inputsInfo;
 
+    /**
+         * @brief Lookup table of inputs, rebuilt whenever inputs info is loaded
+         */
+    InputPlan inputPlan;
+
     /**
          * @brief Holds the information about outputs and it's parameters
          */
@@ -259,6 +282,60 @@ private:
          */
     std::atomic<uint64_t> predictRequestsHandlesCount = 0;
 
+    /**
+         * @brief Memory budget shared by all models of the manager, nullptr if not limited
+         */
+    std::shared_ptr<ModelMemoryBudget> memoryBudget;
+
+    /**
+         * @brief Estimated memory used by the model when loaded, set on successful load
+         */
+    std::atomic<size_t> memoryFootprint = 0;
+
+    /**
+         * @brief Steady clock time of the last request in nanoseconds, tracked only with memory budget
+         */
+    std::atomic<int64_t> lastUsedTimestamp = 0;
+
+    /**
+         * @brief Set when model was unloaded to fit in memory budget and should be loaded back on next request
+         */
+    std::atomic<bool> evicted = false;
+
+    /**
+         * @brief Partitions CPU cores between models, nullptr if not used
+         */
+    std::shared_ptr<CpuResourceManager> cpuResourceManager;
+
+    /**
+         * @brief Number of CPU threads executing single inference, 0 if model does not run on CPU
+         */
+    std::atomic<uint32_t> cpuThreadsPerInference = 0;
+
+    void reportCpuTime(double inferTimeMicroseconds);
+
+    /**
+         * @brief How often client cancellation is checked while waiting for infer request
+         */
+    static constexpr std::chrono::milliseconds CANCELLATION_POLL_INTERVAL{10};
+
+    /**
+         * @brief Waits for infer request with priority of the request handled by the calling thread
+         *
+         * Fails with INFER_QUEUE_FULL or INFER_QUEUE_WAIT_TIMEOUT when limits from model config are exceeded
+         * and with REQUEST_DEADLINE_EXCEEDED or REQUEST_CANCELLED when the client no longer awaits the response.
+         */
+    Status acquireInferRequest(std::unique_ptr<ExecutingStreamIdGuard>& executingStreamIdGuard);
+
+    void markUsed();
+
+    size_t estimateMemoryFootprint() const;
+
+    /**
+         * @brief Loads back evicted model with its current config and makes room for it in memory budget
+         */
+    Status reloadAfterEviction();
+
     /**
          * @brief Internal method for loading tensors
          *
@@ -437,6 +514,13 @@ public:
         return inputsInfo;
     }
 
+    /**
+         * @brief Get the lookup table of inputs, used only if built for getInputsInfo() result
+         */
+    const InputPlan& getInputPlan() const {
+        return inputPlan;
+    }
+
     /**
          * @brief Get the Outputs Info object
          *
@@ -455,6 +539,44 @@ public:
         return 0 == predictRequestsHandlesCount;
     }
 
+    void setMemoryBudget(std::shared_ptr<ModelMemoryBudget> memoryBudget) {
+        this->memoryBudget = std::move(memoryBudget);
+    }
+
+    void setModelSubscriptionManager(const ModelChangeSubscription* modelSubscriptionManager) {
+        this->modelSubscriptionManager = modelSubscriptionManager;
+    }
+
+    void setCpuResourceManager(std::shared_ptr<CpuResourceManager> cpuResourceManager) {
+        this->cpuResourceManager = std::move(cpuResourceManager);
+    }
+
+    size_t getMemoryFootprint() const { return this->memoryFootprint; }
+
+    int64_t getLastUsedTimestamp() const { return this->lastUsedTimestamp.load(std::memory_order_relaxed); }
+
+    bool isEvicted() const { return this->evicted; }
+
+    /**
+         * @brief Check if model holds its memory - is available and not evicted
+         */
+    bool isResident() const;
+
+    /**
+         * @brief Check if model can be unloaded to fit in memory budget.
+         * Stateful models, models loaded with custom loader and models used in pipelines are kept loaded.
+         * Pipelines using the model without specifying version subscribe to the model, not to the version.
+         */
+    bool isEvictable() const;
+
+    /**
+         * @brief Unloads model to free memory, it is loaded back on next request in waitForLoaded.
+         * Returns false without waiting if model is being loaded, used by requests or not evictable.
+         * Otherwise waits until requests which acquired the model before it was marked as loading are finished,
+         * so it must not be called while holding locks taken when loading back evicted models.
+         */
+    bool evict();
+
     /**
          * @brief Get OV streams pool
          *
@@ -553,6 +675,32 @@ public:
         ResponseType* responseProto,
         std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr);
 
+    /**
+     * @brief Callback invoked once asynchronous inference is finished. Response is empty on failure.
+     */
+    using InferenceCompletionCallback = std::function<void(const Status&, std::unique_ptr<InferenceResponse>)>;
+
+    /**
+     * @brief Starts inference without waiting for its results
+     *
+     * Request is validated and deserialized in calling thread. Outputs are collected
+     * and completion callback is called on executor thread once OpenVINO finishes.
+     * Request has to stay valid until completion callback is called.
+     *
+     * @param request
+     * @param response filled and passed to completion callback
+     * @param modelUnloadGuardPtr taken over and held until inference completes
+     * @param executor
+     * @param completion not called if returned status is not OK
+     *
+     * @return Status of starting inference
+     */
+    Status inferAsync(const InferenceRequest* request,
+        std::unique_ptr<InferenceResponse> response,
+        std::unique_ptr<ModelInstanceUnloadGuard>& modelUnloadGuardPtr,
+        InferenceCompletionExecutor& executor,
+        InferenceCompletionCallback completion);
+
     ModelMetricReporter& getMetricReporter() const { return *this->reporter; }
 
     uint32_t getNumOfStreams() const;
@@ -564,9 +712,12 @@ public:
     virtual std::unique_ptr<RequestProcessor<KFSRequest, KFSResponse>> createRequestProcessor(const KFSRequest*, KFSResponse*);
     virtual std::unique_ptr<RequestProcessor<InferenceRequest, InferenceResponse>> createRequestProcessor(const InferenceRequest*, InferenceResponse*);
     virtual const std::set<std::string>& getOptionalInputNames();
+
+private:
+    void completeAsyncInference(AsyncInferenceContext& context);
 };
 template <typename RequestType, typename ResponseType>
-struct RequestProcessor {
+struct RequestProcessor : public ThreadLocalRecycled<RequestProcessor<RequestType, ResponseType>> {
     RequestProcessor();
     virtual ~RequestProcessor();
     virtual Status extractRequestParameters(const RequestType* request);
@@ -15,10 +15,12 @@
 //*****************************************************************************
 #pragma once
 
+#include "threadlocalrecycled.hpp"
+
 namespace ovms {
 class ModelInstance;
 
-class ModelInstanceUnloadGuard {
+class ModelInstanceUnloadGuard : public ThreadLocalRecycled<ModelInstanceUnloadGuard> {
 public:
     ModelInstanceUnloadGuard() = delete;
     ModelInstanceUnloadGuard(ModelInstance& modelInstance);
@@ -37,6 +37,7 @@
 #include "azurefilesystem.hpp"
 #include "cleaner_utils.hpp"
 #include "config.hpp"
+#include "cpu_resource_manager.hpp"
 #include "custom_node_library_internal_manager_wrapper.hpp"
 #include "custom_node_library_manager.hpp"
 #include "customloaderconfig.hpp"
@@ -45,11 +46,13 @@
 #include "entry_node.hpp"  // need for ENTRY_NODE_NAME
 #include "exit_node.hpp"   // need for EXIT_NODE_NAME
 #include "filesystem.hpp"
+#include "inferencecompletionexecutor.hpp"
 #include "gcsfilesystem.hpp"
 #include "localfilesystem.hpp"
 #include "logging.hpp"
 #include "metric_config.hpp"
 #include "metric_registry.hpp"
+#include "model_memory_budget.hpp"
 #include "modelinstance.hpp"  // for logging
 #include "node_library.hpp"
 #include "openssl/md5.h"
@@ -96,6 +99,7 @@ ModelManager::ModelManager(const std::string& modelCacheDirectory, MetricRegistr
         }
     }
     this->customNodeLibraryManager = std::make_unique<CustomNodeLibraryManager>();
+    this->cpuResourceManager = std::make_shared<CpuResourceManager>(CpuTopology::detect());
     if (ovms::Config::instance().cpuExtensionLibraryPath() != "") {
         SPDLOG_INFO("Loading custom CPU extension from {}", ovms::Config::instance().cpuExtensionLibraryPath());
         try {
@@ -147,6 +151,14 @@ void ModelManager::logPluginConfiguration() {
 
 ModelManager::~ModelManager() = default;
 
+InferenceCompletionExecutor& ModelManager::getInferenceCompletionExecutor() {
+    std::call_once(this->inferenceCompletionExecutorCreated, [this]() {
+        size_t threadCount = std::max(1u, std::min(4u, std::thread::hardware_concurrency() / 4));
+        this->inferenceCompletionExecutor = std::make_unique<InferenceCompletionExecutor>(threadCount);
+    });
+    return *this->inferenceCompletionExecutor;
+}
+
 Status ModelManager::start(const Config& config) {
     watcherIntervalSec = config.filesystemPollWaitSeconds();
     sequenceCleaupIntervalMinutes = config.sequenceCleanerPollWaitMinutes();
@@ -155,6 +167,7 @@ Status ModelManager::start(const Config& config) {
         SPDLOG_LOGGER_WARN(modelmanager_logger, "Parameter: custom_node_resources_cleaner_interval_seconds has to be greater than 0. Applying default value(1 second)");
         resourcesCleanupIntervalSec = 1;
     }
+    setModelsMemoryBudget(static_cast<size_t>(config.modelsMemoryBudgetMb()) * 1024 * 1024);
     Status status;
     bool startFromConfigFile = (config.configPath() != "");
     if (startFromConfigFile) {
@@ -609,6 +622,8 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vect
     std::set<std::string> modelsInConfigFile;
     std::set<std::string> modelsWithInvalidConfig;
     std::unordered_map<std::string, ModelConfig> newModelConfigs;
+    std::set<std::string> parsedModelNames;
+    std::vector<ModelConfig> parsedModelConfigs;
     for (const auto& configs : itr->value.GetArray()) {
         ModelConfig modelConfig;
         auto status = modelConfig.parseNode(configs["config"]);
@@ -632,17 +647,51 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vect
             SPDLOG_LOGGER_ERROR(modelmanager_logger, "Model name: {} is already occupied by pipeline definition.", modelName);
             continue;
         }
-        if (modelsInConfigFile.find(modelName) != modelsInConfigFile.end()) {
+        if (!parsedModelNames.emplace(modelName).second) {
             IF_ERROR_NOT_OCCURRED_EARLIER_THEN_SET_FIRST_ERROR(StatusCode::MODEL_NAME_OCCUPIED);
             SPDLOG_LOGGER_WARN(modelmanager_logger, "Duplicated model names: {} defined in config file. Only first definition will be loaded.", modelName);
             continue;
         }
-        status = reloadModelWithVersions(modelConfig);
+        parsedModelConfigs.emplace_back(std::move(modelConfig));
+    }
+
+    // cores are reserved for all models before any of them is compiled, so that models are compiled
+    // with the final assignment regardless of their order in config file
+    const std::vector<int> sharedCpus = this->cpuResourceManager->getSharedCpus();
+    // models missing in config file are retired, their cores can be taken over by models added in their place
+    for (const auto& [modelName, model] : getModels()) {
+        if (parsedModelNames.find(modelName) == parsedModelNames.end()) {
+            this->cpuResourceManager->release(modelName);
+        }
+    }
+    std::vector<ModelConfig> modelConfigsToLoad;
+    for (auto& modelConfig : parsedModelConfigs) {
+        auto status = reserveCpuCores(modelConfig);
+        if (!status.ok()) {
+            IF_ERROR_NOT_OCCURRED_EARLIER_THEN_SET_FIRST_ERROR(status);
+            modelsWithInvalidConfig.emplace(modelConfig.getName());
+            continue;
+        }
+        modelConfigsToLoad.emplace_back(std::move(modelConfig));
+    }
+
+    std::set<std::string> reloadedModels;
+    for (auto& modelConfig : modelConfigsToLoad) {
+        const auto modelName = modelConfig.getName();
+        auto status = reloadModelWithVersions(modelConfig);
         IF_ERROR_NOT_OCCURRED_EARLIER_THEN_SET_FIRST_ERROR(status);
 
         modelsInConfigFile.emplace(modelName);
+        if (status == StatusCode::OK_RELOADED) {
+            reloadedModels.emplace(modelName);
+        }
         if (!status.ok()) {
             SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Cannot reload model: {} with versions due to error: {}", modelName, status.string());
+            auto model = findModelByName(modelName);
+            if (model == nullptr || model->getDefaultModelInstance() == nullptr) {
+                // no version is loaded, so reserved cores are returned to models using shared cores
+                this->cpuResourceManager->release(modelName);
+            }
         }
         if (status == StatusCode::REQUESTED_DYNAMIC_PARAMETERS_ON_SUBSCRIBED_MODEL || status == StatusCode::REQUESTED_STATEFUL_PARAMETERS_ON_SUBSCRIBED_MODEL) {
             SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Will retry to reload model({}) after pipelines are revalidated", modelName);
@@ -659,6 +708,10 @@ Status ModelManager::loadModelsConfig(rapidjson::Document& configJson, std::vect
     }
     this->servedModelConfigs = std::move(newModelConfigs);
     retireModelsRemovedFromConfigFile(modelsInConfigFile, modelsWithInvalidConfig);
+    if (this->cpuResourceManager->getSharedCpus() != sharedCpus) {
+        auto status = reloadModelsUsingSharedCpuCores(reloadedModels);
+        IF_ERROR_NOT_OCCURRED_EARLIER_THEN_SET_FIRST_ERROR(status);
+    }
     return firstErrorStatus;
 }
 
@@ -809,6 +862,7 @@ void ModelManager::retireModelsRemovedFromConfigFile(const std::set<std::string>
         modelsToUnloadAllVersions.begin());
     modelsToUnloadAllVersions.resize(it - modelsToUnloadAllVersions.begin());
     for (auto& modelName : modelsToUnloadAllVersions) {
+        this->cpuResourceManager->release(modelName);
         if (modelsWithInvalidConfig.find(modelName) == modelsWithInvalidConfig.end()) {
             SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Retiring all versions of model: {}", modelName);
             try {
@@ -1099,11 +1153,67 @@ std::shared_ptr<ovms::Model> ModelManager::getModelIfExistCreateElse(const std::
     std::unique_lock modelsLock(modelsMtx);
     auto modelIt = models.find(modelName);
     if (models.end() == modelIt) {
-        models.insert({modelName, modelFactory(modelName, isStateful)});
+        auto model = modelFactory(modelName, isStateful);
+        model->setMemoryBudget(this->memoryBudget);
+        model->setCpuResourceManager(this->cpuResourceManager);
+        models.insert({modelName, std::move(model)});
     }
     return models[modelName];
 }
 
+void ModelManager::setModelsMemoryBudget(size_t budgetBytes) {
+    if (budgetBytes == 0) {
+        this->memoryBudget.reset();
+        return;
+    }
+    SPDLOG_LOGGER_INFO(modelmanager_logger, "Models memory budget: {} bytes. Least recently used models will be unloaded when exceeded", budgetBytes);
+    if (this->modelCacheDirectory.empty()) {
+        SPDLOG_LOGGER_WARN(modelmanager_logger, "Model cache is disabled, evicted models will be compiled again when loaded back. Set cache_dir to speed up loading");
+    }
+    this->memoryBudget = std::make_shared<ModelMemoryBudget>(budgetBytes);
+}
+
+Status ModelManager::reserveCpuCores(const ModelConfig& config) {
+    if (config.getTargetDevice() != "CPU") {
+        if (config.getCpuCores() > 0) {
+            SPDLOG_LOGGER_WARN(modelmanager_logger, "Model: {} has cpu_cores set, but it is ignored for target device: {}", config.getName(), config.getTargetDevice());
+        }
+        this->cpuResourceManager->release(config.getName());
+        return StatusCode::OK;
+    }
+    return this->cpuResourceManager->reserve(config.getName(), config.getCpuCores());
+}
+
+Status ModelManager::reloadModelsUsingSharedCpuCores(const std::set<std::string>& reloadedModels) {
+    Status firstErrorStatus = StatusCode::OK;
+    for (const auto& [modelName, servedConfig] : this->servedModelConfigs) {
+        if (servedConfig.getTargetDevice() != "CPU" || servedConfig.getCpuCores() > 0 ||
+            reloadedModels.find(modelName) != reloadedModels.end()) {
+            continue;
+        }
+        auto model = findModelByName(modelName);
+        if (model == nullptr) {
+            continue;
+        }
+        std::shared_ptr<model_versions_t> versionsToReload = std::make_shared<model_versions_t>();
+        for (const auto& [version, instance] : model->getModelVersions()) {
+            // evicted versions pick up current assignment when loaded back
+            if (instance->getStatus().getState() == ModelVersionState::AVAILABLE) {
+                versionsToReload->emplace_back(version);
+            }
+        }
+        if (versionsToReload->empty()) {
+            continue;
+        }
+        SPDLOG_LOGGER_INFO(modelmanager_logger, "Reloading model: {} since CPU cores shared by models without reservation changed", modelName);
+        ModelConfig config = servedConfig;
+        auto fs = ModelManager::getFilesystem(config.getBasePath());
+        auto status = reloadModelVersions(model, fs, config, versionsToReload, std::make_shared<model_versions_t>());
+        IF_ERROR_NOT_OCCURRED_EARLIER_THEN_SET_FIRST_ERROR(status);
+    }
+    return firstErrorStatus;
+}
+
 std::shared_ptr<FileSystem> ModelManager::getFilesystem(const std::string& basePath) {
     if (basePath.rfind(S3FileSystem::S3_URL_PREFIX, 0) == 0) {
         Aws::SDKOptions options;
@@ -1353,6 +1463,13 @@ Status ModelManager::getModelInstance(const std::string& modelName,
     if (model == nullptr) {
         return StatusCode::MODEL_NAME_MISSING;
     }
+    return getModelInstance(model, modelVersionId, modelInstance, modelInstanceUnloadGuardPtr);
+}
+
+Status ModelManager::getModelInstance(const std::shared_ptr<Model>& model,
+    ovms::model_version_t modelVersionId,
+    std::shared_ptr<ovms::ModelInstance>& modelInstance,
+    std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) const {
     if (modelVersionId != 0) {
         modelInstance = model->getModelInstanceByVersion(modelVersionId);
         if (modelInstance == nullptr) {
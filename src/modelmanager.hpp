@@ -18,6 +18,7 @@
 #include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <shared_mutex>
 #include <string>
@@ -48,7 +49,10 @@ class CNLIMWrapper;
 class CustomLoaderConfig;
 class CustomNodeLibraryManager;
 class MetricRegistry;
+class CpuResourceManager;
+class ModelMemoryBudget;
 class FileSystem;
+class InferenceCompletionExecutor;
 struct FunctorSequenceCleaner;
 struct FunctorResourcesCleaner;
 /**
@@ -82,6 +86,17 @@ protected:
     std::vector<std::shared_ptr<CNLIMWrapper>> resources = {};
 
     GlobalSequencesViewer globalSequencesViewer;
+
+    /**
+     * @brief Limits memory of loaded models, nullptr if not limited
+     */
+    std::shared_ptr<ModelMemoryBudget> memoryBudget;
+
+    /**
+     * @brief Partitions CPU cores between models
+     */
+    std::shared_ptr<CpuResourceManager> cpuResourceManager;
+
     uint32_t waitForModelLoadedTimeoutMs;
     bool watcherStarted = false;
     bool cleanerStarted = false;
@@ -205,7 +220,19 @@ private:
 
     MetricRegistry* metricRegistry;
 
+    /**
+     * @brief Executor finishing asynchronous C-API inferences, created on first use.
+     * Declared after the models so that it is destroyed first, once in-flight inferences complete.
+     */
+    std::unique_ptr<InferenceCompletionExecutor> inferenceCompletionExecutor;
+    std::once_flag inferenceCompletionExecutorCreated;
+
 public:
+    /**
+     * @brief Gets the executor used to complete asynchronous inferences
+     */
+    InferenceCompletionExecutor& getInferenceCompletionExecutor();
+
     /**
      * @brief Mutex for blocking concurrent add & find of model
      */
@@ -282,6 +309,14 @@ public:
         std::shared_ptr<ovms::ModelInstance>& modelInstance,
         std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) const;
 
+    /**
+     * @brief Gets model instance of already resolved model, skips name lookup
+     */
+    Status getModelInstance(const std::shared_ptr<Model>& model,
+        ovms::model_version_t modelVersionId,
+        std::shared_ptr<ovms::ModelInstance>& modelInstance,
+        std::unique_ptr<ModelInstanceUnloadGuard>& modelInstanceUnloadGuardPtr) const;
+
     const bool modelExists(const std::string& name) const {
         if (findModelByName(name) == nullptr)
             return false;
@@ -449,6 +484,29 @@ public:
     void cleanupResources();
 
     MetricRegistry* getMetricRegistry() const { return this->metricRegistry; }
+
+    /**
+     * @brief Limits memory of models loaded afterwards, least recently used models are unloaded when exceeded
+     *
+     * @param budgetBytes 0 disables the limit
+     */
+    void setModelsMemoryBudget(size_t budgetBytes);
+
+    const std::shared_ptr<ModelMemoryBudget>& getModelsMemoryBudget() const { return this->memoryBudget; }
+
+    const std::shared_ptr<CpuResourceManager>& getCpuResourceManager() const { return this->cpuResourceManager; }
+
+    /**
+     * @brief Reserves CPU cores requested in model config, releases them if model does not request any
+     */
+    Status reserveCpuCores(const ModelConfig& config);
+
+    /**
+     * @brief Recompiles loaded CPU models without reservation after the set of shared cores changed
+     *
+     * @param reloadedModels models already compiled with the current assignment
+     */
+    Status reloadModelsUsingSharedCpuCores(const std::set<std::string>& reloadedModels);
 };
 
 void cleanerRoutine(uint32_t resourcesCleanupInterval, FunctorResourcesCleaner& functorResourcesCleaner, uint32_t sequenceCleanerInterval, FunctorSequenceCleaner& functorSequenceCleaner, std::future<void>& cleanerExitSignal);
@@ -97,6 +97,8 @@ public:
 
     NodeSession* getNodeSession(const NodeSessionMetadata& metadata);
 
+    bool hasSessions() const { return !this->nodeSessions.empty(); }
+
 protected:
     NodeSession& getNodeSession(const session_key_t& sessionKey) const;
     virtual std::unique_ptr<NodeSession> createNodeSession(const NodeSessionMetadata& metadata, const CollapseDetails& collapsingDetails);
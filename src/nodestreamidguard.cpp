@@ -22,12 +22,13 @@
 #include "model_metric_reporter.hpp"
 #include "ovinferrequestsqueue.hpp"
 #include "profiler.hpp"
+#include "request_scope.hpp"
 
 namespace ovms {
 
 NodeStreamIdGuard::NodeStreamIdGuard(OVInferRequestsQueue& inferRequestsQueue, ModelMetricReporter& reporter) :
     inferRequestsQueue_(inferRequestsQueue),
-    futureStreamId(inferRequestsQueue_.getIdleStream()),
+    futureStreamId(inferRequestsQueue_.getIdleStream(static_cast<int>(RequestScope::currentPriority()))),
     reporter(reporter) {
     INCREMENT_IF_ENABLED(this->reporter.currentRequests);
 }
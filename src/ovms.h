@@ -71,6 +71,13 @@ typedef enum OVMS_BufferType_enum {
 typedef struct OVMS_InferenceRequest_ OVMS_InferenceRequest;
 typedef struct OVMS_InferenceResponse_ OVMS_InferenceResponse;
 
+// OVMS_InferenceCallback
+//
+// Completion callback of asynchronous inference. Exactly one of response and status is non null.
+// Callee takes the ownership of the object passed. Called from server thread, should not block.
+//
+typedef void (*OVMS_InferenceCallback)(OVMS_InferenceResponse* response, OVMS_Status* status, void* userdata);
+
 // OVMS_LogLevel
 //
 // Levels of OVMS logging.
@@ -326,6 +333,18 @@ OVMS_Status* OVMS_ServerStartFromConfigurationFile(OVMS_Server* server,
 OVMS_Status* OVMS_InferenceRequestNew(OVMS_InferenceRequest** request, OVMS_Server* server, const char* servableName, uint32_t servableVersion);
 void OVMS_InferenceRequestDelete(OVMS_InferenceRequest* response);
 
+// Prepare inference request for repeated use. Servable lookup is done once and subsequent
+// inferences reuse the resolved servable, wrappers of input buffers and storage of responses.
+// Responses of prepared request are returned to the request for reuse by
+// OVMS_InferenceResponseDelete. Input buffers should be kept unchanged between inferences
+// to benefit from reuse, their content may be updated in place. Request must outlive its responses.
+// For DAG pipelines only responses are reused.
+//
+// \param server The server object
+// \param request The request object to be prepared
+// \return OVMS_Status object in case of failure
+OVMS_Status* OVMS_InferenceRequestPrepare(OVMS_Server* server, OVMS_InferenceRequest* request);
+
 // Set the data of the input buffer. Ownership of data needs to be maintained during inference.
 //
 // \param request The request object
@@ -361,6 +380,43 @@ OVMS_Status* OVMS_InferenceRequestInputRemoveData(OVMS_InferenceRequest* request
 // \return OVMS_Status object in case of failure
 OVMS_Status* OVMS_InferenceRequestRemoveInput(OVMS_InferenceRequest* request, const char* inputName);
 
+// Add output to the request. Results of outputs with data set are written directly to the provided memory.
+// Outputs not added to the request are allocated by the server.
+//
+// \param request The request object
+// \param outputName The name of the output
+// \param datatype The data type of the output
+// \param shape The shape of the output
+// \param dimCount The number of dimensions of the shape
+// \return OVMS_Status object in case of failure
+OVMS_Status* OVMS_InferenceRequestAddOutput(OVMS_InferenceRequest* request, const char* outputName, OVMS_DataType datatype, const uint64_t* shape, uint32_t dimCount);
+
+// Set the memory for the output results. Ownership of data needs to be maintained until the response is deleted.
+// Response output refers to this memory instead of owning a copy of results.
+//
+// \param request The request object
+// \param outputName The name of the output with data to be set
+// \param data The memory for output results
+// \param byteSize The byte size of the memory
+// \param bufferType The buffer type of the memory
+// \param deviceId The device id of the memory buffer
+// \return OVMS_Status object in case of failure
+OVMS_Status* OVMS_InferenceRequestOutputSetData(OVMS_InferenceRequest* request, const char* outputName, void* data, size_t byteSize, OVMS_BufferType bufferType, uint32_t deviceId);
+
+// Remove the memory set for the output.
+//
+// \param request The request object
+// \param outputName The name of the output with data to be removed
+// \return OVMS_Status object in case of failure
+OVMS_Status* OVMS_InferenceRequestOutputRemoveData(OVMS_InferenceRequest* request, const char* outputName);
+
+// Remove output from the request.
+//
+// \param request The request object
+// \param outputName The name of the output to be removed
+// \return OVMS_Status object in case of failure
+OVMS_Status* OVMS_InferenceRequestRemoveOutput(OVMS_InferenceRequest* request, const char* outputName);
+
 // Add parameter to the request.
 //
 // \param request The request object
@@ -430,6 +486,16 @@ void OVMS_InferenceResponseDelete(OVMS_InferenceResponse* response);
 // \return OVMS_Status object in case of failure
 OVMS_Status* OVMS_Inference(OVMS_Server* server, OVMS_InferenceRequest* request, OVMS_InferenceResponse** response);
 
+// Execute asynchronous inference.
+// Call returns after request is validated and inputs are set, without waiting for inference results.
+// Request has to stay valid until callback is called.
+//
+// \param request The request object
+// \param callback The callback called once inference is completed. Not called when starting inference fails
+// \param userdata The pointer passed to the callback
+// \return OVMS_Status object in case of failure to start inference
+OVMS_Status* OVMS_InferenceAsync(OVMS_Server* server, OVMS_InferenceRequest* request, OVMS_InferenceCallback callback, void* userdata);
+
 #ifdef __cplusplus
 }
 #endif
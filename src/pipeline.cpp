@@ -19,21 +19,42 @@
 #include <map>
 #include <set>
 #include <string>
+#include <tuple>
 #include <utility>
 
 #include "execution_context.hpp"
 #include "logging.hpp"
+#include "model_metric_reporter.hpp"
 #include "node.hpp"
 #include "nodesession.hpp"
 #include "pipelineeventqueue.hpp"
+#include "pipelinegraphpool.hpp"
 #include "profiler.hpp"
+#include "request_scope.hpp"
 #include "status.hpp"
+#include "timer.hpp"
 
 namespace ovms {
 
-using DeferredNodeSessions = std::vector<std::pair<std::reference_wrapper<Node>, session_key_t>>;
+// Node session deferred due to missing stream id, with tick of the first deferral
+using DeferredNodeSessions = std::vector<std::tuple<std::reference_wrapper<Node>, session_key_t, uint64_t>>;
 
-Pipeline::~Pipeline() = default;
+Pipeline::~Pipeline() {
+    if (!this->graphPool || !this->reusable) {
+        return;
+    }
+    // Graph can be reused only if no node keeps state of this execution
+    for (const auto& node : this->nodes) {
+        if (node->hasSessions()) {
+            return;
+        }
+    }
+    auto graph = std::make_unique<PipelineGraph>();
+    graph->nodes = std::move(this->nodes);
+    graph->entry = &this->entry;
+    graph->exit = &this->exit;
+    this->graphPool->release(std::move(graph), this->graphGeneration);
+}
 
 Pipeline::Pipeline(Node& entry, Node& exit, ServableMetricReporter& reporter, const std::string& name) :
     name(name),
@@ -41,6 +62,15 @@ Pipeline::Pipeline(Node& entry, Node& exit, ServableMetricReporter& reporter, co
     exit(exit),
     reporter(reporter) {}
 
+Pipeline::Pipeline(std::unique_ptr<PipelineGraph> graph, PipelineGraphPool& graphPool, uint64_t graphGeneration, ServableMetricReporter& reporter, const std::string& name) :
+    nodes(std::move(graph->nodes)),
+    name(name),
+    entry(*graph->entry),
+    exit(*graph->exit),
+    reporter(reporter),
+    graphPool(&graphPool),
+    graphGeneration(graphGeneration) {}
+
 void Pipeline::push(std::unique_ptr<Node> node) {
     nodes.emplace_back(std::move(node));
 }
@@ -85,6 +115,14 @@ inline static void setFailIfNotFailEarlier(ovms::Status& earlierStatusCode, ovms
             getName(), NODE.getName(), sessionKey, status.getCode(), status.string());                                                     \
     }
 
+void Pipeline::observeNodeWaitTime(uint64_t deferredSince) {
+    if (!this->reporter.dagNodeWaitTime) {
+        return;
+    }
+    auto waitTime = std::chrono::duration_cast<std::chrono::microseconds>(TickClock::toDuration(TickClock::now() - deferredSince));
+    this->reporter.dagNodeWaitTime->observe(waitTime.count());
+}
+
 Status Pipeline::execute(ExecutionContext context) {
     OVMS_PROFILE_FUNCTION();
     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Started execution of pipeline: {}", getName());
@@ -98,6 +136,10 @@ Status Pipeline::execute(ExecutionContext context) {
     ovms::Status firstErrorStatus{ovms::StatusCode::OK};
     std::set<std::string> startedSessions;
     std::set<std::string> finishedSessions;
+    std::set<const Node*> startedNodes;
+    // set when client deadline passed or client cancelled, nodes which did not start are not executed
+    bool cancelled = false;
+    size_t cancelledNodeSessions = 0;
     NodeSessionMetadata meta(context);
     auto* entryNodeSession = entry.getNodeSession(meta);
     if (!entryNodeSession) {
@@ -106,6 +148,7 @@ Status Pipeline::execute(ExecutionContext context) {
     }
     auto entrySessionKey = meta.getSessionKey();
     startedSessions.emplace(entry.getName() + entrySessionKey);
+    startedNodes.emplace(&entry);
     ovms::Status status = entry.execute(entrySessionKey, finishedNodeQueue);  // first node will triger first message
     if (!status.ok()) {
         SPDLOG_LOGGER_WARN(dag_executor_logger, "Executing pipeline: {} node: {} failed with: {}",
@@ -118,6 +161,14 @@ Status Pipeline::execute(ExecutionContext context) {
     // process finished session nodes and if no one is finished check if any node session with deferred execution
     // has necessary resources already
     while (true) {
+        if (firstErrorStatus.ok()) {
+            status = RequestScope::checkCurrent();
+            if (!status.ok()) {
+                SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Cancelling execution of pipeline: {}; {}", getName(), status.string());
+                setFailIfNotFailEarlier(firstErrorStatus, status);
+                cancelled = true;
+            }
+        }
         spdlog::trace("Pipeline: {} waiting for message that node finished.", getName());
         OVMS_PROFILE_SYNC_BEGIN("PipelineEventQueue::tryPull");
         auto optionallyFinishedNode = finishedNodeQueue.tryPull(WAIT_FOR_FINISHED_NODE_TIMEOUT_MICROSECONDS);
@@ -167,10 +218,12 @@ Status Pipeline::execute(ExecutionContext context) {
                 for (auto& sessionKey : readySessions) {
                     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Started execution of pipeline: {} node: {} session: {}", getName(), nextNode.get().getName(), sessionKey);
                     startedSessions.emplace(nextNode.get().getName() + sessionKey);
+                    startedNodes.emplace(&nextNode.get());
+                    uint64_t readySince = TickClock::now();
                     status = nextNode.get().execute(sessionKey, finishedNodeQueue);
                     if (status == StatusCode::PIPELINE_STREAM_ID_NOT_READY_YET) {
                         SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Node: {} session: {} not ready for execution yet", nextNode.get().getName(), sessionKey);
-                        tmpDeferredNodeSessions.emplace_back(nextNode.get(), sessionKey);
+                        tmpDeferredNodeSessions.emplace_back(nextNode.get(), sessionKey, readySince);
                         status = StatusCode::OK;
                     }
                     CHECK_AND_LOG_ERROR(nextNode.get())
@@ -192,12 +245,13 @@ Status Pipeline::execute(ExecutionContext context) {
                 if (finishedNodeQueue.size() > 0) {
                     break;
                 }
-                auto& [nodeRef, sessionKey] = *it;
+                auto& [nodeRef, sessionKey, deferredSince] = *it;
                 auto& node = nodeRef.get();
                 SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Trying to trigger node: {} session: {} execution", node.getName(), sessionKey);
                 status = node.execute(sessionKey, finishedNodeQueue);
                 if (status.ok()) {
                     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Node: {} session: {} is ready", node.getName(), sessionKey);
+                    observeNodeWaitTime(deferredSince);
                     it = deferredNodeSessions.erase(it);
                     continue;
                 }
@@ -232,11 +286,14 @@ Status Pipeline::execute(ExecutionContext context) {
                 if (deferredNodeSessions.size() > 0) {
                     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Trying to disarm {} remaining deferred node sessions ...", deferredNodeSessions.size());
                     for (auto it = deferredNodeSessions.begin(); it != deferredNodeSessions.end();) {
-                        auto& [nodeRef, sessionKey] = *it;
+                        auto& [nodeRef, sessionKey, deferredSince] = *it;
                         auto& node = nodeRef.get();
                         if (node.tryDisarm(sessionKey, WAIT_FOR_DEFERRED_NODE_DISARM_TIMEOUT_MICROSECONDS)) {
                             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Stream id guard disarm of node {} session: {} has succeeded", node.getName(), sessionKey);
                             finishedSessions.emplace(node.getName() + sessionKey);
+                            if (cancelled) {
+                                ++cancelledNodeSessions;
+                            }
                             it = deferredNodeSessions.erase(it);
                         } else {
                             SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Cannot disarm stream id guard of node: {}, session: {} yet, will try again later", node.getName(), sessionKey);
@@ -257,12 +314,13 @@ Status Pipeline::execute(ExecutionContext context) {
             // free blocked inferRequests from exeuction first rather than free models for reloading
             OVMS_PROFILE_SYNC_BEGIN("Try deferred nodes");
             for (auto it = deferredNodeSessions.begin(); it != deferredNodeSessions.end();) {
-                auto& [nodeRef, sessionKey] = *it;
+                auto& [nodeRef, sessionKey, deferredSince] = *it;
                 auto& node = nodeRef.get();
                 SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Trying to trigger node: {} session: {} execution", node.getName(), sessionKey);
                 status = node.execute(sessionKey, finishedNodeQueue);
                 if (status.ok()) {
                     SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Node: {} session: {} is ready", node.getName(), sessionKey);
+                    observeNodeWaitTime(deferredSince);
                     it = deferredNodeSessions.erase(it);
                     continue;
                 }
@@ -277,6 +335,14 @@ Status Pipeline::execute(ExecutionContext context) {
             OVMS_PROFILE_SYNC_END("Try deferred nodes");
         }
     }
+    if (cancelled) {
+        INCREMENT_IF_ENABLED(this->reporter.dagRequestsCancelled);
+        if (this->reporter.dagNodesCancelled) {
+            size_t notStartedNodes = this->nodes.size() > startedNodes.size() ? this->nodes.size() - startedNodes.size() : 0;
+            this->reporter.dagNodesCancelled->increment(cancelledNodeSessions + notStartedNodes);
+        }
+    }
+    this->reusable = firstErrorStatus.ok();
     return firstErrorStatus;
 }
 }  // namespace ovms
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -30,7 +31,9 @@ class ServableMetricReporter;
 class Node;
 
 class Node;
+class PipelineGraphPool;
 class Status;
+struct PipelineGraph;
 
 void printNodeConnections(const std::string& nodeName, const std::string& sourceNode, const Aliases& pairs);
 
@@ -41,8 +44,14 @@ class Pipeline {
     Node& exit;
     ServableMetricReporter& reporter;
 
+    // Pool to which nodes are returned after successful execution
+    PipelineGraphPool* graphPool = nullptr;
+    uint64_t graphGeneration = 0;
+    bool reusable = false;
+
 public:
     Pipeline(Node& entry, Node& exit, ServableMetricReporter& reporter, const std::string& name = "default_name");
+    Pipeline(std::unique_ptr<PipelineGraph> graph, PipelineGraphPool& graphPool, uint64_t graphGeneration, ServableMetricReporter& reporter, const std::string& name = "default_name");
 
     void push(std::unique_ptr<Node> node);
     ~Pipeline();
@@ -61,6 +70,7 @@ public:
 
 private:
     std::map<const std::string, bool> prepareStatusMap() const;
+    void observeNodeWaitTime(uint64_t deferredSince);
 };
 
 }  // namespace ovms
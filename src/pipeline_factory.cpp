@@ -15,6 +15,8 @@
 //*****************************************************************************
 #include "pipeline_factory.hpp"
 
+#include "inferencerequest.hpp"
+#include "inferenceresponse.hpp"
 #include "logging.hpp"
 #include "model_metric_reporter.hpp"
 #include "modelmanager.hpp"
@@ -108,6 +110,13 @@ Status PipelineFactory::create(std::unique_ptr<Pipeline>& pipeline,
     ModelManager& manager) const {
     return this->createInternal(pipeline, name, request, response, manager);
 }
+Status PipelineFactory::create(std::unique_ptr<Pipeline>& pipeline,
+    const std::string& name,
+    const InferenceRequest* request,
+    InferenceResponse* response,
+    ModelManager& manager) const {
+    return this->createInternal(pipeline, name, request, response, manager);
+}
 
 Status PipelineFactory::reloadDefinition(const std::string& pipelineName,
     const std::vector<NodeInfo>&& nodeInfos,
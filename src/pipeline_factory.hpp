@@ -33,6 +33,8 @@
 
 namespace ovms {
 
+class InferenceRequest;
+class InferenceResponse;
 class ModelManager;
 class NodeInfo;
 class Pipeline;
@@ -70,6 +72,11 @@ public:
         const tensorflow::serving::PredictRequest* request,
         tensorflow::serving::PredictResponse* response,
         ModelManager& manager) const;
+    Status create(std::unique_ptr<Pipeline>& pipeline,
+        const std::string& name,
+        const InferenceRequest* request,
+        InferenceResponse* response,
+        ModelManager& manager) const;
 
     PipelineDefinition* findDefinitionByName(const std::string& name) const;
     Status reloadDefinition(const std::string& pipelineName,
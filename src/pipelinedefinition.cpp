@@ -16,14 +16,19 @@
 #include "pipelinedefinition.hpp"
 
 #include <chrono>
+#include <mutex>
 #include <set>
 #include <thread>
+#include <type_traits>
+#include <unordered_map>
 
 #include "custom_node.hpp"
 #include "custom_node_library_internal_manager_wrapper.hpp"
 #include "dl_node.hpp"
 #include "entry_node.hpp"
 #include "exit_node.hpp"
+#include "inferencerequest.hpp"
+#include "inferenceresponse.hpp"
 #include "logging.hpp"
 #include "model_metric_reporter.hpp"
 #include "modelinstance.hpp"
@@ -61,12 +66,16 @@ PipelineDefinition::PipelineDefinition(const std::string& pipelineName,
     pipelineName(pipelineName),
     nodeInfos(nodeInfos),
     connections(connections),
-    reporter(std::make_unique<ServableMetricReporter>(metricConfig, registry, pipelineName, VERSION)),
-    status(this->pipelineName) {}
+    reporter(std::make_unique<PipelineMetricReporter>(metricConfig, registry, pipelineName, VERSION)),
+    status(this->pipelineName) {
+    compileConnections();
+}
 
 Status PipelineDefinition::validate(ModelManager& manager) {
     SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Started validation of pipeline: {}", getName());
     ValidationResultNotifier notifier(status, loadedNotify);
+    // pooled graphs hold node resources and inputs/outputs info which may change
+    invalidateGraphPools();
     auto& models = manager.getModels();
     if (std::find_if(models.begin(), models.end(), [this](auto pair) { return this->pipelineName == pair.first; }) != models.end()) {
         SPDLOG_LOGGER_ERROR(modelmanager_logger, "Pipeline name: {} is already occupied by model.", pipelineName);
@@ -91,14 +100,16 @@ Status PipelineDefinition::validate(ModelManager& manager) {
     }
     std::unique_lock lock(metadataMtx);
     validationResult = updateInputsInfo(manager);
-    if (!validationResult.ok()) {
-        return validationResult;
+    if (validationResult.ok()) {
+        validationResult = updateOutputsInfo(manager);
     }
-    validationResult = updateOutputsInfo(manager);
+    // graphs may be created until validation ends, graph acquiring new generation
+    // has to be built from updated inputs/outputs info
+    invalidateGraphPools();
+    lock.unlock();
     if (!validationResult.ok()) {
         return validationResult;
     }
-    lock.unlock();
     notifier.passed = true;
     SPDLOG_LOGGER_DEBUG(modelmanager_logger, "Finished validation of pipeline: {}", getName());
     SPDLOG_LOGGER_INFO(modelmanager_logger, "Pipeline: {} inputs: {}", getName(), getTensorMapString(inputsInfo));
@@ -123,7 +134,8 @@ Status PipelineDefinition::initializeNodeResources(ModelManager& manager) {
             }
             std::shared_ptr<CNLIMWrapper> sharedCustomNodeLibraryInternalManager(new CNLIMWrapper{customNodeLibraryInternalManager, nodeInfo.library.deinitialize});
             manager.addResourceToCleaner(sharedCustomNodeLibraryInternalManager);
-            nodeResources.emplace(std::make_pair(nodeInfo.nodeName, std::move(sharedCustomNodeLibraryInternalManager)));
+            // Replace resources of nodes kept between reloads, so new parameters and metadata take effect
+            nodeResources[nodeInfo.nodeName] = std::move(sharedCustomNodeLibraryInternalManager);
         }
     }
     return StatusCode::OK;
@@ -161,10 +173,12 @@ Status PipelineDefinition::reload(ModelManager& manager, const std::vector<NodeI
     while (requestsHandlesCounter > 0) {
         std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
+    invalidateGraphPools();
     // deinitialize all resources that are associated with nodes that are currently in PipelineDefinition, but not in nodeInfos
     deinitializeNodeResources(calculateNodeInfosDiff(nodeInfos));
     this->nodeInfos = std::move(nodeInfos);
     this->connections = std::move(connections);
+    compileConnections();
     makeSubscriptions(manager);
 
     return validate(manager);
@@ -176,11 +190,13 @@ void PipelineDefinition::retire(ModelManager& manager) {
     while (requestsHandlesCounter > 0) {
         std::this_thread::sleep_for(std::chrono::microseconds(1));
     }
+    invalidateGraphPools();
     // deinitalize all resources
     deinitializeNodeResources(this->nodeInfos);
     this->nodeResources.clear();
     this->nodeInfos.clear();
     this->connections.clear();
+    this->compiledConnections.clear();
 }
 
 Status PipelineDefinition::waitForLoaded(std::unique_ptr<PipelineDefinitionUnloadGuard>& unloadGuard, const uint waitForLoadedTimeoutMicroseconds) {
@@ -229,55 +245,86 @@ Status PipelineDefinition::waitForLoaded(std::unique_ptr<PipelineDefinitionUnloa
     return StatusCode::OK;
 }
 
-template <typename RequestType, typename ResponseType>
-Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
-    const RequestType* request,
-    ResponseType* response,
-    ModelManager& manager) {
-    std::unique_ptr<PipelineDefinitionUnloadGuard> unloadGuard;
-    Status status = waitForLoaded(unloadGuard);
-    if (!status.ok()) {
-        return status;
+template <typename RequestType>
+PipelineGraphPool& PipelineDefinition::getGraphPool() {
+    if constexpr (std::is_same_v<RequestType, tensorflow::serving::PredictRequest>) {
+        return this->predictGraphPool;
+    } else if constexpr (std::is_same_v<RequestType, ::KFSRequest>) {
+        return this->kfsGraphPool;
+    } else {
+        static_assert(std::is_same_v<RequestType, InferenceRequest>, "unsupported request type");
+        return this->capiGraphPool;
     }
+}
 
-    std::unordered_map<std::string, std::unique_ptr<Node>> nodes;
-    EntryNode<RequestType>* entry = nullptr;
-    ExitNode<ResponseType>* exit = nullptr;
+void PipelineDefinition::invalidateGraphPools() {
+    this->predictGraphPool.invalidate();
+    this->kfsGraphPool.invalidate();
+    this->capiGraphPool.invalidate();
+}
 
+void PipelineDefinition::compileConnections() {
+    this->compiledConnections.clear();
+    std::unordered_map<std::string, size_t> nodeIndexes;
+    for (size_t i = 0; i < this->nodeInfos.size(); ++i) {
+        nodeIndexes.emplace(this->nodeInfos[i].nodeName, i);
+    }
+    for (const auto& [dependantName, dependencies] : this->connections) {
+        auto dependant = nodeIndexes.find(dependantName);
+        if (dependant == nodeIndexes.end()) {
+            // rejected during validation
+            continue;
+        }
+        for (const auto& [dependencyName, aliases] : dependencies) {
+            auto dependency = nodeIndexes.find(dependencyName);
+            if (dependency == nodeIndexes.end()) {
+                continue;
+            }
+            this->compiledConnections.push_back({dependency->second, dependant->second, &aliases});
+        }
+    }
+}
+
+template <typename RequestType, typename ResponseType>
+std::unique_ptr<PipelineGraph> PipelineDefinition::createGraph(const RequestType* request,
+    ResponseType* response,
+    ModelManager& manager) {
+    auto graph = std::make_unique<PipelineGraph>();
+    graph->nodes.reserve(nodeInfos.size());
     for (const auto& info : nodeInfos) {
         SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Creating pipeline: {}. Adding nodeName: {}, modelName: {}",
             getName(), info.nodeName, info.modelName);
         switch (info.kind) {
         case NodeKind::ENTRY: {
             auto node = std::make_unique<EntryNode<RequestType>>(request, getInputsInfo(), info.demultiplyCount);
-            entry = node.get();
-            nodes.emplace(info.nodeName, std::move(node));
+            graph->entry = node.get();
+            graph->nodes.emplace_back(std::move(node));
             break;
         }
         case NodeKind::DL:
-            nodes.emplace(info.nodeName, std::make_unique<DLNode>(
-                                             info.nodeName,
-                                             info.modelName,
-                                             info.modelVersion,
-                                             manager,
-                                             info.outputNameAliases,
-                                             info.demultiplyCount,
-                                             info.gatherFromNode));
+            graph->nodes.emplace_back(std::make_unique<DLNode>(
+                info.nodeName,
+                info.modelName,
+                info.modelVersion,
+                manager,
+                info.outputNameAliases,
+                info.demultiplyCount,
+                info.gatherFromNode));
             break;
         case NodeKind::CUSTOM:
-            nodes.emplace(info.nodeName, std::make_unique<CustomNode>(
-                                             info.nodeName,
-                                             info.library,
-                                             info.parameters,
-                                             info.outputNameAliases,
-                                             info.demultiplyCount,
-                                             info.gatherFromNode,
-                                             nodeResources.at(info.nodeName)));
+            graph->nodes.emplace_back(std::make_unique<CustomNode>(
+                info.nodeName,
+                info.library,
+                info.parameters,
+                info.outputNameAliases,
+                info.demultiplyCount,
+                info.gatherFromNode,
+                nodeResources.at(info.nodeName)));
             break;
         case NodeKind::EXIT: {
             auto node = std::make_unique<ExitNode<ResponseType>>(response, getOutputsInfo(), info.gatherFromNode, useSharedOutputContent(request));
-            exit = node.get();
-            nodes.emplace(info.nodeName, std::move(node));
+            graph->exit = node.get();
+            graph->nodes.emplace_back(std::move(node));
             break;
         }
         default:
@@ -285,18 +332,37 @@ Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
             throw std::invalid_argument("unknown node kind");
         }
     }
-    for (const auto& kv : connections) {
-        const auto& dependantNode = nodes.at(kv.first);
-        for (const auto& pair : kv.second) {
-            const auto& dependencyNode = nodes.at(pair.first);
-            SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Connecting pipeline: {}, from: {}, to: {}", getName(), dependencyNode->getName(), dependantNode->getName());
-            Pipeline::connect(*dependencyNode, *dependantNode, pair.second);
-        }
+    for (const auto& connection : compiledConnections) {
+        auto& dependencyNode = *graph->nodes[connection.dependency];
+        auto& dependantNode = *graph->nodes[connection.dependant];
+        SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Connecting pipeline: {}, from: {}, to: {}", getName(), dependencyNode.getName(), dependantNode.getName());
+        Pipeline::connect(dependencyNode, dependantNode, *connection.aliases);
+    }
+    return graph;
+}
+
+template <typename RequestType, typename ResponseType>
+Status PipelineDefinition::create(std::unique_ptr<Pipeline>& pipeline,
+    const RequestType* request,
+    ResponseType* response,
+    ModelManager& manager) {
+    std::unique_ptr<PipelineDefinitionUnloadGuard> unloadGuard;
+    Status status = waitForLoaded(unloadGuard);
+    if (!status.ok()) {
+        return status;
     }
-    pipeline = std::make_unique<Pipeline>(*entry, *exit, *this->reporter, pipelineName);
-    for (auto& kv : nodes) {
-        pipeline->push(std::move(kv.second));
+
+    auto& graphPool = getGraphPool<RequestType>();
+    uint64_t graphGeneration = 0;
+    auto graph = graphPool.acquire(graphGeneration);
+    if (graph) {
+        SPDLOG_LOGGER_DEBUG(dag_executor_logger, "Creating pipeline: {} from pooled graph", getName());
+        static_cast<EntryNode<RequestType>*>(graph->entry)->setRequest(request);
+        static_cast<ExitNode<ResponseType>*>(graph->exit)->setResponse(response, useSharedOutputContent(request));
+    } else {
+        graph = createGraph(request, response, manager);
     }
+    pipeline = std::make_unique<Pipeline>(std::move(graph), graphPool, graphGeneration, *this->reporter, pipelineName);
     return status;
 }
 
@@ -725,7 +791,7 @@ public:
                 this->inputsInfo,
                 dependantNodeInfo.library.getInputsInfo,
                 this->pipelineName,
-                getCNLIMWrapperPtr(nodeResources.at(dependantNodeInfo.nodeName)));
+                nodeResources.at(dependantNodeInfo.nodeName));
             if (!result.ok()) {
                 return result;
             }
@@ -734,7 +800,7 @@ public:
                 this->outputsInfo,
                 dependantNodeInfo.library.getOutputsInfo,
                 this->pipelineName,
-                getCNLIMWrapperPtr(nodeResources.at(dependantNodeInfo.nodeName)));
+                nodeResources.at(dependantNodeInfo.nodeName));
             if (!result.ok()) {
                 return result;
             }
@@ -753,7 +819,7 @@ public:
             this->dependencyInputsInfo,
             dependencyNodeInfo.library.getInputsInfo,
             this->pipelineName,
-            getCNLIMWrapperPtr(nodeResources.at(dependencyNodeInfo.nodeName)));
+            nodeResources.at(dependencyNodeInfo.nodeName));
         if (!result.ok()) {
             return result;
         }
@@ -762,7 +828,7 @@ public:
             this->dependencyOutputsInfo,
             dependencyNodeInfo.library.getOutputsInfo,
             this->pipelineName,
-            getCNLIMWrapperPtr(nodeResources.at(dependencyNodeInfo.nodeName)));
+            nodeResources.at(dependencyNodeInfo.nodeName));
         if (!result.ok()) {
             return result;
         }
@@ -1170,7 +1236,7 @@ Status PipelineDefinition::updateInputsInfo(const ModelManager& manager) {
 
                 tensor_map_t info;
                 auto status = getCustomNodeMetadata(*dependantNodeInfo, info, dependantNodeInfo->library.getInputsInfo, this->getName(),
-                    getCNLIMWrapperPtr(nodeResources.at(dependantNodeInfo->nodeName)));
+                    nodeResources.at(dependantNodeInfo->nodeName));
                 if (!status.ok()) {
                     return status;
                 }
@@ -1228,7 +1294,7 @@ Status PipelineDefinition::populateOutputsInfoWithCustomNodeOutputs(const NodeIn
     }
     tensor_map_t info;
     auto status = getCustomNodeMetadata(dependencyNodeInfo, info, dependencyNodeInfo.library.getOutputsInfo, this->getName(),
-        getCNLIMWrapperPtr(nodeResources.at(dependencyNodeInfo.nodeName)));
+        nodeResources.at(dependencyNodeInfo.nodeName));
     if (!status.ok()) {
         return status;
     }
@@ -1307,6 +1373,26 @@ Status PipelineDefinition::getCustomNodeMetadata(const NodeInfo& customNodeInfo,
     return createTensorInfoMap(info, infoCount, inputsInfo, customNodeInfo.library.release, customNodeLibraryInternalManager);
 }
 
+Status PipelineDefinition::getCustomNodeMetadata(const NodeInfo& customNodeInfo, tensor_map_t& inputsInfo, metadata_fn callback, const std::string& pipelineName, const std::shared_ptr<CNLIMWrapper>& customNodeLibraryInternalManager) {
+    if (customNodeLibraryInternalManager == nullptr) {
+        return getCustomNodeMetadata(customNodeInfo, inputsInfo, callback, pipelineName, static_cast<void*>(nullptr));
+    }
+    std::unique_lock lock(customNodeLibraryInternalManager->metadataCacheMtx);
+    auto it = customNodeLibraryInternalManager->metadataCache.find(callback);
+    if (it == customNodeLibraryInternalManager->metadataCache.end()) {
+        tensor_map_t info;
+        auto status = getCustomNodeMetadata(customNodeInfo, info, callback, pipelineName, customNodeLibraryInternalManager->ptr);
+        if (!status.ok()) {
+            return status;
+        }
+        it = customNodeLibraryInternalManager->metadataCache.emplace(callback, std::move(info)).first;
+    } else {
+        SPDLOG_DEBUG("Using cached metadata of custom node: {} in pipeline: {}", customNodeInfo.nodeName, pipelineName);
+    }
+    inputsInfo.insert(it->second.begin(), it->second.end());
+    return StatusCode::OK;
+}
+
 const NodeInfo& PipelineDefinition::findNodeByName(const std::string& name) const {
     return *std::find_if(std::begin(this->nodeInfos), std::end(this->nodeInfos), [&name](const NodeInfo& nodeInfo) {
         return nodeInfo.nodeName == name;
@@ -1337,7 +1423,7 @@ Shape PipelineDefinition::getNodeGatherShape(const NodeInfo& info) const {
                         nodeOutputsInfo,
                         someNodeInfo.library.getOutputsInfo,
                         this->pipelineName,
-                        getCNLIMWrapperPtr(nodeResources.at(someNodeInfo.nodeName)));
+                        nodeResources.at(someNodeInfo.nodeName));
                     if (!result.ok()) {
                         SPDLOG_ERROR("Failed to read node: {} library metadata with error: {}", nodeName, result.string());
                         return;
@@ -1382,5 +1468,10 @@ template Status PipelineDefinition::create<::KFSRequest, ::KFSResponse>(
     const ::KFSRequest* request,
     ::KFSResponse* response,
     ModelManager& manager);
+template Status PipelineDefinition::create<InferenceRequest, InferenceResponse>(
+    std::unique_ptr<Pipeline>& pipeline,
+    const InferenceRequest* request,
+    InferenceResponse* response,
+    ModelManager& manager);
 
 }  // namespace ovms
@@ -35,6 +35,7 @@
 #include "modelversion.hpp"
 #include "nodeinfo.hpp"
 #include "pipelinedefinitionstatus.hpp"
+#include "pipelinegraphpool.hpp"
 #include "tensorinfo.hpp"
 
 namespace ovms {
@@ -75,6 +76,19 @@ class PipelineDefinition {
     std::map<std::string, std::shared_ptr<CNLIMWrapper>> nodeResources = {};
     pipeline_connections_t connections;
 
+    // Connection resolved to indexes of nodeInfos, compiled once per definition load
+    struct NodeConnection {
+        size_t dependency;
+        size_t dependant;
+        const Aliases* aliases;
+    };
+    std::vector<NodeConnection> compiledConnections;
+
+    // Graphs of finished pipelines reused by next requests, separate for each request type
+    PipelineGraphPool predictGraphPool;
+    PipelineGraphPool kfsGraphPool;
+    PipelineGraphPool capiGraphPool;
+
 protected:
     tensor_map_t inputsInfo;
     tensor_map_t outputsInfo;
@@ -122,6 +136,17 @@ private:
         ResponseType* response,
         ModelManager& manager);
 
+    template <typename RequestType, typename ResponseType>
+    std::unique_ptr<PipelineGraph> createGraph(const RequestType* request,
+        ResponseType* response,
+        ModelManager& manager);
+
+    template <typename RequestType>
+    PipelineGraphPool& getGraphPool();
+
+    void compileConnections();
+    void invalidateGraphPools();
+
 public:
     Status reload(ModelManager& manager, const std::vector<NodeInfo>&& nodeInfos, const pipeline_connections_t&& connections);
     void retire(ModelManager& manager);
@@ -154,6 +179,10 @@ public:
 
     ServableMetricReporter& getMetricReporter() const { return *this->reporter; }
 
+    size_t getPooledGraphsCount() const {
+        return this->predictGraphPool.size() + this->kfsGraphPool.size() + this->capiGraphPool.size();
+    }
+
 protected:
     Status updateInputsInfo(const ModelManager& manager);
     Status updateOutputsInfo(const ModelManager& manager);
@@ -164,6 +193,7 @@ public:
 
 private:
     static Status getCustomNodeMetadata(const NodeInfo& customNodeInfo, tensor_map_t& inputsInfo, metadata_fn callback, const std::string& pipelineName, void* customNodeLibraryInternalManager);
+    static Status getCustomNodeMetadata(const NodeInfo& customNodeInfo, tensor_map_t& inputsInfo, metadata_fn callback, const std::string& pipelineName, const std::shared_ptr<CNLIMWrapper>& customNodeLibraryInternalManager);
 
     Status populateOutputsInfoWithDLModelOutputs(
         const NodeInfo& dependencyNodeInfo,
@@ -0,0 +1,66 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "pipelinegraphpool.hpp"
+
+#include <utility>
+
+#include "node.hpp"
+
+namespace ovms {
+
+PipelineGraph::PipelineGraph() = default;
+PipelineGraph::~PipelineGraph() = default;
+
+PipelineGraphPool::PipelineGraphPool(size_t capacity) :
+    capacity(capacity) {}
+
+PipelineGraphPool::~PipelineGraphPool() = default;
+
+std::unique_ptr<PipelineGraph> PipelineGraphPool::acquire(uint64_t& generation) {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    generation = this->generation;
+    if (this->graphs.empty()) {
+        return nullptr;
+    }
+    auto graph = std::move(this->graphs.back());
+    this->graphs.pop_back();
+    return graph;
+}
+
+void PipelineGraphPool::release(std::unique_ptr<PipelineGraph> graph, uint64_t generation) {
+    // declared before the lock, so rejected graph is destroyed after unlocking
+    std::unique_ptr<PipelineGraph> rejected;
+    std::unique_lock<std::mutex> lock(this->mtx);
+    if (generation != this->generation || this->graphs.size() >= this->capacity) {
+        rejected = std::move(graph);
+        return;
+    }
+    this->graphs.emplace_back(std::move(graph));
+}
+
+void PipelineGraphPool::invalidate() {
+    std::vector<std::unique_ptr<PipelineGraph>> dropped;
+    std::unique_lock<std::mutex> lock(this->mtx);
+    ++this->generation;
+    dropped.swap(this->graphs);
+}
+
+size_t PipelineGraphPool::size() const {
+    std::unique_lock<std::mutex> lock(this->mtx);
+    return this->graphs.size();
+}
+
+}  // namespace ovms
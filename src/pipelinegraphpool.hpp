@@ -0,0 +1,70 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace ovms {
+
+class Node;
+
+/**
+ * @brief Connected nodes of a single pipeline execution.
+ * Nodes are stored in the order of pipeline definition node infos.
+ */
+struct PipelineGraph {
+    std::vector<std::unique_ptr<Node>> nodes;
+    Node* entry = nullptr;
+    Node* exit = nullptr;
+
+    PipelineGraph();
+    ~PipelineGraph();
+};
+
+/**
+ * @brief Keeps graphs of pipelines which finished execution, so next requests can reuse them
+ * instead of constructing and connecting all nodes again.
+ * Graphs are tagged with generation of the pool. Invalidating the pool drops stored graphs
+ * and makes graphs acquired earlier rejected on release.
+ */
+class PipelineGraphPool {
+    mutable std::mutex mtx;
+    std::vector<std::unique_ptr<PipelineGraph>> graphs;
+    uint64_t generation = 0;
+    const size_t capacity;
+
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64;
+
+    PipelineGraphPool(size_t capacity = DEFAULT_CAPACITY);
+    ~PipelineGraphPool();
+
+    /**
+     * @brief Takes graph out of the pool.
+     * @param generation set to current generation of the pool, also when pool is empty
+     * @return graph or nullptr if none is available
+     */
+    std::unique_ptr<PipelineGraph> acquire(uint64_t& generation);
+    void release(std::unique_ptr<PipelineGraph> graph, uint64_t generation);
+    void invalidate();
+
+    size_t size() const;
+};
+
+}  // namespace ovms
@@ -20,6 +20,7 @@
 #pragma GCC diagnostic pop
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <spdlog/spdlog.h>
 
@@ -27,10 +28,12 @@
 #include "capi_frontend/capi_utils.hpp"
 #include "inferencerequest.hpp"
 #include "inferencetensor.hpp"
+#include "input_plan.hpp"
 #include "kfs_frontend/kfs_grpc_inference_service.hpp"
 #include "kfs_frontend/kfs_utils.hpp"
 #include "modelconfig.hpp"
 #include "profiler.hpp"
+#include "shared_memory_manager.hpp"
 #include "status.hpp"
 #include "tfs_frontend/tfs_utils.hpp"
 
@@ -96,8 +99,12 @@ class RequestValidator {
     const std::set<std::string>& optionalAllowedInputNames;
     const Mode batchingMode;
     const shapes_info_map_t& shapeInfo;
+    const InputPlan* inputPlan;
 
     InputIterator it;
+    RequestInputPositions localRequestInputPositions;
+    // request input index of each servable input, filled only when input plan is used
+    RequestInputPositions& requestInputPositions;
 
     RequestValidator() = delete;
 
@@ -110,18 +117,21 @@ public:
     RequestValidator(
         const RequestType& request, const tensor_map_t& inputsInfo,
         const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames,
-        const Mode batchingMode, const shapes_info_map_t& shapeInfo) :
+        const Mode batchingMode, const shapes_info_map_t& shapeInfo, const InputPlan* inputPlan = nullptr, RequestInputPositions* mappedInputPositions = nullptr) :
         request(request),
         inputsInfo(inputsInfo),
         servableName(servableName),
         servableVersion(servableVersion),
         optionalAllowedInputNames(optionalAllowedInputNames),
         batchingMode(batchingMode),
-        shapeInfo(shapeInfo) {}
+        shapeInfo(shapeInfo),
+        inputPlan((inputPlan != nullptr && inputPlan->isBuiltFor(inputsInfo)) ? inputPlan : nullptr),
+        requestInputPositions(mappedInputPositions != nullptr ? *mappedInputPositions : localRequestInputPositions) {}
 
     Status validateInferenceTensorBufferType(const InferenceTensor& it) const;
     Status validateNumberOfInputs() const;
-    Status validateAndGetInput(const RequestType& request, const std::string& name, InputIterator& it, size_t& bufferId);
+    void mapRequestInputs();
+    Status validateAndGetInput(const RequestType& request, const std::string& name, size_t ordinal, InputIterator& it, size_t& bufferId);
     Status checkIfShapeValuesNegative(const InputTensorType& proto) const;
     Status validateNumberOfBinaryInputShapeDimensions(const InputTensorType& proto) const;
     Status checkBatchSizeMismatch(const InputTensorType& proto, const Dimension& servableBatchSize, const size_t batchSizeIndex, Status& finalStatus, Mode batchingMode, Mode shapeMode) const;
@@ -142,6 +152,26 @@ Status RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIterat
 
 template <>
 Status RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorType, KFSShapeType>::validateRequestCoherency() const {
+    for (int i = 0; i < request.inputs_size(); i++) {
+        const auto& input = request.inputs(i);
+        SharedMemoryReference reference;
+        bool isSharedMemoryUsed = false;
+        auto status = getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed);
+        if (!status.ok()) {
+            SPDLOG_DEBUG("[servable name: {} version: {}] Invalid shared memory parameters of input: {} - {}", servableName, servableVersion, input.name(), status.string());
+            return status;
+        }
+        if (!isSharedMemoryUsed) {
+            continue;
+        }
+        if (input.has_contents() || input.datatype() == "BYTES" || (i < request.raw_input_contents_size() && !request.raw_input_contents(i).empty())) {
+            std::stringstream ss;
+            ss << "Input placed in shared memory region cannot have BYTES datatype nor buffer in InferInputTensor contents or raw_input_contents. Detected for input: " << input.name();
+            const std::string details = ss.str();
+            SPDLOG_DEBUG("[servable name: {} version: {}] Invalid request message - {}", servableName, servableVersion, details);
+            return Status(StatusCode::INVALID_MESSAGE_STRUCTURE, details);
+        }
+    }
     if (!request.raw_input_contents().empty()) {
         for (auto& input : request.inputs()) {
             if (input.has_contents()) {
@@ -240,7 +270,24 @@ Status RequestValidator<ovms::InferenceRequest, InferenceTensor, const Inference
 }
 
 template <>
-Status RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIteratorType, TFSShapeType>::validateAndGetInput(const TFSRequestType& request, const std::string& name, TFSInputTensorIteratorType& it, size_t& bufferId) {
+void RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIteratorType, TFSShapeType>::mapRequestInputs() {
+    requestInputPositions.clear();
+}
+template <>
+void RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorType, KFSShapeType>::mapRequestInputs() {
+    if (inputPlan != nullptr) {
+        inputPlan->mapRequestInputs(request, requestInputPositions);
+    } else {
+        requestInputPositions.clear();
+    }
+}
+template <>
+void RequestValidator<ovms::InferenceRequest, InferenceTensor, const InferenceTensor*, shape_t>::mapRequestInputs() {
+    requestInputPositions.clear();
+}
+
+template <>
+Status RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIteratorType, TFSShapeType>::validateAndGetInput(const TFSRequestType& request, const std::string& name, size_t ordinal, TFSInputTensorIteratorType& it, size_t& bufferId) {
     it = request.inputs().find(name);
     if (it != request.inputs().end()) {
         currentlyValidatedName = &name;
@@ -254,15 +301,21 @@ Status RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIterat
     return Status(StatusCode::INVALID_MISSING_INPUT, details);
 }
 template <>
-Status RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorType, KFSShapeType>::validateAndGetInput(const KFSRequest& request, const std::string& name, KFSInputTensorIteratorType& it, size_t& bufferId) {
-    it = request.inputs().begin();
-    bufferId = 0;
-    while (it != request.inputs().end()) {
-        if (it->name() == name) {
-            break;
+Status RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorType, KFSShapeType>::validateAndGetInput(const KFSRequest& request, const std::string& name, size_t ordinal, KFSInputTensorIteratorType& it, size_t& bufferId) {
+    if (!requestInputPositions.empty()) {
+        int position = requestInputPositions[ordinal];
+        it = (position == InputPlan::MISSING) ? request.inputs().end() : request.inputs().begin() + position;
+        bufferId = (position == InputPlan::MISSING) ? 0 : static_cast<size_t>(position);
+    } else {
+        it = request.inputs().begin();
+        bufferId = 0;
+        while (it != request.inputs().end()) {
+            if (it->name() == name) {
+                break;
+            }
+            ++it;
+            ++bufferId;
         }
-        ++it;
-        ++bufferId;
     }
     if (it != request.inputs().end()) {
         currentlyValidatedName = &name;
@@ -277,7 +330,7 @@ Status RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorT
 }
 
 template <>
-Status RequestValidator<ovms::InferenceRequest, InferenceTensor, const InferenceTensor*, shape_t>::validateAndGetInput(const InferenceRequest& request, const std::string& name, const InferenceTensor*& it, size_t& bufferId) {
+Status RequestValidator<ovms::InferenceRequest, InferenceTensor, const InferenceTensor*, shape_t>::validateAndGetInput(const InferenceRequest& request, const std::string& name, size_t ordinal, const InferenceTensor*& it, size_t& bufferId) {
     if (request.getInput(name.c_str(), &it) != StatusCode::NONEXISTENT_TENSOR) {
         currentlyValidatedName = &name;
         return StatusCode::OK;
@@ -624,6 +677,39 @@ Status RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorT
     for (int i = 0; i < proto.shape().size(); i++) {
         expectedValueCount *= proto.shape()[i];
     }
+    SharedMemoryReference reference;
+    bool isSharedMemoryUsed = false;
+    auto status = getSharedMemoryReference(proto.parameters(), reference, isSharedMemoryUsed);
+    if (!status.ok()) {
+        return status;
+    }
+    if (isSharedMemoryUsed) {
+        size_t expectedContentSize = expectedValueCount * ov::element::Type(ovmsPrecisionToIE2Precision(expectedPrecision)).size();
+        if (expectedContentSize != reference.byteSize) {
+            std::stringstream ss;
+            ss << "Expected: " << expectedContentSize << " bytes; Actual: " << reference.byteSize << " bytes in shared memory region: " << reference.regionName << "; input name: " << getCurrentlyValidatedInputName();
+            const std::string details = ss.str();
+            SPDLOG_DEBUG("[servable name: {} version: {}] Invalid content size of tensor proto - {}", servableName, servableVersion, details);
+            return Status(StatusCode::INVALID_CONTENT_SIZE, details);
+        }
+        const SharedMemoryManager* manager = SharedMemoryScope::current();
+        if (manager == nullptr) {
+            SPDLOG_DEBUG("[servable name: {} version: {}] Input: {} refers to shared memory region: {} while shared memory is disabled", servableName, servableVersion, getCurrentlyValidatedInputName(), reference.regionName);
+            return StatusCode::SHARED_MEMORY_DISABLED;
+        }
+        std::shared_ptr<const SharedMemoryRegion> region;
+        status = manager->getRegion(reference.regionName, region);
+        if (!status.ok()) {
+            SPDLOG_DEBUG("[servable name: {} version: {}] Shared memory region: {} of input: {} is not registered", servableName, servableVersion, reference.regionName, getCurrentlyValidatedInputName());
+            return status;
+        }
+        char* data = nullptr;
+        status = region->getData(reference.offset, reference.byteSize, &data);
+        if (!status.ok()) {
+            SPDLOG_DEBUG("[servable name: {} version: {}] Input: {} - {}", servableName, servableVersion, getCurrentlyValidatedInputName(), status.string());
+        }
+        return status;
+    }
     if (request.raw_input_contents().size()) {
         size_t expectedContentSize = expectedValueCount * ov::element::Type(ovmsPrecisionToIE2Precision(expectedPrecision)).size();
         if (expectedContentSize != request.raw_input_contents()[bufferId].size()) {
@@ -824,9 +910,11 @@ Status RequestValidator<RequestType, InputTensorType, IteratorType, ShapeType>::
     if (!status.ok())
         return status;
 
+    mapRequestInputs();
     size_t bufferId = 0;
+    size_t ordinal = 0;
     for (const auto& [name, inputInfo] : inputsInfo) {
-        status = validateAndGetInput(request, name, it, bufferId);
+        status = validateAndGetInput(request, name, ordinal++, it, bufferId);
         if (!status.ok())
             return status;
 
@@ -885,21 +973,21 @@ Status RequestValidator<RequestType, InputTensorType, IteratorType, ShapeType>::
 }
 
 template <>
-Status validate(const TFSRequestType& request, const tensor_map_t& inputsInfo, const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames, const Mode batchingMode, const shapes_info_map_t& shapeInfo) {
+Status validate(const TFSRequestType& request, const tensor_map_t& inputsInfo, const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames, const Mode batchingMode, const shapes_info_map_t& shapeInfo, const InputPlan* inputPlan, RequestInputPositions* requestInputPositions) {
     OVMS_PROFILE_FUNCTION();
-    return RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIteratorType, TFSShapeType>(request, inputsInfo, servableName, servableVersion, optionalAllowedInputNames, batchingMode, shapeInfo).validate();
+    return RequestValidator<TFSRequestType, TFSInputTensorType, TFSInputTensorIteratorType, TFSShapeType>(request, inputsInfo, servableName, servableVersion, optionalAllowedInputNames, batchingMode, shapeInfo, inputPlan, requestInputPositions).validate();
 }
 
 template <>
-Status validate(const KFSRequest& request, const tensor_map_t& inputsInfo, const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames, const Mode batchingMode, const shapes_info_map_t& shapeInfo) {
+Status validate(const KFSRequest& request, const tensor_map_t& inputsInfo, const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames, const Mode batchingMode, const shapes_info_map_t& shapeInfo, const InputPlan* inputPlan, RequestInputPositions* requestInputPositions) {
     OVMS_PROFILE_FUNCTION();
-    return RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorType, KFSShapeType>(request, inputsInfo, servableName, servableVersion, optionalAllowedInputNames, batchingMode, shapeInfo).validate();
+    return RequestValidator<KFSRequest, KFSTensorInputProto, KFSInputTensorIteratorType, KFSShapeType>(request, inputsInfo, servableName, servableVersion, optionalAllowedInputNames, batchingMode, shapeInfo, inputPlan, requestInputPositions).validate();
 }
 
 template <>
-Status validate(const InferenceRequest& request, const tensor_map_t& inputsInfo, const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames, const Mode batchingMode, const shapes_info_map_t& shapeInfo) {
+Status validate(const InferenceRequest& request, const tensor_map_t& inputsInfo, const std::string& servableName, const model_version_t servableVersion, const std::set<std::string>& optionalAllowedInputNames, const Mode batchingMode, const shapes_info_map_t& shapeInfo, const InputPlan* inputPlan, RequestInputPositions* requestInputPositions) {
     OVMS_PROFILE_FUNCTION();
-    return RequestValidator<InferenceRequest, InferenceTensor, const InferenceTensor*, shape_t>(request, inputsInfo, servableName, servableVersion, optionalAllowedInputNames, batchingMode, shapeInfo).validate();
+    return RequestValidator<InferenceRequest, InferenceTensor, const InferenceTensor*, shape_t>(request, inputsInfo, servableName, servableVersion, optionalAllowedInputNames, batchingMode, shapeInfo, inputPlan, requestInputPositions).validate();
 }
 }  // namespace request_validation_utils
 }  // namespace ovms
@@ -25,6 +25,8 @@
 #include "tensorinfo.hpp"
 
 namespace ovms {
+class InputPlan;
+class RequestInputPositions;
 class Status;
 namespace request_validation_utils {
 
@@ -36,7 +38,9 @@ Status validate(
     const model_version_t servableVersion,
     const std::set<std::string>& optionalAllowedInputNames = {},
     const Mode batchingMode = Mode::FIXED,
-    const shapes_info_map_t& shapeInfo = shapes_info_map_t());
+    const shapes_info_map_t& shapeInfo = shapes_info_map_t(),
+    const InputPlan* inputPlan = nullptr,
+    RequestInputPositions* requestInputPositions = nullptr);
 
 }  // namespace request_validation_utils
 }  // namespace ovms
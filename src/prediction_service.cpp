@@ -27,6 +27,7 @@
 #include "tensorflow/core/framework/tensor.h"
 #pragma GCC diagnostic pop
 
+#include "access_log.hpp"
 #include "execution_context.hpp"
 #include "get_model_metadata_impl.hpp"
 #include "grpc_utils.hpp"
@@ -37,6 +38,7 @@
 #include "pipeline.hpp"
 #include "prediction_service_utils.hpp"
 #include "profiler.hpp"
+#include "request_scope.hpp"
 #include "servablemanagermodule.hpp"
 #include "server.hpp"
 #include "status.hpp"
@@ -84,10 +86,12 @@ Status PredictionServiceImpl::getPipeline(const PredictRequest* request,
     return this->modelManager.createPipeline(pipelinePtr, request->model_spec().name(), request, response);
 }
 
+// TODO messages of synchronous service are allocated by gRPC, placing them on ProtobufArenaPool arenas requires callback service with message allocator
 grpc::Status ovms::PredictionServiceImpl::Predict(
     ServerContext* context,
     const PredictRequest* request,
     PredictResponse* response) {
+    OVMS_PROFILE_REQUEST("gRPC Predict");
     OVMS_PROFILE_FUNCTION();
     Timer<TIMER_END> timer;
     timer.start(TOTAL);
@@ -100,7 +104,17 @@ grpc::Status ovms::PredictionServiceImpl::Predict(
     std::unique_ptr<ovms::Pipeline> pipelinePtr;
 
     std::unique_ptr<ModelInstanceUnloadGuard> modelInstanceUnloadGuard;
-    auto status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
+    Status status;
+    AccessLogRecord accessLog(ExecutionContext{ExecutionContext::Interface::GRPC, ExecutionContext::Method::Predict},
+        request->model_spec().name(), request->model_spec().version().value(), status);
+    RequestPriority priority = RequestScope::currentPriority();
+    status = getRequestPriority(context, priority);
+    if (!status.ok()) {
+        SPDLOG_DEBUG("Invalid request priority. {}", status.string());
+        return grpc(status);
+    }
+    RequestScope requestScope(priority, getRequestDeadline(context), getCancellationCheck(context));
+    status = getModelInstance(request, modelInstance, modelInstanceUnloadGuard);
 
     if (status == StatusCode::MODEL_NAME_MISSING) {
         SPDLOG_DEBUG("Requested model: {} does not exist. Searching for pipeline with that name...", request->model_spec().name());
@@ -119,4 +119,8 @@ bool useSharedOutputContent(const ::inference::ModelInferRequest* request) {
     return request->raw_input_contents().size() > 0;
 }
 
+bool useSharedOutputContent(const InferenceRequest* request) {
+    return true;
+}
+
 }  // namespace ovms
@@ -40,4 +40,5 @@ std::map<std::string, shape_t> getRequestShapes(const InferenceRequest* request)
 
 bool useSharedOutputContent(const tensorflow::serving::PredictRequest* request);
 bool useSharedOutputContent(const ::inference::ModelInferRequest* request);
+bool useSharedOutputContent(const InferenceRequest* request);
 }  // namespace ovms
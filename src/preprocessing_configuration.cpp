@@ -0,0 +1,200 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "preprocessing_configuration.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+
+#include "status.hpp"
+
+namespace ovms {
+
+static const std::unordered_map<std::string, ov::preprocess::ResizeAlgorithm> resizeAlgorithms{
+    {"linear", ov::preprocess::ResizeAlgorithm::RESIZE_LINEAR},
+    {"cubic", ov::preprocess::ResizeAlgorithm::RESIZE_CUBIC},
+    {"nearest", ov::preprocess::ResizeAlgorithm::RESIZE_NEAREST}};
+
+static const std::unordered_map<std::string, ov::preprocess::ColorFormat> colorFormats{
+    {"RGB", ov::preprocess::ColorFormat::RGB},
+    {"BGR", ov::preprocess::ColorFormat::BGR}};
+
+static Status parseValues(const rapidjson::Value& node, std::vector<float>& values) {
+    values.clear();
+    if (node.IsNumber()) {
+        values.push_back(node.GetFloat());
+        return StatusCode::OK;
+    }
+    if (!node.IsArray() || node.Size() == 0) {
+        return StatusCode::PREPROCESSING_WRONG_FORMAT;
+    }
+    for (const auto& value : node.GetArray()) {
+        if (!value.IsNumber()) {
+            return StatusCode::PREPROCESSING_WRONG_FORMAT;
+        }
+        values.push_back(value.GetFloat());
+    }
+    return StatusCode::OK;
+}
+
+Precision PreprocessingConfiguration::getTensorPrecision() const {
+    return this->tensorPrecision;
+}
+
+const std::vector<float>& PreprocessingConfiguration::getMean() const {
+    return this->mean;
+}
+
+const std::vector<float>& PreprocessingConfiguration::getScale() const {
+    return this->scale;
+}
+
+const std::string& PreprocessingConfiguration::getResizeAlgorithm() const {
+    return this->resizeAlgorithm;
+}
+
+const std::string& PreprocessingConfiguration::getColorFormat() const {
+    return this->colorFormat;
+}
+
+const std::string& PreprocessingConfiguration::getModelColorFormat() const {
+    return this->modelColorFormat;
+}
+
+bool PreprocessingConfiguration::isSet() const {
+    return this->tensorPrecision != Precision::UNDEFINED ||
+           !this->mean.empty() ||
+           !this->scale.empty() ||
+           !this->resizeAlgorithm.empty() ||
+           !this->colorFormat.empty();
+}
+
+void PreprocessingConfiguration::apply(ov::preprocess::InputInfo& input) const {
+    if (this->tensorPrecision != Precision::UNDEFINED) {
+        input.tensor().set_element_type(ovmsPrecisionToIE2Precision(this->tensorPrecision));
+        // mean and scale are applied in floating point, conversion to model precision is added by OpenVINO at the end
+        if (!this->mean.empty() || !this->scale.empty()) {
+            input.preprocess().convert_element_type(ov::element::f32);
+        }
+    }
+    if (!this->colorFormat.empty()) {
+        input.tensor().set_color_format(colorFormats.at(this->colorFormat));
+        input.preprocess().convert_color(colorFormats.at(this->modelColorFormat));
+    }
+    if (!this->resizeAlgorithm.empty()) {
+        input.tensor().set_spatial_dynamic_shape();
+        input.preprocess().resize(resizeAlgorithms.at(this->resizeAlgorithm));
+    }
+    if (!this->mean.empty()) {
+        input.preprocess().mean(this->mean);
+    }
+    if (!this->scale.empty()) {
+        input.preprocess().scale(this->scale);
+    }
+}
+
+bool PreprocessingConfiguration::operator==(const PreprocessingConfiguration& rhs) const {
+    return this->tensorPrecision == rhs.tensorPrecision &&
+           this->mean == rhs.mean &&
+           this->scale == rhs.scale &&
+           this->resizeAlgorithm == rhs.resizeAlgorithm &&
+           this->colorFormat == rhs.colorFormat &&
+           this->modelColorFormat == rhs.modelColorFormat;
+}
+
+bool PreprocessingConfiguration::operator!=(const PreprocessingConfiguration& rhs) const {
+    return !(*this == rhs);
+}
+
+Status PreprocessingConfiguration::fromJson(const rapidjson::Value& node, PreprocessingConfiguration& configOut) {
+    if (!node.IsObject()) {
+        return StatusCode::PREPROCESSING_WRONG_FORMAT;
+    }
+    PreprocessingConfiguration config;
+    for (auto it = node.MemberBegin(); it != node.MemberEnd(); ++it) {
+        std::string key = it->name.GetString();
+        const rapidjson::Value& value = it->value;
+        if (key == "mean" || key == "scale") {
+            auto& values = (key == "mean") ? config.mean : config.scale;
+            auto status = parseValues(value, values);
+            if (!status.ok()) {
+                return status;
+            }
+            continue;
+        }
+        if (!value.IsString()) {
+            return StatusCode::PREPROCESSING_WRONG_FORMAT;
+        }
+        std::string str = value.GetString();
+        if (key == "tensor_element_type") {
+            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+            config.tensorPrecision = fromString(str);
+            if (config.tensorPrecision == Precision::UNDEFINED) {
+                return StatusCode::PREPROCESSING_WRONG_FORMAT;
+            }
+        } else if (key == "resize") {
+            std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+            if (resizeAlgorithms.count(str) == 0) {
+                return StatusCode::PREPROCESSING_WRONG_FORMAT;
+            }
+            config.resizeAlgorithm = str;
+        } else if (key == "color_format" || key == "model_color_format") {
+            std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+            if (colorFormats.count(str) == 0) {
+                return StatusCode::PREPROCESSING_WRONG_FORMAT;
+            }
+            (key == "color_format" ? config.colorFormat : config.modelColorFormat) = str;
+        } else {
+            return StatusCode::PREPROCESSING_WRONG_FORMAT;
+        }
+    }
+    if (config.colorFormat.empty() != config.modelColorFormat.empty()) {
+        return StatusCode::PREPROCESSING_WRONG_FORMAT;
+    }
+    if (std::find(config.scale.begin(), config.scale.end(), 0.0f) != config.scale.end()) {
+        return StatusCode::PREPROCESSING_WRONG_FORMAT;
+    }
+    configOut = config;
+    return StatusCode::OK;
+}
+
+std::string PreprocessingConfiguration::toString() const {
+    std::stringstream ss;
+    if (this->tensorPrecision != Precision::UNDEFINED) {
+        ss << "tensor element type: " << ovms::toString(this->tensorPrecision) << " ";
+    }
+    if (!this->colorFormat.empty()) {
+        ss << "color format: " << this->colorFormat << " -> " << this->modelColorFormat << " ";
+    }
+    if (!this->resizeAlgorithm.empty()) {
+        ss << "resize: " << this->resizeAlgorithm << " ";
+    }
+    auto printValues = [&ss](const std::string& name, const std::vector<float>& values) {
+        if (values.empty()) {
+            return;
+        }
+        ss << name << ": [";
+        for (size_t i = 0; i < values.size(); ++i) {
+            ss << (i == 0 ? "" : ",") << values[i];
+        }
+        ss << "] ";
+    };
+    printValues("mean", this->mean);
+    printValues("scale", this->scale);
+    return ss.str();
+}
+
+}  // namespace ovms
@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+#include <rapidjson/document.h>
+
+#include "precision.hpp"
+
+namespace ovms {
+
+class Status;
+
+/**
+ * @brief Preprocessing of single model input compiled into the model graph with ov::preprocess::PrePostProcessor,
+ * so OpenVINO can fuse it with the first layers instead of converting data on the host.
+ */
+class PreprocessingConfiguration {
+    Precision tensorPrecision = Precision::UNDEFINED;
+    std::vector<float> mean;
+    std::vector<float> scale;
+    std::string resizeAlgorithm;
+    std::string colorFormat;
+    std::string modelColorFormat;
+
+public:
+    PreprocessingConfiguration() = default;
+
+    Precision getTensorPrecision() const;
+    const std::vector<float>& getMean() const;
+    const std::vector<float>& getScale() const;
+    const std::string& getResizeAlgorithm() const;
+    const std::string& getColorFormat() const;
+    const std::string& getModelColorFormat() const;
+
+    bool isSet() const;
+
+    /**
+     * @brief Adds preprocessing steps to model input. Resize and color conversion require tensor layout with H, W and C dimensions.
+     */
+    void apply(ov::preprocess::InputInfo& input) const;
+
+    bool operator==(const PreprocessingConfiguration& rhs) const;
+    bool operator!=(const PreprocessingConfiguration& rhs) const;
+
+    static Status fromJson(const rapidjson::Value& node, PreprocessingConfiguration& configOut);
+    std::string toString() const;
+};
+
+using preprocessing_configurations_map_t = std::unordered_map<std::string, PreprocessingConfiguration>;
+
+}  // namespace ovms
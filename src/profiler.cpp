@@ -17,6 +17,15 @@
 
 #include <stdio.h>
 
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "timer.hpp"
+
 namespace ovms {
 
 bool profiler_init(const char* file_path) {
@@ -53,4 +62,188 @@ bool Profiler::isInitialized() const {
     return this->initialized;
 }
 
+struct SampledTracer::ThreadBuffer {
+    struct Event {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> ticks{0};
+        std::atomic<uint64_t> requestId{0};
+        std::atomic<char> phase{0};
+    };
+
+    const size_t threadIndex;
+    std::atomic<uint64_t> writeIndex{0};
+    // events before this index are not dumped, set by clear() so that it does not write to events
+    std::atomic<uint64_t> clearedIndex{0};
+    std::vector<Event> events;
+
+    ThreadBuffer(size_t threadIndex) :
+        threadIndex(threadIndex),
+        events(THREAD_BUFFER_CAPACITY) {}
+
+    // Only the owning thread writes, readers validate copied events against writeIndex
+    void push(const char* name, char phase, uint64_t requestId) {
+        uint64_t index = this->writeIndex.load(std::memory_order_relaxed);
+        Event& event = this->events[index % THREAD_BUFFER_CAPACITY];
+        event.name.store(name, std::memory_order_relaxed);
+        event.ticks.store(TickClock::now(), std::memory_order_relaxed);
+        event.requestId.store(requestId, std::memory_order_relaxed);
+        event.phase.store(phase, std::memory_order_relaxed);
+        this->writeIndex.store(index + 1, std::memory_order_release);
+    }
+};
+
+SampledTracer& SampledTracer::instance() {
+    static SampledTracer instance;
+    return instance;
+}
+
+void SampledTracer::configure(bool enabled, uint32_t samplingRate, uint32_t retentionSeconds) {
+    this->samplingRate.store(std::max(samplingRate, 1u), std::memory_order_relaxed);
+    this->retentionSeconds.store(std::max(retentionSeconds, 1u), std::memory_order_relaxed);
+    this->enabled.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t SampledTracer::sampleRequest() {
+    if (!this->isEnabled()) {
+        return 0;
+    }
+    if (this->requestsCounter.fetch_add(1, std::memory_order_relaxed) % this->getSamplingRate() != 0) {
+        return 0;
+    }
+    return this->lastRequestId.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+SampledTracer::ThreadBuffer& SampledTracer::getThreadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+    if (!threadBuffer) {
+        std::lock_guard<std::mutex> lock(this->buffersMtx);
+        threadBuffer = std::make_shared<ThreadBuffer>(this->buffers.size());
+        this->buffers.emplace_back(threadBuffer);
+    }
+    return *threadBuffer;
+}
+
+void SampledTracer::recordEvent(const char* name, char phase) {
+    this->getThreadBuffer().push(name, phase, currentRequestId);
+}
+
+void SampledTracer::clear() {
+    std::lock_guard<std::mutex> lock(this->buffersMtx);
+    for (auto& buffer : this->buffers) {
+        buffer->clearedIndex.store(buffer->writeIndex.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+std::string SampledTracer::dump() const {
+    struct DumpedEvent {
+        const char* name;
+        uint64_t ticks;
+        uint64_t requestId;
+        char phase;
+        size_t threadIndex;
+    };
+    std::vector<DumpedEvent> dumped;
+    const uint64_t now = TickClock::now();
+    const auto retention = std::chrono::seconds(this->getRetentionSeconds());
+    {
+        std::lock_guard<std::mutex> lock(this->buffersMtx);
+        for (auto& buffer : this->buffers) {
+            const uint64_t end = buffer->writeIndex.load(std::memory_order_acquire);
+            const uint64_t begin = std::max(end > THREAD_BUFFER_CAPACITY ? end - THREAD_BUFFER_CAPACITY : 0,
+                buffer->clearedIndex.load(std::memory_order_relaxed));
+            size_t firstCopied = dumped.size();
+            std::vector<uint64_t> indexes;
+            for (uint64_t i = begin; i < end; i++) {
+                auto& event = buffer->events[i % THREAD_BUFFER_CAPACITY];
+                uint64_t requestId = event.requestId.load(std::memory_order_relaxed);
+                uint64_t ticks = event.ticks.load(std::memory_order_relaxed);
+                if (requestId == 0 || ticks > now || TickClock::toDuration(now - ticks) > retention) {
+                    continue;
+                }
+                dumped.push_back({event.name.load(std::memory_order_relaxed), ticks, requestId,
+                    event.phase.load(std::memory_order_relaxed), buffer->threadIndex});
+                indexes.push_back(i);
+            }
+            // Drop events overwritten by the owning thread while copying. Slot of index endAfterCopy - CAPACITY
+            // may be being rewritten with the next event, so it is dropped as well.
+            const uint64_t endAfterCopy = buffer->writeIndex.load(std::memory_order_acquire);
+            const uint64_t firstValid = endAfterCopy >= THREAD_BUFFER_CAPACITY ? endAfterCopy - THREAD_BUFFER_CAPACITY + 1 : 0;
+            size_t kept = firstCopied;
+            for (size_t i = 0; i < indexes.size(); i++) {
+                if (indexes[i] >= firstValid) {
+                    dumped[kept++] = dumped[firstCopied + i];
+                }
+            }
+            dumped.resize(kept);
+        }
+        // Buffers of finished threads are released once they hold nothing worth dumping
+        this->buffers.erase(std::remove_if(this->buffers.begin(), this->buffers.end(),
+                                [&](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                    if (buffer.use_count() > 1) {
+                                        return false;
+                                    }
+                                    uint64_t end = buffer->writeIndex.load(std::memory_order_acquire);
+                                    if (end == buffer->clearedIndex.load(std::memory_order_relaxed)) {
+                                        return true;
+                                    }
+                                    uint64_t ticks = buffer->events[(end - 1) % THREAD_BUFFER_CAPACITY].ticks.load(std::memory_order_relaxed);
+                                    return TickClock::toDuration(now - ticks) > retention;
+                                }),
+            this->buffers.end());
+    }
+    uint64_t baseTicks = now;
+    for (auto& event : dumped) {
+        baseTicks = std::min(baseTicks, event.ticks);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writer.StartObject();
+    writer.Key("traceEvents");
+    writer.StartArray();
+    for (auto& event : dumped) {
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(event.name);
+        writer.Key("cat");
+        writer.String("OVMS");
+        writer.Key("ph");
+        writer.String(&event.phase, 1);
+        writer.Key("ts");
+        writer.Double(std::chrono::duration_cast<std::chrono::nanoseconds>(TickClock::toDuration(event.ticks - baseTicks)).count() / 1000.0);
+        writer.Key("pid");
+        writer.Uint(1);
+        writer.Key("tid");
+        writer.Uint64(event.threadIndex);
+        writer.Key("args");
+        writer.StartObject();
+        writer.Key("request_id");
+        writer.Uint64(event.requestId);
+        writer.EndObject();
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+    return buffer.GetString();
+}
+
+SampledTraceRequestGuard::SampledTraceRequestGuard(const char* name) :
+    previousRequestId(SampledTracer::currentRequestId),
+    name(name) {
+    if (this->previousRequestId != 0) {
+        this->name = nullptr;
+        return;
+    }
+    SampledTracer::currentRequestId = SampledTracer::instance().sampleRequest();
+    SampledTracer::record(this->name, 'B');
+}
+
+SampledTraceRequestGuard::~SampledTraceRequestGuard() {
+    if (this->name == nullptr) {
+        return;
+    }
+    SampledTracer::record(this->name, 'E');
+    SampledTracer::currentRequestId = this->previousRequestId;
+}
+
 }  // namespace ovms
@@ -15,18 +15,42 @@
 //*****************************************************************************
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <vector>
 
 #include "minitrace.h"  // NOLINT
 
-#define OVMS_PROFILE_SCOPE(name) MTR_SCOPE("OVMS", name);
-#define OVMS_PROFILE_SCOPE_S(name, vname, cstr) MTR_SCOPE_S("OVMS", name, vname, cstr);
+#define OVMS_PROFILE_CONCAT_IMPL(a, b) a##b
+#define OVMS_PROFILE_CONCAT(a, b) OVMS_PROFILE_CONCAT_IMPL(a, b)
+
+#define OVMS_PROFILE_SCOPE(name) \
+    MTR_SCOPE("OVMS", name);     \
+    ovms::SampledTraceScope OVMS_PROFILE_CONCAT(ovmsSampledTraceScope, __LINE__)(name);
+#define OVMS_PROFILE_SCOPE_S(name, vname, cstr) \
+    MTR_SCOPE_S("OVMS", name, vname, cstr);     \
+    ovms::SampledTraceScope OVMS_PROFILE_CONCAT(ovmsSampledTraceScope, __LINE__)(name);
 #define OVMS_PROFILE_FUNCTION() OVMS_PROFILE_SCOPE(__PRETTY_FUNCTION__)
 
-#define OVMS_PROFILE_SYNC_BEGIN(name) MTR_BEGIN("OVMS", name);
-#define OVMS_PROFILE_SYNC_END(name) MTR_END("OVMS", name);
-#define OVMS_PROFILE_SYNC_BEGIN_S(name, vname, cstr) MTR_BEGIN_S("OVMS", name, vname, cstr);
-#define OVMS_PROFILE_SYNC_END_S(name, vname, cstr) MTR_END_S("OVMS", name, vname, cstr);
+#define OVMS_PROFILE_SYNC_BEGIN(name) \
+    MTR_BEGIN("OVMS", name);          \
+    ovms::SampledTracer::record(name, 'B');
+#define OVMS_PROFILE_SYNC_END(name) \
+    MTR_END("OVMS", name);          \
+    ovms::SampledTracer::record(name, 'E');
+#define OVMS_PROFILE_SYNC_BEGIN_S(name, vname, cstr) \
+    MTR_BEGIN_S("OVMS", name, vname, cstr);          \
+    ovms::SampledTracer::record(name, 'B');
+#define OVMS_PROFILE_SYNC_END_S(name, vname, cstr) \
+    MTR_END_S("OVMS", name, vname, cstr);          \
+    ovms::SampledTracer::record(name, 'E');
+
+// Marks the entry point of a request which may be picked for sampled tracing
+#define OVMS_PROFILE_REQUEST(name) \
+    ovms::SampledTraceRequestGuard OVMS_PROFILE_CONCAT(ovmsSampledTraceRequest, __LINE__)(name);
 
 #define OVMS_PROFILE_ASYNC_BEGIN(name, id) MTR_START("OVMS", name, id);
 #define OVMS_PROFILE_ASYNC_END(name, id) MTR_FINISH("OVMS", name, id);
@@ -46,4 +70,101 @@ private:
     bool initialized = false;
 };
 
+/**
+ * @brief Runtime controlled profiler tracing 1 in N requests end to end.
+ *
+ * Unlike minitrace it is always compiled in. Events of sampled requests are stored in
+ * per-thread ring buffers without locking, and only events from the last retention
+ * period are dumped in Chrome trace format on demand.
+ */
+class SampledTracer {
+public:
+    static constexpr uint32_t DEFAULT_SAMPLING_RATE = 100;
+    static constexpr uint32_t DEFAULT_RETENTION_SECONDS = 10;
+    static constexpr size_t THREAD_BUFFER_CAPACITY = 16384;
+
+    static SampledTracer& instance();
+
+    void configure(bool enabled, uint32_t samplingRate, uint32_t retentionSeconds);
+    bool isEnabled() const { return this->enabled.load(std::memory_order_relaxed); }
+    uint32_t getSamplingRate() const { return this->samplingRate.load(std::memory_order_relaxed); }
+    uint32_t getRetentionSeconds() const { return this->retentionSeconds.load(std::memory_order_relaxed); }
+
+    // Returns id of a new traced request or 0 when the request is not sampled
+    uint64_t sampleRequest();
+    std::string dump() const;
+    void clear();
+
+    static inline void record(const char* name, char phase) {
+        if (currentRequestId == 0) {
+            return;
+        }
+        instance().recordEvent(name, phase);
+    }
+
+    inline static thread_local uint64_t currentRequestId = 0;
+
+private:
+    struct ThreadBuffer;
+
+    SampledTracer() = default;
+    void recordEvent(const char* name, char phase);
+    ThreadBuffer& getThreadBuffer();
+
+    std::atomic<bool> enabled{false};
+    std::atomic<uint32_t> samplingRate{DEFAULT_SAMPLING_RATE};
+    std::atomic<uint32_t> retentionSeconds{DEFAULT_RETENTION_SECONDS};
+    std::atomic<uint64_t> requestsCounter{0};
+    std::atomic<uint64_t> lastRequestId{0};
+
+    mutable std::mutex buffersMtx;
+    mutable std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+};
+
+class SampledTraceRequestGuard {
+    uint64_t previousRequestId;
+    const char* name;
+
+public:
+    SampledTraceRequestGuard(const char* name);
+    ~SampledTraceRequestGuard();
+};
+
+/**
+ * @brief Continues tracing of a request on another thread, e.g. a worker or completion thread the request is handed over to
+ *
+ * @param requestId value of SampledTracer::currentRequestId captured on the thread handing the request over
+ */
+class SampledTraceContinuation {
+    uint64_t previousRequestId;
+
+public:
+    explicit SampledTraceContinuation(uint64_t requestId) :
+        previousRequestId(SampledTracer::currentRequestId) {
+        SampledTracer::currentRequestId = requestId;
+    }
+    ~SampledTraceContinuation() {
+        SampledTracer::currentRequestId = this->previousRequestId;
+    }
+};
+
+class SampledTraceScope {
+    const char* name;
+    bool active;
+
+public:
+    SampledTraceScope(const char* name) :
+        name(name),
+        active(SampledTracer::currentRequestId != 0) {
+        if (this->active) {
+            SampledTracer::record(this->name, 'B');
+        }
+    }
+    ~SampledTraceScope() {
+        if (this->active) {
+            SampledTracer::record(this->name, 'E');
+        }
+    }
+};
+
 }  // namespace ovms
@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "protobuf_arena_pool.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace ovms {
+
+namespace {
+google::protobuf::ArenaOptions makeArenaOptions(char* initialBlock) {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = initialBlock;
+    options.initial_block_size = ProtobufArenaPool::INITIAL_BLOCK_SIZE;
+    return options;
+}
+
+std::vector<std::unique_ptr<PooledArena>>& getThreadPool() {
+    thread_local std::vector<std::unique_ptr<PooledArena>> pool;
+    return pool;
+}
+}  // namespace
+
+PooledArena::PooledArena() :
+    initialBlock(new char[ProtobufArenaPool::INITIAL_BLOCK_SIZE]),
+    arena(makeArenaOptions(initialBlock.get())) {}
+
+ProtobufArenaPool::Lease::Lease(std::unique_ptr<PooledArena> pooledArena) :
+    pooledArena(std::move(pooledArena)) {}
+
+ProtobufArenaPool::Lease::~Lease() {
+    if (!this->pooledArena) {
+        return;
+    }
+    // frees all messages and blocks allocated on top of the initial one
+    this->pooledArena->arena.Reset();
+    auto& pool = getThreadPool();
+    if (pool.size() < MAX_POOLED_ARENAS_PER_THREAD) {
+        pool.emplace_back(std::move(this->pooledArena));
+    }
+}
+
+ProtobufArenaPool::Lease ProtobufArenaPool::acquire() {
+    auto& pool = getThreadPool();
+    if (pool.empty()) {
+        return Lease(std::make_unique<PooledArena>());
+    }
+    std::unique_ptr<PooledArena> pooledArena = std::move(pool.back());
+    pool.pop_back();
+    return Lease(std::move(pooledArena));
+}
+
+size_t ProtobufArenaPool::getPooledArenasCount() {
+    return getThreadPool().size();
+}
+}  // namespace ovms
@@ -0,0 +1,99 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include <google/protobuf/arena.h>
+
+namespace ovms {
+
+/**
+ * @brief Deletes message only if it was allocated on heap. Messages created on arena are freed with the arena.
+ */
+template <typename T>
+struct ArenaMessageDeleter {
+    void operator()(T* message) const {
+        if (message != nullptr && message->GetArena() == nullptr) {
+            delete message;
+        }
+    }
+};
+
+template <typename T>
+using ArenaMessagePtr = std::unique_ptr<T, ArenaMessageDeleter<T>>;
+
+/**
+ * @brief Creates message on arena or on heap if arena is nullptr
+ */
+template <typename T>
+ArenaMessagePtr<T> createArenaMessage(google::protobuf::Arena* arena) {
+    return ArenaMessagePtr<T>(google::protobuf::Arena::CreateMessage<T>(arena));
+}
+
+struct PooledArena {
+    std::unique_ptr<char[]> initialBlock;
+    google::protobuf::Arena arena;
+
+    PooledArena();
+};
+
+/**
+ * @brief Thread local pool of protobuf arenas for request and response messages.
+ *
+ * Messages created on leased arena are freed all at once when the lease is destroyed.
+ * Arena is then reset and returned to the pool of the thread, so that its initial block
+ * is reused by the next request handled by the same thread.
+ */
+class ProtobufArenaPool {
+public:
+    static constexpr size_t INITIAL_BLOCK_SIZE = 64 * 1024;
+    static constexpr size_t MAX_POOLED_ARENAS_PER_THREAD = 4;
+
+    class Lease {
+        std::unique_ptr<PooledArena> pooledArena;
+
+    public:
+        Lease(std::unique_ptr<PooledArena> pooledArena);
+        Lease(Lease&&) = default;
+        Lease& operator=(Lease&&) = delete;
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        ~Lease();
+
+        google::protobuf::Arena* get() { return &this->pooledArena->arena; }
+
+        /**
+         * @brief Creates message owned by leased arena
+         */
+        template <typename T>
+        T* create() {
+            return google::protobuf::Arena::CreateMessage<T>(this->get());
+        }
+    };
+
+    /**
+     * @brief Leases arena from the pool of the calling thread or creates new one if pool is empty
+     */
+    static Lease acquire();
+
+    /**
+     * @brief Number of arenas available in the pool of the calling thread
+     */
+    static size_t getPooledArenasCount();
+};
+}  // namespace ovms
@@ -17,7 +17,11 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
 #include <future>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -35,16 +39,38 @@ class Queue {
 public:
     /**
     * @brief Allocating idle stream for execution
+    *
+    * When there is no idle stream the caller waits for one. Waiters with higher priority are served first,
+    * waiters with the same priority in FIFO order.
     */
-    std::future<int> getIdleStream() {
+    std::future<int> getIdleStream(int priority = 0) {
+        uint64_t waiterId;
+        return std::move(getIdleStream(priority, 0, waiterId).value());
+    }
+
+    /**
+    * @brief Allocating idle stream for execution with limited number of waiters
+    *
+    * @param maxWaiting maximum number of waiters, 0 for unlimited
+    * @param waiterId set to id used to cancel waiting, 0 if idle stream was given right away
+    *
+    * @return std::nullopt if there is no idle stream and maxWaiting callers already wait
+    */
+    std::optional<std::future<int>> getIdleStream(int priority, size_t maxWaiting, uint64_t& waiterId) {
         // OVMS_PROFILE_FUNCTION();
         int value;
         std::promise<int> idleStreamPromise;
         std::future<int> idleStreamFuture = idleStreamPromise.get_future();
+        waiterId = 0;
         std::unique_lock<std::mutex> lk(front_mut);
         if (streams[front_idx] < 0) {  // we need to wait for any idle stream to be returned
             std::unique_lock<std::mutex> queueLock(queue_mutex);
-            promises.push(std::move(idleStreamPromise));
+            if (maxWaiting > 0 && waitingCount >= maxWaiting) {
+                return std::nullopt;
+            }
+            waiterId = ++lastWaiterId;
+            promises[priority].emplace_back(waiterId, std::move(idleStreamPromise));
+            ++waitingCount;
         } else {  // we can give idle stream right away
             value = streams[front_idx];
             streams[front_idx] = -1;  // negative value indicate consumed vector index
@@ -55,6 +81,36 @@ public:
         return idleStreamFuture;
     }
 
+    /**
+    * @brief Stop waiting for idle stream
+    *
+    * @return false if stream has already been given to the waiter, it has to be taken from the future and returned then
+    */
+    bool cancelWaiting(int priority, uint64_t waiterId) {
+        std::unique_lock<std::mutex> lk(queue_mutex);
+        auto it = promises.find(priority);
+        if (it == promises.end()) {
+            return false;
+        }
+        auto& waiters = it->second;
+        for (auto waiter = waiters.begin(); waiter != waiters.end(); ++waiter) {
+            if (waiter->first == waiterId) {
+                waiters.erase(waiter);
+                if (waiters.empty()) {
+                    promises.erase(it);
+                }
+                --waitingCount;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t getWaitingCount() {
+        std::unique_lock<std::mutex> lk(queue_mutex);
+        return waitingCount;
+    }
+
     std::optional<int> tryToGetIdleStream() {
         // OVMS_PROFILE_FUNCTION();
         int value;
@@ -76,9 +132,14 @@ public:
     void returnStream(int streamID) {
         // OVMS_PROFILE_FUNCTION();
         std::unique_lock<std::mutex> lk(queue_mutex);
-        if (promises.size()) {
-            std::promise<int> promise = std::move(promises.front());
-            promises.pop();
+        if (!promises.empty()) {
+            auto highestPriorityWaiters = promises.begin();
+            std::promise<int> promise = std::move(highestPriorityWaiters->second.front().second);
+            highestPriorityWaiters->second.pop_front();
+            if (highestPriorityWaiters->second.empty()) {
+                promises.erase(highestPriorityWaiters);
+            }
+            --waitingCount;
             lk.unlock();
             promise.set_value(streamID);
             return;
@@ -136,6 +197,11 @@ protected:
      * 
      */
     std::vector<T> inferRequests;
-    std::queue<std::promise<int>> promises;
+    /**
+     * @brief Callers waiting for idle stream by priority, highest first
+     */
+    std::map<int, std::deque<std::pair<uint64_t, std::promise<int>>>, std::greater<int>> promises;
+    size_t waitingCount = 0;
+    uint64_t lastWaiterId = 0;
 };
 }  // namespace ovms
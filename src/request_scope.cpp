@@ -0,0 +1,95 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "request_scope.hpp"
+
+#include <strings.h>
+
+#include <utility>
+
+#include "status.hpp"
+
+namespace ovms {
+
+const std::string PRIORITY_HEADER = "ovms-priority";
+const std::string PRIORITY_PARAMETER = "priority";
+
+thread_local const RequestScope* RequestScope::currentScope = nullptr;
+
+const char* toString(RequestPriority priority) {
+    switch (priority) {
+    case RequestPriority::HIGH:
+        return "high";
+    case RequestPriority::NORMAL:
+        return "normal";
+    case RequestPriority::LOW:
+        return "low";
+    }
+    return "unknown";
+}
+
+Status parseRequestPriority(const std::string& value, RequestPriority& priority) {
+    for (auto candidate : REQUEST_PRIORITIES) {
+        if (strcasecmp(value.c_str(), toString(candidate)) == 0) {
+            priority = candidate;
+            return StatusCode::OK;
+        }
+    }
+    return StatusCode::INVALID_PRIORITY;
+}
+
+RequestScope::RequestScope(RequestPriority priority) :
+    previous(currentScope),
+    priority(priority) {
+    if (this->previous) {
+        this->deadline = this->previous->deadline;
+        this->isCancelled = this->previous->isCancelled;
+    }
+    currentScope = this;
+}
+
+RequestScope::RequestScope(RequestPriority priority, Deadline deadline, CancellationCheck isCancelled) :
+    previous(currentScope),
+    priority(priority),
+    deadline(std::move(deadline)),
+    isCancelled(std::move(isCancelled)) {
+    currentScope = this;
+}
+
+RequestScope::~RequestScope() {
+    currentScope = this->previous;
+}
+
+RequestPriority RequestScope::currentPriority() {
+    const RequestScope* scope = currentScope;
+    return scope ? scope->priority : RequestPriority::NORMAL;
+}
+
+Status RequestScope::check() const {
+    if (this->deadline && Clock::now() >= this->deadline.value()) {
+        return StatusCode::REQUEST_DEADLINE_EXCEEDED;
+    }
+    if (this->isCancelled && this->isCancelled()) {
+        return StatusCode::REQUEST_CANCELLED;
+    }
+    return StatusCode::OK;
+}
+
+Status RequestScope::checkCurrent() {
+    const RequestScope* scope = currentScope;
+    return scope ? scope->check() : StatusCode::OK;
+}
+
+}  // namespace ovms
@@ -0,0 +1,119 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace ovms {
+
+class Status;
+
+/**
+ * @brief Priority class of inference request, requests of higher class are served first when all infer requests of a model are busy
+ */
+enum class RequestPriority : int {
+    LOW = -1,
+    NORMAL = 0,
+    HIGH = 1,
+};
+
+constexpr std::array<RequestPriority, 3> REQUEST_PRIORITIES = {RequestPriority::HIGH, RequestPriority::NORMAL, RequestPriority::LOW};
+
+// gRPC metadata key and HTTP header
+extern const std::string PRIORITY_HEADER;
+// KServe request parameter
+extern const std::string PRIORITY_PARAMETER;
+
+const char* toString(RequestPriority priority);
+
+/**
+ * @brief Index of priority class in per class arrays, LOW is 0
+ */
+inline size_t toIndex(RequestPriority priority) {
+    return static_cast<size_t>(static_cast<int>(priority) - static_cast<int>(RequestPriority::LOW));
+}
+
+/**
+ * @brief Parses priority class name: high, normal or low, case insensitive
+ */
+Status parseRequestPriority(const std::string& value, RequestPriority& priority);
+
+/**
+ * @brief Binds scheduling parameters of the request being handled to the calling thread.
+ *
+ * ModelInstance and Pipeline read them when waiting for an infer request and between processing stages,
+ * so they do not have to be passed through every frontend and pipeline call. Nested scope (e.g. KServe parameter
+ * in a REST request with priority header) overrides the outer one until it goes out of scope.
+ */
+class RequestScope {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Deadline = std::optional<Clock::time_point>;
+    using CancellationCheck = std::function<bool()>;
+
+private:
+    static thread_local const RequestScope* currentScope;
+
+    const RequestScope* previous;
+    RequestPriority priority;
+    Deadline deadline;
+    CancellationCheck isCancelled;
+
+public:
+    /**
+     * @brief Scope with deadline and cancellation check inherited from the enclosing scope
+     */
+    explicit RequestScope(RequestPriority priority);
+    /**
+     * @param deadline point in time after which the client no longer waits for the response, std::nullopt for none
+     * @param isCancelled returns true when the client abandoned the request, may be empty
+     */
+    RequestScope(RequestPriority priority, Deadline deadline, CancellationCheck isCancelled);
+    ~RequestScope();
+
+    RequestScope(const RequestScope&) = delete;
+    RequestScope& operator=(const RequestScope&) = delete;
+
+    static const RequestScope* current() { return currentScope; }
+
+    /**
+     * @brief Priority of the request handled by the calling thread, NORMAL outside of request scope
+     */
+    static RequestPriority currentPriority();
+
+    RequestPriority getPriority() const { return this->priority; }
+    const Deadline& getDeadline() const { return this->deadline; }
+    bool isCancellable() const { return static_cast<bool>(this->isCancelled); }
+
+    /**
+     * @brief Checks whether the response is still awaited by the client
+     *
+     * @return REQUEST_DEADLINE_EXCEEDED, REQUEST_CANCELLED or OK
+     */
+    Status check() const;
+
+    /**
+     * @brief Checks request handled by the calling thread, OK outside of request scope
+     */
+    static Status checkCurrent();
+};
+
+}  // namespace ovms
@@ -19,17 +19,19 @@
 #include <string>
 
 #include "rest_utils.hpp"
+#include "shared_memory_manager.hpp"
 #include "status.hpp"
 #include "tfs_frontend/tfs_utils.hpp"
 
 namespace ovms {
 
-TFSRestParser::TFSRestParser(const tensor_map_t& tensors) {
+TFSRestParser::TFSRestParser(const tensor_map_t& tensors, google::protobuf::Arena* arena) :
+    requestProto(createArenaMessage<tensorflow::serving::PredictRequest>(arena)) {
     for (const auto& kv : tensors) {
         const auto& name = kv.first;
         const auto& tensor = kv.second;
         tensorPrecisionMap[name] = tensor->getPrecision();
-        auto& input = (*requestProto.mutable_inputs())[name];
+        auto& input = (*requestProto->mutable_inputs())[name];
         input.set_dtype(getPrecisionAsDataType(tensor->getPrecision()));
 
         auto fold = [](size_t a, const Dimension& b) {
@@ -52,8 +54,28 @@ TFSRestParser::TFSRestParser(const tensor_map_t& tensors) {
     }
 }
 
+TFSRestParser::TFSRestParser(const TFSRestParser& other) :
+    order(other.order),
+    format(other.format),
+    binaryDataOutput(other.binaryDataOutput),
+    requestProto(createArenaMessage<tensorflow::serving::PredictRequest>(nullptr)),
+    tensorPrecisionMap(other.tensorPrecisionMap) {
+    this->requestProto->CopyFrom(*other.requestProto);
+}
+
+TFSRestParser& TFSRestParser::operator=(const TFSRestParser& other) {
+    if (this != &other) {
+        this->order = other.order;
+        this->format = other.format;
+        this->binaryDataOutput = other.binaryDataOutput;
+        this->requestProto->CopyFrom(*other.requestProto);
+        this->tensorPrecisionMap = other.tensorPrecisionMap;
+    }
+    return *this;
+}
+
 void TFSRestParser::removeUnusedInputs() {
-    auto& inputs = (*requestProto.mutable_inputs());
+    auto& inputs = (*requestProto->mutable_inputs());
     auto it = inputs.begin();
     while (it != inputs.end()) {
         if (!it->second.tensor_shape().dim_size()) {
@@ -165,7 +187,7 @@ bool TFSRestParser::parseInstance(rapidjson::Value& doc) {
     }
     for (auto& itr : doc.GetObject()) {
         std::string tensorName = itr.name.GetString();
-        auto& proto = (*requestProto.mutable_inputs())[tensorName];
+        auto& proto = (*requestProto->mutable_inputs())[tensorName];
         increaseBatchSize(proto);
         if (!parseArray(itr.value, 1, proto, tensorName)) {
             return false;
@@ -176,7 +198,7 @@ bool TFSRestParser::parseInstance(rapidjson::Value& doc) {
 
 bool TFSRestParser::isBatchSizeEqualForAllInputs() const {
     int64_t size = 0;
-    for (const auto& kv : requestProto.inputs()) {
+    for (const auto& kv : requestProto->inputs()) {
         if (size == 0) {
             size = kv.second.tensor_shape().dim(0).size();
         } else if (kv.second.tensor_shape().dim(0).size() != size) {
@@ -207,11 +229,11 @@ Status TFSRestParser::parseRowFormat(rapidjson::Value& node) {
         }
     } else if (node.GetArray()[0].IsArray() || node.GetArray()[0].IsNumber() || isBinary(node.GetArray()[0])) {
         // no named format
-        if (requestProto.inputs_size() != 1) {
+        if (requestProto->inputs_size() != 1) {
             return StatusCode::REST_INPUT_NOT_PREALLOCATED;
         }
-        auto inputsIterator = requestProto.mutable_inputs()->begin();
-        if (inputsIterator == requestProto.mutable_inputs()->end()) {
+        auto inputsIterator = requestProto->mutable_inputs()->begin();
+        if (inputsIterator == requestProto->mutable_inputs()->end()) {
             const std::string details = "Failed to parse row formatted request.";
             SPDLOG_ERROR("Internal error occured: {}", details);
             return Status(StatusCode::INTERNAL_ERROR, details);
@@ -237,11 +259,11 @@ Status TFSRestParser::parseColumnFormat(rapidjson::Value& node) {
     order = Order::COLUMN;
     // no named format
     if (node.IsArray()) {
-        if (requestProto.inputs_size() != 1) {
+        if (requestProto->inputs_size() != 1) {
             return StatusCode::REST_INPUT_NOT_PREALLOCATED;
         }
-        auto inputsIterator = requestProto.mutable_inputs()->begin();
-        if (inputsIterator == requestProto.mutable_inputs()->end()) {
+        auto inputsIterator = requestProto->mutable_inputs()->begin();
+        if (inputsIterator == requestProto->mutable_inputs()->end()) {
             const std::string details = "Failed to parse column formatted request.";
             SPDLOG_ERROR("Internal error occured: {}", details);
             return Status(StatusCode::INTERNAL_ERROR, details);
@@ -261,7 +283,7 @@ Status TFSRestParser::parseColumnFormat(rapidjson::Value& node) {
     }
     for (auto& kv : node.GetObject()) {
         std::string tensorName = kv.name.GetString();
-        auto& proto = (*requestProto.mutable_inputs())[tensorName];
+        auto& proto = (*requestProto->mutable_inputs())[tensorName];
         if (!parseArray(kv.value, 0, proto, tensorName)) {
             return StatusCode::REST_COULD_NOT_PARSE_INPUT;
         }
@@ -279,6 +301,13 @@ Status TFSRestParser::parse(const char* json) {
     if (!doc.IsObject()) {
         return StatusCode::REST_BODY_IS_NOT_AN_OBJECT;
     }
+    auto binaryDataOutputItr = doc.FindMember("binary_data_output");
+    if (binaryDataOutputItr != doc.MemberEnd()) {
+        if (!binaryDataOutputItr->value.IsBool()) {
+            return StatusCode::REST_COULD_NOT_PARSE_PARAMETERS;
+        }
+        binaryDataOutput = binaryDataOutputItr->value.GetBool();
+    }
     auto instancesItr = doc.FindMember("instances");
     auto inputsItr = doc.FindMember("inputs");
     if (instancesItr != doc.MemberEnd() && inputsItr != doc.MemberEnd()) {
@@ -466,6 +495,13 @@ bool TFSRestParser::setDTypeIfNotSet(const rapidjson::Value& value, tensorflow::
     return true;
 }
 
+KFSRestParser::KFSRestParser() :
+    ownedRequestProto(createArenaMessage<::KFSRequest>(nullptr)),
+    requestProto(*ownedRequestProto) {}
+
+KFSRestParser::KFSRestParser(::KFSRequest& requestProto) :
+    requestProto(requestProto) {}
+
 Status KFSRestParser::parseId(rapidjson::Value& node) {
     if (!node.IsString()) {
         return StatusCode::REST_COULD_NOT_PARSE_INPUT;
@@ -490,9 +526,9 @@ Status KFSRestParser::parseId(rapidjson::Value& node) {
         } else if (parameter.value.IsBool()) {                                                                \
             auto requestParameters = PROTO.mutable_parameters();                                              \
             ((*requestParameters)[parameter.name.GetString()]).set_bool_param(parameter.value.GetBool());     \
-        } else if (parameter.value.IsInt()) {                                                                 \
+        } else if (parameter.value.IsInt64()) {                                                               \
             auto requestParameters = PROTO.mutable_parameters();                                              \
-            ((*requestParameters)[parameter.name.GetString()]).set_int64_param(parameter.value.GetInt());     \
+            ((*requestParameters)[parameter.name.GetString()]).set_int64_param(parameter.value.GetInt64());   \
         } else {                                                                                              \
             return StatusCode::REST_COULD_NOT_PARSE_PARAMETERS;                                               \
         }                                                                                                     \
@@ -512,7 +548,6 @@ Status KFSRestParser::parseOutput(rapidjson::Value& node) {
     if (!node.IsObject()) {
         return StatusCode::REST_COULD_NOT_PARSE_OUTPUT;
     }
-    requestProto.mutable_outputs()->Clear();
     auto output = requestProto.add_outputs();
     auto nameItr = node.FindMember("name");
     if ((nameItr == node.MemberEnd()) || !(nameItr->value.IsString())) {
@@ -534,6 +569,7 @@ Status KFSRestParser::parseOutputs(rapidjson::Value& node) {
     if (!node.IsArray()) {
         return StatusCode::REST_COULD_NOT_PARSE_INPUT;
     }
+    requestProto.mutable_outputs()->Clear();
     for (auto& output : node.GetArray()) {
         auto status = parseOutput(output);
         if (!status.ok()) {
@@ -648,6 +684,9 @@ Status KFSRestParser::parseInput(rapidjson::Value& node, bool onlyOneInput) {
         if (binary_data_size_parameter != input->parameters().end()) {
             return StatusCode::OK;
         }
+        if (input->parameters().find(SHARED_MEMORY_REGION_PARAMETER) != input->parameters().end()) {
+            return StatusCode::OK;
+        }
         return binaryDataSizeCanBeCalculated(*input, onlyOneInput);
     }
 }
@@ -28,6 +28,7 @@
 #include "kfs_frontend/kfs_grpc_inference_service.hpp"
 #pragma GCC diagnostic pop
 
+#include "protobuf_arena_pool.hpp"
 #include "tensorinfo.hpp"
 
 namespace ovms {
@@ -67,10 +68,15 @@ class TFSRestParser : RestParser {
      */
     Format format = Format::UNKNOWN;
 
+    /**
+     * @brief Whether outputs should be sent as raw bytes following JSON header
+     */
+    bool binaryDataOutput = false;
+
     /**
      * @brief Request proto
      */
-    tensorflow::serving::PredictRequest requestProto;
+    ArenaMessagePtr<tensorflow::serving::PredictRequest> requestProto;
 
     /**
      * @brief Request content precision
@@ -178,14 +184,20 @@ public:
      * 
      * @param tensors Tensor map with model input parameters
      */
-    TFSRestParser(const tensor_map_t& tensors);
+    TFSRestParser(const tensor_map_t& tensors, google::protobuf::Arena* arena = nullptr);
+
+    /**
+     * @brief Copies parser state, copied request proto is always allocated on heap
+     */
+    TFSRestParser(const TFSRestParser& other);
+    TFSRestParser& operator=(const TFSRestParser& other);
 
     /**
      * @brief Gets parsed request proto
      * 
      * @return proto
      */
-    tensorflow::serving::PredictRequest& getProto() { return requestProto; }
+    tensorflow::serving::PredictRequest& getProto() { return *requestProto; }
 
     /**
      * @brief Gets request order
@@ -201,6 +213,13 @@ public:
         return format;
     }
 
+    /**
+     * @brief Gets binary_data_output flag of the request
+     */
+    bool isBinaryDataOutputRequested() const {
+        return binaryDataOutput;
+    }
+
     /**
      * @brief Parses http request body string
      * 
@@ -211,6 +230,7 @@ public:
      * JSON expected to be passed in following structure:
      * {
      *     "signature_name": "serving_default",
+     *     "binary_data_output": false,
      *     "instances": [
      *         {...}, {...}, {...}, ...
      *     ]
@@ -220,7 +240,8 @@ public:
 };
 
 class KFSRestParser : RestParser {
-    ::KFSRequest requestProto;
+    ArenaMessagePtr<::KFSRequest> ownedRequestProto;
+    ::KFSRequest& requestProto;
     Status parseId(rapidjson::Value& node);
     Status parseRequestParameters(rapidjson::Value& node);
     Status parseInputParameters(rapidjson::Value& node, ::KFSRequest::InferInputTensor& input);
@@ -232,6 +253,12 @@ class KFSRestParser : RestParser {
     Status parseInputs(rapidjson::Value& node);
 
 public:
+    KFSRestParser();
+    /**
+     * @brief Parses directly into given request, e.g. created on protobuf arena, instead of owning one
+     */
+    KFSRestParser(::KFSRequest& requestProto);
+
     Status parse(const char* json);
     ::KFSRequest& getProto() { return requestProto; }
 };
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #include "rest_utils.hpp"
 
+#include <map>
 #include <set>
 
 #include <rapidjson/document.h>
@@ -31,6 +32,7 @@
 #pragma GCC diagnostic pop
 #include "kfs_frontend/kfs_utils.hpp"
 #include "precision.hpp"
+#include "shared_memory_manager.hpp"
 #include "src/kfserving_api/grpc_predict_v2.grpc.pb.h"
 #include "status.hpp"
 #include "tfs_frontend/tfs_utils.hpp"
@@ -205,6 +207,101 @@ Status makeJsonFromPredictResponse(
     return StatusCode::OK;
 }
 
+// KServe binary data extension representation of BYTES tensor: 4 bytes little endian length followed by content of each element
+static void appendBinaryStrings(std::string& bytesOutputsBuffer, const tensorflow::TensorProto& tensor) {
+    for (const auto& element : tensor.string_val()) {
+        uint32_t length = element.size();
+        for (size_t i = 0; i < sizeof(length); i++) {
+            bytesOutputsBuffer.push_back(static_cast<char>((length >> (8 * i)) & 0xFF));
+        }
+        bytesOutputsBuffer.append(element);
+    }
+}
+
+Status makeBinaryFromPredictResponse(
+    const PredictResponse& response_proto,
+    std::string* response,
+    std::optional<int>& inferenceHeaderContentLength) {
+    Timer<TIMER_END> timer;
+    using std::chrono::microseconds;
+    timer.start(CONVERT);
+
+    if (response_proto.outputs_size() == 0) {
+        SPDLOG_ERROR("Creating binary response from tensors failed: No outputs found.");
+        return StatusCode::REST_PROTO_TO_STRING_ERROR;
+    }
+    // outputs map has no stable iteration order, sort by name so offsets of binary data are reproducible
+    std::map<std::string, const tensorflow::TensorProto*> outputs;
+    for (const auto& [name, tensor] : response_proto.outputs()) {
+        outputs.emplace(name, &tensor);
+    }
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+    writer.SetFormatOptions(rapidjson::kFormatSingleLineArray);
+    writer.StartObject();
+    writer.Key("outputs");
+    writer.StartArray();
+    std::string bytesOutputsBuffer;
+    for (const auto& [name, tensorPtr] : outputs) {
+        const auto& tensor = *tensorPtr;
+        size_t expectedElementsNumber = 1;
+        for (int i = 0; i < tensor.tensor_shape().dim_size(); i++) {
+            expectedElementsNumber *= tensor.tensor_shape().dim(i).size();
+        }
+        std::string datatype = "BYTES";
+        size_t outputSize = bytesOutputsBuffer.size();
+        if (tensor.dtype() == DataType::DT_STRING) {
+            if (expectedElementsNumber > 0) {
+                auto status = checkValField(tensor.string_val_size(), expectedElementsNumber);
+                if (!status.ok())
+                    return status;
+            }
+            appendBinaryStrings(bytesOutputsBuffer, tensor);
+        } else {
+            datatype = ovmsPrecisionToKFSPrecision(TFSPrecisionToOvmsPrecision(tensor.dtype()));
+            if (datatype == "INVALID") {
+                return StatusCode::REST_UNSUPPORTED_PRECISION;
+            }
+            size_t expectedContentSize = expectedElementsNumber * DataTypeSize(tensor.dtype());
+            if (tensor.tensor_content().size() == 0 && expectedContentSize > 0)
+                return StatusCode::REST_SERIALIZE_NO_DATA;
+            if (tensor.tensor_content().size() != expectedContentSize)
+                return StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE;
+            bytesOutputsBuffer.append(tensor.tensor_content());
+        }
+        outputSize = bytesOutputsBuffer.size() - outputSize;
+
+        writer.StartObject();
+        writer.Key("name");
+        writer.String(name.c_str());
+        writer.Key("shape");
+        writer.StartArray();
+        for (int i = 0; i < tensor.tensor_shape().dim_size(); i++) {
+            writer.Int64(tensor.tensor_shape().dim(i).size());
+        }
+        writer.EndArray();
+        writer.Key("datatype");
+        writer.String(datatype.c_str());
+        writer.Key("parameters");
+        writer.StartObject();
+        writer.Key("binary_data_size");
+        writer.Int64(outputSize);
+        writer.EndObject();
+        writer.EndObject();
+    }
+    writer.EndArray();
+    writer.EndObject();
+
+    response->assign(buffer.GetString());
+    inferenceHeaderContentLength = response->length();
+    response->append(bytesOutputsBuffer);
+
+    timer.stop(CONVERT);
+    SPDLOG_DEBUG("GRPC to HTTP binary response conversion: {:.3f} ms", timer.elapsed<microseconds>(CONVERT) / 1000);
+    return StatusCode::OK;
+}
+
 static Status parseResponseParameters(const ::KFSResponse& response_proto, rapidjson::PrettyWriter<rapidjson::StringBuffer>& writer) {
     if (response_proto.parameters_size() > 0) {
         writer.Key("parameters");
@@ -217,7 +314,7 @@ static Status parseResponseParameters(const ::KFSResponse& response_proto, rapid
                 writer.Bool(protoParameter.second.bool_param());
                 break;
             case inference::InferParameter::ParameterChoiceCase::kInt64Param:
-                writer.Int(protoParameter.second.int64_param());
+                writer.Int64(protoParameter.second.int64_param());
                 break;
             case inference::InferParameter::ParameterChoiceCase::kStringParam:
                 writer.String(protoParameter.second.string_param().c_str());
@@ -304,6 +401,27 @@ static Status parseOutputs(const ::KFSResponse& response_proto, rapidjson::Prett
         }
         size_t expectedElementsNumber = dataTypeSize > 0 ? expectedContentSize / dataTypeSize : 0;
 
+        if (tensor.parameters().find(SHARED_MEMORY_REGION_PARAMETER) != tensor.parameters().end()) {
+            // data was placed in shared memory region, only its location is returned
+            writer.StartObject();
+            writer.Key("name");
+            writer.String(tensor.name().c_str());
+            writer.Key("shape");
+            writer.StartArray();
+            for (int i = 0; i < tensor.shape().size(); i++) {
+                writer.Int(tensor.shape().at(i));
+            }
+            writer.EndArray();
+            writer.Key("datatype");
+            writer.String(tensor.datatype().c_str());
+            auto status = parseOutputParameters(tensor, writer, 0);
+            if (!status.ok()) {
+                return status;
+            }
+            writer.EndObject();
+            tensor_it++;
+            continue;
+        }
         if (!seekDataInValField && (response_proto.raw_output_contents(tensor_it).size() != expectedContentSize))
             return StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE;
         writer.StartObject();
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <optional>
 #include <set>
 #include <string>
 
@@ -32,6 +33,17 @@ Status makeJsonFromPredictResponse(
     std::string* response_json,
     Order order);
 
+/**
+ * @brief Serializes TFS response as JSON header with outputs metadata followed by raw outputs data,
+ *        same as KServe binary data extension with binary_data_output request parameter
+ *
+ * @param inferenceHeaderContentLength set to size of JSON header
+ */
+Status makeBinaryFromPredictResponse(
+    const tensorflow::serving::PredictResponse& response_proto,
+    std::string* response,
+    std::optional<int>& inferenceHeaderContentLength);
+
 Status makeJsonFromPredictResponse(
     const ::KFSResponse& response_proto,
     std::string* response_json,
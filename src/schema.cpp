@@ -77,10 +77,37 @@ const char* MODELS_CONFIG_SCHEMA = R"({
 						"layout": {
 							"type": ["object", "string"]
 						},
+						"preprocess": {
+							"type": "object",
+							"additionalProperties": {
+								"type": "object",
+								"properties": {
+									"tensor_element_type": {"type": "string"},
+									"mean": {"type": ["number", "array"], "items": {"type": "number"}},
+									"scale": {"type": ["number", "array"], "items": {"type": "number"}},
+									"resize": {"type": "string"},
+									"color_format": {"type": "string"},
+									"model_color_format": {"type": "string"}
+								},
+								"additionalProperties": false
+							}
+						},
 						"nireq": {
 							"type": "integer",
 							"minimum": 0
 						},
+						"cpu_cores": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"max_queue_depth": {
+							"type": "integer",
+							"minimum": 0
+						},
+						"max_queue_wait_ms": {
+							"type": "integer",
+							"minimum": 0
+						},
 						"target_device": {
 							"type": "string"
 						},
@@ -15,6 +15,7 @@
 //*****************************************************************************
 #pragma once
 
+#include <cstring>
 #include <memory>
 #include <string>
 
@@ -27,7 +28,9 @@
 #include "tensorflow_serving/apis/prediction_service.grpc.pb.h"
 #pragma GCC diagnostic pop
 
+#include "buffer.hpp"
 #include "capi_frontend/capi_utils.hpp"
+#include "inferencerequest.hpp"
 #include "inferenceresponse.hpp"
 #include "inferencetensor.hpp"
 #include "kfs_frontend/kfs_grpc_inference_service.hpp"
@@ -151,7 +154,9 @@ Status serializePredictResponse(
     model_version_t servableVersion,
     const tensor_map_t& outputMap,
     InferenceResponse* response,
-    outputNameChooser_t outputNameChooser) {
+    outputNameChooser_t outputNameChooser,
+    const InferenceRequest* request = nullptr,
+    bool useSharedOutputContent = false) {
     OVMS_PROFILE_FUNCTION();
     Status status;
     uint32_t outputId = 0;
@@ -219,12 +224,52 @@ Status serializePredictResponse(
                 outputName, response->getServableName(), response->getServableVersion());
             return StatusCode::INTERNAL_ERROR;
         }
+        // Output buffer provided by the caller is referenced instead of copied.
+        // It already holds results if it was bound to infer request before inference.
+        const InferenceTensor* requestOutput{nullptr};
+        const Buffer* callerBuffer{nullptr};
+        if ((request != nullptr) && request->getOutput(outputInfo->getMappedName().c_str(), &requestOutput).ok()) {
+            callerBuffer = requestOutput->getBuffer();
+        }
+        // Pipeline results are owned by the session and are referenced instead of copied
+        if ((callerBuffer == nullptr) && useSharedOutputContent) {
+            outputTensor->removeBuffer();
+            outputTensor->setBuffer(
+                tensor.data(),
+                tensor.get_byte_size(),
+                OVMS_BUFFERTYPE_CPU,
+                std::nullopt);
+            outputTensor->setSharedTensor(tensor);
+            continue;
+        }
+        // Output recycled from previous inference of the pooled response keeps its buffer
+        if (callerBuffer == nullptr) {
+            if ((outputTensor->getBuffer() != nullptr) && outputTensor->refillBuffer(tensor.data(), tensor.get_byte_size()).ok()) {
+                continue;
+            }
+            outputTensor->removeBuffer();
+            outputTensor->setBuffer(
+                tensor.data(),
+                tensor.get_byte_size(),
+                OVMS_BUFFERTYPE_CPU,
+                std::nullopt,
+                true);
+            continue;
+        }
+        if (callerBuffer->getByteSize() != tensor.get_byte_size()) {
+            SPDLOG_DEBUG("Cannot serialize output with name:{} for servable name:{}; version:{}; error: output buffer size: {} does not match result size: {}",
+                outputName, response->getServableName(), response->getServableVersion(), callerBuffer->getByteSize(), tensor.get_byte_size());
+            return StatusCode::INVALID_CONTENT_SIZE;
+        }
+        if (callerBuffer->data() != tensor.data()) {
+            std::memcpy(const_cast<void*>(callerBuffer->data()), tensor.data(), tensor.get_byte_size());
+        }
+        outputTensor->removeBuffer();
         outputTensor->setBuffer(
-            tensor.data(),
-            tensor.get_byte_size(),
-            OVMS_BUFFERTYPE_CPU,
-            std::nullopt,
-            true);
+            callerBuffer->data(),
+            callerBuffer->getByteSize(),
+            callerBuffer->getBufferType(),
+            callerBuffer->getDeviceId());
     }
     return StatusCode::OK;
 }
@@ -103,8 +103,11 @@ static void logConfig(const Config& config) {
     SPDLOG_DEBUG("gRPC channel arguments: {}", config.grpcChannelArguments());
     SPDLOG_DEBUG("log level: {}", config.logLevel());
     SPDLOG_DEBUG("log path: {}", config.logPath());
+    SPDLOG_DEBUG("async logging: {}", config.asyncLogging());
+    SPDLOG_DEBUG("access log path: {}", config.accessLogPath());
     SPDLOG_DEBUG("file system poll wait seconds: {}", config.filesystemPollWaitSeconds());
     SPDLOG_DEBUG("sequence cleaner poll wait minutes: {}", config.sequenceCleanerPollWaitMinutes());
+    SPDLOG_DEBUG("models memory budget MB: {}", config.modelsMemoryBudgetMb());
 }
 
 static void onInterrupt(int status) {
@@ -366,7 +369,12 @@ Status Server::start(ServerSettingsImpl* serverSettings, ModelsSettingsImpl* mod
         auto& config = ovms::Config::instance();
         if (!config.parse(serverSettings, modelsSettings))
             return StatusCode::OPTIONS_USAGE_ERROR;
-        configure_logger(config.logLevel(), config.logPath());
+        LoggingSettings loggingSettings;
+        loggingSettings.async = config.asyncLogging();
+        loggingSettings.asyncQueueSize = config.asyncLoggingQueueSize();
+        loggingSettings.asyncOverflowPolicy = config.asyncLoggingOverflowPolicy();
+        loggingSettings.accessLogPath = config.accessLogPath();
+        configure_logger(config.logLevel(), config.logPath(), loggingSettings);
         logConfig(config);
         return this->startModules(config);
     } catch (std::exception& e) {
@@ -27,11 +27,20 @@ struct ServerSettingsImpl {
     std::string grpcBindAddress = "0.0.0.0";
     std::optional<uint32_t> restWorkers;
     std::string restBindAddress = "0.0.0.0";
+    uint32_t restCompressionThreshold = 1024;
+    uint32_t restEventLoops = 1;
+    uint64_t restMaxBodySize = 1024 * 1024 * 1024;
+    uint32_t restMaxConcurrentRequests = 0;
+    bool sharedMemoryEnabled = false;
     bool metricsEnabled = false;
     std::string metricsList;
     std::string cpuExtensionLibraryPath;
     std::string logLevel = "INFO";
     std::string logPath;
+    bool asyncLogging = false;
+    uint32_t asyncLoggingQueueSize = 8192;
+    std::string asyncLoggingOverflowPolicy = "block";
+    std::string accessLogPath;
 #ifdef MTR_ENABLED
     std::string tracePath;
 #endif
@@ -40,6 +49,7 @@ struct ServerSettingsImpl {
     uint32_t sequenceCleanerPollWaitMinutes = 5;
     uint32_t resourcesCleanerPollWaitSeconds = 1;
     std::string cacheDir;
+    uint64_t modelsMemoryBudgetMb = 0;
 };
 
 struct ModelsSettingsImpl {
@@ -0,0 +1,45 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "shared_buffer_allocator.hpp"
+
+#include <utility>
+
+namespace ovms {
+
+SharedBufferAllocator::SharedBufferAllocator(std::shared_ptr<const void> owner, void* data) :
+    owner(std::move(owner)),
+    data(data) {}
+
+void* SharedBufferAllocator::allocate(const size_t bytes, const size_t alignment) {
+    return this->data;
+}
+
+void SharedBufferAllocator::deallocate(void* handle, const size_t bytes, size_t alignment) {
+    // memory is released by the owner
+}
+
+bool SharedBufferAllocator::is_equal(const AllocatorImpl& other) const {
+    const SharedBufferAllocator* otherPtr = dynamic_cast<const SharedBufferAllocator*>(&other);
+    if (otherPtr == nullptr) {
+        return false;
+    }
+    return (this->owner == otherPtr->owner) && (this->data == otherPtr->data);
+}
+
+ov::Tensor makeSharedBufferTensor(ov::element::Type precision, const ov::Shape& shape, std::shared_ptr<const void> owner, const void* data) {
+    return ov::Tensor(precision, shape, ov::Allocator(std::make_shared<SharedBufferAllocator>(std::move(owner), const_cast<void*>(data))));
+}
+}  // namespace ovms
@@ -0,0 +1,43 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <memory>
+
+#include <openvino/openvino.hpp>
+
+namespace ovms {
+
+/**
+ * @brief Allocator of tensor data owned by some other object.
+ * It does not allocate anything, but keeps the owner alive for as long as tensor is used.
+ */
+class SharedBufferAllocator : public ov::AllocatorImpl {
+    std::shared_ptr<const void> owner;
+    void* data;
+
+public:
+    SharedBufferAllocator(std::shared_ptr<const void> owner, void* data);
+    void* allocate(const size_t bytes, const size_t alignment = alignof(max_align_t)) override;
+    void deallocate(void* handle, const size_t bytes, size_t alignment = alignof(max_align_t)) override;
+    bool is_equal(const AllocatorImpl& other) const override;
+};
+
+/**
+ * @brief Creates tensor using data owned by other object without copying it
+ */
+ov::Tensor makeSharedBufferTensor(ov::element::Type precision, const ov::Shape& shape, std::shared_ptr<const void> owner, const void* data);
+}  // namespace ovms
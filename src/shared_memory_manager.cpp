@@ -0,0 +1,210 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "shared_memory_manager.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "logging.hpp"
+#include "shared_buffer_allocator.hpp"
+#include "status.hpp"
+
+namespace ovms {
+
+const std::string SHARED_MEMORY_REGION_PARAMETER = "shared_memory_region";
+const std::string SHARED_MEMORY_OFFSET_PARAMETER = "shared_memory_offset";
+const std::string SHARED_MEMORY_BYTE_SIZE_PARAMETER = "shared_memory_byte_size";
+
+SharedMemoryRegion::SharedMemoryRegion(const std::string& name, const std::string& key, size_t offset, size_t byteSize) :
+    name(name),
+    key(key),
+    offset(offset),
+    byteSize(byteSize) {}
+
+SharedMemoryRegion::~SharedMemoryRegion() {
+    if (this->mapping != nullptr) {
+        munmap(this->mapping, this->mappingSize);
+    }
+}
+
+Status SharedMemoryRegion::map() {
+    if (this->byteSize == 0) {
+        return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Region byte size must be positive");
+    }
+    int fd = shm_open(this->key.c_str(), O_RDWR, 0);
+    if (fd == -1) {
+        SPDLOG_DEBUG("Could not open shared memory object: {}; error: {}", this->key, std::strerror(errno));
+        return Status(StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED, "Could not open shared memory object: " + this->key);
+    }
+    struct stat objectStat;
+    // compared without adding offset and byte size, which could overflow
+    if (fstat(fd, &objectStat) == -1 ||
+        this->offset > static_cast<size_t>(objectStat.st_size) ||
+        this->byteSize > static_cast<size_t>(objectStat.st_size) - this->offset) {
+        close(fd);
+        return Status(StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS, "Region exceeds shared memory object: " + this->key);
+    }
+    // mmap offset has to be aligned to page size
+    const size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t alignedOffset = this->offset - this->offset % pageSize;
+    this->mappingSize = this->byteSize + this->offset - alignedOffset;
+    void* mapping = mmap(nullptr, this->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, alignedOffset);
+    // mapping stays valid after closing the descriptor
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        SPDLOG_DEBUG("Could not map shared memory object: {}; error: {}", this->key, std::strerror(errno));
+        return Status(StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED, "Could not map shared memory object: " + this->key);
+    }
+    this->mapping = mapping;
+    this->data = static_cast<char*>(mapping) + (this->offset - alignedOffset);
+    return StatusCode::OK;
+}
+
+Status SharedMemoryRegion::getData(size_t offset, size_t byteSize, char** result) const {
+    if (offset > this->byteSize || byteSize > this->byteSize - offset) {
+        std::stringstream ss;
+        ss << "Region: " << this->name << " byte size: " << this->byteSize << "; requested offset: " << offset << " byte size: " << byteSize;
+        return Status(StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS, ss.str());
+    }
+    *result = this->data + offset;
+    return StatusCode::OK;
+}
+
+Status SharedMemoryManager::registerRegion(const std::string& name, const std::string& key, size_t offset, size_t byteSize) {
+    if (name.empty() || key.empty()) {
+        return Status(StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Region name and key must not be empty");
+    }
+    {
+        std::shared_lock lock(this->regionsMtx);
+        if (this->regions.find(name) != this->regions.end()) {
+            return Status(StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, name);
+        }
+    }
+    auto region = std::make_shared<SharedMemoryRegion>(name, key, offset, byteSize);
+    auto status = region->map();
+    if (!status.ok()) {
+        return status;
+    }
+    std::unique_lock lock(this->regionsMtx);
+    if (!this->regions.emplace(name, std::move(region)).second) {
+        return Status(StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, name);
+    }
+    SPDLOG_INFO("Registered shared memory region: {}; key: {}; offset: {}; byte size: {}", name, key, offset, byteSize);
+    return StatusCode::OK;
+}
+
+Status SharedMemoryManager::unregisterRegion(const std::string& name) {
+    std::unique_lock lock(this->regionsMtx);
+    if (name.empty()) {
+        this->regions.clear();
+        SPDLOG_INFO("Unregistered all shared memory regions");
+        return StatusCode::OK;
+    }
+    if (this->regions.erase(name) == 0) {
+        return Status(StatusCode::SHARED_MEMORY_REGION_NOT_FOUND, name);
+    }
+    SPDLOG_INFO("Unregistered shared memory region: {}", name);
+    return StatusCode::OK;
+}
+
+Status SharedMemoryManager::getRegions(const std::string& name, std::vector<std::shared_ptr<const SharedMemoryRegion>>& result) const {
+    if (!name.empty()) {
+        std::shared_ptr<const SharedMemoryRegion> region;
+        auto status = this->getRegion(name, region);
+        if (!status.ok()) {
+            return status;
+        }
+        result.emplace_back(std::move(region));
+        return StatusCode::OK;
+    }
+    std::shared_lock lock(this->regionsMtx);
+    for (const auto& [regionName, region] : this->regions) {
+        result.emplace_back(region);
+    }
+    return StatusCode::OK;
+}
+
+Status SharedMemoryManager::getRegion(const std::string& name, std::shared_ptr<const SharedMemoryRegion>& region) const {
+    std::shared_lock lock(this->regionsMtx);
+    auto it = this->regions.find(name);
+    if (it == this->regions.end()) {
+        return Status(StatusCode::SHARED_MEMORY_REGION_NOT_FOUND, name);
+    }
+    region = it->second;
+    return StatusCode::OK;
+}
+
+Status SharedMemoryManager::createTensor(const SharedMemoryReference& reference, ov::element::Type precision, const ov::Shape& shape, ov::Tensor& tensor) const {
+    std::shared_ptr<const SharedMemoryRegion> region;
+    auto status = this->getRegion(reference.regionName, region);
+    if (!status.ok()) {
+        return status;
+    }
+    if (ov::shape_size(shape) * precision.size() != reference.byteSize) {
+        std::stringstream ss;
+        ss << "Expected: " << ov::shape_size(shape) * precision.size() << " bytes; Actual: " << reference.byteSize << " bytes in region: " << reference.regionName;
+        return Status(StatusCode::INVALID_CONTENT_SIZE, ss.str());
+    }
+    char* data = nullptr;
+    status = region->getData(reference.offset, reference.byteSize, &data);
+    if (!status.ok()) {
+        return status;
+    }
+    tensor = makeSharedBufferTensor(precision, shape, std::move(region), data);
+    return StatusCode::OK;
+}
+
+Status SharedMemoryManager::write(const SharedMemoryReference& reference, const void* data, size_t byteSize) const {
+    std::shared_ptr<const SharedMemoryRegion> region;
+    auto status = this->getRegion(reference.regionName, region);
+    if (!status.ok()) {
+        return status;
+    }
+    if (byteSize > reference.byteSize) {
+        std::stringstream ss;
+        ss << "Output requires: " << byteSize << " bytes; provided: " << reference.byteSize << " bytes in region: " << reference.regionName;
+        return Status(StatusCode::INVALID_CONTENT_SIZE, ss.str());
+    }
+    char* destination = nullptr;
+    status = region->getData(reference.offset, byteSize, &destination);
+    if (!status.ok()) {
+        return status;
+    }
+    if (destination != data) {
+        std::memcpy(destination, data, byteSize);
+    }
+    return StatusCode::OK;
+}
+
+thread_local const SharedMemoryManager* SharedMemoryScope::currentManager = nullptr;
+
+SharedMemoryScope::SharedMemoryScope(const SharedMemoryManager* manager) :
+    previous(currentManager) {
+    currentManager = manager;
+}
+
+SharedMemoryScope::~SharedMemoryScope() {
+    currentManager = this->previous;
+}
+}  // namespace ovms
@@ -0,0 +1,141 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include <openvino/openvino.hpp>
+
+namespace ovms {
+class Status;
+
+// Tensor parameters referring to data placed in registered shared memory region
+extern const std::string SHARED_MEMORY_REGION_PARAMETER;
+extern const std::string SHARED_MEMORY_OFFSET_PARAMETER;
+extern const std::string SHARED_MEMORY_BYTE_SIZE_PARAMETER;
+
+/**
+ * @brief Part of POSIX shared memory object mapped into server address space.
+ * Mapping is released when last reference is dropped, so region unregistered
+ * during inference stays valid until requests using it are finished.
+ */
+class SharedMemoryRegion {
+    const std::string name;
+    const std::string key;
+    const size_t offset;
+    const size_t byteSize;
+    void* mapping = nullptr;
+    size_t mappingSize = 0;
+    char* data = nullptr;
+
+public:
+    SharedMemoryRegion(const std::string& name, const std::string& key, size_t offset, size_t byteSize);
+    SharedMemoryRegion(const SharedMemoryRegion&) = delete;
+    SharedMemoryRegion& operator=(const SharedMemoryRegion&) = delete;
+    ~SharedMemoryRegion();
+
+    Status map();
+
+    const std::string& getName() const { return this->name; }
+    const std::string& getKey() const { return this->key; }
+    size_t getOffset() const { return this->offset; }
+    size_t getByteSize() const { return this->byteSize; }
+
+    /**
+     * @brief Gets address of data placed in the region
+     * @param offset relative to the beginning of the region
+     * @param byteSize
+     * @param result
+     * @return Status SHARED_MEMORY_REGION_OUT_OF_BOUNDS if data does not fit in the region
+     */
+    Status getData(size_t offset, size_t byteSize, char** result) const;
+};
+
+/**
+ * @brief Tensor data placed in shared memory region, as referred by request parameters.
+ */
+struct SharedMemoryReference {
+    std::string regionName;
+    size_t offset = 0;
+    size_t byteSize = 0;
+};
+
+/**
+ * @brief Provides shared memory regions registered by clients placed on the same host.
+ * Owned by gRPC server module and created only when shared memory API is enabled.
+ */
+class SharedMemoryManager {
+    mutable std::shared_mutex regionsMtx;
+    std::map<std::string, std::shared_ptr<SharedMemoryRegion>> regions;
+
+public:
+    SharedMemoryManager() = default;
+    SharedMemoryManager(const SharedMemoryManager&) = delete;
+
+    /**
+     * @brief Maps byteSize bytes starting from offset of POSIX shared memory object
+     * with given key and registers them under given name
+     */
+    Status registerRegion(const std::string& name, const std::string& key, size_t offset, size_t byteSize);
+
+    /**
+     * @brief Unregisters region with given name, or all regions when name is empty
+     */
+    Status unregisterRegion(const std::string& name);
+
+    /**
+     * @brief Gets registered regions, all of them when name is empty
+     */
+    Status getRegions(const std::string& name, std::vector<std::shared_ptr<const SharedMemoryRegion>>& result) const;
+
+    Status getRegion(const std::string& name, std::shared_ptr<const SharedMemoryRegion>& region) const;
+
+    /**
+     * @brief Wraps data placed in shared memory as tensor without copying it.
+     * Tensor keeps the region mapped for as long as it is alive.
+     */
+    Status createTensor(const SharedMemoryReference& reference, ov::element::Type precision, const ov::Shape& shape, ov::Tensor& tensor) const;
+
+    /**
+     * @brief Copies data into shared memory region
+     */
+    Status write(const SharedMemoryReference& reference, const void* data, size_t byteSize) const;
+};
+
+/**
+ * @brief Binds shared memory manager to the thread handling KServe request, so request validation and
+ * deserialization of model and pipeline inputs can resolve regions without the manager being passed through them.
+ * Outside of the scope, or with nullptr manager, inputs referring to shared memory are rejected.
+ */
+class SharedMemoryScope {
+    static thread_local const SharedMemoryManager* currentManager;
+    const SharedMemoryManager* previous;
+
+public:
+    explicit SharedMemoryScope(const SharedMemoryManager* manager);
+    ~SharedMemoryScope();
+
+    SharedMemoryScope(const SharedMemoryScope&) = delete;
+    SharedMemoryScope& operator=(const SharedMemoryScope&) = delete;
+
+    static const SharedMemoryManager* current() { return currentManager; }
+};
+}  // namespace ovms
@@ -70,10 +70,14 @@ const std::unordered_map<const StatusCode, const std::string> Status::statusMess
     {StatusCode::REQUESTED_MODEL_TYPE_CHANGE, "Model type cannot be changed after it is loaded"},
     {StatusCode::INVALID_NON_STATEFUL_MODEL_PARAMETER, "Stateful model config parameter used for non stateful model"},
     {StatusCode::INVALID_MAX_SEQUENCE_NUMBER, "Sequence max number parameter too high"},
+    {StatusCode::CPU_CORES_NOT_AVAILABLE, "Not enough free CPU cores to reserve for model"},
     {StatusCode::CANNOT_CONVERT_FLAT_SHAPE, "Cannot convert flat shape to Shape object"},
     {StatusCode::INVALID_BATCH_DIMENSION, "Invalid batch dimension in shape"},
     {StatusCode::LAYOUT_INCOMPATIBLE_WITH_SHAPE, "Layout incompatible with given shape"},
     {StatusCode::ALLOW_CACHE_WITH_CUSTOM_LOADER, "allow_cache is set to true with custom loader usage"},
+    {StatusCode::PREPROCESSING_WRONG_FORMAT, "The provided preprocessing configuration is in wrong format"},
+    {StatusCode::CONFIG_PREPROCESSING_IS_NOT_IN_MODEL, "Preprocessing from config not found in model inputs"},
+    {StatusCode::CONFIG_PREPROCESSING_MAPPED_BUT_USED_REAL_NAME, "Preprocessing from config has real name. Use mapped name instead"},
     {StatusCode::UNKNOWN_ERROR, "Unknown error"},
 
     // Sequence management
@@ -91,6 +95,7 @@ const std::unordered_map<const StatusCode, const std::string> Status::statusMess
     {StatusCode::INVALID_NO_OF_INPUTS, "Invalid number of inputs"},
     {StatusCode::INVALID_MISSING_INPUT, "Missing input with specific name"},
     {StatusCode::INVALID_MISSING_OUTPUT, "Missing output with specific name"},
+    {StatusCode::INVALID_UNEXPECTED_OUTPUT, "Unexpected output name"},
     {StatusCode::INVALID_NO_OF_SHAPE_DIMENSIONS, "Invalid number of shape dimensions"},
     {StatusCode::INVALID_BATCH_SIZE, "Invalid input batch size"},
     {StatusCode::INVALID_SHAPE, "Invalid input shape"},
@@ -109,6 +114,13 @@ const std::unordered_map<const StatusCode, const std::string> Status::statusMess
     // Inference
     {StatusCode::OV_INTERNAL_INFERENCE_ERROR, "Internal inference error"},
 
+    // Admission control
+    {StatusCode::INVALID_PRIORITY, "Invalid request priority. Accepted values are: high, normal, low"},
+    {StatusCode::INFER_QUEUE_FULL, "Too many requests waiting for the model, request rejected"},
+    {StatusCode::INFER_QUEUE_WAIT_TIMEOUT, "Request exceeded maximum queue wait time of the model"},
+    {StatusCode::REQUEST_DEADLINE_EXCEEDED, "Request deadline exceeded, processing stopped"},
+    {StatusCode::REQUEST_CANCELLED, "Request cancelled by the client, processing stopped"},
+
     // Serialization
     {StatusCode::OV_UNSUPPORTED_SERIALIZATION_PRECISION, "Unsupported serialization precision"},
     {StatusCode::OV_INTERNAL_SERIALIZATION_ERROR, "Internal serialization error"},
@@ -149,6 +161,11 @@ const std::unordered_map<const StatusCode, const std::string> Status::statusMess
     {StatusCode::REST_BINARY_BUFFER_EXCEEDED, "Received buffer size is smaller than binary_data_size parameter indicates"},
     {StatusCode::REST_INFERENCE_HEADER_CONTENT_LENGTH_INVALID, "Inference-Header-Content-Length header is invalid and couldn't be parsed"},
     {StatusCode::REST_CONTENTS_FIELD_NOT_EMPTY, "Request contains values both in binary data and in content value"},
+    {StatusCode::REST_COMPRESSION_ERROR, "Error while compressing response body"},
+    {StatusCode::REST_UNSUPPORTED_CONTENT_ENCODING, "Unsupported Content-Encoding of request body, supported are gzip, deflate and identity"},
+    {StatusCode::REST_DECOMPRESSION_ERROR, "Error while decompressing request body"},
+    {StatusCode::REST_TOO_MANY_CONCURRENT_REQUESTS, "Maximal number of concurrent REST requests reached"},
+    {StatusCode::REST_PROFILER_SETTINGS_INVALID, "Profiler settings should be an object with enable boolean, sampling_rate and retention_seconds positive integers"},
 
     // Pipeline validation errors
     {StatusCode::PIPELINE_DEFINITION_ALREADY_EXIST, "Pipeline definition with the same name already exists"},
@@ -253,6 +270,17 @@ const std::unordered_map<const StatusCode, const std::string> Status::statusMess
     {StatusCode::BYTES_CONTENTS_EMPTY, "Bytes contents is empty"},
     {StatusCode::NODE_LIBRARY_INITIALIZE_FAILED, "Failure during custom node library initialization"},
 
+    // Shared memory
+    {StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED, "Shared memory region with provided name is already registered"},
+    {StatusCode::SHARED_MEMORY_REGION_NOT_FOUND, "Shared memory region with provided name is not registered"},
+    {StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED, "Could not open and map shared memory region"},
+    {StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS, "Data exceeds bounds of shared memory region"},
+    {StatusCode::SHARED_MEMORY_PARAMETERS_INVALID, "Invalid shared memory parameters"},
+    {StatusCode::SHARED_MEMORY_DISABLED, "Shared memory API is disabled, start the server with shared_memory_enable"},
+
+    // Streaming
+    {StatusCode::STREAM_WRITE_FAILED, "Writing response to the stream failed"},
+
     // Model control API
     {StatusCode::OK_NOT_RELOADED, "Config reload was not needed"},
     {StatusCode::OK_RELOADED, "Config reload successful"},
@@ -282,6 +310,7 @@ const std::unordered_map<const StatusCode, const std::string> Status::statusMess
     {StatusCode::NONEXISTENT_TENSOR_FOR_REMOVAL, "Tried to remove nonexisting tensor"},
     {StatusCode::NONEXISTENT_STATUS, "Tried to use nonexisting status"},
     {StatusCode::NONEXISTENT_LOG_LEVEL, "Tried to use nonexisting log level"},
+    {StatusCode::NONEXISTENT_CALLBACK, "Tried to use nonexisting callback"},
     {StatusCode::SERVER_NOT_READY_FOR_INFERENCE, "Server not in a state to perform inference"},
 
     // Server Start errors
@@ -59,6 +59,9 @@ enum class StatusCode {
     INVALID_BATCH_DIMENSION, /*!< Invalid batch dimension in shape */
     ALLOW_CACHE_WITH_CUSTOM_LOADER,
     LAYOUT_INCOMPATIBLE_WITH_SHAPE,
+    PREPROCESSING_WRONG_FORMAT, /*!< The provided preprocess param is in wrong format */
+    CONFIG_PREPROCESSING_IS_NOT_IN_MODEL,
+    CONFIG_PREPROCESSING_MAPPED_BUT_USED_REAL_NAME, /*!< Using old name of input in config preprocess when mapped in mapping_config.json*/
 
     // Model management
     MODEL_MISSING,                                     /*!< Model with such name and/or version does not exist */
@@ -74,6 +77,7 @@ enum class StatusCode {
     REQUESTED_MODEL_TYPE_CHANGE,                       /*!< Model type cannot be changed after it's loaded */
     INVALID_NON_STATEFUL_MODEL_PARAMETER,              /*!< Stateful model config parameter used for non stateful model */
     INVALID_MAX_SEQUENCE_NUMBER,                       /*!< Sequence max number parameter too high */
+    CPU_CORES_NOT_AVAILABLE,                           /*!< Not enough free CPU cores to reserve for model */
 
     // Sequence management
     SEQUENCE_MISSING,                /*!< Sequence with provided ID does not exist */
@@ -90,6 +94,7 @@ enum class StatusCode {
     INVALID_NO_OF_INPUTS,           /*!< Invalid number of inputs */
     INVALID_MISSING_INPUT,          /*!< Missing one or more of inputs */
     INVALID_MISSING_OUTPUT,         /*!< Missing one or more of outputs */
+    INVALID_UNEXPECTED_OUTPUT,      /*!< Unexpected output name */
     INVALID_NO_OF_SHAPE_DIMENSIONS, /*!< Invalid number of shape dimensions */
     INVALID_BATCH_SIZE,             /*!< Input batch size other than required */
     INVALID_SHAPE,                  /*!< Invalid shape dimension number or dimension value */
@@ -107,6 +112,13 @@ enum class StatusCode {
     // Inference
     OV_INTERNAL_INFERENCE_ERROR, /*!< Error occured during inference */
 
+    // Admission control
+    INVALID_PRIORITY,          /*!< Unknown request priority class */
+    INFER_QUEUE_FULL,          /*!< Maximum number of requests waiting for inference request reached */
+    INFER_QUEUE_WAIT_TIMEOUT,  /*!< Request waited for inference request longer than allowed */
+    REQUEST_DEADLINE_EXCEEDED, /*!< Client deadline passed before request processing completed */
+    REQUEST_CANCELLED,         /*!< Client cancelled the request */
+
     // Serialization
     OV_UNSUPPORTED_SERIALIZATION_PRECISION, /*!< Unsupported serializaton precision */
     OV_INTERNAL_SERIALIZATION_ERROR,        /*!< Error occurred during serialization */
@@ -191,6 +203,11 @@ enum class StatusCode {
     REST_INFERENCE_HEADER_CONTENT_LENGTH_INVALID, /*!< inferenceHeaderContentLength parameter is invalid and cannot be parsed*/
     REST_BINARY_BUFFER_EXCEEDED,                  /*!< Received buffer size is smaller than binary_data_size parameter indicates*/
     REST_CONTENTS_FIELD_NOT_EMPTY,                /*!< Request contains values both in binary data and in content value*/
+    REST_COMPRESSION_ERROR,                       /*!< Error while compressing response body */
+    REST_UNSUPPORTED_CONTENT_ENCODING,            /*!< Request body sent with unsupported Content-Encoding */
+    REST_DECOMPRESSION_ERROR,                     /*!< Error while decompressing request body */
+    REST_PROFILER_SETTINGS_INVALID,               /*!< Profiler settings in request body are invalid */
+    REST_TOO_MANY_CONCURRENT_REQUESTS,            /*!< Request rejected because rest_max_concurrent_requests was reached */
 
     // Pipeline validation errors
     PIPELINE_DEFINITION_ALREADY_EXIST,
@@ -264,6 +281,17 @@ enum class StatusCode {
     STRING_VAL_EMPTY,
     BYTES_CONTENTS_EMPTY,
 
+    // Shared memory
+    SHARED_MEMORY_REGION_ALREADY_REGISTERED,
+    SHARED_MEMORY_REGION_NOT_FOUND,
+    SHARED_MEMORY_REGION_OPEN_FAILED,
+    SHARED_MEMORY_REGION_OUT_OF_BOUNDS,
+    SHARED_MEMORY_PARAMETERS_INVALID,
+    SHARED_MEMORY_DISABLED,
+
+    // Streaming
+    STREAM_WRITE_FAILED,
+
     // Model control API
     OK_NOT_RELOADED, /*!< Operation succeeded but no config reload was needed */
     OK_RELOADED,     /*!< Operation succeeded and config reload was needed */
@@ -293,6 +321,7 @@ enum class StatusCode {
     NONEXISTENT_TENSOR_FOR_REMOVAL,
     NONEXISTENT_STATUS,
     NONEXISTENT_LOG_LEVEL,
+    NONEXISTENT_CALLBACK,
     SERVER_NOT_READY_FOR_INFERENCE,
 
     // Server Start errors
@@ -0,0 +1,108 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <spdlog/sinks/ostream_sink.h>
+
+#include "../access_log.hpp"
+#include "../logging.hpp"
+#include "../status.hpp"
+
+using namespace ovms;
+using testing::HasSubstr;
+using testing::Not;
+
+class AccessLogTest : public ::testing::Test {
+protected:
+    std::ostringstream output;
+
+    void SetUp() override {
+        auto sink = std::make_shared<spdlog::sinks::ostream_sink_mt>(output);
+        access_logger = std::make_shared<spdlog::logger>("access_test", sink);
+        access_logger->set_pattern("%v");
+    }
+    void TearDown() override {
+        access_logger.reset();
+    }
+};
+
+TEST_F(AccessLogTest, WritesEntryWhenGoingOutOfScope) {
+    Status status;
+    {
+        AccessLogRecord record(ExecutionContext{ExecutionContext::Interface::GRPC, ExecutionContext::Method::ModelInfer}, "dummy", 0, status);
+        AccessLogRecord* current = AccessLogRecord::current("dummy");
+        ASSERT_EQ(current, &record);
+        current->setServableVersion(3);
+        current->addStage("deserialize", 12.5);
+        current->addStage("prediction", 100);
+        status = StatusCode::INVALID_SHAPE;
+        EXPECT_TRUE(output.str().empty());
+    }
+    const std::string entry = output.str();
+    EXPECT_THAT(entry, HasSubstr("\"interface\":\"gRPC\""));
+    EXPECT_THAT(entry, HasSubstr("\"method\":\"ModelInfer\""));
+    EXPECT_THAT(entry, HasSubstr("\"servable\":\"dummy\""));
+    EXPECT_THAT(entry, HasSubstr("\"version\":3"));
+    EXPECT_THAT(entry, HasSubstr("\"status_code\":" + std::to_string(static_cast<int>(StatusCode::INVALID_SHAPE))));
+    EXPECT_THAT(entry, HasSubstr("\"total_us\":"));
+    EXPECT_THAT(entry, HasSubstr("\"deserialize_us\":12.5"));
+    EXPECT_THAT(entry, HasSubstr("\"prediction_us\":100.0"));
+    EXPECT_EQ(AccessLogRecord::current("dummy"), nullptr);
+}
+
+TEST_F(AccessLogTest, OnlyOutermostRecordIsWritten) {
+    Status status;
+    {
+        AccessLogRecord outer(ExecutionContext{ExecutionContext::Interface::REST, ExecutionContext::Method::ModelInfer}, "dummy", 1, status);
+        {
+            AccessLogRecord inner(ExecutionContext{ExecutionContext::Interface::GRPC, ExecutionContext::Method::ModelInfer}, "dummy", 1, status);
+            EXPECT_EQ(AccessLogRecord::current("dummy"), &outer);
+        }
+        EXPECT_TRUE(output.str().empty());
+    }
+    EXPECT_THAT(output.str(), HasSubstr("\"interface\":\"REST\""));
+    EXPECT_THAT(output.str(), Not(HasSubstr("\"interface\":\"gRPC\"")));
+}
+
+TEST_F(AccessLogTest, StagesOfOtherServablesAreNotAttributed) {
+    Status status;
+    AccessLogRecord record(ExecutionContext{ExecutionContext::Interface::GRPC, ExecutionContext::Method::Predict}, "pipeline", 0, status);
+    EXPECT_EQ(AccessLogRecord::current("model_in_pipeline"), nullptr);
+    EXPECT_EQ(AccessLogRecord::current("pipeline"), &record);
+}
+
+TEST_F(AccessLogTest, EscapesServableName) {
+    Status status;
+    {
+        AccessLogRecord record(ExecutionContext{ExecutionContext::Interface::CAPI, ExecutionContext::Method::ModelInfer}, "a\"b\\c", 0, status);
+    }
+    EXPECT_THAT(output.str(), HasSubstr("\"servable\":\"a\\\"b\\\\c\""));
+}
+
+TEST_F(AccessLogTest, DisabledRecordIsInactive) {
+    access_logger.reset();
+    Status status;
+    {
+        AccessLogRecord record(ExecutionContext{ExecutionContext::Interface::GRPC, ExecutionContext::Method::Predict}, "dummy", 0, status);
+        EXPECT_FALSE(AccessLogRecord::isEnabled());
+        EXPECT_EQ(AccessLogRecord::current("dummy"), nullptr);
+    }
+    EXPECT_TRUE(output.str().empty());
+}
@@ -14,9 +14,11 @@
 // limitations under the License.
 //*****************************************************************************
 
+#include <future>
 #include <memory>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -442,6 +444,311 @@ TEST_F(CapiInference, Basic) {
     OVMS_ServerDelete(cserver);
 }
 
+namespace {
+struct AsyncInferenceResult {
+    std::promise<void> completed;
+    OVMS_InferenceResponse* response{nullptr};
+    OVMS_Status* status{nullptr};
+};
+
+void onAsyncInferenceCompleted(OVMS_InferenceResponse* response, OVMS_Status* status, void* userdata) {
+    auto result = reinterpret_cast<AsyncInferenceResult*>(userdata);
+    result->response = response;
+    result->status = status;
+    result->completed.set_value();
+}
+}  // namespace
+
+TEST_F(CapiInference, Async) {
+    std::string port = "9000";
+    randomizePort(port);
+    OVMS_ServerSettings* serverSettings = 0;
+    OVMS_ModelsSettings* modelsSettings = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsNew(&serverSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsNew(&modelsSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsSetGrpcPort(serverSettings, std::stoi(port)));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsSetConfigPath(modelsSettings, "/ovms/src/test/c_api/config_standard_dummy.json"));
+    OVMS_Server* cserver = nullptr;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerNew(&cserver));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerStartFromConfigurationFile(cserver, serverSettings, modelsSettings));
+
+    OVMS_InferenceRequest* request{nullptr};
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "dummy", 1));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddInput(request, DUMMY_MODEL_INPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    std::array<float, DUMMY_MODEL_INPUT_SIZE> data{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint32_t notUsedNum = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestInputSetData(request, DUMMY_MODEL_INPUT_NAME, reinterpret_cast<void*>(data.data()), sizeof(float) * data.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceAsync(nullptr, request, onAsyncInferenceCompleted, nullptr), StatusCode::NONEXISTENT_SERVER);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceAsync(cserver, nullptr, onAsyncInferenceCompleted, nullptr), StatusCode::NONEXISTENT_REQUEST);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceAsync(cserver, request, nullptr, nullptr), StatusCode::NONEXISTENT_CALLBACK);
+
+    // several requests in flight, more than model streams
+    const size_t inferencesCount = 8;
+    std::vector<AsyncInferenceResult> results(inferencesCount);
+    for (auto& result : results) {
+        ASSERT_CAPI_STATUS_NULL(OVMS_InferenceAsync(cserver, request, onAsyncInferenceCompleted, &result));
+    }
+    for (auto& result : results) {
+        ASSERT_EQ(result.completed.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+        ASSERT_EQ(result.status, nullptr);
+        ASSERT_NE(result.response, nullptr);
+        const void* voutputData;
+        size_t bytesize = 0;
+        OVMS_DataType datatype = (OVMS_DataType)199;
+        const uint64_t* shape{nullptr};
+        uint32_t dimCount = 0;
+        OVMS_BufferType bufferType = (OVMS_BufferType)199;
+        uint32_t deviceId = 42;
+        const char* outputName{nullptr};
+        ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutput(result.response, 0, &outputName, &datatype, &shape, &dimCount, &voutputData, &bytesize, &bufferType, &deviceId));
+        ASSERT_EQ(std::string(DUMMY_MODEL_OUTPUT_NAME), outputName);
+        ASSERT_EQ(bytesize, sizeof(float) * DUMMY_MODEL_INPUT_SIZE);
+        const float* outputData = reinterpret_cast<const float*>(voutputData);
+        for (size_t i = 0; i < data.size(); ++i) {
+            EXPECT_EQ(data[i] + 1, outputData[i]) << "Different at:" << i << " place.";
+        }
+        OVMS_InferenceResponseDelete(result.response);
+    }
+
+    // invalid request is reported synchronously, callback is not called
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestRemoveInput(request, DUMMY_MODEL_INPUT_NAME));
+    AsyncInferenceResult invalidResult;
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceAsync(cserver, request, onAsyncInferenceCompleted, &invalidResult), StatusCode::INVALID_NO_OF_INPUTS);
+    EXPECT_EQ(invalidResult.completed.get_future().wait_for(std::chrono::milliseconds(10)), std::future_status::timeout);
+
+    OVMS_InferenceRequestDelete(request);
+    OVMS_ServerDelete(cserver);
+}
+
+TEST_F(CapiInference, CallerProvidedOutputs) {
+    std::string port = "9000";
+    randomizePort(port);
+    OVMS_ServerSettings* serverSettings = 0;
+    OVMS_ModelsSettings* modelsSettings = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsNew(&serverSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsNew(&modelsSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsSetGrpcPort(serverSettings, std::stoi(port)));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsSetConfigPath(modelsSettings, "/ovms/src/test/c_api/config_standard_dummy.json"));
+    OVMS_Server* cserver = nullptr;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerNew(&cserver));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerStartFromConfigurationFile(cserver, serverSettings, modelsSettings));
+
+    OVMS_InferenceRequest* request{nullptr};
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "dummy", 1));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddInput(request, DUMMY_MODEL_INPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    std::array<float, DUMMY_MODEL_INPUT_SIZE> data{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint32_t notUsedNum = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestInputSetData(request, DUMMY_MODEL_INPUT_NAME, reinterpret_cast<void*>(data.data()), sizeof(float) * data.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+
+    std::array<float, DUMMY_MODEL_INPUT_SIZE> outputMemory;
+    outputMemory.fill(-1);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestAddOutput(nullptr, DUMMY_MODEL_OUTPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()), StatusCode::NONEXISTENT_REQUEST);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestAddOutput(request, nullptr, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()), StatusCode::NONEXISTENT_STRING);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestAddOutput(request, DUMMY_MODEL_OUTPUT_NAME, OVMS_DATATYPE_FP32, nullptr, DUMMY_MODEL_SHAPE.size()), StatusCode::NONEXISTENT_TABLE);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestOutputSetData(request, DUMMY_MODEL_OUTPUT_NAME, outputMemory.data(), sizeof(float) * outputMemory.size(), OVMS_BUFFERTYPE_CPU, notUsedNum), StatusCode::NONEXISTENT_TENSOR_FOR_SET_BUFFER);
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddOutput(request, DUMMY_MODEL_OUTPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestOutputSetData(request, DUMMY_MODEL_OUTPUT_NAME, nullptr, sizeof(float) * outputMemory.size(), OVMS_BUFFERTYPE_CPU, notUsedNum), StatusCode::NONEXISTENT_DATA);
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestOutputSetData(request, DUMMY_MODEL_OUTPUT_NAME, outputMemory.data(), sizeof(float) * outputMemory.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+
+    // results land in caller memory and response refers to it
+    OVMS_InferenceResponse* response = nullptr;
+    ASSERT_CAPI_STATUS_NULL(OVMS_Inference(cserver, request, &response));
+    const void* voutputData;
+    size_t bytesize = 0;
+    OVMS_DataType datatype = (OVMS_DataType)199;
+    const uint64_t* shape{nullptr};
+    uint32_t dimCount = 0;
+    OVMS_BufferType bufferType = (OVMS_BufferType)199;
+    uint32_t deviceId = 42;
+    const char* outputName{nullptr};
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutput(response, 0, &outputName, &datatype, &shape, &dimCount, &voutputData, &bytesize, &bufferType, &deviceId));
+    ASSERT_EQ(std::string(DUMMY_MODEL_OUTPUT_NAME), outputName);
+    EXPECT_EQ(voutputData, outputMemory.data());
+    ASSERT_EQ(bytesize, sizeof(float) * DUMMY_MODEL_INPUT_SIZE);
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(data[i] + 1, outputMemory[i]) << "Different at:" << i << " place.";
+    }
+    OVMS_InferenceResponseDelete(response);
+
+    // caller memory is not used by later inferences without output set
+    outputMemory.fill(-1);
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestOutputRemoveData(request, DUMMY_MODEL_OUTPUT_NAME));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestOutputRemoveData(request, DUMMY_MODEL_OUTPUT_NAME), StatusCode::NONEXISTENT_BUFFER_FOR_REMOVAL);
+    ASSERT_CAPI_STATUS_NULL(OVMS_Inference(cserver, request, &response));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutput(response, 0, &outputName, &datatype, &shape, &dimCount, &voutputData, &bytesize, &bufferType, &deviceId));
+    EXPECT_NE(voutputData, outputMemory.data());
+    const float* outputData = reinterpret_cast<const float*>(voutputData);
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(data[i] + 1, outputData[i]) << "Different at:" << i << " place.";
+        EXPECT_EQ(-1, outputMemory[i]) << "Different at:" << i << " place.";
+    }
+    OVMS_InferenceResponseDelete(response);
+
+    // wrong size of caller memory
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestOutputSetData(request, DUMMY_MODEL_OUTPUT_NAME, outputMemory.data(), sizeof(float) * (outputMemory.size() - 1), OVMS_BUFFERTYPE_CPU, notUsedNum));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, request, &response), StatusCode::INVALID_CONTENT_SIZE);
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestRemoveOutput(request, DUMMY_MODEL_OUTPUT_NAME));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestRemoveOutput(request, DUMMY_MODEL_OUTPUT_NAME), StatusCode::NONEXISTENT_TENSOR_FOR_REMOVAL);
+    // output not present in the model
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddOutput(request, "NONEXISTENT_OUTPUT", OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, request, &response), StatusCode::INVALID_UNEXPECTED_OUTPUT);
+
+    OVMS_InferenceRequestDelete(request);
+    OVMS_ServerDelete(cserver);
+}
+
+TEST_F(CapiInference, PreparedRequest) {
+    std::string port = "9000";
+    randomizePort(port);
+    OVMS_ServerSettings* serverSettings = 0;
+    OVMS_ModelsSettings* modelsSettings = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsNew(&serverSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsNew(&modelsSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsSetGrpcPort(serverSettings, std::stoi(port)));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsSetConfigPath(modelsSettings, "/ovms/src/test/c_api/config_standard_dummy.json"));
+    OVMS_Server* cserver = nullptr;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerNew(&cserver));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerStartFromConfigurationFile(cserver, serverSettings, modelsSettings));
+
+    OVMS_InferenceRequest* request{nullptr};
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "NONEXISTENT_MODEL", 1));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestPrepare(cserver, request), StatusCode::MODEL_NAME_MISSING);
+    OVMS_InferenceRequestDelete(request);
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "dummy", 1));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestPrepare(nullptr, request), StatusCode::NONEXISTENT_SERVER);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestPrepare(cserver, nullptr), StatusCode::NONEXISTENT_REQUEST);
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddInput(request, DUMMY_MODEL_INPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    std::array<float, DUMMY_MODEL_INPUT_SIZE> data{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint32_t notUsedNum = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestInputSetData(request, DUMMY_MODEL_INPUT_NAME, reinterpret_cast<void*>(data.data()), sizeof(float) * data.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestPrepare(cserver, request));
+
+    // input content updated in place and response storage reused across inferences
+    const void* previousOutputData{nullptr};
+    for (int iteration = 0; iteration < 3; ++iteration) {
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = iteration * 10 + i;
+        }
+        OVMS_InferenceResponse* response = nullptr;
+        ASSERT_CAPI_STATUS_NULL(OVMS_Inference(cserver, request, &response));
+        uint32_t outputCount = 42;
+        ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutputCount(response, &outputCount));
+        ASSERT_EQ(outputCount, 1);
+        const void* voutputData;
+        size_t bytesize = 0;
+        OVMS_DataType datatype = (OVMS_DataType)199;
+        const uint64_t* shape{nullptr};
+        uint32_t dimCount = 0;
+        OVMS_BufferType bufferType = (OVMS_BufferType)199;
+        uint32_t deviceId = 42;
+        const char* outputName{nullptr};
+        ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutput(response, 0, &outputName, &datatype, &shape, &dimCount, &voutputData, &bytesize, &bufferType, &deviceId));
+        ASSERT_EQ(std::string(DUMMY_MODEL_OUTPUT_NAME), outputName);
+        ASSERT_EQ(bytesize, sizeof(float) * DUMMY_MODEL_INPUT_SIZE);
+        if (previousOutputData != nullptr) {
+            EXPECT_EQ(previousOutputData, voutputData);
+        }
+        previousOutputData = voutputData;
+        const float* outputData = reinterpret_cast<const float*>(voutputData);
+        for (size_t i = 0; i < data.size(); ++i) {
+            EXPECT_EQ(data[i] + 1, outputData[i]) << "Different at:" << i << " place.";
+        }
+        OVMS_InferenceResponseDelete(response);
+    }
+
+    // prepared request can be used with asynchronous inference
+    AsyncInferenceResult result;
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceAsync(cserver, request, onAsyncInferenceCompleted, &result));
+    ASSERT_EQ(result.completed.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    ASSERT_EQ(result.status, nullptr);
+    ASSERT_NE(result.response, nullptr);
+    OVMS_InferenceResponseDelete(result.response);
+
+    OVMS_InferenceRequestDelete(request);
+    OVMS_ServerDelete(cserver);
+}
+
+TEST_F(CapiInference, Pipeline) {
+    std::string port = "9000";
+    randomizePort(port);
+    OVMS_ServerSettings* serverSettings = 0;
+    OVMS_ModelsSettings* modelsSettings = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsNew(&serverSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsNew(&modelsSettings));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerSettingsSetGrpcPort(serverSettings, std::stoi(port)));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ModelsSettingsSetConfigPath(modelsSettings, "/ovms/src/test/c_api/config_dummy_dag.json"));
+    OVMS_Server* cserver = nullptr;
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerNew(&cserver));
+    ASSERT_CAPI_STATUS_NULL(OVMS_ServerStartFromConfigurationFile(cserver, serverSettings, modelsSettings));
+
+    OVMS_InferenceRequest* request{nullptr};
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "pipeline1Dummy", 0));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddInput(request, DUMMY_MODEL_INPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    std::array<float, DUMMY_MODEL_INPUT_SIZE> data{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint32_t notUsedNum = 0;
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestInputSetData(request, DUMMY_MODEL_INPUT_NAME, reinterpret_cast<void*>(data.data()), sizeof(float) * data.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestPrepare(cserver, request));
+
+    const void* voutputData;
+    size_t bytesize = 0;
+    OVMS_DataType datatype = (OVMS_DataType)199;
+    const uint64_t* shape{nullptr};
+    uint32_t dimCount = 0;
+    OVMS_BufferType bufferType = (OVMS_BufferType)199;
+    uint32_t deviceId = 42;
+    const char* outputName{nullptr};
+    for (int iteration = 0; iteration < 2; ++iteration) {
+        OVMS_InferenceResponse* response = nullptr;
+        ASSERT_CAPI_STATUS_NULL(OVMS_Inference(cserver, request, &response));
+        uint32_t outputCount = 42;
+        ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutputCount(response, &outputCount));
+        ASSERT_EQ(outputCount, 1);
+        ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutput(response, 0, &outputName, &datatype, &shape, &dimCount, &voutputData, &bytesize, &bufferType, &deviceId));
+        ASSERT_EQ(std::string(DUMMY_MODEL_OUTPUT_NAME), outputName);
+        EXPECT_EQ(datatype, OVMS_DATATYPE_FP32);
+        EXPECT_EQ(bufferType, OVMS_BUFFERTYPE_CPU);
+        ASSERT_EQ(dimCount, 2);
+        ASSERT_EQ(bytesize, sizeof(float) * DUMMY_MODEL_INPUT_SIZE);
+        const float* outputData = reinterpret_cast<const float*>(voutputData);
+        for (size_t i = 0; i < data.size(); ++i) {
+            EXPECT_EQ(data[i] + 1, outputData[i]) << "Different at:" << i << " place.";
+        }
+        OVMS_InferenceResponseDelete(response);
+    }
+
+    AsyncInferenceResult asyncResult;
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceAsync(cserver, request, onAsyncInferenceCompleted, &asyncResult), StatusCode::NOT_IMPLEMENTED);
+    std::array<float, DUMMY_MODEL_INPUT_SIZE> outputMemory;
+    OVMS_InferenceResponse* response = nullptr;
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddOutput(request, DUMMY_MODEL_OUTPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestOutputSetData(request, DUMMY_MODEL_OUTPUT_NAME, outputMemory.data(), sizeof(float) * outputMemory.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, request, &response), StatusCode::NOT_IMPLEMENTED);
+    OVMS_InferenceRequestDelete(request);
+
+    // demultiplexed request is gathered into single output
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "dummyDemux", 0));
+    const std::array<uint64_t, 3> demuxShape{2, 1, DUMMY_MODEL_INPUT_SIZE};
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestAddInput(request, DUMMY_MODEL_INPUT_NAME, OVMS_DATATYPE_FP32, demuxShape.data(), demuxShape.size()));
+    std::array<float, 2 * DUMMY_MODEL_INPUT_SIZE> demuxData;
+    for (size_t i = 0; i < demuxData.size(); ++i) {
+        demuxData[i] = i;
+    }
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestInputSetData(request, DUMMY_MODEL_INPUT_NAME, reinterpret_cast<void*>(demuxData.data()), sizeof(float) * demuxData.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
+    ASSERT_CAPI_STATUS_NULL(OVMS_Inference(cserver, request, &response));
+    ASSERT_CAPI_STATUS_NULL(OVMS_InferenceResponseGetOutput(response, 0, &outputName, &datatype, &shape, &dimCount, &voutputData, &bytesize, &bufferType, &deviceId));
+    ASSERT_EQ(dimCount, 3);
+    EXPECT_EQ(shape[0], 2);
+    ASSERT_EQ(bytesize, sizeof(float) * demuxData.size());
+    const float* outputData = reinterpret_cast<const float*>(voutputData);
+    for (size_t i = 0; i < demuxData.size(); ++i) {
+        EXPECT_EQ(demuxData[i] + 1, outputData[i]) << "Different at:" << i << " place.";
+    }
+    OVMS_InferenceResponseDelete(response);
+    OVMS_InferenceRequestDelete(request);
+    OVMS_ServerDelete(cserver);
+}
+
 TEST_F(CapiInference, NegativeInference) {
     // first start OVMS
     std::string port = "9000";
@@ -511,7 +818,7 @@ TEST_F(CapiInference, NegativeInference) {
     OVMS_InferenceResponse* reponseNoModel{nullptr};
     ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestNew(&request, cserver, "NONEXISTENT_MODEL", 13));
     // negative no model
-    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, request, &response), StatusCode::NOT_IMPLEMENTED);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, request, &response), StatusCode::PIPELINE_DEFINITION_NAME_MISSING);
 
     ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceRequestAddInput(nullptr, DUMMY_MODEL_INPUT_NAME, OVMS_DATATYPE_FP32, DUMMY_MODEL_SHAPE.data(), DUMMY_MODEL_SHAPE.size()), StatusCode::NONEXISTENT_REQUEST);
     ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, requestNoModel, &reponseNoModel), StatusCode::NONEXISTENT_REQUEST);
@@ -631,6 +938,7 @@ TEST_F(CapiInference, CallInferenceServerNotStarted) {
     uint32_t notUsedNum = 0;
     ASSERT_CAPI_STATUS_NULL(OVMS_InferenceRequestInputSetData(request, DUMMY_MODEL_INPUT_NAME, reinterpret_cast<void*>(data.data()), sizeof(float) * data.size(), OVMS_BUFFERTYPE_CPU, notUsedNum));
     ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_Inference(cserver, request, &response), StatusCode::SERVER_NOT_READY_FOR_INFERENCE);
+    ASSERT_CAPI_STATUS_NOT_NULL_EXPECT_CODE(OVMS_InferenceAsync(cserver, request, onAsyncInferenceCompleted, nullptr), StatusCode::SERVER_NOT_READY_FOR_INFERENCE);
     OVMS_InferenceResponseDelete(response);
     OVMS_InferenceRequestDelete(request);
     OVMS_ServerDelete(cserver);
@@ -0,0 +1,152 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include "../compression.hpp"
+#include "../status.hpp"
+
+using namespace ovms;
+
+static std::string gunzip(const std::string& compressed) {
+    z_stream stream{};
+    EXPECT_EQ(inflateInit2(&stream, 15 + 16), Z_OK);
+    std::string output(compressed.size() * 100 + 1024, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = compressed.size();
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = output.size();
+    EXPECT_EQ(inflate(&stream, Z_FINISH), Z_STREAM_END);
+    output.resize(stream.total_out);
+    inflateEnd(&stream);
+    return output;
+}
+
+TEST(Compression, GzipAccepted) {
+    EXPECT_TRUE(isGzipAccepted("gzip"));
+    EXPECT_TRUE(isGzipAccepted("GZIP"));
+    EXPECT_TRUE(isGzipAccepted("deflate, gzip;q=1.0, *;q=0.5"));
+    EXPECT_TRUE(isGzipAccepted("br, gzip"));
+    EXPECT_TRUE(isGzipAccepted("*"));
+    EXPECT_TRUE(isGzipAccepted(" gzip ; q=0.3"));
+}
+
+TEST(Compression, GzipNotAccepted) {
+    EXPECT_FALSE(isGzipAccepted(""));
+    EXPECT_FALSE(isGzipAccepted("identity"));
+    EXPECT_FALSE(isGzipAccepted("deflate, br"));
+    EXPECT_FALSE(isGzipAccepted("gzip;q=0"));
+    EXPECT_FALSE(isGzipAccepted("gzip; q=0.000, identity"));
+    EXPECT_FALSE(isGzipAccepted("gzipx"));
+}
+
+TEST(Compression, GzipRoundTrip) {
+    std::string input;
+    for (int i = 0; i < 10000; i++) {
+        input += "ovms_requests_success{api=\"KServe\",interface=\"gRPC\",method=\"ModelInfer\",name=\"resnet\",version=\"" + std::to_string(i) + "\"} 0\n";
+    }
+    std::string compressed;
+    ASSERT_EQ(gzipCompress(input, compressed), StatusCode::OK);
+    EXPECT_LT(compressed.size(), input.size() / 10);
+    EXPECT_EQ(gunzip(compressed), input);
+}
+
+TEST(Compression, GzipEmptyInput) {
+    std::string compressed = "previous content";
+    ASSERT_EQ(gzipCompress("", compressed), StatusCode::OK);
+    EXPECT_GT(compressed.size(), 0);
+    EXPECT_EQ(gunzip(compressed), "");
+}
+
+TEST(Compression, SelectContentEncoding) {
+    EXPECT_EQ(selectContentEncoding("gzip, deflate"), GZIP_ENCODING);
+    EXPECT_EQ(selectContentEncoding("deflate"), DEFLATE_ENCODING);
+    EXPECT_EQ(selectContentEncoding("gzip;q=0.5, deflate"), DEFLATE_ENCODING);
+    EXPECT_EQ(selectContentEncoding("br, *;q=0.1"), GZIP_ENCODING);
+    EXPECT_EQ(selectContentEncoding("gzip;q=0, *"), DEFLATE_ENCODING);
+    EXPECT_EQ(selectContentEncoding("zstd, br"), "");
+    EXPECT_EQ(selectContentEncoding(""), "");
+}
+
+static std::string createCompressibleInput() {
+    std::string input;
+    for (int i = 0; i < 10000; i++) {
+        input += "{\"outputs\": [[" + std::to_string(i) + ".0, 0.0, 0.0, 0.0]]}\n";
+    }
+    return input;
+}
+
+TEST(Compression, DeflateRoundTrip) {
+    std::string input = createCompressibleInput();
+    std::string compressed;
+    ASSERT_EQ(compress(input, DEFLATE_ENCODING, compressed), StatusCode::OK);
+    EXPECT_LT(compressed.size(), input.size() / 10);
+    EXPECT_FALSE(isGzipCompressed(compressed));
+    std::string decompressed;
+    ASSERT_EQ(decompress(compressed, "Deflate", input.size(), decompressed), StatusCode::OK);
+    EXPECT_EQ(decompressed, input);
+}
+
+TEST(Compression, GzipDecompress) {
+    std::string input = createCompressibleInput();
+    std::string compressed;
+    ASSERT_EQ(compress(input, GZIP_ENCODING, compressed), StatusCode::OK);
+    EXPECT_TRUE(isGzipCompressed(compressed));
+    std::string decompressed;
+    ASSERT_EQ(decompress(compressed, " gzip", input.size(), decompressed), StatusCode::OK);
+    EXPECT_EQ(decompressed, input);
+    EXPECT_TRUE(isGzipEncoding("x-gzip"));
+    EXPECT_FALSE(isGzipEncoding("deflate"));
+}
+
+TEST(Compression, RawDeflateDecompress) {
+    std::string input = createCompressibleInput();
+    z_stream stream{};
+    ASSERT_EQ(deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY), Z_OK);
+    std::string compressed(deflateBound(&stream, input.size()), '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(input.data());
+    stream.avail_in = input.size();
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = compressed.size();
+    ASSERT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    std::string decompressed;
+    ASSERT_EQ(decompress(compressed, DEFLATE_ENCODING, input.size(), decompressed), StatusCode::OK);
+    EXPECT_EQ(decompressed, input);
+}
+
+TEST(Compression, DecompressIdentity) {
+    std::string decompressed;
+    ASSERT_EQ(decompress("{}", "identity", 2, decompressed), StatusCode::OK);
+    EXPECT_EQ(decompressed, "{}");
+}
+
+TEST(Compression, DecompressErrors) {
+    std::string input = createCompressibleInput();
+    std::string compressed;
+    ASSERT_EQ(gzipCompress(input, compressed), StatusCode::OK);
+    std::string decompressed;
+    EXPECT_EQ(decompress(compressed, "br", input.size(), decompressed), StatusCode::REST_UNSUPPORTED_CONTENT_ENCODING);
+    EXPECT_EQ(decompress(compressed, "gzip, deflate", input.size(), decompressed), StatusCode::REST_UNSUPPORTED_CONTENT_ENCODING);
+    EXPECT_EQ(decompress(compressed, GZIP_ENCODING, input.size() - 1, decompressed), StatusCode::REST_DECOMPRESSION_ERROR);
+    EXPECT_TRUE(decompressed.empty());
+    EXPECT_EQ(decompress(compressed.substr(0, compressed.size() / 2), GZIP_ENCODING, input.size(), decompressed), StatusCode::REST_DECOMPRESSION_ERROR);
+    EXPECT_EQ(decompress("not compressed", GZIP_ENCODING, input.size(), decompressed), StatusCode::REST_DECOMPRESSION_ERROR);
+}
@@ -0,0 +1,165 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../cpu_resource_manager.hpp"
+#include "../status.hpp"
+
+using namespace ovms;
+using testing::ElementsAre;
+
+// 2 NUMA nodes with 8 cpus each
+static CpuTopology createTopology() {
+    CpuTopology topology;
+    for (int cpu = 0; cpu < 16; ++cpu) {
+        topology.cpus.emplace_back(cpu);
+        topology.numaNodeOfCpu[cpu] = cpu / 8;
+    }
+    return topology;
+}
+
+TEST(CpuListTest, Parse) {
+    std::vector<int> cpus;
+    ASSERT_TRUE(parseCpuList("0-3,8,10-11\n", cpus));
+    EXPECT_THAT(cpus, ElementsAre(0, 1, 2, 3, 8, 10, 11));
+    cpus.clear();
+    EXPECT_TRUE(parseCpuList("", cpus));
+    EXPECT_TRUE(cpus.empty());
+    EXPECT_FALSE(parseCpuList("3-1", cpus));
+    EXPECT_FALSE(parseCpuList("a", cpus));
+    EXPECT_FALSE(parseCpuList("1-2x", cpus));
+}
+
+TEST(CpuListTest, Format) {
+    EXPECT_EQ(formatCpuList({0, 1, 2, 3, 8, 10, 11}), "0-3,8,10-11");
+    EXPECT_EQ(formatCpuList({}), "");
+}
+
+TEST(CpuResourceManagerTest, ReservationsAreDisjointAndFitInNumaNode) {
+    CpuResourceManager manager(createTopology());
+    ASSERT_EQ(manager.reserve("a", 6), StatusCode::OK);
+    ASSERT_EQ(manager.reserve("b", 4), StatusCode::OK);
+    auto a = manager.getAssignment("a");
+    auto b = manager.getAssignment("b");
+    EXPECT_TRUE(a.dedicated);
+    EXPECT_EQ(a.cpus.size(), 6u);
+    EXPECT_EQ(a.numaNodes.size(), 1u);
+    EXPECT_EQ(b.cpus.size(), 4u);
+    EXPECT_EQ(b.numaNodes.size(), 1u);
+    // "b" does not fit in the rest of "a" node
+    EXPECT_NE(*a.numaNodes.begin(), *b.numaNodes.begin());
+
+    ASSERT_EQ(manager.reserve("c", 2), StatusCode::OK);
+    auto c = manager.getAssignment("c");
+    // best fit takes the last 2 cores of "a" node
+    EXPECT_EQ(*c.numaNodes.begin(), *a.numaNodes.begin());
+
+    std::set<int> all;
+    all.insert(a.cpus.begin(), a.cpus.end());
+    all.insert(b.cpus.begin(), b.cpus.end());
+    all.insert(c.cpus.begin(), c.cpus.end());
+    EXPECT_EQ(all.size(), 12u);
+
+    auto shared = manager.getAssignment("other");
+    EXPECT_FALSE(shared.dedicated);
+    EXPECT_EQ(shared.cpus.size(), 4u);
+    for (int cpu : shared.cpus) {
+        EXPECT_EQ(all.count(cpu), 0u);
+    }
+}
+
+TEST(CpuResourceManagerTest, ReservationSpansNumaNodesWhenNeeded) {
+    CpuResourceManager manager(createTopology());
+    ASSERT_EQ(manager.reserve("a", 12), StatusCode::OK);
+    EXPECT_EQ(manager.getAssignment("a").numaNodes.size(), 2u);
+}
+
+TEST(CpuResourceManagerTest, NotEnoughCoresKeepsPreviousReservation) {
+    CpuResourceManager manager(createTopology());
+    ASSERT_EQ(manager.reserve("a", 8), StatusCode::OK);
+    ASSERT_EQ(manager.reserve("b", 4), StatusCode::OK);
+    auto before = manager.getAssignment("b").cpus;
+    EXPECT_EQ(manager.reserve("b", 10), StatusCode::CPU_CORES_NOT_AVAILABLE);
+    EXPECT_EQ(manager.getAssignment("b").cpus, before);
+    EXPECT_EQ(manager.reserve("c", 5), StatusCode::CPU_CORES_NOT_AVAILABLE);
+    EXPECT_FALSE(manager.getAssignment("c").dedicated);
+}
+
+TEST(CpuResourceManagerTest, ReleaseReturnsCoresToSharedPool) {
+    CpuResourceManager manager(createTopology());
+    ASSERT_EQ(manager.reserve("a", 16), StatusCode::OK);
+    // no free cores left, shared models use all of them
+    EXPECT_EQ(manager.getAssignment("other").cpus.size(), 16u);
+    ASSERT_EQ(manager.reserve("a", 4), StatusCode::OK);
+    EXPECT_EQ(manager.getAssignment("other").cpus.size(), 12u);
+    manager.release("a");
+    EXPECT_FALSE(manager.hasReservations());
+    EXPECT_FALSE(manager.getAssignment("a").dedicated);
+}
+
+TEST(CpuResourceManagerTest, SharedCpusChangeWithReservations) {
+    CpuResourceManager manager(createTopology());
+    // models use plugin defaults until first reservation
+    EXPECT_TRUE(manager.getSharedCpus().empty());
+    ASSERT_EQ(manager.reserve("a", 8), StatusCode::OK);
+    auto shared = manager.getSharedCpus();
+    EXPECT_EQ(shared.size(), 8u);
+    EXPECT_EQ(shared, manager.getAssignment("other").cpus);
+    ASSERT_EQ(manager.reserve("a", 8), StatusCode::OK);
+    EXPECT_EQ(manager.getSharedCpus(), shared);
+    ASSERT_EQ(manager.reserve("a", 4), StatusCode::OK);
+    EXPECT_EQ(manager.getSharedCpus().size(), 12u);
+    manager.release("a");
+    EXPECT_TRUE(manager.getSharedCpus().empty());
+}
+
+TEST(CpuResourceManagerTest, PluginConfigUnchangedWithoutReservations) {
+    CpuResourceManager manager(createTopology());
+    plugin_config_t pluginConfig{{"PERFORMANCE_HINT", "THROUGHPUT"}};
+    manager.applyToPluginConfig("a", pluginConfig);
+    EXPECT_EQ(pluginConfig.size(), 1u);
+}
+
+TEST(CpuResourceManagerTest, AssignmentIsTranslatedToPluginConfig) {
+    CpuResourceManager manager(createTopology());
+    ASSERT_EQ(manager.reserve("a", 8), StatusCode::OK);
+    plugin_config_t reserved{{"PERFORMANCE_HINT", "THROUGHPUT"}};
+    manager.applyToPluginConfig("a", reserved);
+    EXPECT_EQ(reserved["INFERENCE_NUM_THREADS"].as<std::string>(), "8");
+    EXPECT_EQ(reserved["AFFINITY"].as<std::string>(), "NONE");
+    EXPECT_EQ(reserved["NUM_STREAMS"].as<std::string>(), "2");
+
+    plugin_config_t shared{{"PERFORMANCE_HINT", "THROUGHPUT"}};
+    manager.applyToPluginConfig("b", shared);
+    EXPECT_EQ(shared["INFERENCE_NUM_THREADS"].as<std::string>(), "8");
+    EXPECT_EQ(shared["AFFINITY"].as<std::string>(), "NONE");
+    EXPECT_EQ(shared.count("NUM_STREAMS"), 0u);
+}
+
+TEST(CpuResourceManagerTest, UserPluginConfigIsNotOverridden) {
+    CpuResourceManager manager(createTopology());
+    ASSERT_EQ(manager.reserve("a", 8), StatusCode::OK);
+    plugin_config_t pluginConfig{{"INFERENCE_NUM_THREADS", "2"}, {"AFFINITY", "NUMA"}, {"PERFORMANCE_HINT", "LATENCY"}};
+    manager.applyToPluginConfig("a", pluginConfig);
+    EXPECT_EQ(pluginConfig["INFERENCE_NUM_THREADS"].as<std::string>(), "2");
+    EXPECT_EQ(pluginConfig["AFFINITY"].as<std::string>(), "NUMA");
+    EXPECT_EQ(pluginConfig.count("NUM_STREAMS"), 0u);
+}
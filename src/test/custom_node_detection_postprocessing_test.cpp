@@ -0,0 +1,158 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../custom_nodes/common/detection_postprocessing.hpp"
+#include "../custom_nodes/east_ocr/nms.hpp"
+
+using namespace ovms;
+using custom_nodes_common::DetectionBoxes;
+using custom_nodes_common::multiclass_nms;
+using custom_nodes_common::nms;
+using custom_nodes_common::select_scores_above_threshold;
+using custom_nodes_common::select_strided_scores_above_threshold;
+
+using testing::ElementsAre;
+
+static std::vector<uint32_t> allIndexes(size_t count) {
+    std::vector<uint32_t> indexes(count);
+    std::iota(indexes.begin(), indexes.end(), 0);
+    return indexes;
+}
+
+TEST(CustomNodeDetectionPostprocessing, SelectScoresAboveThresholdMatchesScalarLoop) {
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+    // sizes not divisible by vector width check remainder handling
+    for (size_t count : {0, 1, 3, 4, 7, 8, 9, 31, 1000}) {
+        std::vector<float> scores(count);
+        for (auto& score : scores) {
+            score = distribution(generator);
+        }
+        if (count > 2) {
+            scores[2] = 0.5f;
+        }
+        std::vector<uint32_t> expected;
+        for (size_t i = 0; i < count; ++i) {
+            if (scores[i] >= 0.5f) {
+                expected.push_back(i);
+            }
+        }
+        std::vector<uint32_t> indexes;
+        select_scores_above_threshold(scores.data(), scores.size(), 0.5f, indexes);
+        EXPECT_EQ(indexes, expected) << "count: " << count;
+    }
+}
+
+TEST(CustomNodeDetectionPostprocessing, SelectStridedScoresAboveThreshold) {
+    // [image_id, label, confidence] triplets
+    std::vector<float> detections{
+        0, 1, 0.9f,
+        0, 2, 0.1f,
+        0, 3, 0.5f,
+        0, 4, 0.49f};
+    std::vector<uint32_t> indexes;
+    select_strided_scores_above_threshold(detections.data() + 2, 4, 3, 0.5f, indexes);
+    EXPECT_THAT(indexes, ElementsAre(0, 2));
+}
+
+TEST(CustomNodeDetectionPostprocessing, NmsKeepsHighestScoredOfOverlappingBoxes) {
+    DetectionBoxes boxes;
+    boxes.add(0, 0, 10, 10);
+    boxes.add(1, 1, 11, 11);
+    boxes.add(20, 20, 30, 30);
+    boxes.add(0, 0, 10, 10);
+    std::vector<float> scores{0.5f, 0.9f, 0.7f, 0.1f};
+    std::vector<uint32_t> keep;
+    nms(boxes, scores.data(), allIndexes(boxes.size()), 0.3f, boxes.size(), keep);
+    EXPECT_THAT(keep, ElementsAre(1, 2));
+}
+
+TEST(CustomNodeDetectionPostprocessing, NmsStopsAfterMaxOutputs) {
+    DetectionBoxes boxes;
+    std::vector<float> scores;
+    for (int i = 0; i < 10; ++i) {
+        boxes.add(i * 20, 0, i * 20 + 10, 10);
+        scores.push_back(i / 10.0f);
+    }
+    std::vector<uint32_t> keep;
+    nms(boxes, scores.data(), allIndexes(boxes.size()), 0.3f, 3, keep);
+    EXPECT_THAT(keep, ElementsAre(9, 8, 7));
+}
+
+TEST(CustomNodeDetectionPostprocessing, NmsMatchesLegacyImplementation) {
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> position(0, 500);
+    std::uniform_int_distribution<int> size(5, 60);
+    const size_t count = 2000;
+    std::vector<cv::Rect> rects;
+    std::vector<float> scores;
+    std::vector<int> metadata;
+    DetectionBoxes boxes;
+    for (size_t i = 0; i < count; ++i) {
+        cv::Rect rect(position(generator), position(generator), size(generator), size(generator));
+        rects.push_back(rect);
+        // distinct scores, so order of equally scored boxes does not matter
+        scores.push_back(static_cast<float>((i * 7919) % count) / count);
+        metadata.push_back(i);
+        boxes.add(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+    }
+    for (float threshold : {0.0f, 0.3f, 0.7f}) {
+        std::vector<cv::Rect> legacyRects;
+        std::vector<float> legacyScores;
+        std::vector<int> legacyIndexes;
+        nms2(rects, scores, metadata, legacyRects, legacyScores, legacyIndexes, threshold);
+        std::vector<uint32_t> keep;
+        nms(boxes, scores.data(), allIndexes(count), threshold, count, keep);
+        EXPECT_EQ(std::vector<int>(keep.begin(), keep.end()), legacyIndexes) << "threshold: " << threshold;
+    }
+}
+
+TEST(CustomNodeDetectionPostprocessing, NmsBreaksScoreTiesLikeLegacyImplementation) {
+    std::vector<cv::Rect> rects{{0, 0, 10, 10}, {1, 1, 10, 10}, {50, 50, 10, 10}, {51, 51, 10, 10}};
+    std::vector<float> scores{0.5f, 0.5f, 0.5f, 0.5f};
+    std::vector<int> metadata{0, 1, 2, 3};
+    DetectionBoxes boxes;
+    for (const auto& rect : rects) {
+        boxes.add(rect.x, rect.y, rect.x + rect.width, rect.y + rect.height);
+    }
+    std::vector<cv::Rect> legacyRects;
+    std::vector<float> legacyScores;
+    std::vector<int> legacyIndexes;
+    nms2(rects, scores, metadata, legacyRects, legacyScores, legacyIndexes, 0.3f);
+    std::vector<uint32_t> keep;
+    nms(boxes, scores.data(), allIndexes(boxes.size()), 0.3f, boxes.size(), keep);
+    EXPECT_THAT(keep, ElementsAre(3, 1));
+    EXPECT_EQ(std::vector<int>(keep.begin(), keep.end()), legacyIndexes);
+}
+
+TEST(CustomNodeDetectionPostprocessing, MulticlassNmsSuppressesOnlyBoxesWithTheSameLabel) {
+    DetectionBoxes boxes;
+    boxes.add(0, 0, 10, 10);
+    boxes.add(1, 1, 11, 11);
+    boxes.add(0, 0, 10, 10);
+    boxes.add(30, 30, 40, 40);
+    std::vector<float> scores{0.9f, 0.8f, 0.7f, 0.6f};
+    std::vector<int> labels{1, 1, 2, 1};
+    std::vector<uint32_t> keep;
+    multiclass_nms(boxes, scores.data(), labels.data(), allIndexes(boxes.size()), 0.3f, boxes.size(), keep);
+    EXPECT_THAT(keep, ElementsAre(0, 2, 3));
+}
@@ -5259,3 +5259,77 @@ TEST_F(EnsembleFlowCustomNodePipelineExecutionTest, ReloadPipelineWithoutNodeDei
     // in order to count whether deinitialize has been called expected number of times
     ASSERT_EQ(LibraryCountDeinitialize::deinitializeCounter, 3);
 }
+
+struct LibraryCountMetadataCalls {
+    inline static int getInputsInfoCounter;
+    inline static int getOutputsInfoCounter;
+    inline static metadata_fn wrappedGetInputsInfo;
+    inline static metadata_fn wrappedGetOutputsInfo;
+
+    static int initialize(void** customNodeLibraryInternalManager, const struct CustomNodeParam* params, int paramsCount) {
+        return 0;
+    }
+    static int deinitialize(void* customNodeLibraryInternalManager) {
+        return 0;
+    }
+    static int execute(const struct CustomNodeTensor* inputs, int, struct CustomNodeTensor** outputs, int* outputsCount, const struct CustomNodeParam*, int, void* customNodeLibraryInternalManager) {
+        return 0;
+    }
+    static int getInputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
+        getInputsInfoCounter += 1;
+        return wrappedGetInputsInfo(info, infoCount, params, paramsCount, customNodeLibraryInternalManager);
+    }
+    static int getOutputsInfo(struct CustomNodeTensorInfo** info, int* infoCount, const struct CustomNodeParam* params, int paramsCount, void* customNodeLibraryInternalManager) {
+        getOutputsInfoCounter += 1;
+        return wrappedGetOutputsInfo(info, infoCount, params, paramsCount, customNodeLibraryInternalManager);
+    }
+    static int release(void* ptr, void* customNodeLibraryInternalManager) {
+        free(ptr);
+        return 0;
+    }
+};
+
+TEST_F(EnsembleFlowCustomNodePipelineExecutionTest, LibraryMetadataIsRetrievedOncePerNodeInitialization) {
+    // Nodes
+    // request   custom    custom_2    response
+    //  O--------->O--------->O---------->O
+    //          add-sub    add-sub
+    ResourcesAccessModelManager manager;
+    PipelineFactory factory;
+
+    // mocking custom node library and forwarding metadata calls to add_sub_lib in order to count them
+    auto mockedLibrary = createLibraryMock<LibraryCountMetadataCalls>();
+    mockedLibrary.release = library.release;
+    LibraryCountMetadataCalls::wrappedGetInputsInfo = library.getInputsInfo;
+    LibraryCountMetadataCalls::wrappedGetOutputsInfo = library.getOutputsInfo;
+    LibraryCountMetadataCalls::getInputsInfoCounter = 0;
+    LibraryCountMetadataCalls::getOutputsInfoCounter = 0;
+
+    std::vector<NodeInfo> info{
+        {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{pipelineInputName, pipelineInputName}}},
+        {NodeKind::CUSTOM, "custom_node", "", std::nullopt, {{customNodeOutputName, customNodeOutputName}},
+            std::nullopt, {}, mockedLibrary, parameters_t{}},
+        {NodeKind::CUSTOM, "custom_node_2", "", std::nullopt, {{customNodeOutputName, customNodeOutputName}},
+            std::nullopt, {}, mockedLibrary, parameters_t{}},
+        {NodeKind::EXIT, EXIT_NODE_NAME},
+    };
+
+    pipeline_connections_t connections;
+    connections["custom_node"] = {
+        {ENTRY_NODE_NAME, {{pipelineInputName, customNodeInputName}}}};
+    connections["custom_node_2"] = {
+        {"custom_node", {{customNodeOutputName, customNodeInputName}}}};
+    connections[EXIT_NODE_NAME] = {
+        {"custom_node_2", {{customNodeOutputName, pipelineOutputName}}}};
+
+    // Validation asks for metadata of each node several times, library is called once per node
+    ASSERT_EQ(factory.createDefinition("my_new_pipeline", info, connections, manager), StatusCode::OK);
+    EXPECT_EQ(LibraryCountMetadataCalls::getInputsInfoCounter, 2);
+    EXPECT_EQ(LibraryCountMetadataCalls::getOutputsInfoCounter, 2);
+
+    // Reload initializes nodes again, so metadata is retrieved again
+    ASSERT_EQ(factory.reloadDefinition("my_new_pipeline", std::move(info), std::move(connections), manager), StatusCode::OK);
+    EXPECT_EQ(LibraryCountMetadataCalls::getInputsInfoCounter, 4);
+    EXPECT_EQ(LibraryCountMetadataCalls::getOutputsInfoCounter, 4);
+    factory.retireOtherThan({}, manager);
+}
@@ -13,9 +13,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <functional>
 #include <memory>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -37,6 +42,7 @@
 #include "../pipeline_factory.hpp"
 #include "../pipelinedefinition.hpp"
 #include "../prediction_service_utils.hpp"
+#include "../request_scope.hpp"
 #include "../status.hpp"
 #include "../timer.hpp"
 #include "test_utils.hpp"
@@ -198,6 +204,54 @@ protected:
         ::checkDummyResponse(customPipelineOutputName, requestData, request, response, seriesLength, batchSize);
     }
 
+    // entry -> dummy_node -> exit
+    std::unique_ptr<PipelineDefinition> createDummyPipelineDefinition() {
+        std::vector<NodeInfo> info{
+            {NodeKind::ENTRY, ENTRY_NODE_NAME, "", std::nullopt, {{customPipelineInputName, customPipelineInputName}}},
+            {NodeKind::DL, "dummy_node", dummyModelName, std::nullopt, {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_OUTPUT_NAME}}},
+            {NodeKind::EXIT, EXIT_NODE_NAME},
+        };
+        pipeline_connections_t connections;
+        connections["dummy_node"] = {
+            {ENTRY_NODE_NAME, {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}}}};
+        connections[EXIT_NODE_NAME] = {
+            {"dummy_node", {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}}}};
+        return std::make_unique<PipelineDefinition>("originalName", info, connections);
+    }
+
+    // entry -> dummy_node_0 -> ... -> dummy_node_N-1 -> exit
+    std::unique_ptr<Pipeline> createSeriesOfDummyModelsPipeline(ModelManager& manager, int seriesLength,
+        std::function<std::unique_ptr<DLNode>(const std::string& nodeName)> createDummyNode = nullptr) {
+        if (!createDummyNode) {
+            createDummyNode = [this, &manager](const std::string& nodeName) {
+                return std::make_unique<DLNode>(nodeName, dummyModelName, requestedModelVersion, manager);
+            };
+        }
+        const tensor_map_t inputsInfo{{customPipelineInputName, dagDummyModelInputTensorInfo}};
+        auto input_node = std::make_unique<EntryNode<PredictRequest>>(&request, inputsInfo);
+        const tensor_map_t outputsInfo{{customPipelineOutputName, dagDummyModelOutputTensorInfo}};
+        auto output_node = std::make_unique<ExitNode<PredictResponse>>(&response, outputsInfo);
+
+        std::vector<std::unique_ptr<DLNode>> dummy_nodes;
+        for (int i = 0; i < seriesLength; i++) {
+            dummy_nodes.emplace_back(createDummyNode("dummy_node_" + std::to_string(i)));
+        }
+
+        auto pipeline = std::make_unique<Pipeline>(*input_node, *output_node, *this->reporter);
+        pipeline->connect(*input_node, *(dummy_nodes[0]), {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
+        pipeline->connect(*(dummy_nodes[seriesLength - 1]), *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
+        for (int i = 0; i < seriesLength - 1; i++) {
+            pipeline->connect(*(dummy_nodes[i]), *(dummy_nodes[i + 1]), {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
+        }
+
+        pipeline->push(std::move(input_node));
+        pipeline->push(std::move(output_node));
+        for (auto& dummy_node : dummy_nodes) {
+            pipeline->push(std::move(dummy_node));
+        }
+        return pipeline;
+    }
+
     void performWrongPipelineConfigTest(const char* configFileContent) {
         std::string fileToReload = directoryPath + "/ovms_config_file1.json";
         createConfigFileWithContent(configFileContent, fileToReload);
@@ -751,34 +805,11 @@ TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
 
     ConstructorEnabledModelManager managerWithDummyModel;
     managerWithDummyModel.reloadModelWithVersions(config);
-
-    // Configure pipeline
-    const tensor_map_t inputsInfo{{customPipelineInputName, dagDummyModelInputTensorInfo}};
-    auto input_node = std::make_unique<EntryNode<PredictRequest>>(&request, inputsInfo);
-    const tensor_map_t outputsInfo{{customPipelineOutputName, dagDummyModelOutputTensorInfo}};
-    auto output_node = std::make_unique<ExitNode<PredictResponse>>(&response, outputsInfo);
-
-    std::unique_ptr<DLNode> dummy_nodes[N];
-    for (int i = 0; i < N; i++) {
-        dummy_nodes[i] = std::make_unique<DLNode>("dummy_node_" + std::to_string(i), dummyModelName, requestedModelVersion, managerWithDummyModel);
-    }
-
-    Pipeline pipeline(*input_node, *output_node, *this->reporter);
-    pipeline.connect(*input_node, *(dummy_nodes[0]), {{customPipelineInputName, DUMMY_MODEL_INPUT_NAME}});
-    pipeline.connect(*(dummy_nodes[N - 1]), *output_node, {{DUMMY_MODEL_OUTPUT_NAME, customPipelineOutputName}});
-    for (int i = 0; i < N - 1; i++) {
-        pipeline.connect(*(dummy_nodes[i]), *(dummy_nodes[i + 1]), {{DUMMY_MODEL_OUTPUT_NAME, DUMMY_MODEL_INPUT_NAME}});
-    }
-
-    pipeline.push(std::move(input_node));
-    pipeline.push(std::move(output_node));
-    for (auto& dummy_node : dummy_nodes) {
-        pipeline.push(std::move(dummy_node));
-    }
+    auto pipeline = createSeriesOfDummyModelsPipeline(managerWithDummyModel, N);
 
     timer.stop(PREPARE);
     timer.start(EXECUTE);
-    ASSERT_EQ(pipeline.execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
+    ASSERT_EQ(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
     timer.stop(EXECUTE);
 
     timer.start(COMPARE);
@@ -790,6 +821,61 @@ TEST_F(EnsembleFlowTest, SeriesOfDummyModels) {
     std::cout << "compare results: " << timer.elapsed<std::chrono::microseconds>(COMPARE) / 1000 << "ms\n";
 }
 
+class DLNodeCountingExecutions : public DLNode {
+    int& executedNodes;
+    int& finishedNodes;
+
+public:
+    DLNodeCountingExecutions(const std::string& nodeName, const std::string& modelName, std::optional<model_version_t> modelVersion,
+        ModelManager& modelManager, int& executedNodes, int& finishedNodes) :
+        DLNode(nodeName, modelName, modelVersion, modelManager),
+        executedNodes(executedNodes),
+        finishedNodes(finishedNodes) {}
+    ovms::Status execute(session_key_t sessionId, PipelineEventQueue& notifyEndQueue) override {
+        ++executedNodes;
+        return DLNode::execute(sessionId, notifyEndQueue);
+    }
+    ovms::Status fetchResults(NodeSession& nodeSession, SessionResults& sessionResults) override {
+        auto status = DLNode::fetchResults(nodeSession, sessionResults);
+        ++finishedNodes;
+        return status;
+    }
+};
+
+TEST_F(EnsembleFlowTest, CancelledRequestDoesNotStartRemainingNodes) {
+    const int N = 10;
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+    int executedNodes = 0;
+    int finishedNodes = 0;
+    auto pipeline = createSeriesOfDummyModelsPipeline(managerWithDummyModel, N,
+        [&](const std::string& nodeName) {
+            return std::make_unique<DLNodeCountingExecutions>(nodeName, dummyModelName, requestedModelVersion, managerWithDummyModel, executedNodes, finishedNodes);
+        });
+
+    // client cancels once the first node finished
+    RequestScope requestScope(RequestPriority::NORMAL, std::nullopt, [&finishedNodes]() { return finishedNodes > 0; });
+    ASSERT_EQ(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::REQUEST_CANCELLED);
+    EXPECT_EQ(response.outputs().count(customPipelineOutputName), 0);
+    // second node was started together with fetching results of the first one, the rest is skipped
+    EXPECT_EQ(finishedNodes, 1);
+    EXPECT_EQ(executedNodes, 2);
+}
+
+TEST_F(EnsembleFlowTest, ExpiredRequestIsNotInferred) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+    std::shared_ptr<ovms::ModelInstance> model;
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unload_guard;
+    ASSERT_EQ(managerWithDummyModel.getModelInstance(dummyModelName, 0, model, unload_guard), StatusCode::OK);
+
+    PredictRequest simpleModelRequest;
+    prepareRequest(bs1requestData, simpleModelRequest, DUMMY_MODEL_INPUT_NAME);
+    RequestScope requestScope(RequestPriority::NORMAL, RequestScope::Clock::now() - std::chrono::milliseconds(1), nullptr);
+    EXPECT_EQ(model->infer(&simpleModelRequest, &response, unload_guard), StatusCode::REQUEST_DEADLINE_EXCEEDED);
+    EXPECT_EQ(response.outputs().size(), 0);
+}
+
 TEST_F(EnsembleFlowTest, ExecutePipelineWithBatchSizeAny) {
     // Scenario
 
@@ -3336,6 +3422,76 @@ TEST_F(EnsembleFlowTest, ExecuteOnPipelineCreatedBeforeRetireShouldPass) {
     checkDummyResponse(dummySeriallyConnectedCount);
 }
 
+TEST_F(EnsembleFlowTest, PipelineGraphIsReusedAfterSuccessfulExecution) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto pd = createDummyPipelineDefinition();
+    ASSERT_EQ(pd->validate(managerWithDummyModel), StatusCode::OK);
+
+    const Node* firstEntry = nullptr;
+    const Node* firstExit = nullptr;
+    {
+        std::unique_ptr<Pipeline> pipeline;
+        ASSERT_EQ(pd->create(pipeline, &request, &response, managerWithDummyModel), StatusCode::OK);
+        firstEntry = &pipeline->getEntry();
+        firstExit = &pipeline->getExit();
+        ASSERT_EQ(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
+    }
+    checkDummyResponse(1);
+    EXPECT_EQ(pd->getPooledGraphsCount(), 1);
+
+    // Second request reuses nodes bound to new response
+    response.Clear();
+    std::unique_ptr<Pipeline> pipeline;
+    ASSERT_EQ(pd->create(pipeline, &request, &response, managerWithDummyModel), StatusCode::OK);
+    EXPECT_EQ(pd->getPooledGraphsCount(), 0);
+    EXPECT_EQ(&pipeline->getEntry(), firstEntry);
+    EXPECT_EQ(&pipeline->getExit(), firstExit);
+    ASSERT_EQ(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
+    checkDummyResponse(1);
+}
+
+TEST_F(EnsembleFlowTest, PipelineGraphIsNotReusedAfterFailedExecution) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto pd = createDummyPipelineDefinition();
+    ASSERT_EQ(pd->validate(managerWithDummyModel), StatusCode::OK);
+
+    tensorflow::serving::PredictRequest wrongRequest;
+    {
+        std::unique_ptr<Pipeline> pipeline;
+        ASSERT_EQ(pd->create(pipeline, &wrongRequest, &response, managerWithDummyModel), StatusCode::OK);
+        ASSERT_NE(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
+    }
+    EXPECT_EQ(pd->getPooledGraphsCount(), 0);
+}
+
+TEST_F(EnsembleFlowTest, PipelineGraphIsNotReusedAfterRevalidationAndRetire) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto pd = createDummyPipelineDefinition();
+    ASSERT_EQ(pd->validate(managerWithDummyModel), StatusCode::OK);
+
+    {
+        std::unique_ptr<Pipeline> pipeline;
+        ASSERT_EQ(pd->create(pipeline, &request, &response, managerWithDummyModel), StatusCode::OK);
+        ASSERT_EQ(pd->validate(managerWithDummyModel), StatusCode::OK);
+        ASSERT_EQ(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
+    }
+    EXPECT_EQ(pd->getPooledGraphsCount(), 0);
+    {
+        std::unique_ptr<Pipeline> pipeline;
+        ASSERT_EQ(pd->create(pipeline, &request, &response, managerWithDummyModel), StatusCode::OK);
+        ASSERT_EQ(pipeline->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK);
+    }
+    EXPECT_EQ(pd->getPooledGraphsCount(), 1);
+    pd->retire(managerWithDummyModel);
+    EXPECT_EQ(pd->getPooledGraphsCount(), 0);
+}
+
 TEST_F(EnsembleFlowTest, RuntimeWrongBatchSizeArbitraryPosition) {
     ConstructorEnabledModelManager managerWithDummyModel;
 
@@ -3439,6 +3595,54 @@ public:
     }
 };
 
+TEST_F(EnsembleFlowTest, PipelineGraphCreatedDuringRevalidationIsNotReused) {
+    ConstructorEnabledModelManager managerWithDummyModel;
+    config.setBatchSize(1);
+    managerWithDummyModel.reloadModelWithVersions(config);
+
+    auto pd = createDummyPipelineDefinition();
+    pd->makeSubscriptions(managerWithDummyModel);
+    ASSERT_EQ(pd->validate(managerWithDummyModel), StatusCode::OK);
+
+    tensorflow::serving::PredictRequest bs2Request;
+    prepareRequest(std::vector<float>(2 * DUMMY_MODEL_INPUT_SIZE, 1.0), bs2Request, customPipelineInputName, {2, DUMMY_MODEL_INPUT_SIZE});
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> workers;
+    for (int i = 0; i < 4; i++) {
+        workers.emplace_back([this, i, &stop, &pd, &bs2Request, &managerWithDummyModel]() {
+            const tensorflow::serving::PredictRequest* workerRequest = (i % 2) ? &bs2Request : &this->request;
+            while (!stop) {
+                tensorflow::serving::PredictResponse workerResponse;
+                std::unique_ptr<Pipeline> pipeline;
+                if (pd->create(pipeline, workerRequest, &workerResponse, managerWithDummyModel).ok()) {
+                    pipeline->execute(DEFAULT_TEST_CONTEXT);
+                }
+            }
+        });
+    }
+    // every reload changes pipeline inputs info while requests are running, ending with batch size 1
+    for (int i = 0; i < 10; i++) {
+        config.setBatchSize((i % 2) ? 1 : 2);
+        EXPECT_TRUE(managerWithDummyModel.reloadModelWithVersions(config).ok());
+        EXPECT_EQ(pd->validate(managerWithDummyModel), StatusCode::OK);
+    }
+    stop = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    // take all pooled graphs at once, each of them has to accept batch size 1
+    const size_t pipelinesCount = PipelineGraphPool::DEFAULT_CAPACITY + 1;
+    std::vector<tensorflow::serving::PredictResponse> responses(pipelinesCount);
+    std::vector<std::unique_ptr<Pipeline>> pipelines(pipelinesCount);
+    for (size_t i = 0; i < pipelinesCount; i++) {
+        ASSERT_EQ(pd->create(pipelines[i], &request, &responses[i], managerWithDummyModel), StatusCode::OK);
+    }
+    for (size_t i = 0; i < pipelinesCount; i++) {
+        EXPECT_EQ(pipelines[i]->execute(DEFAULT_TEST_CONTEXT), StatusCode::OK) << "pipeline: " << i;
+    }
+}
+
 TEST_F(EnsembleFlowTest, WaitForLoadingPipelineDefinitionFromBeginStatus) {
     ConstructorEnabledModelManager managerWithDummyModel;
     managerWithDummyModel.reloadModelWithVersions(config);
@@ -0,0 +1,117 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../http_rest_api_handler.hpp"
+#include "../http_server.hpp"
+#include "../status.hpp"
+
+using namespace ovms;
+
+static int getPort(int fd) {
+    struct sockaddr_in address;
+    socklen_t length = sizeof(address);
+    if (getsockname(fd, reinterpret_cast<struct sockaddr*>(&address), &length) != 0) {
+        return -1;
+    }
+    return ntohs(address.sin_port);
+}
+
+TEST(HttpServerListenSocket, EventLoopsShareThePort) {
+    int first = createReusePortListenSocket("127.0.0.1", 0);
+    ASSERT_GE(first, 0);
+    int port = getPort(first);
+    ASSERT_GT(port, 0);
+    int second = createReusePortListenSocket("127.0.0.1", port);
+    EXPECT_GE(second, 0);
+    EXPECT_EQ(getPort(second), port);
+    // event loop requires non-blocking socket
+    EXPECT_TRUE(fcntl(second, F_GETFL) & O_NONBLOCK);
+    close(first);
+    if (second >= 0) {
+        close(second);
+    }
+}
+
+TEST(HttpServerListenSocket, InvalidAddress) {
+    EXPECT_EQ(createReusePortListenSocket("not a valid address", 0), -1);
+}
+
+// workers are busy, scheduled handlers are never run
+class SaturatedExecutor : public tensorflow::serving::Executor {
+public:
+    void Schedule(std::function<void()> fn) override {
+        scheduled.emplace_back(std::move(fn));
+    }
+    std::vector<std::function<void()>> scheduled;
+};
+
+TEST(HttpServerRequestLimit, RejectedRequestsAreCounted) {
+    auto serverLoad = std::make_shared<RestServerLoad>();
+    RestRequestLimiter limiter(2, serverLoad);
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_FALSE(limiter.tryAcquire());
+    EXPECT_FALSE(limiter.tryAcquire());
+    EXPECT_EQ(serverLoad->rejectedRequests.load(), 2u);
+    limiter.release();
+    EXPECT_TRUE(limiter.tryAcquire());
+    EXPECT_EQ(serverLoad->rejectedRequests.load(), 2u);
+}
+
+TEST(HttpServerRequestLimit, NoLimitByDefault) {
+    auto serverLoad = std::make_shared<RestServerLoad>();
+    RestRequestLimiter limiter(0, serverLoad);
+    for (int i = 0; i < 1000; i++) {
+        EXPECT_TRUE(limiter.tryAcquire());
+    }
+    EXPECT_EQ(serverLoad->rejectedRequests.load(), 0u);
+}
+
+TEST(HttpServerRequestLimit, RejectedRequestIsAnsweredWithServiceUnavailable) {
+    EXPECT_EQ(http(StatusCode::REST_TOO_MANY_CONCURRENT_REQUESTS), tensorflow::serving::net_http::HTTPStatusCode::SERVICE_UNAV);
+}
+
+TEST(HttpServerRequestLimit, RejectionIsNotQueuedForWorkers) {
+    auto serverLoad = std::make_shared<RestServerLoad>();
+    auto workers = std::make_shared<SaturatedExecutor>();
+    RequestExecutor executor(workers, serverLoad);
+    executor.Schedule([]() {});
+    EXPECT_EQ(workers->scheduled.size(), 1u);
+    EXPECT_EQ(serverLoad->queuedRequests.load(), 1);
+
+    bool rejected = false;
+    RequestExecutor::runNextInline();
+    executor.Schedule([&rejected]() { rejected = true; });
+    EXPECT_TRUE(rejected);
+    EXPECT_EQ(workers->scheduled.size(), 1u);
+    EXPECT_EQ(serverLoad->queuedRequests.load(), 1);
+
+    // only the next handler is run inline
+    executor.Schedule([]() {});
+    EXPECT_EQ(workers->scheduled.size(), 2u);
+    EXPECT_EQ(serverLoad->queuedRequests.load(), 2);
+}
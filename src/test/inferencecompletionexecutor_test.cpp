@@ -0,0 +1,79 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../inferencecompletionexecutor.hpp"
+
+using ovms::InferenceCompletionExecutor;
+
+TEST(InferenceCompletionExecutor, RunsSubmittedTasks) {
+    InferenceCompletionExecutor executor(2);
+    const size_t tasksCount = 100;
+    std::atomic<size_t> executed{0};
+    std::promise<void> allExecuted;
+    for (size_t i = 0; i < tasksCount; ++i) {
+        executor.expect();
+        executor.submit([&executed, &allExecuted, tasksCount]() {
+            if (++executed == tasksCount) {
+                allExecuted.set_value();
+            }
+        });
+    }
+    ASSERT_EQ(allExecuted.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(executed, tasksCount);
+}
+
+TEST(InferenceCompletionExecutor, DestructorWaitsForExpectedTasks) {
+    std::atomic<bool> executed{false};
+    std::thread lateSubmitter;
+    {
+        auto executor = std::make_unique<InferenceCompletionExecutor>(1);
+        executor->expect();
+        InferenceCompletionExecutor* submittingExecutor = executor.get();
+        lateSubmitter = std::thread([submittingExecutor, &executed]() {
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            submittingExecutor->submit([&executed]() { executed = true; });
+        });
+        executor.reset();
+        EXPECT_TRUE(executed);
+    }
+    lateSubmitter.join();
+}
+
+TEST(InferenceCompletionExecutor, WithdrawnTaskDoesNotBlockDestruction) {
+    InferenceCompletionExecutor executor(1);
+    executor.expect();
+    EXPECT_EQ(executor.getPendingCount(), 1);
+    executor.withdraw();
+    EXPECT_EQ(executor.getPendingCount(), 0);
+}
+
+TEST(InferenceCompletionExecutor, TaskExceptionIsContained) {
+    InferenceCompletionExecutor executor(1);
+    std::promise<void> secondExecuted;
+    executor.expect();
+    executor.submit([]() { throw std::runtime_error("completion failed"); });
+    executor.expect();
+    executor.submit([&secondExecuted]() { secondExecuted.set_value(); });
+    ASSERT_EQ(secondExecuted.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
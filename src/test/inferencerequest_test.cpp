@@ -14,6 +14,7 @@
 // limitations under the License.
 //*****************************************************************************
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #include <gmock/gmock.h>
@@ -33,6 +34,7 @@ using ovms::Buffer;
 using ovms::InferenceParameter;
 using ovms::InferenceRequest;
 using ovms::InferenceResponse;
+using ovms::InferenceResponsePool;
 using ovms::InferenceTensor;
 using ovms::Shape;
 using ovms::Status;
@@ -130,6 +132,46 @@ TEST(InferenceRequest, CreateInferenceRequest) {
     ASSERT_EQ(status, StatusCode::OK) << status.string();
     ASSERT_EQ(nullptr, request.getParameter(PARAMETER_NAME.c_str()));
 }
+TEST(InferenceRequest, CallerProvidedOutputs) {
+    InferenceRequest request(MODEL_NAME.c_str(), MODEL_VERSION);
+    std::array<float, 10> outputData{};
+    EXPECT_EQ(request.getOutputsSize(), 0);
+    auto status = request.setOutputBuffer(INPUT_NAME.c_str(), outputData.data(), sizeof(float) * outputData.size(), OVMS_BUFFERTYPE_CPU, std::nullopt);
+    ASSERT_EQ(status, StatusCode::NONEXISTENT_TENSOR_FOR_SET_BUFFER) << status.string();
+    status = request.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = request.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::DOUBLE_TENSOR_INSERT) << status.string();
+    EXPECT_EQ(request.getOutputsSize(), 1);
+    // outputs are not mixed with inputs
+    EXPECT_EQ(request.getInputsSize(), 0);
+    status = request.setOutputBuffer(INPUT_NAME.c_str(), outputData.data(), sizeof(float) * outputData.size(), OVMS_BUFFERTYPE_CPU, std::nullopt);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+
+    const InferenceTensor* tensor{nullptr};
+    status = request.getOutput(INPUT_NAME.c_str(), &tensor);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    ASSERT_NE(nullptr, tensor);
+    EXPECT_EQ(tensor->getDataType(), DATATYPE);
+    EXPECT_TRUE(Shape(tensor->getShape()).match(INPUT_SHAPE));
+    const Buffer* buffer = tensor->getBuffer();
+    ASSERT_NE(nullptr, buffer);
+    // caller memory is referenced, never copied
+    EXPECT_EQ(buffer->data(), outputData.data());
+    EXPECT_EQ(buffer->getByteSize(), sizeof(float) * outputData.size());
+
+    status = request.removeOutputBuffer(INPUT_NAME.c_str());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = request.removeOutputBuffer(INPUT_NAME.c_str());
+    ASSERT_EQ(status, StatusCode::NONEXISTENT_BUFFER_FOR_REMOVAL) << status.string();
+    status = request.removeOutput(INPUT_NAME.c_str());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = request.removeOutput(INPUT_NAME.c_str());
+    ASSERT_EQ(status, StatusCode::NONEXISTENT_TENSOR_FOR_REMOVAL) << status.string();
+    status = request.getOutput(INPUT_NAME.c_str(), &tensor);
+    ASSERT_EQ(status, StatusCode::NONEXISTENT_TENSOR) << status.string();
+    EXPECT_EQ(nullptr, tensor);
+}
 TEST(InferenceResponse, CreateAndReadData) {
     // create response
     InferenceResponse response{MODEL_NAME, MODEL_VERSION};
@@ -196,3 +238,105 @@ TEST(InferenceResponse, CreateAndReadData) {
     status = response.addParameter(PARAMETER_NAME.c_str(), PARAMETER_DATATYPE, reinterpret_cast<const void*>(&PARAMETER_VALUE));
     ASSERT_EQ(status, StatusCode::DOUBLE_PARAMETER_INSERT) << status.string();
 }
+TEST(InferenceResponse, RecycleKeepsMatchingOutputs) {
+    InferenceResponse response{MODEL_NAME, MODEL_VERSION};
+    auto status = response.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    const std::string* outputName = nullptr;
+    InferenceTensor* tensor = nullptr;
+    status = response.getOutput(0, &outputName, &tensor);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = tensor->setBuffer(INPUT_DATA.data(), INPUT_DATA_BYTESIZE, OVMS_BUFFERTYPE_CPU, std::nullopt, true);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    const void* ownedData = tensor->getBuffer()->data();
+    status = response.addParameter(PARAMETER_NAME.c_str(), PARAMETER_DATATYPE, reinterpret_cast<const void*>(&PARAMETER_VALUE));
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+
+    response.recycle();
+    EXPECT_EQ(response.getOutputCount(), 0);
+    EXPECT_EQ(response.getParameterCount(), 0);
+    status = response.getOutput(0, &outputName, &tensor);
+    ASSERT_EQ(status, StatusCode::NONEXISTENT_TENSOR) << status.string();
+
+    // output with the same name, datatype and shape is reused with its buffer
+    status = response.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = response.getOutput(0, &outputName, &tensor);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    ASSERT_NE(nullptr, tensor->getBuffer());
+    EXPECT_EQ(tensor->getBuffer()->data(), ownedData);
+    std::array<float, 10> RANDOM_DATA{10., 9, 8, 7, 6, 5, 4, 3, 2, 1};
+    status = tensor->refillBuffer(RANDOM_DATA.data(), INPUT_DATA_BYTESIZE);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    EXPECT_EQ(tensor->getBuffer()->data(), ownedData);
+    EXPECT_EQ(0, std::memcmp(ownedData, RANDOM_DATA.data(), INPUT_DATA_BYTESIZE));
+    status = tensor->refillBuffer(RANDOM_DATA.data(), INPUT_DATA_BYTESIZE - 1);
+    ASSERT_EQ(status, StatusCode::INVALID_CONTENT_SIZE) << status.string();
+    status = response.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::DOUBLE_TENSOR_INSERT) << status.string();
+
+    // output with different shape replaces recycled one
+    response.recycle();
+    const ovms::shape_t otherShape{1, 10};
+    status = response.addOutput(INPUT_NAME.c_str(), DATATYPE, otherShape.data(), otherShape.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = response.getOutput(0, &outputName, &tensor);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    EXPECT_EQ(nullptr, tensor->getBuffer());
+    EXPECT_THAT(tensor->getShape(), ElementsAre(1, 10));
+    EXPECT_EQ(response.getOutputCount(), 1);
+}
+TEST(InferenceResponse, RecycleDropsNotOwnedBuffers) {
+    InferenceResponse response{MODEL_NAME, MODEL_VERSION};
+    auto status = response.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    const std::string* outputName = nullptr;
+    InferenceTensor* tensor = nullptr;
+    status = response.getOutput(0, &outputName, &tensor);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = tensor->setBuffer(INPUT_DATA.data(), INPUT_DATA_BYTESIZE, OVMS_BUFFERTYPE_CPU, std::nullopt);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    response.recycle();
+    status = response.addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    status = response.getOutput(0, &outputName, &tensor);
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    EXPECT_EQ(nullptr, tensor->getBuffer());
+}
+TEST(InferenceResponsePool, ReusesGivenBackResponses) {
+    auto pool = std::make_shared<InferenceResponsePool>(MODEL_NAME, MODEL_VERSION);
+    auto response = pool->acquire();
+    ASSERT_NE(nullptr, response);
+    EXPECT_EQ(response->getServableName(), MODEL_NAME);
+    EXPECT_EQ(response->getServableVersion(), MODEL_VERSION);
+    EXPECT_EQ(response->getPool(), pool);
+    auto status = response->addOutput(INPUT_NAME.c_str(), DATATYPE, INPUT_SHAPE.data(), INPUT_SHAPE.size());
+    ASSERT_EQ(status, StatusCode::OK) << status.string();
+    InferenceResponse* responseAddress = response.get();
+    EXPECT_EQ(pool->getSpareCount(), 0);
+    pool->giveBack(std::move(response));
+    EXPECT_EQ(pool->getSpareCount(), 1);
+
+    response = pool->acquire();
+    EXPECT_EQ(response.get(), responseAddress);
+    EXPECT_EQ(response->getOutputCount(), 0);
+    EXPECT_EQ(pool->getSpareCount(), 0);
+    auto secondResponse = pool->acquire();
+    EXPECT_NE(secondResponse.get(), responseAddress);
+    // response keeps pool alive
+    std::weak_ptr<InferenceResponsePool> weakPool = pool;
+    pool.reset();
+    EXPECT_FALSE(weakPool.expired());
+    weakPool.lock()->giveBack(std::move(secondResponse));
+    response->getPool()->giveBack(std::move(response));
+    EXPECT_TRUE(weakPool.expired());
+}
+TEST(InferenceResponsePool, OutlivesServableNameOfRequest) {
+    auto servableName = std::make_unique<std::string>(MODEL_NAME);
+    auto pool = std::make_shared<InferenceResponsePool>(*servableName, MODEL_VERSION);
+    auto response = pool->acquire();
+    servableName.reset();
+    EXPECT_EQ(response->getServableName(), MODEL_NAME);
+    pool->giveBack(std::move(response));
+    EXPECT_EQ(pool->acquire()->getServableName(), MODEL_NAME);
+}
@@ -0,0 +1,137 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../input_plan.hpp"
+#include "../predict_request_validation_utils.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+class InputPlanTest : public ::testing::Test {
+protected:
+    static constexpr size_t INPUTS_COUNT = 24;
+    ovms::tensor_map_t servableInputs;
+    ::KFSRequest request;
+
+    static std::string inputName(size_t i) {
+        return "input_" + std::to_string(i);
+    }
+
+    void SetUp() override {
+        inputs_info_t requestInputs;
+        for (size_t i = 0; i < INPUTS_COUNT; i++) {
+            servableInputs[inputName(i)] = std::make_shared<ovms::TensorInfo>(inputName(i), ovms::Precision::FP32, ovms::shape_t{1, 10}, ovms::Layout{"NC"});
+            requestInputs[inputName(i)] = std::tuple<ovms::shape_t, ovms::Precision>{{1, 10}, ovms::Precision::FP32};
+        }
+        preparePredictRequest(request, requestInputs);
+    }
+
+    ovms::Status validate(const ovms::InputPlan* plan) {
+        return ovms::request_validation_utils::validate(request, servableInputs, "dummy", ovms::model_version_t{1}, {}, ovms::Mode::FIXED, ovms::shapes_info_map_t(), plan);
+    }
+};
+
+TEST_F(InputPlanTest, MapRequestInputs) {
+    ovms::tensor_map_t inputs{
+        {"a", std::make_shared<ovms::TensorInfo>("a", ovms::Precision::FP32, ovms::shape_t{1})},
+        {"b", std::make_shared<ovms::TensorInfo>("b", ovms::Precision::FP32, ovms::shape_t{1})},
+        {"c", std::make_shared<ovms::TensorInfo>("c", ovms::Precision::FP32, ovms::shape_t{1})}};
+    ovms::InputPlan plan(inputs);
+    EXPECT_TRUE(plan.isBuiltFor(inputs));
+    EXPECT_EQ(plan.size(), 3u);
+    ::KFSRequest kfsRequest;
+    kfsRequest.add_inputs()->set_name("c");
+    kfsRequest.add_inputs()->set_name("unknown");
+    kfsRequest.add_inputs()->set_name("a");
+    kfsRequest.add_inputs()->set_name("c");
+    ovms::RequestInputPositions positions;
+    plan.mapRequestInputs(kfsRequest, positions);
+    ASSERT_EQ(positions.size(), 3u);
+    EXPECT_EQ(positions[0], 2);
+    EXPECT_EQ(positions[1], ovms::InputPlan::MISSING);
+    EXPECT_EQ(positions[2], 0);
+}
+
+TEST_F(InputPlanTest, ValidationFillsRequestInputPositions) {
+    static_assert(INPUTS_COUNT > ovms::RequestInputPositions::INLINE_CAPACITY);
+    std::reverse(request.mutable_inputs()->begin(), request.mutable_inputs()->end());
+    ovms::InputPlan plan(servableInputs);
+    ovms::RequestInputPositions positions;
+    ASSERT_EQ(ovms::request_validation_utils::validate(request, servableInputs, "dummy", ovms::model_version_t{1}, {}, ovms::Mode::FIXED, ovms::shapes_info_map_t(), &plan, &positions), ovms::StatusCode::OK);
+    ASSERT_EQ(positions.size(), INPUTS_COUNT);
+    size_t ordinal = 0;
+    for (const auto& [name, _] : servableInputs) {
+        EXPECT_EQ(request.inputs(positions[ordinal++]).name(), name);
+    }
+    // without plan positions are left empty and deserialization searches inputs by name
+    ASSERT_EQ(ovms::request_validation_utils::validate(request, servableInputs, "dummy", ovms::model_version_t{1}, {}, ovms::Mode::FIXED, ovms::shapes_info_map_t(), nullptr, &positions), ovms::StatusCode::OK);
+    EXPECT_TRUE(positions.empty());
+}
+
+TEST_F(InputPlanTest, NotUsedForOtherInputs) {
+    ovms::tensor_map_t copy = servableInputs;
+    ovms::InputPlan plan(servableInputs);
+    EXPECT_TRUE(plan.isBuiltFor(servableInputs));
+    EXPECT_FALSE(plan.isBuiltFor(copy));
+    EXPECT_FALSE(ovms::InputPlan().isBuiltFor(servableInputs));
+}
+
+TEST_F(InputPlanTest, ValidRequest) {
+    ovms::InputPlan plan(servableInputs);
+    EXPECT_EQ(validate(&plan), ovms::StatusCode::OK);
+    EXPECT_EQ(validate(nullptr), ovms::StatusCode::OK);
+}
+
+TEST_F(InputPlanTest, ValidRequestInReversedOrder) {
+    std::reverse(request.mutable_inputs()->begin(), request.mutable_inputs()->end());
+    ovms::InputPlan plan(servableInputs);
+    EXPECT_EQ(validate(&plan), ovms::StatusCode::OK);
+}
+
+TEST_F(InputPlanTest, MissingInput) {
+    request.mutable_inputs()->Mutable(INPUTS_COUNT / 2)->set_name("unknown");
+    ovms::InputPlan plan(servableInputs);
+    EXPECT_EQ(validate(&plan), ovms::StatusCode::INVALID_MISSING_INPUT);
+    EXPECT_EQ(validate(nullptr), ovms::StatusCode::INVALID_MISSING_INPUT);
+}
+
+TEST_F(InputPlanTest, ContentOfMatchedInputIsValidated) {
+    // raw buffer of input is found by request input position, not by servable input order
+    std::reverse(request.mutable_inputs()->begin(), request.mutable_inputs()->end());
+    request.mutable_raw_input_contents()->Mutable(0)->resize(4);
+    ovms::InputPlan plan(servableInputs);
+    EXPECT_EQ(validate(&plan), ovms::StatusCode::INVALID_CONTENT_SIZE);
+    EXPECT_EQ(validate(nullptr), ovms::StatusCode::INVALID_CONTENT_SIZE);
+}
+
+// Run with --gtest_also_run_disabled_tests to compare validation time with and without input plan
+TEST_F(InputPlanTest, DISABLED_ValidationBenchmark) {
+    const size_t iterations = 100000;
+    ovms::InputPlan plan(servableInputs);
+    for (const ovms::InputPlan* usedPlan : {static_cast<const ovms::InputPlan*>(nullptr), &plan}) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            ASSERT_EQ(validate(usedPlan), ovms::StatusCode::OK);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - start).count();
+        RecordProperty(usedPlan != nullptr ? "with_input_plan_ns" : "without_input_plan_ns", static_cast<int>(elapsed / iterations));
+    }
+}
@@ -15,15 +15,19 @@
 //*****************************************************************************
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <rapidjson/document.h>
 
+#include "../compression.hpp"
 #include "../config.hpp"
 #include "../grpcservermodule.hpp"
 #include "../http_rest_api_handler.hpp"
 #include "../servablemanagermodule.hpp"
 #include "../server.hpp"
+#include "../shared_memory_manager.hpp"
 #include "../status.hpp"
 #include "../version.hpp"
 
@@ -187,6 +191,99 @@ TEST_F(HttpRestApiHandlerTest, RegexParseServerLive) {
     ASSERT_EQ(comp.type, ovms::KFS_GetServerLive);
 }
 
+TEST_F(HttpRestApiHandlerTest, RegexParseProfiler) {
+    ovms::HttpRequestComponents comp;
+
+    ASSERT_EQ(handler->parseRequestComponents(comp, "GET", "/v1/profiler"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::ProfilerStatus);
+    ASSERT_EQ(handler->parseRequestComponents(comp, "POST", "/v1/profiler"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::ProfilerConfig);
+    ASSERT_EQ(handler->parseRequestComponents(comp, "GET", "/v1/profiler/trace"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::ProfilerTrace);
+}
+
+TEST_F(HttpRestApiHandlerTest, RegexParseSharedMemory) {
+    ovms::HttpRequestComponents comp;
+
+    ASSERT_EQ(handler->parseRequestComponents(comp, "GET", "/v2/systemsharedmemory/status"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::KFS_SharedMemoryStatus);
+    ASSERT_EQ(comp.shared_memory_region, "");
+    ASSERT_EQ(handler->parseRequestComponents(comp, "GET", "/v2/systemsharedmemory/region/input_region/status"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::KFS_SharedMemoryStatus);
+    ASSERT_EQ(comp.shared_memory_region, "input_region");
+    ASSERT_EQ(handler->parseRequestComponents(comp, "POST", "/v2/systemsharedmemory/region/input_region/register"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::KFS_SharedMemoryRegister);
+    ASSERT_EQ(comp.shared_memory_region, "input_region");
+    ASSERT_EQ(handler->parseRequestComponents(comp, "POST", "/v2/systemsharedmemory/region/input_region/unregister"), StatusCode::OK);
+    ASSERT_EQ(comp.type, ovms::KFS_SharedMemoryUnregister);
+    ASSERT_EQ(comp.shared_memory_region, "input_region");
+    ovms::HttpRequestComponents allRegions;
+    ASSERT_EQ(handler->parseRequestComponents(allRegions, "POST", "/v2/systemsharedmemory/unregister"), StatusCode::OK);
+    ASSERT_EQ(allRegions.type, ovms::KFS_SharedMemoryUnregister);
+    ASSERT_EQ(allRegions.shared_memory_region, "");
+
+    EXPECT_EQ(handler->parseRequestComponents(comp, "POST", "/v2/systemsharedmemory/register"), StatusCode::REST_UNSUPPORTED_METHOD);
+    EXPECT_EQ(handler->parseRequestComponents(comp, "POST", "/v2/systemsharedmemory/status"), StatusCode::REST_UNSUPPORTED_METHOD);
+    EXPECT_EQ(handler->parseRequestComponents(comp, "GET", "/v2/systemsharedmemory/region/input_region/register"), StatusCode::REST_UNSUPPORTED_METHOD);
+}
+
+TEST_F(HttpRestApiHandlerTest, SharedMemoryDisabledByDefault) {
+    ovms::HttpRequestComponents comp;
+    comp.shared_memory_region = "region";
+    std::string response;
+    EXPECT_EQ(handler->processSharedMemoryRegisterKFSRequest(comp, response, R"({"key": "/ovms_missing", "byte_size": 16})"), StatusCode::SHARED_MEMORY_DISABLED);
+    EXPECT_EQ(handler->processSharedMemoryUnregisterKFSRequest(comp, response), StatusCode::SHARED_MEMORY_DISABLED);
+    EXPECT_EQ(handler->processSharedMemoryStatusKFSRequest(ovms::HttpRequestComponents{}, response), StatusCode::SHARED_MEMORY_DISABLED);
+}
+
+TEST_F(HttpRestApiHandlerTest, SharedMemoryRegisterRequestValidation) {
+    ovms::SharedMemoryManager manager;
+    auto& kfsGrpcImpl = dynamic_cast<const ovms::GRPCServerModule*>(server->getModule(ovms::GRPC_SERVER_MODULE_NAME))->getKFSGrpcImpl();
+    kfsGrpcImpl.setSharedMemoryManager(&manager);
+    ovms::HttpRequestComponents comp;
+    comp.shared_memory_region = "region";
+    std::string response;
+    EXPECT_EQ(handler->processSharedMemoryRegisterKFSRequest(comp, response, "not json"), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    EXPECT_EQ(handler->processSharedMemoryRegisterKFSRequest(comp, response, R"({"byte_size": 16})"), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    EXPECT_EQ(handler->processSharedMemoryRegisterKFSRequest(comp, response, R"({"key": "/ovms_missing"})"), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    EXPECT_EQ(handler->processSharedMemoryRegisterKFSRequest(comp, response, R"({"key": "/ovms_missing", "offset": -1, "byte_size": 16})"), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    EXPECT_EQ(handler->processSharedMemoryRegisterKFSRequest(comp, response, R"({"key": "/ovms_missing", "byte_size": 16})"), StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED);
+    EXPECT_EQ(handler->processSharedMemoryUnregisterKFSRequest(comp, response), StatusCode::SHARED_MEMORY_REGION_NOT_FOUND);
+    EXPECT_EQ(handler->processSharedMemoryStatusKFSRequest(ovms::HttpRequestComponents{}, response), StatusCode::OK);
+    EXPECT_EQ(response, "[]");
+    kfsGrpcImpl.setSharedMemoryManager(nullptr);
+}
+
+TEST_F(HttpRestApiHandlerTest, ProfilerConfig) {
+    std::string response;
+    ASSERT_EQ(handler->processProfilerConfigRequest(R"({"enable": true, "sampling_rate": 7, "retention_seconds": 3})", response), StatusCode::OK);
+    rapidjson::Document doc;
+    doc.Parse(response.c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    EXPECT_TRUE(doc["enable"].GetBool());
+    EXPECT_EQ(doc["sampling_rate"].GetUint(), 7);
+    EXPECT_EQ(doc["retention_seconds"].GetUint(), 3);
+
+    ASSERT_EQ(handler->processProfilerConfigRequest(R"({"enable": false})", response), StatusCode::OK);
+    ASSERT_EQ(handler->processProfilerStatusRequest(response), StatusCode::OK);
+    doc.Parse(response.c_str());
+    EXPECT_FALSE(doc["enable"].GetBool());
+    EXPECT_EQ(doc["sampling_rate"].GetUint(), 7);
+
+    EXPECT_EQ(handler->processProfilerConfigRequest(R"({"enable": 1})", response), StatusCode::REST_PROFILER_SETTINGS_INVALID);
+    EXPECT_EQ(handler->processProfilerConfigRequest(R"({"sampling_rate": 0})", response), StatusCode::REST_PROFILER_SETTINGS_INVALID);
+    EXPECT_EQ(handler->processProfilerConfigRequest(R"({"retention_seconds": -5})", response), StatusCode::REST_PROFILER_SETTINGS_INVALID);
+    EXPECT_EQ(handler->processProfilerConfigRequest(R"([])", response), StatusCode::REST_PROFILER_SETTINGS_INVALID);
+    EXPECT_EQ(handler->processProfilerConfigRequest("not json", response), StatusCode::REST_PROFILER_SETTINGS_INVALID);
+
+    ASSERT_EQ(handler->processProfilerTraceRequest(response), StatusCode::OK);
+    doc.Parse(response.c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    EXPECT_TRUE(doc["traceEvents"].IsArray());
+
+    ASSERT_EQ(handler->processProfilerConfigRequest(R"({"enable": false, "sampling_rate": 100, "retention_seconds": 10})", response), StatusCode::OK);
+}
+
 TEST_F(HttpRestApiHandlerTest, RegexParseInferWithBinaryInputs) {
     std::string request = "/v2/models/dummy/versions/1/infer";
     ovms::HttpRequestComponents comp;
@@ -314,6 +411,68 @@ TEST_F(HttpRestApiHandlerTest, inferRequest) {
     }
 }
 
+TEST_F(HttpRestApiHandlerTest, inferRequestWithCompressedBody) {
+    std::string request_body = "{\"inputs\":[{\"name\":\"b\",\"shape\":[1,10],\"datatype\":\"FP32\",\"data\":[0,1,2,3,4,5,6,7,8,9]}], \"id\":\"1\"}";
+    for (const auto& encoding : {ovms::GZIP_ENCODING, ovms::DEFLATE_ENCODING}) {
+        std::string compressed;
+        ASSERT_EQ(ovms::compress(request_body, encoding, compressed), ovms::StatusCode::OK);
+        std::vector<std::pair<std::string, std::string>> headers{{"Content-Encoding", encoding}, {"Accept-Encoding", "gzip"}};
+        std::string response;
+        ovms::HttpResponseComponents responseComponents;
+        ASSERT_EQ(handler->processRequest("POST", "/v2/models/dummy/versions/1/infer", compressed, &headers, &response, responseComponents), ovms::StatusCode::OK);
+        // response is smaller than default rest_compression_threshold
+        EXPECT_FALSE(responseComponents.contentEncoding.has_value());
+        rapidjson::Document doc;
+        doc.Parse(response.c_str());
+        ASSERT_EQ(doc["id"].GetString(), std::string("1"));
+    }
+}
+
+TEST_F(HttpRestApiHandlerTest, inferRequestWithCompressedBodyOverMaxBodySizeIsRejected) {
+    std::string request_body = "{\"inputs\":[{\"name\":\"b\",\"shape\":[1,10],\"datatype\":\"FP32\",\"data\":[0,1,2,3,4,5,6,7,8,9]}], \"id\":\"1\"}";
+    auto limitedHandler = std::make_unique<HttpRestApiHandler>(*server, 5, nullptr, request_body.size() - 1);
+    for (const auto& encoding : {ovms::GZIP_ENCODING, ovms::DEFLATE_ENCODING}) {
+        std::string compressed;
+        ASSERT_EQ(ovms::compress(request_body, encoding, compressed), ovms::StatusCode::OK);
+        std::vector<std::pair<std::string, std::string>> headers{{"Content-Encoding", encoding}};
+        std::string response;
+        ovms::HttpResponseComponents responseComponents;
+        EXPECT_EQ(limitedHandler->processRequest("POST", "/v2/models/dummy/versions/1/infer", compressed, &headers, &response, responseComponents), ovms::StatusCode::REST_DECOMPRESSION_ERROR);
+        headers = {{"Content-Encoding", encoding}};
+        auto exactLimitHandler = std::make_unique<HttpRestApiHandler>(*server, 5, nullptr, request_body.size());
+        EXPECT_EQ(exactLimitHandler->processRequest("POST", "/v2/models/dummy/versions/1/infer", compressed, &headers, &response, responseComponents), ovms::StatusCode::OK);
+    }
+}
+
+TEST_F(HttpRestApiHandlerTest, inferRequestWithUnsupportedContentEncoding) {
+    std::vector<std::pair<std::string, std::string>> headers{{"Content-Encoding", "br"}};
+    std::string response;
+    ovms::HttpResponseComponents responseComponents;
+    EXPECT_EQ(handler->processRequest("POST", "/v2/models/dummy/versions/1/infer", "{}", &headers, &response, responseComponents), ovms::StatusCode::REST_UNSUPPORTED_CONTENT_ENCODING);
+}
+
+TEST_F(HttpRestApiHandlerTest, predictRequestWithBinaryDataOutput) {
+    std::string request_body = R"({"binary_data_output": true, "instances": [[0,1,2,3,4,5,6,7,8,9]]})";
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string response;
+    ovms::HttpResponseComponents responseComponents;
+    ASSERT_EQ(handler->processRequest("POST", "/v1/models/dummy/versions/1:predict", request_body, &headers, &response, responseComponents), ovms::StatusCode::OK);
+    ASSERT_TRUE(responseComponents.inferenceHeaderContentLength.has_value());
+    const size_t headerLength = responseComponents.inferenceHeaderContentLength.value();
+    ASSERT_EQ(response.size(), headerLength + 10 * sizeof(float));
+    rapidjson::Document doc;
+    doc.Parse(response.substr(0, headerLength).c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    auto output = doc["outputs"].GetArray()[0].GetObject();
+    EXPECT_EQ(output["name"].GetString(), std::string("a"));
+    EXPECT_EQ(output["datatype"].GetString(), std::string("FP32"));
+    EXPECT_EQ(output["parameters"]["binary_data_size"].GetUint64(), 10 * sizeof(float));
+    const float* data = reinterpret_cast<const float*>(response.data() + headerLength);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(data[i], i + 1);
+    }
+}
+
 TEST_F(HttpRestApiHandlerTest, inferPreprocess) {
     std::string request_body("{\"inputs\":[{\"name\":\"b\",\"shape\":[1,10],\"datatype\":\"FP32\",\"data\":[0,1,2,3,4,5,6,7,8,9]}],\"parameters\":{\"binary_data_output\":1, \"bool_test\":true, \"string_test\":\"test\"}}");
 
@@ -0,0 +1,214 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../grpcservermodule.hpp"
+#include "../kfs_frontend/kfs_grpc_inference_service.hpp"
+#include "../kfs_frontend/kfs_stream_infer_session.hpp"
+#include "../model.hpp"
+#include "../servablemanagermodule.hpp"
+#include "../server.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+using ovms::StatusCode;
+
+namespace {
+class MockedServer : public ovms::Server {
+public:
+    MockedServer() = default;
+};
+
+class FakeStream : public KFSStreamReaderWriter {
+    std::mutex mtx;
+    std::vector<KFSRequest> requests;
+    size_t nextRequest = 0;
+    size_t failWriteAfter;
+
+public:
+    std::vector<KFSStreamResponse> responses;
+
+    FakeStream(std::vector<KFSRequest> requests, size_t failWriteAfter = std::numeric_limits<size_t>::max()) :
+        requests(std::move(requests)),
+        failWriteAfter(failWriteAfter) {}
+
+    void SendInitialMetadata() override {}
+    bool NextMessageSize(uint32_t* sz) override {
+        *sz = 0;
+        return nextRequest < requests.size();
+    }
+    bool Read(KFSRequest* msg) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (nextRequest >= requests.size()) {
+            return false;
+        }
+        *msg = requests[nextRequest++];
+        return true;
+    }
+    using KFSStreamReaderWriter::Write;
+    bool Write(const KFSStreamResponse& msg, ::grpc::WriteOptions options) override {
+        std::unique_lock<std::mutex> lock(mtx);
+        if (responses.size() >= failWriteAfter) {
+            return false;
+        }
+        responses.push_back(msg);
+        return true;
+    }
+};
+}  // namespace
+
+class KFSStreamInferTest : public ::testing::Test {
+public:
+    static void SetUpTestSuite() {
+        server = std::make_unique<MockedServer>();
+        std::string port = "9187";
+        char* argv[] = {
+            (char*)"OpenVINO Model Server",
+            (char*)"--model_name",
+            (char*)"dummy",
+            (char*)"--model_path",
+            (char*)"/ovms/src/test/dummy",
+            (char*)"--port",
+            (char*)port.c_str(),
+            nullptr};
+        thread = std::make_unique<std::thread>(
+            [&argv]() {
+                ASSERT_EQ(EXIT_SUCCESS, server->start(7, argv));
+            });
+        auto start = std::chrono::high_resolution_clock::now();
+        while ((server->getModuleState(ovms::SERVABLE_MANAGER_MODULE_NAME) != ovms::ModuleState::INITIALIZED) &&
+               (std::chrono::duration_cast<std::chrono::seconds>(std::chrono::high_resolution_clock::now() - start).count() < 5)) {
+        }
+    }
+    static void TearDownTestSuite() {
+        server->setShutdownRequest(1);
+        thread->join();
+        server->setShutdownRequest(0);
+    }
+
+    ovms::KFSInferenceServiceImpl& getService() {
+        return dynamic_cast<const ovms::GRPCServerModule*>(server->getModule(ovms::GRPC_SERVER_MODULE_NAME))->getKFSGrpcImpl();
+    }
+
+    static KFSRequest prepareRequest(const std::string& servableName, const std::string& id, float value) {
+        KFSRequest request;
+        request.set_model_name(servableName);
+        request.set_id(id);
+        std::vector<float> data(DUMMY_MODEL_INPUT_SIZE, value);
+        preparePredictRequest(request, {{DUMMY_MODEL_INPUT_NAME, std::tuple<ovms::shape_t, ovms::Precision>{{1, DUMMY_MODEL_INPUT_SIZE}, ovms::Precision::FP32}}}, data);
+        return request;
+    }
+
+    static std::unique_ptr<MockedServer> server;
+    static std::unique_ptr<std::thread> thread;
+};
+
+std::unique_ptr<MockedServer> KFSStreamInferTest::server = nullptr;
+std::unique_ptr<std::thread> KFSStreamInferTest::thread = nullptr;
+
+TEST_F(KFSStreamInferTest, ResponsesAreReturnedInOrder) {
+    const size_t requestsCount = 3 * ovms::KFSStreamInferSession::MAX_IN_FLIGHT_REQUESTS + 1;
+    std::vector<KFSRequest> requests;
+    for (size_t i = 0; i < requestsCount; i++) {
+        requests.push_back(prepareRequest("dummy", std::to_string(i), static_cast<float>(i)));
+    }
+    FakeStream stream(std::move(requests));
+    ASSERT_EQ(getService().ModelStreamInferImpl(nullptr, &stream), StatusCode::OK);
+    ASSERT_EQ(stream.responses.size(), requestsCount);
+    for (size_t i = 0; i < requestsCount; i++) {
+        const auto& response = stream.responses[i];
+        EXPECT_TRUE(response.error_message().empty()) << response.error_message();
+        EXPECT_EQ(response.infer_response().id(), std::to_string(i));
+        ASSERT_EQ(response.infer_response().raw_output_contents_size(), 1);
+        const std::string& content = response.infer_response().raw_output_contents(0);
+        ASSERT_EQ(content.size(), DUMMY_MODEL_OUTPUT_SIZE * sizeof(float));
+        const float* output = reinterpret_cast<const float*>(content.data());
+        EXPECT_EQ(output[0], static_cast<float>(i) + 1);
+    }
+}
+
+TEST_F(KFSStreamInferTest, ErrorDoesNotTerminateStream) {
+    std::vector<KFSRequest> requests;
+    requests.push_back(prepareRequest("dummy", "0", 0));
+    requests.push_back(prepareRequest("not_existing", "1", 0));
+    requests.push_back(prepareRequest("dummy", "2", 0));
+    FakeStream stream(std::move(requests));
+    ASSERT_EQ(getService().ModelStreamInferImpl(nullptr, &stream), StatusCode::OK);
+    ASSERT_EQ(stream.responses.size(), 3u);
+    EXPECT_TRUE(stream.responses[0].error_message().empty());
+    EXPECT_FALSE(stream.responses[1].error_message().empty());
+    EXPECT_EQ(stream.responses[1].infer_response().id(), "1");
+    EXPECT_TRUE(stream.responses[2].error_message().empty());
+    EXPECT_EQ(stream.responses[2].infer_response().id(), "2");
+}
+
+TEST_F(KFSStreamInferTest, EmptyStream) {
+    FakeStream stream({});
+    EXPECT_EQ(getService().ModelStreamInferImpl(nullptr, &stream), StatusCode::OK);
+    EXPECT_TRUE(stream.responses.empty());
+}
+
+TEST_F(KFSStreamInferTest, WriteFailureStopsStream) {
+    std::vector<KFSRequest> requests;
+    for (size_t i = 0; i < 10; i++) {
+        requests.push_back(prepareRequest("dummy", std::to_string(i), 0));
+    }
+    FakeStream stream(std::move(requests), 2);
+    EXPECT_EQ(getService().ModelStreamInferImpl(nullptr, &stream), StatusCode::STREAM_WRITE_FAILED);
+    EXPECT_EQ(stream.responses.size(), 2u);
+}
+
+TEST(KFSStreamInferSession, StatefulAndSequenceRequestsAreProcessedSequentially) {
+    KFSRequest request;
+    request.add_inputs()->set_name(DUMMY_MODEL_INPUT_NAME);
+    ovms::Model statelessModel("stateless", false, nullptr);
+    ovms::Model statefulModel("stateful", true, nullptr);
+    EXPECT_FALSE(ovms::KFSStreamInferSession::requiresSequentialProcessing(request, nullptr));
+    EXPECT_FALSE(ovms::KFSStreamInferSession::requiresSequentialProcessing(request, &statelessModel));
+    EXPECT_TRUE(ovms::KFSStreamInferSession::requiresSequentialProcessing(request, &statefulModel));
+
+    request.add_inputs()->set_name("sequence_id");
+    EXPECT_TRUE(ovms::KFSStreamInferSession::requiresSequentialProcessing(request, nullptr));
+    EXPECT_TRUE(ovms::KFSStreamInferSession::requiresSequentialProcessing(request, &statelessModel));
+}
+
+TEST_F(KFSStreamInferTest, SequenceRequestsKeepStreamOrder) {
+    // dummy model is stateless so sequence requests fail, but they are still answered in order
+    std::vector<KFSRequest> requests;
+    for (size_t i = 0; i < 2 * ovms::KFSStreamInferSession::MAX_IN_FLIGHT_REQUESTS; i++) {
+        requests.push_back(prepareRequest("dummy", std::to_string(i), static_cast<float>(i)));
+        if (i % 3 == 1) {
+            requests.back().add_inputs()->set_name("sequence_id");
+        }
+    }
+    const size_t requestsCount = requests.size();
+    FakeStream stream(std::move(requests));
+    ASSERT_EQ(getService().ModelStreamInferImpl(nullptr, &stream), StatusCode::OK);
+    ASSERT_EQ(stream.responses.size(), requestsCount);
+    for (size_t i = 0; i < requestsCount; i++) {
+        EXPECT_EQ(stream.responses[i].infer_response().id(), std::to_string(i));
+        EXPECT_EQ(stream.responses[i].error_message().empty(), i % 3 != 1);
+    }
+}
@@ -0,0 +1,134 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../customloaderinterface.hpp"
+#include "../mapped_file.hpp"
+#include "../shared_buffer_allocator.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+class MappedFileTest : public TestWithTempDir {
+protected:
+    const std::string content = "OpenVINO Model Server weights";
+
+    std::string createFile(const std::string& name, const std::string& fileContent) {
+        const std::string path = this->directoryPath + "/" + name;
+        std::ofstream file(path, std::ios::binary);
+        file << fileContent;
+        return path;
+    }
+};
+
+TEST_F(MappedFileTest, MapsWholeFile) {
+    auto path = createFile("model.bin", content);
+    std::shared_ptr<const MappedFile> mapped;
+    ASSERT_EQ(MappedFile::map(path, mapped), StatusCode::OK);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(mapped->getPath(), path);
+    ASSERT_EQ(mapped->getSize(), content.size());
+    EXPECT_EQ(std::memcmp(mapped->getData(), content.data(), content.size()), 0);
+}
+
+TEST_F(MappedFileTest, ReusesMappingOfTheSameFile) {
+    auto path = createFile("model.bin", content);
+    std::shared_ptr<const MappedFile> first, second;
+    ASSERT_EQ(MappedFile::map(path, first), StatusCode::OK);
+    ASSERT_EQ(MappedFile::map(path, second), StatusCode::OK);
+    EXPECT_EQ(first.get(), second.get());
+}
+
+TEST_F(MappedFileTest, RemapsModifiedFile) {
+    auto path = createFile("model.bin", content);
+    std::shared_ptr<const MappedFile> first, second;
+    ASSERT_EQ(MappedFile::map(path, first), StatusCode::OK);
+    std::filesystem::remove(path);
+    const std::string newContent = "different weights of different size";
+    createFile("model.bin", newContent);
+    ASSERT_EQ(MappedFile::map(path, second), StatusCode::OK);
+    EXPECT_NE(first.get(), second.get());
+    ASSERT_EQ(second->getSize(), newContent.size());
+    EXPECT_EQ(std::memcmp(second->getData(), newContent.data(), newContent.size()), 0);
+    // previous mapping stays valid for its users
+    EXPECT_EQ(std::memcmp(first->getData(), content.data(), content.size()), 0);
+}
+
+TEST_F(MappedFileTest, MissingFile) {
+    std::shared_ptr<const MappedFile> mapped;
+    EXPECT_EQ(MappedFile::map(this->directoryPath + "/not_existing.bin", mapped), StatusCode::FILE_INVALID);
+    EXPECT_EQ(mapped, nullptr);
+}
+
+TEST_F(MappedFileTest, EmptyFile) {
+    auto path = createFile("empty.bin", "");
+    std::shared_ptr<const MappedFile> mapped;
+    EXPECT_EQ(MappedFile::map(path, mapped), StatusCode::FILE_INVALID);
+    EXPECT_EQ(mapped, nullptr);
+}
+
+TEST_F(MappedFileTest, SharedBufferTensorKeepsMappingAlive) {
+    auto path = createFile("model.bin", content);
+    std::weak_ptr<const MappedFile> observer;
+    ov::Tensor tensor;
+    {
+        std::shared_ptr<const MappedFile> mapped;
+        ASSERT_EQ(MappedFile::map(path, mapped), StatusCode::OK);
+        observer = mapped;
+        tensor = makeSharedBufferTensor(ov::element::u8, ov::Shape{mapped->getSize()}, mapped, mapped->getData());
+    }
+    EXPECT_FALSE(observer.expired());
+    ASSERT_EQ(tensor.get_byte_size(), content.size());
+    EXPECT_EQ(std::memcmp(tensor.data(), content.data(), content.size()), 0);
+    tensor = ov::Tensor();
+    EXPECT_TRUE(observer.expired());
+}
+
+namespace {
+class VectorCustomLoader : public CustomLoaderInterface {
+public:
+    CustomLoaderStatus loaderInit(const std::string& loaderPath) override { return CustomLoaderStatus::OK; }
+    CustomLoaderStatus loadModel(const std::string& modelName, const std::string& basePath, const int version,
+        const std::string& loaderOptions, std::vector<uint8_t>& modelBuffer, std::vector<uint8_t>& weights) override {
+        modelBuffer = {'<', 'x', 'm', 'l', '>'};
+        weights = {1, 2, 3};
+        return CustomLoaderStatus::MODEL_TYPE_IR;
+    }
+    CustomLoaderStatus getModelBlacklistStatus(const std::string& modelName, const int version) override { return CustomLoaderStatus::OK; }
+    CustomLoaderStatus unloadModel(const std::string& modelName, const int version) override { return CustomLoaderStatus::OK; }
+    CustomLoaderStatus retireModel(const std::string& modelName) override { return CustomLoaderStatus::OK; }
+    CustomLoaderStatus loaderDeInit() override { return CustomLoaderStatus::OK; }
+};
+}  // namespace
+
+TEST(CustomLoaderBuffers, DefaultImplementationTakesOverVectors) {
+    VectorCustomLoader loader;
+    CustomLoaderBuffer model, weights;
+    ASSERT_EQ(loader.loadModelBuffers("dummy", "/tmp", 1, "", model, weights), CustomLoaderStatus::MODEL_TYPE_IR);
+    ASSERT_NE(model.owner, nullptr);
+    ASSERT_NE(weights.owner, nullptr);
+    EXPECT_EQ(std::string(reinterpret_cast<const char*>(model.data), model.size), "<xml>");
+    ASSERT_EQ(weights.size, 3u);
+    EXPECT_EQ(weights.data[2], 3);
+}
@@ -371,25 +371,29 @@ TEST_F(MetricFlowTest, RestPredict) {
     for (int i = 0; i < numberOfSuccessRequests; i++) {
         std::string request = R"({"signature_name": "serving_default", "instances": [[1,2,3,4,5,6,7,8,9,10]]})";
         std::string response;
-        ASSERT_EQ(handler.processPredictRequest(modelName, modelVersion, modelVersionLabel, request, &response), ovms::StatusCode::OK);
+        std::optional<int> inferenceHeaderContentLength;
+        ASSERT_EQ(handler.processPredictRequest(modelName, modelVersion, modelVersionLabel, request, &response, inferenceHeaderContentLength), ovms::StatusCode::OK);
     }
 
     for (int i = 0; i < numberOfFailedRequests; i++) {
         std::string request = R"({"signature_name": "serving_default", "instances": [[1,2,3,4,5,6,7,8,9]]})";
         std::string response;
-        ASSERT_EQ(handler.processPredictRequest(modelName, modelVersion, modelVersionLabel, request, &response), ovms::StatusCode::INVALID_SHAPE);
+        std::optional<int> inferenceHeaderContentLength;
+        ASSERT_EQ(handler.processPredictRequest(modelName, modelVersion, modelVersionLabel, request, &response, inferenceHeaderContentLength), ovms::StatusCode::INVALID_SHAPE);
     }
 
     for (int i = 0; i < numberOfSuccessRequests; i++) {
         std::string request = R"({"signature_name": "serving_default", "instances": [[[1,2,3,4,5,6,7,8,9,10]],[[1,2,3,4,5,6,7,8,9,10]],[[1,2,3,4,5,6,7,8,9,10]]]})";
         std::string response;
-        ASSERT_EQ(handler.processPredictRequest(dagName, modelVersion, modelVersionLabel, request, &response), ovms::StatusCode::OK);
+        std::optional<int> inferenceHeaderContentLength;
+        ASSERT_EQ(handler.processPredictRequest(dagName, modelVersion, modelVersionLabel, request, &response, inferenceHeaderContentLength), ovms::StatusCode::OK);
     }
 
     for (int i = 0; i < numberOfFailedRequests; i++) {
         std::string request = R"({"signature_name": "serving_default", "instances": [[[1,2,3,4,5,6,7,8,9,10]],[[1,2,3,4,5,6,7,8,9,10]],[[1,2,3,4,5,6,7,8,9]]]})";
         std::string response;
-        ASSERT_EQ(handler.processPredictRequest(dagName, modelVersion, modelVersionLabel, request, &response), ovms::StatusCode::REST_COULD_NOT_PARSE_INSTANCE);
+        std::optional<int> inferenceHeaderContentLength;
+        ASSERT_EQ(handler.processPredictRequest(dagName, modelVersion, modelVersionLabel, request, &response, inferenceHeaderContentLength), ovms::StatusCode::REST_COULD_NOT_PARSE_INSTANCE);
     }
 
     checkRequestsCounter(server.collect(), METRIC_NAME_REQUESTS_SUCCESS, modelName, 1, "REST", "Predict", "TensorFlowServing", dynamicBatch * numberOfSuccessRequests + numberOfSuccessRequests);  // ran by demultiplexer + real request
@@ -414,6 +418,18 @@ TEST_F(MetricFlowTest, RestPredict) {
 
     EXPECT_THAT(server.collect(), HasSubstr(METRIC_NAME_INFER_REQ_QUEUE_SIZE + std::string{"{name=\""} + modelName + std::string{"\",version=\"1\"} "} + std::to_string(2)));
     EXPECT_THAT(server.collect(), Not(HasSubstr(METRIC_NAME_INFER_REQ_QUEUE_SIZE + std::string{"{name=\""} + dagName + std::string{"\",version=\"1\"} "})));
+
+    for (std::string stage : {"get_infer_request", "preprocess", "deserialize", "prediction", "serialize", "postprocess"}) {
+        EXPECT_THAT(server.collect(), HasSubstr(METRIC_NAME_INFERENCE_STAGE_TIME + std::string{"_count{name=\""} + modelName + std::string{"\",stage=\""} + stage + std::string{"\",version=\"1\"} "} + std::to_string(numberOfSuccessRequests)));
+        EXPECT_THAT(server.collect(), Not(HasSubstr(METRIC_NAME_INFERENCE_STAGE_TIME + std::string{"_count{name=\""} + dagName)));
+    }
+
+    EXPECT_THAT(server.collect(), HasSubstr(METRIC_NAME_REQUEST_STAGE_TIME + std::string{"_count{interface=\"REST\",name=\""} + modelName + std::string{"\",stage=\"render\",version=\"1\"} "} + std::to_string(numberOfSuccessRequests)));
+    EXPECT_THAT(server.collect(), HasSubstr(METRIC_NAME_REQUEST_STAGE_TIME + std::string{"_count{interface=\"REST\",name=\""} + dagName + std::string{"\",stage=\"render\",version=\"1\"} "} + std::to_string(numberOfSuccessRequests)));
+    EXPECT_THAT(server.collect(), HasSubstr(METRIC_NAME_REQUEST_STAGE_TIME + std::string{"_count{interface=\"REST\",name=\""} + dagName + std::string{"\",stage=\"parse\",version=\"1\"} "} + std::to_string(numberOfSuccessRequests)));
+
+    EXPECT_THAT(server.collect(), HasSubstr(METRIC_NAME_DAG_NODE_WAIT_TIME + std::string{"_count{name=\""} + dagName + std::string{"\",version=\"1\"} "}));
+    EXPECT_THAT(server.collect(), Not(HasSubstr(METRIC_NAME_DAG_NODE_WAIT_TIME + std::string{"_count{name=\""} + modelName + std::string{"\",version=\"1\"} "})));
 }
 
 TEST_F(MetricFlowTest, RestGetModelMetadata) {
@@ -550,6 +566,25 @@ TEST_F(MetricFlowTest, ModelReady) {
     checkRequestsCounter(server.collect(), METRIC_NAME_REQUESTS_SUCCESS, dagName, 1, "REST", "ModelReady", "KServe", numberOfSuccessRequests);    // ran by real request
 }
 
+TEST_F(MetricFlowTest, RestMetricsGzipWhenAccepted) {
+    HttpRestApiHandler handler(server, 0);
+    HttpRequestComponents components;
+    HttpResponseComponents responseComponents;
+    std::string request, response;
+
+    ASSERT_EQ(handler.processMetrics(components, response, request, responseComponents), ovms::StatusCode::OK);
+    EXPECT_FALSE(responseComponents.contentEncoding.has_value());
+    EXPECT_THAT(response, HasSubstr("# TYPE "));
+
+    components.acceptEncoding = "deflate, gzip;q=0.8";
+    ASSERT_EQ(handler.processMetrics(components, response, request, responseComponents), ovms::StatusCode::OK);
+    ASSERT_TRUE(responseComponents.contentEncoding.has_value());
+    EXPECT_EQ(responseComponents.contentEncoding.value(), "gzip");
+    ASSERT_GE(response.size(), 2);
+    EXPECT_EQ(static_cast<unsigned char>(response[0]), 0x1f);
+    EXPECT_EQ(static_cast<unsigned char>(response[1]), 0x8b);
+}
+
 std::string MetricFlowTest::prepareConfigContent() {
     return std::string{R"({
         "monitoring": {
@@ -565,6 +600,9 @@ std::string MetricFlowTest::prepareConfigContent() {
            R"(",")" + METRIC_NAME_STREAMS +
            R"(",")" + METRIC_NAME_INFERENCE_TIME +
            R"(",")" + METRIC_NAME_WAIT_FOR_INFER_REQ_TIME +
+           R"(",")" + METRIC_NAME_INFERENCE_STAGE_TIME +
+           R"(",")" + METRIC_NAME_REQUEST_STAGE_TIME +
+           R"(",")" + METRIC_NAME_DAG_NODE_WAIT_TIME +
            R"("]
             }
         },
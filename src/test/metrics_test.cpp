@@ -13,6 +13,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 //*****************************************************************************
+#include <chrono>
 #include <future>
 #include <memory>
 #include <thread>
@@ -694,6 +695,31 @@ family2_bucket{label="value",le="+Inf"} 1
     EXPECT_EQ(registry.collect(), expected);
 }
 
+TEST(MetricsRegistry, FamiliesAreGroupedByTypeInRegistrationOrder) {
+    MetricRegistry registry;
+    registry.createFamily<MetricHistogram>("histogram", "desc")->addMetric({}, {1.0})->observe(0.5);
+    registry.createFamily<MetricGauge>("gauge", "desc")->addMetric({})->set(1);
+    registry.createFamily<MetricCounter>("counter2", "desc")->addMetric({})->increment();
+    registry.createFamily<MetricCounter>("counter1", "desc")->addMetric({})->increment();
+    std::string expected = R"(# HELP counter2 desc
+# TYPE counter2 counter
+counter2 1
+# HELP counter1 desc
+# TYPE counter1 counter
+counter1 1
+# HELP gauge desc
+# TYPE gauge gauge
+gauge 1
+# HELP histogram desc
+# TYPE histogram histogram
+histogram_count 1
+histogram_sum 0.5
+histogram_bucket{le="1"} 1
+histogram_bucket{le="+Inf"} 1
+)";
+    EXPECT_EQ(registry.collect(), expected);
+}
+
 TEST(MetricsHistogram, CreateFamilyWithSameNameSameMetricType) {
     MetricRegistry registry;
     EXPECT_NE(registry.createFamily<MetricHistogram>("family", "desc"), nullptr);
@@ -969,3 +995,95 @@ TEST(MetricsManyOps, MultipleThreads) {
         }
     }
 }
+
+TEST(MetricsCounter, ValuesOfDestroyedMetricAreReported) {
+    MetricRegistry registry;
+    auto family = registry.createFamily<MetricCounter>("name", "desc");
+    auto metric = family->addMetric({{"label", "value"}});
+    metric->increment(3);
+    metric.reset();
+    EXPECT_THAT(registry.collect(), HasSubstr("name{label=\"value\"} 3\n"));
+    EXPECT_THAT(registry.collect(), HasSubstr("name{label=\"value\"} 3\n"));
+}
+
+TEST(MetricsHistogram, ValuesOfDestroyedMetricAreReported) {
+    MetricRegistry registry;
+    auto family = registry.createFamily<MetricHistogram>("name", "desc");
+    auto metric = family->addMetric({{"label", "value"}}, {1.0});
+    metric->observe(0.5);
+    metric->observe(2.5);
+    metric.reset();
+    EXPECT_THAT(registry.collect(), HasSubstr("name_bucket{label=\"value\",le=\"1\"} 1\n"));
+    EXPECT_THAT(registry.collect(), HasSubstr("name_count{label=\"value\"} 2\n"));
+    EXPECT_THAT(registry.collect(), HasSubstr("name_sum{label=\"value\"} 3\n"));
+}
+
+TEST(MetricsManyOps, CollectDuringParallelUpdates) {
+    const int numberOfWorkers = 8;
+    const int numberOfOperations = 10000;
+    MetricRegistry registry;
+    auto counter = registry.createFamily<MetricCounter>("counter", "desc")->addMetric();
+    auto histogram = registry.createFamily<MetricHistogram>("histogram", "desc")->addMetric({}, {1.0});
+    std::vector<std::unique_ptr<std::thread>> workers;
+    for (int i = 0; i < numberOfWorkers; i++)
+        workers.emplace_back(std::make_unique<std::thread>([&counter, &histogram]() {
+            for (int j = 0; j < numberOfOperations; j++) {
+                counter->increment();
+                histogram->observe(0.5);
+            }
+        }));
+    for (int i = 0; i < 100; i++) {
+        registry.collect();
+    }
+    std::for_each(workers.begin(), workers.end(), [](auto& thread) { thread->join(); });
+    std::string content = registry.collect();
+    EXPECT_THAT(content, HasSubstr("counter 80000\n"));
+    EXPECT_THAT(content, HasSubstr("histogram_count 80000\n"));
+    EXPECT_THAT(content, HasSubstr("histogram_bucket{le=\"1\"} 80000\n"));
+}
+
+// Measures metrics cost of single request as done in ModelInstance::infer and frontends.
+// Reports average time per request with metrics enabled and disabled, does not assert on timing.
+// Run with --gtest_also_run_disabled_tests, times per request in ns are recorded as test properties in --gtest_output report
+TEST(MetricsBenchmark, DISABLED_PerRequestOverheadEnabledVsDisabled) {
+    const int numberOfWorkers = 8;
+    const int numberOfRequests = 100000;
+    MetricRegistry registry;
+    BucketBoundaries buckets;
+    for (int i = 0; i < 33; i++) {
+        buckets.emplace_back(floor(10 * pow(1.8, i)));
+    }
+    auto runWorkload = [&](std::unique_ptr<MetricCounter>& requestSuccess,
+                           std::unique_ptr<MetricHistogram>& requestTime,
+                           std::unique_ptr<MetricHistogram>& inferenceTime,
+                           std::unique_ptr<MetricHistogram>& waitForInferReqTime) {
+        std::vector<std::unique_ptr<std::thread>> workers;
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < numberOfWorkers; i++)
+            workers.emplace_back(std::make_unique<std::thread>([&]() {
+                for (int j = 0; j < numberOfRequests; j++) {
+                    OBSERVE_IF_ENABLED(waitForInferReqTime, j % 100);
+                    OBSERVE_IF_ENABLED(inferenceTime, j % 1000);
+                    OBSERVE_IF_ENABLED(requestTime, j % 2000);
+                    INCREMENT_IF_ENABLED(requestSuccess);
+                }
+            }));
+        std::for_each(workers.begin(), workers.end(), [](auto& thread) { thread->join(); });
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count() / double(numberOfRequests);
+    };
+
+    std::unique_ptr<MetricCounter> disabledCounter;
+    std::unique_ptr<MetricHistogram> disabledHistogram;
+    double disabledNs = runWorkload(disabledCounter, disabledHistogram, disabledHistogram, disabledHistogram);
+
+    auto requestSuccess = registry.createFamily<MetricCounter>("requests_success", "desc")->addMetric({{"name", "dummy"}});
+    auto requestTime = registry.createFamily<MetricHistogram>("request_time", "desc")->addMetric({{"name", "dummy"}}, buckets);
+    auto inferenceTime = registry.createFamily<MetricHistogram>("inference_time", "desc")->addMetric({{"name", "dummy"}}, buckets);
+    auto waitForInferReqTime = registry.createFamily<MetricHistogram>("wait_time", "desc")->addMetric({{"name", "dummy"}}, buckets);
+    double enabledNs = runWorkload(requestSuccess, requestTime, inferenceTime, waitForInferReqTime);
+
+    RecordProperty("enabled_ns", static_cast<int>(enabledNs));
+    RecordProperty("disabled_ns", static_cast<int>(disabledNs));
+    EXPECT_THAT(registry.collect(), HasSubstr("requests_success{name=\"dummy\"} " + std::to_string(numberOfWorkers * numberOfRequests) + "\n"));
+}
@@ -0,0 +1,136 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../model_memory_budget.hpp"
+#include "../modelinstance.hpp"
+#include "../modelinstanceunloadguard.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+class ModelMemoryBudgetTest : public ::testing::Test {
+protected:
+    std::unique_ptr<ov::Core> ieCore;
+    std::vector<std::shared_ptr<ModelInstance>> instances;
+
+    void SetUp() override {
+        ieCore = std::make_unique<ov::Core>();
+    }
+
+    void createInstances(size_t count, const std::shared_ptr<ModelMemoryBudget>& budget) {
+        for (size_t i = 0; i < count; ++i) {
+            auto instance = std::make_shared<ModelInstance>("dummy" + std::to_string(i), 1, *ieCore);
+            instance->setMemoryBudget(budget);
+            budget->add(instance);
+            instances.emplace_back(instance);
+        }
+    }
+
+    void load(size_t index, const std::shared_ptr<ModelMemoryBudget>& budget) {
+        ASSERT_EQ(instances[index]->loadModel(DUMMY_MODEL_CONFIG), StatusCode::OK);
+        budget->enforce(instances[index].get());
+        // timestamps of subsequent loads and requests have to differ
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    size_t dummyFootprint() {
+        ModelInstance instance("dummy", 1, *ieCore);
+        EXPECT_EQ(instance.loadModel(DUMMY_MODEL_CONFIG), StatusCode::OK);
+        return instance.getMemoryFootprint();
+    }
+};
+
+TEST_F(ModelMemoryBudgetTest, FootprintIsEstimatedOnLoad) {
+    EXPECT_GT(dummyFootprint(), 0u);
+}
+
+TEST_F(ModelMemoryBudgetTest, LeastRecentlyUsedModelIsEvicted) {
+    const size_t footprint = dummyFootprint();
+    auto budget = std::make_shared<ModelMemoryBudget>(2 * footprint);
+    createInstances(3, budget);
+    load(0, budget);
+    load(1, budget);
+    EXPECT_EQ(budget->getResidentBytes(), 2 * footprint);
+
+    // model 0 used after model 1 was loaded
+    std::unique_ptr<ModelInstanceUnloadGuard> guard;
+    ASSERT_EQ(instances[0]->waitForLoaded(0, guard), StatusCode::OK);
+    guard.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    load(2, budget);
+    EXPECT_FALSE(instances[0]->isEvicted());
+    EXPECT_TRUE(instances[1]->isEvicted());
+    EXPECT_FALSE(instances[2]->isEvicted());
+    EXPECT_EQ(instances[1]->getStatus().getState(), ModelVersionState::LOADING);
+    EXPECT_EQ(budget->getResidentBytes(), 2 * footprint);
+}
+
+TEST_F(ModelMemoryBudgetTest, EvictedModelIsLoadedBackOnRequest) {
+    const size_t footprint = dummyFootprint();
+    auto budget = std::make_shared<ModelMemoryBudget>(footprint);
+    createInstances(2, budget);
+    load(0, budget);
+    load(1, budget);
+    ASSERT_TRUE(instances[0]->isEvicted());
+
+    std::unique_ptr<ModelInstanceUnloadGuard> guard;
+    ASSERT_EQ(instances[0]->waitForLoaded(0, guard), StatusCode::OK);
+    EXPECT_NE(guard, nullptr);
+    EXPECT_EQ(instances[0]->getStatus().getState(), ModelVersionState::AVAILABLE);
+    EXPECT_FALSE(instances[0]->isEvicted());
+    EXPECT_FALSE(instances[0]->getInputsInfo().empty());
+    // loading back makes room by evicting the other model
+    EXPECT_TRUE(instances[1]->isEvicted());
+    EXPECT_EQ(budget->getResidentBytes(), footprint);
+}
+
+TEST_F(ModelMemoryBudgetTest, ModelInUseIsNotEvicted) {
+    const size_t footprint = dummyFootprint();
+    auto budget = std::make_shared<ModelMemoryBudget>(footprint);
+    createInstances(2, budget);
+    load(0, budget);
+    std::unique_ptr<ModelInstanceUnloadGuard> guard;
+    ASSERT_EQ(instances[0]->waitForLoaded(0, guard), StatusCode::OK);
+
+    load(1, budget);
+    EXPECT_FALSE(instances[0]->isEvicted());
+    EXPECT_EQ(budget->getResidentBytes(), 2 * footprint);
+
+    guard.reset();
+    EXPECT_EQ(budget->enforce(instances[1].get()), 1u);
+    EXPECT_TRUE(instances[0]->isEvicted());
+}
+
+TEST_F(ModelMemoryBudgetTest, RetiredEvictedModelIsNotLoadedBack) {
+    const size_t footprint = dummyFootprint();
+    auto budget = std::make_shared<ModelMemoryBudget>(footprint);
+    createInstances(2, budget);
+    load(0, budget);
+    load(1, budget);
+    ASSERT_TRUE(instances[0]->isEvicted());
+
+    instances[0]->retireModel();
+    std::unique_ptr<ModelInstanceUnloadGuard> guard;
+    EXPECT_EQ(instances[0]->waitForLoaded(0, guard), StatusCode::MODEL_VERSION_NOT_LOADED_ANYMORE);
+    EXPECT_FALSE(instances[1]->isEvicted());
+}
@@ -21,6 +21,7 @@
 #include "../filesystem.hpp"
 #include "../model.hpp"
 #include "../modelmanager.hpp"
+#include "../pipelinedefinition.hpp"
 #include "mockmodelinstancechangingstates.hpp"
 #include "test_utils.hpp"
 
@@ -116,6 +117,52 @@ TEST_F(ModelDefaultVersions, DefaultVersionShouldReturnHighestNonRetired) {
     EXPECT_EQ(1, defaultInstance->getVersion());
 }
 
+TEST_F(ModelDefaultVersions, DefaultVersionShouldReturnHighestEvicted) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    std::shared_ptr<ovms::model_versions_t> versionsToChange = std::make_shared<ovms::model_versions_t>();
+    std::shared_ptr<ovms::model_versions_t> versionsFailed = std::make_shared<ovms::model_versions_t>();
+    versionsToChange->push_back(1);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    auto fs = ovms::ModelManager::getFilesystem(config.getBasePath());
+    ASSERT_EQ(mockModel.addVersions(versionsToChange, config, fs, *ieCore, versionsFailed), ovms::StatusCode::OK);
+    versionsToChange->clear();
+
+    versionsToChange->push_back(2);
+    config.setVersion(2);
+    ASSERT_EQ(mockModel.addVersions(versionsToChange, config, fs, *ieCore, versionsFailed), ovms::StatusCode::OK);
+    versionsToChange->clear();
+
+    ASSERT_TRUE(mockModel.getModelInstanceByVersion(2)->evict());
+    versionsToChange->push_back(1);
+    mockModel.retireVersions(versionsToChange);
+    versionsToChange->clear();
+
+    std::shared_ptr<ovms::ModelInstance> defaultInstance;
+    defaultInstance = mockModel.getDefaultModelInstance();
+    ASSERT_TRUE(nullptr != defaultInstance);
+    EXPECT_EQ(2, defaultInstance->getVersion());
+    EXPECT_TRUE(defaultInstance->isEvicted());
+}
+
+TEST_F(ModelDefaultVersions, VersionIsNotEvictableWhenModelIsUsedByPipeline) {
+    MockModelWithInstancesJustChangingStates mockModel;
+    std::shared_ptr<ovms::model_versions_t> versionsToChange = std::make_shared<ovms::model_versions_t>();
+    std::shared_ptr<ovms::model_versions_t> versionsFailed = std::make_shared<ovms::model_versions_t>();
+    versionsToChange->push_back(1);
+    ovms::ModelConfig config = DUMMY_MODEL_CONFIG;
+    auto fs = ovms::ModelManager::getFilesystem(config.getBasePath());
+    ASSERT_EQ(mockModel.addVersions(versionsToChange, config, fs, *ieCore, versionsFailed), ovms::StatusCode::OK);
+    auto instance = mockModel.getModelInstanceByVersion(1);
+    ASSERT_TRUE(instance->isEvictable());
+
+    ovms::PipelineDefinition pd("UNUSED_NAME", {}, {});
+    mockModel.subscribe(pd);
+    EXPECT_FALSE(instance->isEvictable());
+    EXPECT_FALSE(instance->evict());
+    mockModel.unsubscribe(pd);
+    EXPECT_TRUE(instance->isEvictable());
+}
+
 TEST_F(ModelDefaultVersions, DefaultVersionShouldReturnHighestWhenVersionReloaded) {
     MockModelWithInstancesJustChangingStates mockModel;
     std::shared_ptr<ovms::model_versions_t> versionsToChange = std::make_shared<ovms::model_versions_t>();
@@ -191,6 +191,56 @@ TEST(ModelConfig, parseLayoutParam_multi) {
     }
 }
 
+TEST(ModelConfig, parsePreprocessingParam) {
+    using namespace ovms;
+    ModelConfig config;
+    rapidjson::Document node;
+    node.Parse(R"({"input": {"tensor_element_type": "u8", "mean": [123.675, 116.28, 103.53], "scale": 58.4, "resize": "Linear", "color_format": "bgr", "model_color_format": "RGB"}})");
+    ASSERT_FALSE(node.HasParseError());
+
+    ASSERT_EQ(config.parsePreprocessingParameter(node), StatusCode::OK);
+    ASSERT_EQ(config.getPreprocessing().count("input"), 1);
+    const auto& preprocessing = config.getPreprocessing().at("input");
+    EXPECT_TRUE(preprocessing.isSet());
+    EXPECT_EQ(preprocessing.getTensorPrecision(), Precision::U8);
+    EXPECT_EQ(preprocessing.getMean(), std::vector<float>({123.675f, 116.28f, 103.53f}));
+    EXPECT_EQ(preprocessing.getScale(), std::vector<float>({58.4f}));
+    EXPECT_EQ(preprocessing.getResizeAlgorithm(), "linear");
+    EXPECT_EQ(preprocessing.getColorFormat(), "BGR");
+    EXPECT_EQ(preprocessing.getModelColorFormat(), "RGB");
+
+    ModelConfig other;
+    EXPECT_FALSE(config.isPreprocessingConfigurationEqual(other));
+    other.setPreprocessing(config.getPreprocessing());
+    EXPECT_TRUE(config.isPreprocessingConfigurationEqual(other));
+    EXPECT_TRUE(config.isReloadRequired(ModelConfig()));
+}
+
+TEST(ModelConfig, parsePreprocessingParamInvalid) {
+    using namespace ovms;
+    std::vector<std::string> invalid_str{
+        R"({"input": "u8"})",
+        R"({"input": {"tensor_element_type": "u7"}})",
+        R"({"input": {"tensor_element_type": 8}})",
+        R"({"input": {"mean": []}})",
+        R"({"input": {"mean": ["1"]}})",
+        R"({"input": {"scale": [1, 0]}})",
+        R"({"input": {"resize": "bilinear"}})",
+        R"({"input": {"color_format": "BGR"}})",
+        R"({"input": {"color_format": "NV12", "model_color_format": "BGR"}})",
+        R"({"input": {"unknown": "value"}})",
+    };
+
+    for (std::string str : invalid_str) {
+        ModelConfig config;
+        rapidjson::Document node;
+        node.Parse(str.c_str());
+        ASSERT_FALSE(node.HasParseError()) << str;
+        EXPECT_EQ(config.parsePreprocessingParameter(node), StatusCode::PREPROCESSING_WRONG_FORMAT) << " Failed for: " << str;
+        EXPECT_EQ(config.getPreprocessing().size(), 0);
+    }
+}
+
 TEST(ModelConfig, shape) {
     ovms::ModelConfig config;
 
@@ -1014,6 +1064,74 @@ TEST(ModelConfig, ConfigParseNodeWithValidShapeFormatArray) {
     EXPECT_EQ(shapes["input"].shape, (ovms::Shape{1, 3, 600, 600}));
 }
 
+TEST(ModelConfig, ConfigParseNodeWithCpuCores) {
+    std::string config = R"#(
+        {
+        "model_config_list": [
+            {
+                "config": {
+                    "name": "alpha",
+                    "base_path": "/tmp/models/dummy1",
+                    "cpu_cores": 4
+                }
+            }
+        ]
+    }
+    )#";
+
+    rapidjson::Document configJson;
+    rapidjson::ParseResult parsingSucceeded = configJson.Parse(config.c_str());
+    ASSERT_EQ(parsingSucceeded, true);
+
+    const auto modelConfigList = configJson.FindMember("model_config_list");
+    ASSERT_NE(modelConfigList, configJson.MemberEnd());
+    const auto& configs = modelConfigList->value.GetArray();
+    ASSERT_EQ(configs.Size(), 1);
+    ovms::ModelConfig modelConfig;
+    auto status = modelConfig.parseNode(configs[0]["config"]);
+
+    ASSERT_EQ(status, ovms::StatusCode::OK);
+    EXPECT_EQ(modelConfig.getCpuCores(), 4);
+    ovms::ModelConfig otherConfig = modelConfig;
+    otherConfig.setCpuCores(2);
+    EXPECT_TRUE(modelConfig.isReloadRequired(otherConfig));
+}
+
+TEST(ModelConfig, ConfigParseNodeWithQueueLimits) {
+    std::string config = R"#(
+        {
+        "model_config_list": [
+            {
+                "config": {
+                    "name": "alpha",
+                    "base_path": "/tmp/models/dummy1",
+                    "max_queue_depth": 16,
+                    "max_queue_wait_ms": 250
+                }
+            }
+        ]
+    }
+    )#";
+
+    rapidjson::Document configJson;
+    rapidjson::ParseResult parsingSucceeded = configJson.Parse(config.c_str());
+    ASSERT_EQ(parsingSucceeded, true);
+
+    const auto modelConfigList = configJson.FindMember("model_config_list");
+    ASSERT_NE(modelConfigList, configJson.MemberEnd());
+    const auto& configs = modelConfigList->value.GetArray();
+    ASSERT_EQ(configs.Size(), 1);
+    ovms::ModelConfig modelConfig;
+    auto status = modelConfig.parseNode(configs[0]["config"]);
+
+    ASSERT_EQ(status, ovms::StatusCode::OK);
+    EXPECT_EQ(modelConfig.getMaxQueueDepth(), 16);
+    EXPECT_EQ(modelConfig.getMaxQueueWaitMs(), 250);
+    ovms::ModelConfig otherConfig = modelConfig;
+    otherConfig.setMaxQueueWaitMs(0);
+    EXPECT_TRUE(modelConfig.isReloadRequired(otherConfig));
+}
+
 static std::string config_low_latency_no_stateful = R"#(
     {
     "model_config_list": [
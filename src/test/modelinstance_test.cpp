@@ -91,6 +91,21 @@ TEST_F(TestUnloadModel, CanUnloadModelNotHoldingModelInstanceAtPredictPath) {
     EXPECT_TRUE(modelInstance.canUnloadInstance());
 }
 
+TEST_F(TestUnloadModel, UnloadGuardReusesMemoryOfPreviousGuardOnSameThread) {
+    ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION, *ieCore);
+    ASSERT_EQ(modelInstance.loadModel(DUMMY_MODEL_CONFIG), ovms::StatusCode::OK);
+    std::unique_ptr<ovms::ModelInstanceUnloadGuard> unloadGuard;
+    ASSERT_EQ(modelInstance.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    const void* firstGuardAddress = unloadGuard.get();
+    unloadGuard.reset();
+    EXPECT_TRUE(modelInstance.canUnloadInstance());
+    ASSERT_EQ(modelInstance.waitForLoaded(0, unloadGuard), ovms::StatusCode::OK);
+    EXPECT_EQ(firstGuardAddress, unloadGuard.get());
+    EXPECT_FALSE(modelInstance.canUnloadInstance());
+    std::thread([&unloadGuard]() { unloadGuard.reset(); }).join();
+    EXPECT_TRUE(modelInstance.canUnloadInstance());
+}
+
 TEST_F(TestUnloadModel, UnloadWaitsUntilMetadataResponseIsBuilt) {
     static std::thread thread;
     static std::shared_ptr<ovms::ModelInstance> instance;
@@ -251,6 +266,29 @@ TEST_F(TestLoadModel, LoadModelWithRTMapParameterOutputLayoutIncompatible) {
     ASSERT_EQ(status, ovms::StatusCode::MODEL_NOT_LOADED) << status.string();
 }
 
+// Preprocessing is compiled into the model, so input accepts tensor element type from configuration.
+TEST_F(TestLoadModel, LoadModelWithPreprocessingChangesInputPrecision) {
+    ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION, *ieCore);
+    auto config = DUMMY_MODEL_CONFIG;
+    rapidjson::Document preprocessing;
+    preprocessing.Parse(R"({"b": {"tensor_element_type": "u8", "mean": 1.0, "scale": 2.0}})");
+    ASSERT_EQ(config.parsePreprocessingParameter(preprocessing), ovms::StatusCode::OK);
+    auto status = modelInstance.loadModel(config);
+    ASSERT_EQ(status, ovms::StatusCode::OK) << status.string();
+    ASSERT_EQ(modelInstance.getInputsInfo().size(), 1);
+    EXPECT_EQ(modelInstance.getInputsInfo().begin()->second->getPrecision(), ovms::Precision::U8);
+    EXPECT_EQ(modelInstance.getOutputsInfo().begin()->second->getPrecision(), ovms::Precision::FP32);
+}
+
+TEST_F(TestLoadModel, LoadModelWithPreprocessingOfUnknownInputFails) {
+    ovms::ModelInstance modelInstance("UNUSED_NAME", UNUSED_MODEL_VERSION, *ieCore);
+    auto config = DUMMY_MODEL_CONFIG;
+    rapidjson::Document preprocessing;
+    preprocessing.Parse(R"({"unknown": {"tensor_element_type": "u8"}})");
+    ASSERT_EQ(config.parsePreprocessingParameter(preprocessing), ovms::StatusCode::OK);
+    EXPECT_EQ(modelInstance.loadModel(config), ovms::StatusCode::CONFIG_PREPROCESSING_IS_NOT_IN_MODEL);
+}
+
 class MockModelInstanceThrowingFileNotFoundForLoadingCNN : public ovms::ModelInstance {
 public:
     MockModelInstanceThrowingFileNotFoundForLoadingCNN(ov::Core& ieCore) :
@@ -1066,6 +1066,29 @@ TEST_F(ModelManager, ConfigReloadingWithTwoModelsWithTheSameName) {
     modelMock.reset();
 }
 
+static std::string createConfigWithModelUsingCpuCores(const std::string& modelName, size_t cpuCores) {
+    return R"({"model_config_list": [{"config": {"name": ")" + modelName +
+           R"(", "base_path": "/ovms/src/test/dummy", "cpu_cores": )" + std::to_string(cpuCores) + "}}]}";
+}
+
+TEST_F(ModelManager, ConfigReloadingModelReplacedOnFullHostTakesOverCpuCores) {
+    const size_t cpusCount = fixtureManager.getCpuResourceManager()->getCpusCount();
+    std::string configFile = createConfigFileWithContent(createConfigWithModelUsingCpuCores("first", cpusCount));
+    ASSERT_EQ(fixtureManager.startFromFile(configFile), ovms::StatusCode::OK);
+    ASSERT_TRUE(fixtureManager.getCpuResourceManager()->getAssignment("first").dedicated);
+
+    createConfigFileWithContent(createConfigWithModelUsingCpuCores("second", cpusCount), configFile);
+    ASSERT_EQ(fixtureManager.loadConfig(configFile), ovms::StatusCode::OK);
+    auto assignment = fixtureManager.getCpuResourceManager()->getAssignment("second");
+    EXPECT_TRUE(assignment.dedicated);
+    EXPECT_EQ(assignment.cpus.size(), cpusCount);
+    EXPECT_FALSE(fixtureManager.getCpuResourceManager()->getAssignment("first").dedicated);
+    auto model = fixtureManager.findModelByName("second");
+    ASSERT_NE(model, nullptr);
+    ASSERT_NE(model->getDefaultModelInstance(), nullptr);
+    EXPECT_EQ(model->getDefaultModelInstance()->getStatus().getState(), ovms::ModelVersionState::AVAILABLE);
+}
+
 class MockModelManagerWithModelInstancesJustChangingStates : public ovms::ModelManager {
 public:
     std::shared_ptr<ovms::Model> modelFactory(const std::string& name, const bool isStateful) override {
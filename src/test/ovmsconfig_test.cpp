@@ -207,6 +207,18 @@ TEST_F(OvmsConfigDeathTest, restWorkersDefinedRestPortUndefined) {
     EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "rest_workers is set but rest_port is not set");
 }
 
+TEST_F(OvmsConfigDeathTest, restEventLoopsZero) {
+    char* n_argv[] = {"ovms", "--config_path", "/path1", "--rest_port", "8080", "--rest_event_loops", "0"};
+    int arg_count = 7;
+    EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "rest_event_loops count should be from 1 to CPU core count");
+}
+
+TEST_F(OvmsConfigDeathTest, restMaxBodySizeZero) {
+    char* n_argv[] = {"ovms", "--config_path", "/path1", "--rest_port", "8080", "--rest_max_body_size", "0"};
+    int arg_count = 7;
+    EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "rest_max_body_size must be greater than 0");
+}
+
 TEST_F(OvmsConfigDeathTest, invalidRestBindAddress) {
     char* n_argv[] = {"ovms", "--config_path", "/path1", "--rest_port", "8081", "--port", "8080", "--rest_bind_address", "192.0.2"};
     int arg_count = 9;
@@ -285,6 +297,18 @@ TEST_F(OvmsConfigDeathTest, nonExistingLogLevel) {
     EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "log_level should be one of");
 }
 
+TEST_F(OvmsConfigDeathTest, nonExistingAsyncLoggingOverflowPolicy) {
+    char* n_argv[] = {"ovms", "--model_path", "/path1", "--model_name", "model", "--async_logging", "--async_logging_overflow_policy", "WRONG"};
+    int arg_count = 8;
+    EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "async_logging_overflow_policy should be one of");
+}
+
+TEST_F(OvmsConfigDeathTest, zeroAsyncLoggingQueueSize) {
+    char* n_argv[] = {"ovms", "--model_path", "/path1", "--model_name", "model", "--async_logging", "--async_logging_queue_size", "0"};
+    int arg_count = 8;
+    EXPECT_EXIT(ovms::Config::instance().parse(arg_count, n_argv), ::testing::ExitedWithCode(EX_USAGE), "async_logging_queue_size must be greater than 0");
+}
+
 TEST_F(OvmsConfigDeathTest, lowLatencyUsedForNonStateful) {
     char* n_argv[] = {"ovms", "--model_path", "/path1", "--model_name", "model", "--low_latency_transformation"};
     int arg_count = 6;
@@ -363,6 +387,46 @@ TEST(OvmsConfigTest, positiveMulti) {
     EXPECT_EQ(config.configPath(), "/config.json");
 }
 
+TEST(OvmsConfigTest, restServerLimits) {
+    char* n_argv[] = {"ovms",
+        "--config_path", "/config.json",
+        "--rest_port", "45",
+        "--rest_event_loops", "1",
+        "--rest_max_body_size", "1048576",
+        "--rest_max_concurrent_requests", "64"};
+    int arg_count = 11;
+    ConstructorEnabledConfig config;
+    config.parse(arg_count, n_argv);
+
+    EXPECT_EQ(config.restEventLoops(), 1);
+    EXPECT_EQ(config.restMaxBodySize(), 1048576);
+    EXPECT_EQ(config.restMaxConcurrentRequests(), 64);
+}
+
+TEST(OvmsConfigTest, restServerLimitsDefaults) {
+    char* n_argv[] = {"ovms", "--config_path", "/config.json", "--rest_port", "45"};
+    int arg_count = 5;
+    ConstructorEnabledConfig config;
+    config.parse(arg_count, n_argv);
+
+    EXPECT_EQ(config.restEventLoops(), 1);
+    EXPECT_EQ(config.restMaxBodySize(), 1024 * 1024 * 1024);
+    EXPECT_EQ(config.restMaxConcurrentRequests(), 0);
+}
+
+TEST(OvmsConfigTest, sharedMemoryDisabledByDefault) {
+    char* n_argv[] = {"ovms", "--config_path", "/config.json"};
+    int arg_count = 3;
+    ConstructorEnabledConfig config;
+    config.parse(arg_count, n_argv);
+    EXPECT_FALSE(config.sharedMemoryEnabled());
+
+    char* enabled_argv[] = {"ovms", "--config_path", "/config.json", "--shared_memory_enable"};
+    ConstructorEnabledConfig enabledConfig;
+    enabledConfig.parse(4, enabled_argv);
+    EXPECT_TRUE(enabledConfig.sharedMemoryEnabled());
+}
+
 TEST(OvmsConfigTest, positiveSingle) {
     char* n_argv[] = {
         "ovms",
@@ -0,0 +1,164 @@
+//*****************************************************************************
+// Copyright 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "../profiler.hpp"
+
+using namespace ovms;
+
+using testing::HasSubstr;
+using testing::Not;
+
+namespace {
+void tracedStage() {
+    OVMS_PROFILE_FUNCTION();
+    OVMS_PROFILE_SYNC_BEGIN("sync stage");
+    OVMS_PROFILE_SYNC_END("sync stage");
+}
+
+void tracedRequest() {
+    OVMS_PROFILE_REQUEST("test request");
+    tracedStage();
+}
+
+size_t countEvents(const std::string& dump, const std::string& name) {
+    rapidjson::Document doc;
+    doc.Parse(dump.c_str());
+    EXPECT_FALSE(doc.HasParseError());
+    size_t count = 0;
+    for (auto& event : doc["traceEvents"].GetArray()) {
+        if (name == event["name"].GetString()) {
+            count++;
+        }
+    }
+    return count;
+}
+}  // namespace
+
+class SampledTracerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SampledTracer::instance().clear();
+    }
+    void TearDown() override {
+        SampledTracer::instance().configure(false, SampledTracer::DEFAULT_SAMPLING_RATE, SampledTracer::DEFAULT_RETENTION_SECONDS);
+        SampledTracer::instance().clear();
+    }
+};
+
+TEST_F(SampledTracerTest, DisabledRecordsNothing) {
+    SampledTracer::instance().configure(false, 1, 10);
+    tracedRequest();
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "test request"), 0);
+    EXPECT_EQ(SampledTracer::currentRequestId, 0);
+}
+
+TEST_F(SampledTracerTest, EveryRequestTracedWithRateOne) {
+    SampledTracer::instance().configure(true, 1, 10);
+    for (int i = 0; i < 3; i++) {
+        tracedRequest();
+    }
+    auto dump = SampledTracer::instance().dump();
+    EXPECT_EQ(countEvents(dump, "test request"), 6);
+    EXPECT_EQ(countEvents(dump, "sync stage"), 6);
+    EXPECT_THAT(dump, HasSubstr("tracedStage"));
+    EXPECT_EQ(SampledTracer::currentRequestId, 0);
+}
+
+TEST_F(SampledTracerTest, OneInNRequestsTraced) {
+    SampledTracer::instance().configure(true, 10, 10);
+    for (int i = 0; i < 100; i++) {
+        tracedRequest();
+    }
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "test request"), 2 * 10);
+}
+
+TEST_F(SampledTracerTest, ScopesOutsideOfRequestNotTraced) {
+    SampledTracer::instance().configure(true, 1, 10);
+    tracedStage();
+    EXPECT_THAT(SampledTracer::instance().dump(), Not(HasSubstr("sync stage")));
+}
+
+TEST_F(SampledTracerTest, EventsFromManyThreads) {
+    SampledTracer::instance().configure(true, 1, 10);
+    std::vector<std::thread> threads;
+    const int threadsCount = 4;
+    const int requestsPerThread = 50;
+    for (int t = 0; t < threadsCount; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < requestsPerThread; i++) {
+                tracedRequest();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "test request"), 2 * threadsCount * requestsPerThread);
+}
+
+TEST_F(SampledTracerTest, RequestTracedOnThreadItIsHandedOverTo) {
+    SampledTracer::instance().configure(true, 1, 10);
+    {
+        OVMS_PROFILE_REQUEST("test request");
+        std::thread worker([traceRequestId = SampledTracer::currentRequestId]() {
+            SampledTraceContinuation trace(traceRequestId);
+            tracedStage();
+        });
+        worker.join();
+    }
+    rapidjson::Document doc;
+    doc.Parse(SampledTracer::instance().dump().c_str());
+    ASSERT_FALSE(doc.HasParseError());
+    std::set<uint64_t> requestIds;
+    std::set<uint64_t> threadIds;
+    for (auto& event : doc["traceEvents"].GetArray()) {
+        requestIds.insert(event["args"]["request_id"].GetUint64());
+        threadIds.insert(event["tid"].GetUint64());
+    }
+    EXPECT_EQ(requestIds.size(), 1u);
+    EXPECT_EQ(threadIds.size(), 2u);
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "sync stage"), 2);
+}
+
+TEST_F(SampledTracerTest, ClearDropsEarlierEvents) {
+    SampledTracer::instance().configure(true, 1, 10);
+    tracedRequest();
+    SampledTracer::instance().clear();
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "test request"), 0);
+    tracedRequest();
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "test request"), 2);
+}
+
+TEST_F(SampledTracerTest, SlotWrittenNextIsNotDumped) {
+    SampledTracer::instance().configure(true, 1, 10);
+    // new thread starts with empty buffer, each request records 2 events
+    std::thread worker([]() {
+        for (size_t i = 0; i < SampledTracer::THREAD_BUFFER_CAPACITY / 2; i++) {
+            OVMS_PROFILE_REQUEST("test request");
+        }
+    });
+    worker.join();
+    // buffer is full, the oldest event may be overwritten by the next write
+    EXPECT_EQ(countEvents(SampledTracer::instance().dump(), "test request"), SampledTracer::THREAD_BUFFER_CAPACITY - 1);
+}
@@ -0,0 +1,110 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../protobuf_arena_pool.hpp"
+#include "../rest_parser.hpp"
+#include "../status.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+using testing::ElementsAre;
+
+TEST(ProtobufArenaPool, ArenaIsReturnedToThreadPool) {
+    // run in separate thread to start with empty pool
+    std::thread t([]() {
+        EXPECT_EQ(ProtobufArenaPool::getPooledArenasCount(), 0);
+        google::protobuf::Arena* leasedArena = nullptr;
+        {
+            auto lease = ProtobufArenaPool::acquire();
+            leasedArena = lease.get();
+            auto* request = lease.create<::KFSRequest>();
+            request->set_model_name("dummy");
+            EXPECT_EQ(request->GetArena(), leasedArena);
+        }
+        EXPECT_EQ(ProtobufArenaPool::getPooledArenasCount(), 1);
+        auto lease = ProtobufArenaPool::acquire();
+        EXPECT_EQ(lease.get(), leasedArena);
+        EXPECT_EQ(ProtobufArenaPool::getPooledArenasCount(), 0);
+    });
+    t.join();
+}
+
+TEST(ProtobufArenaPool, NestedLeasesUseDifferentArenas) {
+    std::thread t([]() {
+        auto first = ProtobufArenaPool::acquire();
+        auto second = ProtobufArenaPool::acquire();
+        EXPECT_NE(first.get(), second.get());
+    });
+    t.join();
+}
+
+TEST(ProtobufArenaPool, PoolSizeIsLimited) {
+    std::thread t([]() {
+        {
+            std::vector<ProtobufArenaPool::Lease> leases;
+            for (size_t i = 0; i < ProtobufArenaPool::MAX_POOLED_ARENAS_PER_THREAD + 2; i++) {
+                leases.emplace_back(ProtobufArenaPool::acquire());
+            }
+        }
+        EXPECT_EQ(ProtobufArenaPool::getPooledArenasCount(), ProtobufArenaPool::MAX_POOLED_ARENAS_PER_THREAD);
+    });
+    t.join();
+}
+
+TEST(ProtobufArenaPool, ArenaGrowsBeyondInitialBlock) {
+    auto lease = ProtobufArenaPool::acquire();
+    auto* request = lease.create<::KFSRequest>();
+    request->add_raw_input_contents()->assign(4 * ProtobufArenaPool::INITIAL_BLOCK_SIZE, 'a');
+    EXPECT_EQ(request->raw_input_contents(0).size(), 4 * ProtobufArenaPool::INITIAL_BLOCK_SIZE);
+}
+
+TEST(ProtobufArenaPool, CreateArenaMessageOnHeap) {
+    auto message = createArenaMessage<::KFSRequest>(nullptr);
+    ASSERT_NE(message, nullptr);
+    EXPECT_EQ(message->GetArena(), nullptr);
+}
+
+TEST(ProtobufArenaPool, KFSRestParserParsesIntoArenaMessage) {
+    auto lease = ProtobufArenaPool::acquire();
+    ::KFSRequest& request = *lease.create<::KFSRequest>();
+    KFSRestParser parser(request);
+    std::string body = R"({"inputs" : [{"name" : "input0", "shape" : [ 2 ], "datatype" : "INT32", "data" : [ 1, 2 ]}]})";
+    ASSERT_EQ(parser.parse(body.c_str()), StatusCode::OK);
+    EXPECT_EQ(&parser.getProto(), &request);
+    ASSERT_EQ(request.inputs_size(), 1);
+    EXPECT_THAT(request.inputs(0).contents().int_contents(), ElementsAre(1, 2));
+}
+
+TEST(ProtobufArenaPool, TFSRestParserOnArena) {
+    auto lease = ProtobufArenaPool::acquire();
+    TFSRestParser parser(prepareTensors({{"i", {1, 2}}}), lease.get());
+    ASSERT_EQ(parser.parse(R"({"instances":[{"i":[155.0, 56.0]}]})"), StatusCode::OK);
+    EXPECT_EQ(parser.getProto().GetArena(), lease.get());
+    ASSERT_EQ(parser.getProto().inputs().count("i"), 1u);
+    EXPECT_EQ(parser.getProto().inputs().at("i").tensor_content().size(), 2 * sizeof(float));
+
+    TFSRestParser copy(parser);
+    EXPECT_EQ(copy.getProto().GetArena(), nullptr);
+    EXPECT_EQ(copy.getProto().inputs().at("i").tensor_content(), parser.getProto().inputs().at("i").tensor_content());
+    EXPECT_EQ(copy.getOrder(), Order::ROW);
+}
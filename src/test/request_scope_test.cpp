@@ -0,0 +1,172 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <optional>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../queue.hpp"
+#include "../request_scope.hpp"
+#include "../status.hpp"
+
+using namespace ovms;
+
+TEST(RequestPriority, Parse) {
+    RequestPriority priority = RequestPriority::NORMAL;
+    EXPECT_EQ(parseRequestPriority("high", priority), StatusCode::OK);
+    EXPECT_EQ(priority, RequestPriority::HIGH);
+    EXPECT_EQ(parseRequestPriority("LOW", priority), StatusCode::OK);
+    EXPECT_EQ(priority, RequestPriority::LOW);
+    EXPECT_EQ(parseRequestPriority("Normal", priority), StatusCode::OK);
+    EXPECT_EQ(priority, RequestPriority::NORMAL);
+    EXPECT_EQ(parseRequestPriority("urgent", priority), StatusCode::INVALID_PRIORITY);
+    EXPECT_EQ(parseRequestPriority("", priority), StatusCode::INVALID_PRIORITY);
+    EXPECT_EQ(priority, RequestPriority::NORMAL);
+}
+
+TEST(RequestPriority, IndexesAreDistinctAndInRange) {
+    EXPECT_EQ(toIndex(RequestPriority::LOW), 0u);
+    EXPECT_EQ(toIndex(RequestPriority::NORMAL), 1u);
+    EXPECT_EQ(toIndex(RequestPriority::HIGH), 2u);
+    for (auto priority : REQUEST_PRIORITIES) {
+        EXPECT_LT(toIndex(priority), REQUEST_PRIORITIES.size());
+    }
+}
+
+TEST(RequestScope, NestedScopeRestoresOuterPriority) {
+    EXPECT_EQ(RequestScope::current(), nullptr);
+    EXPECT_EQ(RequestScope::currentPriority(), RequestPriority::NORMAL);
+    {
+        RequestScope outer(RequestPriority::LOW);
+        EXPECT_EQ(RequestScope::currentPriority(), RequestPriority::LOW);
+        {
+            RequestScope inner(RequestPriority::HIGH);
+            EXPECT_EQ(RequestScope::current(), &inner);
+            EXPECT_EQ(RequestScope::currentPriority(), RequestPriority::HIGH);
+        }
+        EXPECT_EQ(RequestScope::current(), &outer);
+        EXPECT_EQ(RequestScope::currentPriority(), RequestPriority::LOW);
+    }
+    EXPECT_EQ(RequestScope::current(), nullptr);
+}
+
+TEST(RequestScope, IsBoundToThread) {
+    RequestScope scope(RequestPriority::HIGH);
+    auto otherThreadPriority = std::async(std::launch::async, []() { return RequestScope::currentPriority(); });
+    EXPECT_EQ(otherThreadPriority.get(), RequestPriority::NORMAL);
+}
+
+TEST(RequestScope, ChecksDeadlineAndCancellation) {
+    EXPECT_EQ(RequestScope::checkCurrent(), StatusCode::OK);
+    bool cancelled = false;
+    RequestScope scope(RequestPriority::NORMAL, RequestScope::Clock::now() + std::chrono::hours(1), [&cancelled]() { return cancelled; });
+    EXPECT_TRUE(scope.isCancellable());
+    EXPECT_EQ(RequestScope::checkCurrent(), StatusCode::OK);
+    cancelled = true;
+    EXPECT_EQ(RequestScope::checkCurrent(), StatusCode::REQUEST_CANCELLED);
+    {
+        RequestScope expired(RequestPriority::NORMAL, RequestScope::Clock::now() - std::chrono::milliseconds(1), nullptr);
+        EXPECT_FALSE(expired.isCancellable());
+        EXPECT_EQ(RequestScope::checkCurrent(), StatusCode::REQUEST_DEADLINE_EXCEEDED);
+    }
+    EXPECT_EQ(RequestScope::checkCurrent(), StatusCode::REQUEST_CANCELLED);
+}
+
+TEST(RequestScope, NestedScopeInheritsDeadlineAndCancellation) {
+    const auto deadline = RequestScope::Clock::now() + std::chrono::hours(1);
+    RequestScope outer(RequestPriority::LOW, deadline, []() { return true; });
+    RequestScope inner(RequestPriority::HIGH);
+    EXPECT_EQ(inner.getDeadline(), deadline);
+    EXPECT_TRUE(inner.isCancellable());
+    EXPECT_EQ(RequestScope::checkCurrent(), StatusCode::REQUEST_CANCELLED);
+}
+
+TEST(QueuePriority, HigherPriorityWaiterIsServedFirst) {
+    Queue<int> queue(1);
+    uint64_t waiterId = 0;
+    auto taken = queue.getIdleStream(0, 0, waiterId);
+    ASSERT_TRUE(taken.has_value());
+    EXPECT_EQ(waiterId, 0u);
+    int streamId = taken->get();
+
+    auto low = queue.getIdleStream(static_cast<int>(RequestPriority::LOW));
+    auto normal = queue.getIdleStream(static_cast<int>(RequestPriority::NORMAL));
+    auto high = queue.getIdleStream(static_cast<int>(RequestPriority::HIGH));
+    EXPECT_EQ(queue.getWaitingCount(), 3u);
+
+    queue.returnStream(streamId);
+    ASSERT_EQ(high.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_NE(low.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_NE(normal.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    queue.returnStream(high.get());
+    ASSERT_EQ(normal.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_NE(low.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    queue.returnStream(normal.get());
+    ASSERT_EQ(low.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_EQ(low.get(), streamId);
+    EXPECT_EQ(queue.getWaitingCount(), 0u);
+}
+
+TEST(QueuePriority, SamePriorityWaitersAreServedInOrder) {
+    Queue<int> queue(1);
+    int streamId = queue.getIdleStream().get();
+    auto first = queue.getIdleStream();
+    auto second = queue.getIdleStream();
+    queue.returnStream(streamId);
+    ASSERT_EQ(first.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_NE(second.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    queue.returnStream(first.get());
+    EXPECT_EQ(second.get(), streamId);
+}
+
+TEST(QueuePriority, WaitersOverLimitAreRejected) {
+    Queue<int> queue(1);
+    uint64_t waiterId = 0;
+    int streamId = queue.getIdleStream().get();
+    auto first = queue.getIdleStream(0, 2, waiterId);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_NE(waiterId, 0u);
+    auto second = queue.getIdleStream(0, 2, waiterId);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_FALSE(queue.getIdleStream(1, 2, waiterId).has_value());
+    // limit does not apply when there is an idle stream
+    queue.returnStream(streamId);
+    queue.returnStream(first->get());
+    queue.returnStream(second->get());
+    EXPECT_TRUE(queue.getIdleStream(0, 2, waiterId).has_value());
+    EXPECT_EQ(waiterId, 0u);
+}
+
+TEST(QueuePriority, CancelledWaiterIsSkipped) {
+    Queue<int> queue(1);
+    int streamId = queue.getIdleStream().get();
+    uint64_t cancelledId = 0;
+    uint64_t waitingId = 0;
+    auto cancelled = queue.getIdleStream(1, 0, cancelledId);
+    auto waiting = queue.getIdleStream(0, 0, waitingId);
+    ASSERT_TRUE(cancelled.has_value());
+    ASSERT_TRUE(waiting.has_value());
+    EXPECT_TRUE(queue.cancelWaiting(1, cancelledId));
+    EXPECT_FALSE(queue.cancelWaiting(1, cancelledId));
+    EXPECT_EQ(queue.getWaitingCount(), 1u);
+    queue.returnStream(streamId);
+    EXPECT_EQ(waiting->get(), streamId);
+    // stream already given cannot be cancelled
+    EXPECT_FALSE(queue.cancelWaiting(0, waitingId));
+}
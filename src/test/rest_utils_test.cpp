@@ -265,6 +265,53 @@ TEST_P(TFSMakeJsonFromPredictResponseRawTest, ErrorWhenNoOutputs) {
     EXPECT_EQ(makeJsonFromPredictResponse(proto, &json, order), StatusCode::REST_PROTO_TO_STRING_ERROR);
 }
 
+TEST_F(TFSMakeJsonFromPredictResponseRawTest, PositiveBinary) {
+    std::optional<int> inferenceHeaderContentLength;
+    ASSERT_EQ(makeBinaryFromPredictResponse(proto, &json, inferenceHeaderContentLength), StatusCode::OK);
+    std::string expectedJson = R"({
+    "outputs": [{
+            "name": "output1",
+            "shape": [2, 1, 4],
+            "datatype": "FP32",
+            "parameters": {
+                "binary_data_size": 32
+            }
+        }, {
+            "name": "output2",
+            "shape": [2, 5],
+            "datatype": "INT8",
+            "parameters": {
+                "binary_data_size": 10
+            }
+        }]
+})";
+    ASSERT_TRUE(inferenceHeaderContentLength.has_value());
+    ASSERT_EQ(inferenceHeaderContentLength.value(), expectedJson.size());
+    EXPECT_EQ(json.substr(0, expectedJson.size()), expectedJson);
+    EXPECT_EQ(json.substr(expectedJson.size()), output1->tensor_content() + output2->tensor_content());
+}
+
+TEST_F(TFSMakeJsonFromPredictResponseRawTest, PositiveBinaryString) {
+    proto.mutable_outputs()->clear();
+    auto& output = (*proto.mutable_outputs())["output"];
+    output.set_dtype(tensorflow::DataType::DT_STRING);
+    output.mutable_tensor_shape()->add_dim()->set_size(2);
+    output.add_string_val("abc");
+    output.add_string_val("");
+    std::optional<int> inferenceHeaderContentLength;
+    ASSERT_EQ(makeBinaryFromPredictResponse(proto, &json, inferenceHeaderContentLength), StatusCode::OK);
+    ASSERT_TRUE(inferenceHeaderContentLength.has_value());
+    EXPECT_NE(json.substr(0, inferenceHeaderContentLength.value()).find(R"("datatype": "BYTES")"), std::string::npos);
+    EXPECT_EQ(json.substr(inferenceHeaderContentLength.value()), std::string("\x03\x00\x00\x00" "abc" "\x00\x00\x00\x00", 11));
+}
+
+TEST_F(TFSMakeJsonFromPredictResponseRawTest, BinaryInvalidTensorContentSizeError) {
+    output1->mutable_tensor_content()->assign("\xFF\xFF\x55\x55", 4);
+    std::optional<int> inferenceHeaderContentLength;
+    EXPECT_EQ(makeBinaryFromPredictResponse(proto, &json, inferenceHeaderContentLength), StatusCode::REST_SERIALIZE_TENSOR_CONTENT_INVALID_SIZE);
+    EXPECT_FALSE(inferenceHeaderContentLength.has_value());
+}
+
 INSTANTIATE_TEST_SUITE_P(
     TestGrpcRestResponseConversion,
     TFSMakeJsonFromPredictResponseRawTest,
@@ -0,0 +1,211 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "../deserialization.hpp"
+#include "../kfs_frontend/kfs_utils.hpp"
+#include "../shared_memory_manager.hpp"
+#include "../status.hpp"
+#include "../tensorinfo.hpp"
+#include "test_utils.hpp"
+
+using namespace ovms;
+
+class SharedMemoryManagerTest : public ::testing::Test {
+protected:
+    const std::string key = "/ovms_shared_memory_manager_test";
+    static constexpr size_t OBJECT_SIZE = 8192;
+    char* object = nullptr;
+    SharedMemoryManager manager;
+
+    void SetUp() override {
+        int fd = shm_open(key.c_str(), O_CREAT | O_RDWR, 0600);
+        ASSERT_NE(fd, -1);
+        ASSERT_EQ(ftruncate(fd, OBJECT_SIZE), 0);
+        void* mapping = mmap(nullptr, OBJECT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        ASSERT_NE(mapping, MAP_FAILED);
+        object = static_cast<char*>(mapping);
+    }
+    void TearDown() override {
+        manager.unregisterRegion("");
+        if (object != nullptr) {
+            munmap(object, OBJECT_SIZE);
+        }
+        shm_unlink(key.c_str());
+    }
+};
+
+TEST_F(SharedMemoryManagerTest, RegisterAndUnregister) {
+    ASSERT_EQ(manager.registerRegion("input", key, 0, 1024), StatusCode::OK);
+    EXPECT_EQ(manager.registerRegion("input", key, 1024, 1024), StatusCode::SHARED_MEMORY_REGION_ALREADY_REGISTERED);
+    ASSERT_EQ(manager.registerRegion("output", key, 4096, 1024), StatusCode::OK);
+
+    std::vector<std::shared_ptr<const SharedMemoryRegion>> regions;
+    ASSERT_EQ(manager.getRegions("", regions), StatusCode::OK);
+    EXPECT_EQ(regions.size(), 2);
+    regions.clear();
+    ASSERT_EQ(manager.getRegions("output", regions), StatusCode::OK);
+    ASSERT_EQ(regions.size(), 1);
+    EXPECT_EQ(regions[0]->getKey(), key);
+    EXPECT_EQ(regions[0]->getOffset(), 4096);
+    EXPECT_EQ(regions[0]->getByteSize(), 1024);
+
+    ASSERT_EQ(manager.unregisterRegion("input"), StatusCode::OK);
+    EXPECT_EQ(manager.unregisterRegion("input"), StatusCode::SHARED_MEMORY_REGION_NOT_FOUND);
+    regions.clear();
+    EXPECT_EQ(manager.getRegions("input", regions), StatusCode::SHARED_MEMORY_REGION_NOT_FOUND);
+    ASSERT_EQ(manager.unregisterRegion(""), StatusCode::OK);
+    regions.clear();
+    ASSERT_EQ(manager.getRegions("", regions), StatusCode::OK);
+    EXPECT_EQ(regions.size(), 0);
+}
+
+TEST_F(SharedMemoryManagerTest, RegisterInvalidRegion) {
+    EXPECT_EQ(manager.registerRegion("input", "/ovms_not_existing_object", 0, 16), StatusCode::SHARED_MEMORY_REGION_OPEN_FAILED);
+    EXPECT_EQ(manager.registerRegion("input", key, OBJECT_SIZE - 8, 16), StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS);
+    EXPECT_EQ(manager.registerRegion("input", key, OBJECT_SIZE + 1, 1), StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS);
+    // offset + byte size overflows to the value within object size
+    EXPECT_EQ(manager.registerRegion("input", key, 16, std::numeric_limits<size_t>::max() - 8), StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS);
+    EXPECT_EQ(manager.registerRegion("input", key, std::numeric_limits<size_t>::max() - 8, 16), StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS);
+    EXPECT_EQ(manager.registerRegion("input", key, 0, 0), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    EXPECT_EQ(manager.registerRegion("", key, 0, 16), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+}
+
+TEST_F(SharedMemoryManagerTest, CreateTensorDoesNotCopyData) {
+    // offset which is not aligned to page size
+    ASSERT_EQ(manager.registerRegion("input", key, 100, 64), StatusCode::OK);
+    float* values = reinterpret_cast<float*>(object + 100 + 16);
+    values[0] = 1.0f;
+    values[1] = 2.0f;
+
+    ov::Tensor tensor;
+    EXPECT_EQ(manager.createTensor({"input", 16, 8}, ov::element::f32, ov::Shape{1, 3}, tensor), StatusCode::INVALID_CONTENT_SIZE);
+    EXPECT_EQ(manager.createTensor({"input", 60, 8}, ov::element::f32, ov::Shape{1, 2}, tensor), StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS);
+    EXPECT_EQ(manager.createTensor({"missing", 16, 8}, ov::element::f32, ov::Shape{1, 2}, tensor), StatusCode::SHARED_MEMORY_REGION_NOT_FOUND);
+    ASSERT_EQ(manager.createTensor({"input", 16, 8}, ov::element::f32, ov::Shape{1, 2}, tensor), StatusCode::OK);
+    EXPECT_EQ(tensor.get_shape(), (ov::Shape{1, 2}));
+    EXPECT_EQ(tensor.data<float>()[0], 1.0f);
+    EXPECT_EQ(tensor.data<float>()[1], 2.0f);
+
+    // mapping is kept until tensor is released
+    ASSERT_EQ(manager.unregisterRegion("input"), StatusCode::OK);
+    values[1] = 3.0f;
+    EXPECT_EQ(tensor.data<float>()[1], 3.0f);
+}
+
+TEST_F(SharedMemoryManagerTest, Write) {
+    ASSERT_EQ(manager.registerRegion("output", key, 4096, 32), StatusCode::OK);
+    const std::vector<float> data{4.0f, 5.0f};
+    EXPECT_EQ(manager.write({"output", 8, 4}, data.data(), 8), StatusCode::INVALID_CONTENT_SIZE);
+    EXPECT_EQ(manager.write({"output", 28, 8}, data.data(), 8), StatusCode::SHARED_MEMORY_REGION_OUT_OF_BOUNDS);
+    ASSERT_EQ(manager.write({"output", 8, 16}, data.data(), 8), StatusCode::OK);
+    EXPECT_EQ(std::memcmp(object + 4096 + 8, data.data(), 8), 0);
+}
+
+static void setSharedMemoryParameters(KFSParameters& parameters, const std::string& region, int64_t offset, int64_t byteSize) {
+    parameters[SHARED_MEMORY_REGION_PARAMETER].set_string_param(region);
+    parameters[SHARED_MEMORY_OFFSET_PARAMETER].set_int64_param(offset);
+    parameters[SHARED_MEMORY_BYTE_SIZE_PARAMETER].set_int64_param(byteSize);
+}
+
+TEST(SharedMemoryParameters, GetSharedMemoryReference) {
+    KFSTensorInputProto input;
+    SharedMemoryReference reference;
+    bool isSharedMemoryUsed = true;
+    ASSERT_EQ(getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed), StatusCode::OK);
+    EXPECT_FALSE(isSharedMemoryUsed);
+
+    setSharedMemoryParameters(*input.mutable_parameters(), "input", 16, 8);
+    ASSERT_EQ(getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed), StatusCode::OK);
+    EXPECT_TRUE(isSharedMemoryUsed);
+    EXPECT_EQ(reference.regionName, "input");
+    EXPECT_EQ(reference.offset, 16);
+    EXPECT_EQ(reference.byteSize, 8);
+
+    (*input.mutable_parameters())[SHARED_MEMORY_BYTE_SIZE_PARAMETER].set_int64_param(0);
+    EXPECT_EQ(getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    (*input.mutable_parameters())[SHARED_MEMORY_BYTE_SIZE_PARAMETER].set_string_param("8");
+    EXPECT_EQ(getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    setSharedMemoryParameters(*input.mutable_parameters(), "input", -1, 8);
+    EXPECT_EQ(getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+    input.mutable_parameters()->erase(SHARED_MEMORY_REGION_PARAMETER);
+    EXPECT_EQ(getSharedMemoryReference(input.parameters(), reference, isSharedMemoryUsed), StatusCode::SHARED_MEMORY_PARAMETERS_INVALID);
+}
+
+TEST_F(SharedMemoryManagerTest, DeserializeInputFromSharedMemory) {
+    ASSERT_EQ(manager.registerRegion("input", key, 0, 64), StatusCode::OK);
+    float* values = reinterpret_cast<float*>(object);
+    for (int i = 0; i < DUMMY_MODEL_INPUT_SIZE; i++) {
+        values[i] = i;
+    }
+    auto tensorInfo = std::make_shared<TensorInfo>(DUMMY_MODEL_INPUT_NAME, ovms::Precision::FP32, shape_t{1, DUMMY_MODEL_INPUT_SIZE}, Layout{"NC"});
+    KFSTensorInputProto input;
+    input.set_name(DUMMY_MODEL_INPUT_NAME);
+    input.set_datatype("FP32");
+    input.add_shape(1);
+    input.add_shape(DUMMY_MODEL_INPUT_SIZE);
+    setSharedMemoryParameters(*input.mutable_parameters(), "input", 0, DUMMY_MODEL_INPUT_SIZE * sizeof(float));
+
+    ov::Tensor tensor;
+    bool isSharedMemoryUsed = false;
+    EXPECT_EQ(makeSharedMemoryTensor(input, tensorInfo, tensor, isSharedMemoryUsed), StatusCode::SHARED_MEMORY_DISABLED);
+    SharedMemoryScope scope(&manager);
+    ASSERT_EQ(makeSharedMemoryTensor(input, tensorInfo, tensor, isSharedMemoryUsed), StatusCode::OK);
+    ASSERT_TRUE(isSharedMemoryUsed);
+    EXPECT_EQ(tensor.data(), object);
+    EXPECT_EQ(tensor.get_byte_size(), DUMMY_MODEL_INPUT_SIZE * sizeof(float));
+}
+
+TEST_F(SharedMemoryManagerTest, WriteOutputsToSharedMemory) {
+    ASSERT_EQ(manager.registerRegion("output", key, 0, 64), StatusCode::OK);
+    KFSRequest request;
+    auto* requestedOutput = request.add_outputs();
+    requestedOutput->set_name("b");
+    setSharedMemoryParameters(*requestedOutput->mutable_parameters(), "output", 8, 16);
+    request.add_outputs()->set_name("a");
+
+    KFSResponse response;
+    const std::vector<float> a{1.0f, 2.0f};
+    const std::vector<float> b{3.0f, 4.0f};
+    response.add_outputs()->set_name("a");
+    response.add_raw_output_contents()->assign(reinterpret_cast<const char*>(a.data()), 8);
+    response.add_outputs()->set_name("b");
+    response.add_raw_output_contents()->assign(reinterpret_cast<const char*>(b.data()), 8);
+
+    EXPECT_EQ(writeOutputsToSharedMemory(nullptr, request, response), StatusCode::SHARED_MEMORY_DISABLED);
+    ASSERT_EQ(writeOutputsToSharedMemory(&manager, request, response), StatusCode::OK);
+    EXPECT_EQ(std::memcmp(object + 8, b.data(), 8), 0);
+    ASSERT_EQ(response.raw_output_contents_size(), 2);
+    EXPECT_EQ(response.raw_output_contents(0).size(), 8);
+    EXPECT_TRUE(response.raw_output_contents(1).empty());
+    const auto& parameters = response.outputs(1).parameters();
+    EXPECT_EQ(parameters.at(SHARED_MEMORY_REGION_PARAMETER).string_param(), "output");
+    EXPECT_EQ(parameters.at(SHARED_MEMORY_OFFSET_PARAMETER).int64_param(), 8);
+    EXPECT_EQ(parameters.at(SHARED_MEMORY_BYTE_SIZE_PARAMETER).int64_param(), 8);
+    EXPECT_EQ(response.outputs(0).parameters_size(), 0);
+}
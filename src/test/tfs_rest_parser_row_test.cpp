@@ -643,3 +643,14 @@ TEST(TFSRestParserRow, RemoveUnnecessaryInputs) {
     ASSERT_EQ(parser.getProto().inputs().count("k"), 1);
     ASSERT_EQ(parser.getProto().inputs().count("l"), 1);
 }
+
+TEST(TFSRestParserRow, BinaryDataOutput) {
+    TFSRestParser parser(prepareTensors({{"i", {1, 1}}}));
+    ASSERT_EQ(parser.parse(R"({"instances":[{"i":[1.0]}]})"), StatusCode::OK);
+    EXPECT_FALSE(parser.isBinaryDataOutputRequested());
+    ASSERT_EQ(parser.parse(R"({"binary_data_output":true,"instances":[{"i":[1.0]}]})"), StatusCode::OK);
+    EXPECT_TRUE(parser.isBinaryDataOutputRequested());
+
+    TFSRestParser invalidParser(prepareTensors({{"i", {1, 1}}}));
+    EXPECT_EQ(invalidParser.parse(R"({"binary_data_output":1,"instances":[{"i":[1.0]}]})"), StatusCode::REST_COULD_NOT_PARSE_PARAMETERS);
+}
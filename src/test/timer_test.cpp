@@ -0,0 +1,72 @@
+//*****************************************************************************
+// Copyright 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include <chrono>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "../timer.hpp"
+
+using namespace ovms;
+
+namespace {
+enum : unsigned int {
+    FIRST,
+    SECOND,
+    TIMER_END
+};
+}  // namespace
+
+TEST(TimerTest, ElapsedMatchesSteadyClock) {
+    Timer<TIMER_END> timer;
+    auto steadyStart = std::chrono::steady_clock::now();
+    timer.start(FIRST);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timer.stop(FIRST);
+    auto steadyElapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - steadyStart).count();
+    double elapsed = timer.elapsed<std::chrono::microseconds>(FIRST);
+    EXPECT_GE(elapsed, 20000 * 0.95);
+    EXPECT_LE(elapsed, steadyElapsed * 1.05);
+    EXPECT_NEAR(timer.elapsed<std::chrono::milliseconds>(FIRST), elapsed / 1000, 1);
+}
+
+TEST(TimerTest, IndependentSlots) {
+    Timer<TIMER_END> timer;
+    timer.start(FIRST);
+    timer.start(SECOND);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    timer.stop(SECOND);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    timer.stop(FIRST);
+    EXPECT_GT(timer.elapsed<std::chrono::microseconds>(FIRST), timer.elapsed<std::chrono::microseconds>(SECOND));
+}
+
+// Run with --gtest_also_run_disabled_tests, cost in ns is recorded as test property in --gtest_output report
+TEST(TimerTest, DISABLED_StartStopCost) {
+    const int iterations = 1000000;
+    Timer<TIMER_END> timer;
+    double sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        timer.start(FIRST);
+        timer.stop(FIRST);
+        sink += timer.elapsed<std::chrono::nanoseconds>(FIRST);
+    }
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    RecordProperty("start_stop_ns", static_cast<int>(ns / iterations));
+    RecordProperty("tsc_used", TickClock::isTscUsed());
+    EXPECT_GE(sink, 0);
+}
@@ -0,0 +1,69 @@
+//*****************************************************************************
+// Copyright 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+namespace ovms {
+/**
+ * @brief Base for objects created and destroyed once per inference, like unload guards.
+ * Memory of the last destroyed object is kept per thread and reused by the next object
+ * created on that thread, so steady state inference does not reach the global allocator for them.
+ * Derived classes of other size are allocated with global operator new.
+ */
+template <typename T>
+class ThreadLocalRecycled {
+    struct SpareBlock {
+        void* block = nullptr;
+        ~SpareBlock() {
+            ::operator delete(block);
+        }
+    };
+
+    static SpareBlock& spare() {
+        thread_local SpareBlock spareBlock;
+        return spareBlock;
+    }
+
+public:
+    static void* operator new(std::size_t size) {
+        if (size == sizeof(T)) {
+            SpareBlock& spareBlock = spare();
+            if (spareBlock.block != nullptr) {
+                void* block = spareBlock.block;
+                spareBlock.block = nullptr;
+                return block;
+            }
+        }
+        return ::operator new(size);
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+        if (size == sizeof(T)) {
+            SpareBlock& spareBlock = spare();
+            if (spareBlock.block == nullptr) {
+                spareBlock.block = ptr;
+                return;
+            }
+        }
+        ::operator delete(ptr);
+    }
+};
+}  // namespace ovms
@@ -0,0 +1,67 @@
+//*****************************************************************************
+// Copyright 2023 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//*****************************************************************************
+#include "timer.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace ovms {
+
+namespace {
+constexpr auto TSC_CALIBRATION_TIME = std::chrono::milliseconds(2);
+constexpr unsigned int CPUID_ADVANCED_POWER_MANAGEMENT_LEAF = 0x80000007;
+constexpr unsigned int CPUID_INVARIANT_TSC_BIT = 1 << 8;
+
+bool isInvariantTscAvailable() {
+#if defined(__x86_64__) || defined(__i386__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid_max(0x80000000, nullptr) < CPUID_ADVANCED_POWER_MANAGEMENT_LEAF) {
+        return false;
+    }
+    if (!__get_cpuid(CPUID_ADVANCED_POWER_MANAGEMENT_LEAF, &eax, &ebx, &ecx, &edx)) {
+        return false;
+    }
+    return (edx & CPUID_INVARIANT_TSC_BIT) != 0;
+#else
+    return false;
+#endif
+}
+}  // namespace
+
+TickClock::Calibration TickClock::calibrate() {
+    if (!isInvariantTscAvailable()) {
+        return {false, 1.0};
+    }
+#if defined(__x86_64__) || defined(__i386__)
+    auto steadyStart = std::chrono::steady_clock::now();
+    uint64_t tscStart = __rdtsc();
+    auto steadyStop = steadyStart;
+    while (steadyStop - steadyStart < TSC_CALIBRATION_TIME) {
+        steadyStop = std::chrono::steady_clock::now();
+    }
+    uint64_t tscStop = __rdtsc();
+    if (tscStop <= tscStart) {
+        return {false, 1.0};
+    }
+    double elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(steadyStop - steadyStart).count();
+    return {true, elapsedNs / (tscStop - tscStart)};
+#else
+    return {false, 1.0};
+#endif
+}
+
+}  // namespace ovms
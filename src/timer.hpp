@@ -15,10 +15,16 @@
 //*****************************************************************************
 #pragma once
 
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 namespace ovms {
 
 template <typename T>
@@ -27,25 +33,64 @@ struct is_chrono_duration_type : std::false_type {};
 template <typename T, typename U>
 struct is_chrono_duration_type<std::chrono::duration<T, U>> : std::true_type {};
 
+/**
+ * @brief Cheap monotonic tick source for request stage timers.
+ *
+ * Reads the CPU time stamp counter when it is invariant (constant rate, not stopped in idle states),
+ * otherwise falls back to steady_clock with nanosecond ticks. Tick rate is calibrated once per process,
+ * on first use, so that it does not delay process start and does not depend on static initialization order.
+ */
+class TickClock {
+    struct Calibration {
+        bool useTsc;
+        double nanosecondsPerTick;
+    };
+    static Calibration calibrate();
+
+    static inline const Calibration& getCalibration() {
+        static const Calibration calibration = calibrate();
+        return calibration;
+    }
+
+public:
+    static inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+        if (getCalibration().useTsc) {
+            return __rdtsc();
+        }
+#endif
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static inline std::chrono::nanoseconds toDuration(uint64_t ticks) {
+        return std::chrono::nanoseconds(static_cast<int64_t>(ticks * getCalibration().nanosecondsPerTick));
+    }
+
+    static bool isTscUsed() { return getCalibration().useTsc; }
+};
+
 typedef unsigned int SIZE_TYPE;
 template <SIZE_TYPE N>
 class Timer {
-    std::array<std::chrono::high_resolution_clock::time_point, N> startTimestamps;
-    std::array<std::chrono::high_resolution_clock::time_point, N> stopTimestamps;
+    std::array<uint64_t, N> startTimestamps;
+    std::array<uint64_t, N> stopTimestamps;
 
 public:
     void start(SIZE_TYPE i) {
-        startTimestamps[i] = std::chrono::high_resolution_clock::now();
+        startTimestamps[i] = TickClock::now();
     }
 
     void stop(SIZE_TYPE i) {
-        stopTimestamps[i] = std::chrono::high_resolution_clock::now();
+        stopTimestamps[i] = TickClock::now();
     }
 
     template <typename T>
     double elapsed(SIZE_TYPE i) {
         static_assert(is_chrono_duration_type<T>::value, "Non supported type.");
-        return std::chrono::duration_cast<T>(stopTimestamps[i] - startTimestamps[i]).count();
+        if (stopTimestamps[i] < startTimestamps[i]) {
+            return 0;
+        }
+        return std::chrono::duration_cast<T>(TickClock::toDuration(stopTimestamps[i] - startTimestamps[i])).count();
     }
 };
 }  // namespace ovms